@@ -34,6 +34,7 @@
 #include <ctkCmdLineModuleConcurrentHelpers.h>
 #include <ctkCmdLineModuleDescription.h>
 #include <ctkCmdLineModuleFrontendFactoryQtGui.h>
+#include <ctkCmdLineModuleFrontendQtGui.h>
 #include <ctkCmdLineModuleFrontendFactoryQtWebKit.h>
 #include <ctkCmdLineModuleBackendLocalProcess.h>
 #include <ctkCmdLineModuleBackendFunctionPointer.h>
@@ -88,6 +89,12 @@ ctkCLModuleExplorerMainWindow::ctkCLModuleExplorerMainWindow(QWidget *parent) :
                        ).toInt() * 1000);
 
   // Frontends
+  // Keep the generated Qt GUIs next to the cached XML descriptions
+#if (QT_VERSION < QT_VERSION_CHECK(5,0,0))
+  ctkCmdLineModuleFrontendQtGui::setUiCacheDirectory(QDesktopServices::storageLocation(QDesktopServices::CacheLocation));
+#else
+  ctkCmdLineModuleFrontendQtGui::setUiCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+#endif
   moduleFrontendFactories << new ctkCmdLineModuleFrontendFactoryQtGui;
   moduleFrontendFactories << new ctkCmdLineModuleFrontendFactoryQtWebKit;
   defaultModuleFrontendFactory = moduleFrontendFactories.front();
@@ -7,7 +7,7 @@
 function(ctkFunctionGeneratePluginManifest QRC_SRCS)
 
   CtkMacroParseArguments(MY
-    "ACTIVATIONPOLICY;CATEGORY;CONTACT_ADDRESS;COPYRIGHT;DESCRIPTION;DOC_URL;ICON;LICENSE;NAME;REQUIRE_PLUGIN;SYMBOLIC_NAME;VENDOR;VERSION;CUSTOM_HEADERS"
+    "ACTIVATIONPOLICY;CATEGORY;CONTACT_ADDRESS;COPYRIGHT;DESCRIPTION;DOC_URL;ICON;LAZY_SERVICES;LICENSE;NAME;REQUIRE_PLUGIN;SYMBOLIC_NAME;VENDOR;VERSION;CUSTOM_HEADERS"
     ""
     ${ARGN}
     )
@@ -52,6 +52,11 @@ function(ctkFunctionGeneratePluginManifest QRC_SRCS)
     set(_manifest_content "${_manifest_content}\nPlugin-Icon: ${MY_ICON}")
   endif()
 
+  if(DEFINED MY_LAZY_SERVICES)
+    string(REPLACE ";" "," lazy_services "${MY_LAZY_SERVICES}")
+    set(_manifest_content "${_manifest_content}\nPlugin-LazyServices: ${lazy_services}")
+  endif()
+
   if(DEFINED MY_LICENSE)
     set(_manifest_content "${_manifest_content}\nPlugin-License: ${MY_LICENSE}")
   endif()
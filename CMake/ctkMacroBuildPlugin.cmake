@@ -41,6 +41,7 @@
 #! - Plugin-Description
 #! - Plugin-DocURL
 #! - Plugin-Icon
+#! - Plugin-LazyServices
 #! - Plugin-License
 #! - Plugin-Name
 #! - Require-Plugin
@@ -88,6 +89,7 @@ macro(ctkMacroBuildPlugin)
   set(Plugin-Description )
   set(Plugin-DocURL )
   set(Plugin-Icon )
+  set(Plugin-LazyServices )
   set(Plugin-License )
   set(Plugin-Name )
   set(Require-Plugin )
@@ -216,6 +218,7 @@ macro(ctkMacroBuildPlugin)
     DESCRIPTION ${Plugin-Description}
     DOC_URL ${Plugin-DocURL}
     ICON ${Plugin-Icon}
+    LAZY_SERVICES ${Plugin-LazyServices}
     LICENSE ${Plugin-License}
     NAME ${Plugin-Name}
     REQUIRE_PLUGIN ${Require-Plugin}
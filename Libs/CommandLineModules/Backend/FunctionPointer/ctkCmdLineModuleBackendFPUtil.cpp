@@ -61,5 +61,11 @@ void FunctionPointerProxy::call(const QList<QVariant> &args)
   FpHolder->call(args);
 }
 
+//----------------------------------------------------------------------------
+bool FunctionPointerProxy::isPointerArgument(int index) const
+{
+  return FpHolder->isPointerArgument(index);
+}
+
 }
 }
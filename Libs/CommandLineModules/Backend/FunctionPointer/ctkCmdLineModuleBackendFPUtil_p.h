@@ -23,7 +23,11 @@
 #define CTKCMDLINEMODULEBACKENDFPUTIL_P_H
 
 #include "ctkCommandLineModulesBackendFunctionPointerExport.h"
+#include "ctkCmdLineModuleBackendFPTypeTraits.h"
+#include "ctkCmdLineModuleDataRegistry.h"
+#include "ctkCmdLineModuleRunException.h"
 
+#include <QUrl>
 #include <QVariant>
 
 class ctkCmdLineModuleBackendFunctionPointer;
@@ -31,6 +35,40 @@ class ctkCmdLineModuleBackendFunctionPointer;
 namespace ctk {
 namespace CmdLineModuleBackendFunctionPointer {
 
+// default argument conversion
+template<typename T, typename Enable = void>
+struct ArgumentValue
+{
+  static T get(const QVariant& arg)
+  {
+    Q_ASSERT(arg.canConvert<T>());
+    return arg.value<T>();
+  }
+};
+
+// specialization for pointer arguments, which may point to data from the ctkCmdLineModuleDataRegistry
+template<typename T>
+struct ArgumentValue<T, typename EnableIf<(TypeTraits<T>::isPointer != 0)>::Type>
+{
+  static T get(const QVariant& arg)
+  {
+    if (arg.userType() == qMetaTypeId<DataHolderPointer>())
+    {
+      typedef typename TypeTraits<T>::RawType RawType;
+      DataHolderPointer holder = arg.value<DataHolderPointer>();
+      if (qstrcmp(holder->typeName(), typeid(RawType).name()) != 0)
+      {
+        throw ctkCmdLineModuleRunException(QUrl(), 0,
+                                           QString("Registered data of type %1 does not match the parameter type %2")
+                                           .arg(holder->typeName()).arg(typeid(RawType).name()));
+      }
+      return static_cast<T>(holder->data());
+    }
+    Q_ASSERT(arg.canConvert<T>());
+    return arg.value<T>();
+  }
+};
+
 struct CTK_CMDLINEMODULEBACKENDFP_EXPORT FunctionPointerHolderBase
 {
   virtual ~FunctionPointerHolderBase();
@@ -38,6 +76,9 @@ struct CTK_CMDLINEMODULEBACKENDFP_EXPORT FunctionPointerHolderBase
   virtual FunctionPointerHolderBase* clone() const = 0;
 
   virtual void call(const QList<QVariant>& args) = 0;
+
+  // true if the argument at the given index is declared as a pointer
+  virtual bool isPointerArgument(int index) const = 0;
 };
 
 
@@ -56,8 +97,12 @@ struct FunctionPointerHolder : public FunctionPointerHolderBase
   void call(const QList<QVariant>& args)
   {
     Q_ASSERT(args.size() > 0);
-    Q_ASSERT(args.at(0).canConvert<A>());
-    Fp(args.at(0).value<A>());
+    Fp(ArgumentValue<A>::get(args.at(0)));
+  }
+
+  bool isPointerArgument(int index) const
+  {
+    return index == 0 && TypeTraits<A>::isPointer;
   }
 
   FunctionPointerType Fp;
@@ -78,9 +123,12 @@ struct FunctionPointerHolder2 : public FunctionPointerHolderBase
   void call(const QList<QVariant>& args)
   {
     Q_ASSERT(args.size() > 1);
-    Q_ASSERT(args.at(0).canConvert<A>());
-    Q_ASSERT(args.at(1).canConvert<B>());
-    Fp(args.at(0).value<A>(), args.at(1).value<B>());
+    Fp(ArgumentValue<A>::get(args.at(0)), ArgumentValue<B>::get(args.at(1)));
+  }
+
+  bool isPointerArgument(int index) const
+  {
+    return (index == 0 && TypeTraits<A>::isPointer) || (index == 1 && TypeTraits<B>::isPointer);
   }
 
   FunctionPointerType Fp;
@@ -104,6 +152,8 @@ struct CTK_CMDLINEMODULEBACKENDFP_EXPORT FunctionPointerProxy
 
   void call(const QList<QVariant>& args);
 
+  bool isPointerArgument(int index) const;
+
 private:
 
   friend class ::ctkCmdLineModuleBackendFunctionPointer;
@@ -23,6 +23,7 @@
 
 #include "ctkCmdLineModuleBackendFPUtil_p.h"
 #include "ctkCmdLineModuleBackendFPDescriptionPrivate.h"
+#include "ctkCmdLineModuleDataRegistry.h"
 #include "ctkCmdLineModuleFunctionPointerTask_p.h"
 
 #include "ctkCmdLineModuleFuture.h"
@@ -245,6 +246,20 @@ ctkCmdLineModuleFuture ctkCmdLineModuleBackendFunctionPointer::run(ctkCmdLineMod
   const Description& descr = d->UrlToFpDescription[url];
   QList<QVariant> args = this->arguments(frontend);
 
+  // Hand registered in-memory data to pointer parameters of the function instead
+  // of its reference string. The task keeps the data alive until the function
+  // has returned.
+  ctkCmdLineModuleDataRegistry* dataRegistry = ctkCmdLineModuleDataRegistry::instance();
+  for (int i = 0; i < args.size(); ++i)
+  {
+    if (args[i].type() != QVariant::String || !descr.d->FpProxy.isPointerArgument(i)) continue;
+    ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer holder = dataRegistry->holder(args[i].toString());
+    if (holder)
+    {
+      args[i] = QVariant::fromValue(holder);
+    }
+  }
+
   // Instances of ctkCmdLineModuleFunctionPointerTask are auto-deleted by the
   // thread pool
   ctkCmdLineModuleFunctionPointerTask* fpTask = new ctkCmdLineModuleFunctionPointerTask(descr, args);
@@ -0,0 +1,86 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkCmdLineModuleDataRegistry.h"
+
+#include <QMutexLocker>
+
+Q_GLOBAL_STATIC(ctkCmdLineModuleDataRegistry, globalDataRegistry)
+
+namespace ctk {
+namespace CmdLineModuleBackendFunctionPointer {
+
+//----------------------------------------------------------------------------
+DataHolderBase::~DataHolderBase()
+{
+}
+
+}
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleDataRegistry::ctkCmdLineModuleDataRegistry()
+  : LastId(0)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleDataRegistry* ctkCmdLineModuleDataRegistry::instance()
+{
+  return globalDataRegistry();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleDataRegistry::unregisterData(const QString& reference)
+{
+  ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer holder;
+  {
+    QMutexLocker lock(&this->Mutex);
+    holder = this->Data.take(reference);
+  }
+  // the data may be deleted here, outside of the lock
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleDataRegistry::contains(const QString& value) const
+{
+  if (!value.startsWith("data://")) return false;
+  QMutexLocker lock(&this->Mutex);
+  return this->Data.contains(value);
+}
+
+//----------------------------------------------------------------------------
+ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer
+ctkCmdLineModuleDataRegistry::holder(const QString& reference) const
+{
+  QMutexLocker lock(&this->Mutex);
+  return this->Data.value(reference);
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleDataRegistry::registerHolder(const ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer& holder)
+{
+  QMutexLocker lock(&this->Mutex);
+  QString reference = QString("data://%1").arg(++this->LastId);
+  this->Data.insert(reference, holder);
+  return reference;
+}
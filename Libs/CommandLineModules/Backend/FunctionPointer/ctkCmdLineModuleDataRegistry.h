@@ -0,0 +1,157 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKCMDLINEMODULEDATAREGISTRY_H
+#define CTKCMDLINEMODULEDATAREGISTRY_H
+
+#include "ctkCommandLineModulesBackendFunctionPointerExport.h"
+
+#include <QHash>
+#include <QMetaType>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+
+#include <typeinfo>
+
+namespace ctk {
+namespace CmdLineModuleBackendFunctionPointer {
+
+struct CTK_CMDLINEMODULEBACKENDFP_EXPORT DataHolderBase
+{
+  virtual ~DataHolderBase();
+
+  virtual const char* typeName() const = 0;
+
+  virtual void* data() const = 0;
+};
+
+template<typename T>
+struct DataHolder : public DataHolderBase
+{
+  DataHolder(const QSharedPointer<T>& data) : Data(data) {}
+
+  const char* typeName() const
+  {
+    return typeid(T).name();
+  }
+
+  void* data() const
+  {
+    return const_cast<void*>(static_cast<const void*>(Data.data()));
+  }
+
+  QSharedPointer<T> Data;
+};
+
+typedef QSharedPointer<DataHolderBase> DataHolderPointer;
+
+}
+}
+
+Q_DECLARE_METATYPE(ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer)
+
+/**
+ * \class ctkCmdLineModuleDataRegistry
+ * \brief Shares in-memory data with function pointer modules.
+ * \ingroup CommandLineModulesBackendFunctionPointer_API
+ *
+ * Registering data returns a reference string of the form <code>data://&lt;id&gt;</code>,
+ * which can be used as the value of any module parameter. When a function pointer
+ * module is run, ctkCmdLineModuleBackendFunctionPointer replaces reference strings by a
+ * pointer to the registered data if the function argument is a pointer to the registered
+ * type. The data is neither copied nor written to disk, so the output of one module can
+ * be handed to the next one by passing the same reference to both.
+ *
+ * Data is reference counted. The registry holds one reference until the data is
+ * unregistered and every module run holds one until it has finished.
+ *
+ * \code
+ * QString ref = ctkCmdLineModuleDataRegistry::instance()->registerData(QSharedPointer<MyImageData>(image));
+ * frontend->setValue("inputImage", ref);
+ * \endcode
+ */
+class CTK_CMDLINEMODULEBACKENDFP_EXPORT ctkCmdLineModuleDataRegistry
+{
+
+public:
+
+  ctkCmdLineModuleDataRegistry();
+
+  static ctkCmdLineModuleDataRegistry* instance();
+
+  /**
+   * @brief Register data for use by function pointer modules.
+   * @param data The data.
+   * @return The reference string for use as parameter value.
+   */
+  template<typename T>
+  QString registerData(const QSharedPointer<T>& data)
+  {
+    return this->registerHolder(ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer(
+                                  new ctk::CmdLineModuleBackendFunctionPointer::DataHolder<T>(data)));
+  }
+
+  /**
+   * @brief Get registered data.
+   * @param reference The reference string returned by registerData().
+   * @return The data, or a null pointer if the reference is unknown or the data
+   *         was registered with a different type.
+   */
+  template<typename T>
+  QSharedPointer<T> data(const QString& reference) const
+  {
+    ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer holder = this->holder(reference);
+    if (!holder || qstrcmp(holder->typeName(), typeid(T).name()) != 0) return QSharedPointer<T>();
+    return static_cast<ctk::CmdLineModuleBackendFunctionPointer::DataHolder<T>*>(holder.data())->Data;
+  }
+
+  /**
+   * @brief Release the reference of the registry to the data.
+   * @param reference The reference string returned by registerData().
+   */
+  void unregisterData(const QString& reference);
+
+  /**
+   * @brief Check if a value is the reference string of registered data.
+   * @param value A parameter value.
+   * @return \c true if the value references registered data.
+   */
+  bool contains(const QString& value) const;
+
+  /**
+   * @brief Get the type-erased holder of registered data.
+   * @param reference The reference string returned by registerData().
+   * @return The holder or a null pointer if the reference is unknown.
+   */
+  ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer holder(const QString& reference) const;
+
+private:
+
+  QString registerHolder(const ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer& holder);
+
+  mutable QMutex Mutex;
+  quint64 LastId;
+  QHash<QString, ctk::CmdLineModuleBackendFunctionPointer::DataHolderPointer> Data;
+};
+
+#endif // CTKCMDLINEMODULEDATAREGISTRY_H
@@ -59,6 +59,10 @@ void ctkCmdLineModuleFunctionPointerTask::run()
   {
     FpDescription.d->FpProxy.call(ParamValues);
   }
+  catch (const ctkCmdLineModuleRunException& e)
+  {
+    excMsg = e.errorString();
+  }
   catch (const std::exception& e)
   {
     excMsg = e.what();
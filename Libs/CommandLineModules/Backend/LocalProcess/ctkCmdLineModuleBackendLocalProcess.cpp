@@ -26,6 +26,7 @@
 #include "ctkCmdLineModuleFuture.h"
 #include "ctkCmdLineModuleParameter.h"
 #include "ctkCmdLineModuleParameterGroup.h"
+#include "ctkCmdLineModuleProcessSupervisor_p.h"
 #include "ctkCmdLineModuleProcessTask.h"
 #include "ctkCmdLineModuleReference.h"
 #include "ctkCmdLineModuleRunException.h"
@@ -33,9 +34,14 @@
 
 #include "ctkUtils.h"
 #include <iostream>
+#include <QMutex>
 #include <QProcess>
 #include <QUrl>
 
+#if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
+extern int qHash(const QUrl& url);
+#endif
+
 //----------------------------------------------------------------------------
 struct ctkCmdLineModuleBackendLocalProcessPrivate
 {
@@ -52,71 +58,130 @@ struct ctkCmdLineModuleBackendLocalProcessPrivate
     return flag.trimmed().remove(QRegExp("^-*"));
   }
 
-  QStringList commandLineArguments(const QHash<QString,QVariant>& currentValues,
-                                   const ctkCmdLineModuleDescription& description) const
+  // The command line arguments of the last value of each parameter. Runs
+  // which only change a few values, like the items of a batch, reuse the
+  // arguments of all other parameters.
+  struct ParameterArguments
   {
-    QStringList cmdLineArgs;
-    QHash<int, QString> indexedArgs;
+    ParameterArguments() : Index(-1), Multiple(false), HasValue(false) {}
 
-    QHashIterator<QString,QVariant> valuesIter(currentValues);
-    while(valuesIter.hasNext())
+    int Index;
+    QString Flag;
+    QString Tag;
+    bool Multiple;
+
+    bool HasValue;
+    QVariant Value;
+    QStringList Args;
+  };
+
+  struct ModuleArguments
+  {
+    QByteArray RawXml;
+    QHash<QString, ParameterArguments> Parameters;
+  };
+
+  QMutex m_ArgumentsMutex;
+  QHash<QUrl, ModuleArguments> m_Arguments;
+
+  void updateArguments(ParameterArguments& arguments, const QVariant& value) const
+  {
+    arguments.HasValue = true;
+    arguments.Value = value;
+    arguments.Args.clear();
+
+    if (arguments.Index > -1)
     {
-      valuesIter.next();
-      ctkCmdLineModuleParameter parameter = description.parameter(valuesIter.key());
-      if (parameter.index() > -1)
+      arguments.Args.push_back(value.toString());
+    }
+    else if (arguments.Tag == "boolean")
+    {
+      if (value.toBool())
       {
-        indexedArgs.insert(parameter.index(), valuesIter.value().toString());
+        arguments.Args << arguments.Flag;
+      }
+    }
+    else
+    {
+      QStringList args;
+      if (arguments.Multiple)
+      {
+        args = value.toString().split(',', QString::SkipEmptyParts);
       }
       else
       {
-        QString argFlag;
-        if (parameter.longFlag().isEmpty())
+        args.push_back(value.toString());
+      }
+
+      foreach(QString arg, args)
+      {
+        if (arguments.Tag == "string")
         {
-          argFlag = QString("-") + this->normalizeFlag(parameter.flag());
+          arguments.Args << arguments.Flag << arg;
         }
         else
         {
-          argFlag = QString("--") + this->normalizeFlag(parameter.longFlag());
+          QString trimmedArg = arg.trimmed();
+          if (trimmedArg.length() != 0) // If not string, and no arg, we don't output. We need this policy for integers, doubles, etc.
+          {
+            arguments.Args << arguments.Flag << trimmedArg;
+          }
         }
+      } // end foreach
+    }
+  }
 
-        if (parameter.tag() == "boolean")
+  QStringList commandLineArguments(const QHash<QString,QVariant>& currentValues,
+                                   const ctkCmdLineModuleReference& moduleRef)
+  {
+    QStringList cmdLineArgs;
+    QHash<int, QString> indexedArgs;
+
+    QMutexLocker lock(&m_ArgumentsMutex);
+    ModuleArguments& moduleArgs = m_Arguments[moduleRef.location()];
+    if (moduleArgs.RawXml != moduleRef.rawXmlDescription())
+    {
+      // The module was updated
+      moduleArgs.RawXml = moduleRef.rawXmlDescription();
+      moduleArgs.Parameters.clear();
+    }
+
+    QHashIterator<QString,QVariant> valuesIter(currentValues);
+    while(valuesIter.hasNext())
+    {
+      valuesIter.next();
+      QHash<QString, ParameterArguments>::iterator argsIter = moduleArgs.Parameters.find(valuesIter.key());
+      if (argsIter == moduleArgs.Parameters.end())
+      {
+        ctkCmdLineModuleParameter parameter = moduleRef.description().parameter(valuesIter.key());
+        ParameterArguments arguments;
+        arguments.Index = parameter.index();
+        if (parameter.longFlag().isEmpty())
         {
-          if (valuesIter.value().toBool())
-          {
-            cmdLineArgs << argFlag;
-          }
+          arguments.Flag = QString("-") + this->normalizeFlag(parameter.flag());
         }
         else
         {
-          QStringList args;
-          if (parameter.multiple())
-          {
-            args = valuesIter.value().toString().split(',', QString::SkipEmptyParts);
-          }
-          else
-          {
-            args.push_back(valuesIter.value().toString());
-          }
-
-          if (args.length() > 0)
-          {
-            foreach(QString arg, args)
-            {
-              if (parameter.tag() == "string")
-              {
-                cmdLineArgs << argFlag << arg;
-              }
-              else
-              {
-                QString trimmedArg = arg.trimmed();
-                if (trimmedArg.length() != 0) // If not string, and no arg, we don't output. We need this policy for integers, doubles, etc.
-                {
-                  cmdLineArgs << argFlag << trimmedArg;
-                }
-              }
-            } // end foreach
-          } // end if (args.length() > 0)
+          arguments.Flag = QString("--") + this->normalizeFlag(parameter.longFlag());
         }
+        arguments.Tag = parameter.tag();
+        arguments.Multiple = parameter.multiple();
+        argsIter = moduleArgs.Parameters.insert(valuesIter.key(), arguments);
+      }
+
+      ParameterArguments& arguments = argsIter.value();
+      if (!arguments.HasValue || arguments.Value != valuesIter.value())
+      {
+        this->updateArguments(arguments, valuesIter.value());
+      }
+
+      if (arguments.Index > -1)
+      {
+        indexedArgs.insert(arguments.Index, arguments.Args.front());
+      }
+      else
+      {
+        cmdLineArgs << arguments.Args;
       }
     }
 
@@ -199,15 +264,23 @@ QByteArray ctkCmdLineModuleBackendLocalProcess::rawXmlDescription(const QUrl &lo
 //----------------------------------------------------------------------------
 ctkCmdLineModuleFuture ctkCmdLineModuleBackendLocalProcess::run(ctkCmdLineModuleFrontend* frontend)
 {
-  QStringList args = d->commandLineArguments(frontend->values(), frontend->moduleReference().description());
+  ctkCmdLineModuleReference moduleRef = frontend->moduleReference();
+  QStringList args = d->commandLineArguments(frontend->values(), moduleRef);
 
   // Instances of ctkCmdLineModuleProcessTask are auto-deleted by the
-  // thread pool.
+  // process supervisor.
   ctkCmdLineModuleProcessTask* moduleProcess =
-      new ctkCmdLineModuleProcessTask(frontend->location().toLocalFile(), args);
+      new ctkCmdLineModuleProcessTask(frontend->location().toLocalFile(), args,
+                                      moduleRef.description().persistentWorker());
   return moduleProcess->start();
 }
 
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBackendLocalProcess::setMaxConcurrentRuns(int maxRuns)
+{
+  ctkCmdLineModuleProcessSupervisor::instance()->setMaxIdleWorkers(maxRuns);
+}
+
 //----------------------------------------------------------------------------
 void ctkCmdLineModuleBackendLocalProcess::setTimeOutForXMLRetrieval(int timeOut)
 {
@@ -48,6 +48,19 @@ struct ctkCmdLineModuleBackendLocalProcessPrivate;
  *
  * The ctkCmdLineModuleFuture returned by run() allows cancelation by killing the running
  * process. On Unix systems, it also allows to pause it.
+ *
+ * The processes of all running modules are supervised by the event loop of a single
+ * thread, so running modules do not occupy threads of the global QThreadPool.
+ *
+ * Modules which declare \code <persistent-worker>true</persistent-worker> \endcode in
+ * their XML description are started once with the \c &ndash;&ndash;worker argument and
+ * kept running between runs, saving the start-up time of the executable. For each run,
+ * the number of command line arguments followed by one percent-encoded argument per line
+ * is written to the standard input of the worker. The worker reports progress and results
+ * as usual and prints \code <worker-finished exit-code="0"/> \endcode at the end of the
+ * run. It must exit when its standard input is closed. The number of idle workers kept
+ * for reuse is limited to the number of concurrent runs allowed by the scheduler of the
+ * ctkCmdLineModuleManager. All other modules are started anew for each run.
  */
 class CTK_CMDLINEMODULEBACKENDLP_EXPORT ctkCmdLineModuleBackendLocalProcess : public ctkCmdLineModuleBackend
 {
@@ -90,6 +103,12 @@ public:
    */
   virtual ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend *frontend);
 
+  /**
+   * @brief Limits the number of idle persistent workers to the number of concurrent runs.
+   * @param maxRuns The maximum number of concurrent runs.
+   */
+  virtual void setMaxConcurrentRuns(int maxRuns);
+
   /**
    * @brief Setter for the number of milliseconds to wait when retrieving xml.
    * @param timeOut in milliseconds.
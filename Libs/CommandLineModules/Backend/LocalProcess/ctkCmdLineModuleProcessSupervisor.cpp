@@ -0,0 +1,351 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkCmdLineModuleProcessSupervisor_p.h"
+#include "ctkCmdLineModuleProcessTask.h"
+#include "ctkCmdLineModuleProcessWatcher_p.h"
+
+#include <QDebug>
+#include <QUrl>
+
+namespace {
+
+// Every running QProcess keeps a few pipe descriptors open in the supervisor
+// thread. Keep their number well below the FD_SETSIZE limit of the select()
+// based event dispatchers.
+const int MAX_RUNNING_PROCESSES = 128;
+
+// Idle workers are stopped after this many milliseconds
+const int WORKER_IDLE_TIMEOUT = 60000;
+
+// Workers which do not exit after their standard input was closed are killed
+const int WORKER_STOP_TIMEOUT = 5000;
+
+// The request for one run of a worker: the number of arguments, followed by one
+// percent-encoded argument per line.
+QByteArray workerRequest(const QStringList& args)
+{
+  QByteArray request = QByteArray::number(args.size()) + '\n';
+  foreach(const QString& arg, args)
+  {
+    request += QUrl::toPercentEncoding(arg) + '\n';
+  }
+  return request;
+}
+
+}
+
+Q_GLOBAL_STATIC(ctkCmdLineModuleProcessSupervisor, globalSupervisor)
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleProcessSupervisor* ctkCmdLineModuleProcessSupervisor::instance()
+{
+  return globalSupervisor();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleProcessSupervisor::ctkCmdLineModuleProcessSupervisor()
+  : launchScheduled(false)
+  , maxIdleWorkers(QThread::idealThreadCount())
+  , idleTimer(this)
+{
+  connect(&idleTimer, SIGNAL(timeout()), SLOT(expireIdleWorkers()));
+
+  this->moveToThread(&thread);
+  thread.start();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleProcessSupervisor::~ctkCmdLineModuleProcessSupervisor()
+{
+  thread.quit();
+  thread.wait();
+
+  // Cancel everything which is still pending or running, so that no one
+  // waits forever for these futures.
+  foreach(ctkCmdLineModuleProcessTask* task, pending)
+  {
+    task->reportCanceled();
+    task->reportFinished();
+    delete task;
+  }
+  pending.clear();
+
+  QHashIterator<QProcess*, RunningProcess> iter(running);
+  while (iter.hasNext())
+  {
+    iter.next();
+    iter.key()->disconnect(this);
+    iter.value().task->reportCanceled();
+    iter.value().task->reportFinished();
+    delete iter.value().watcher;
+    delete iter.key();
+    delete iter.value().task;
+  }
+  running.clear();
+
+  foreach(const IdleWorker& worker, idleWorkers)
+  {
+    worker.process->disconnect(this);
+    delete worker.process;
+  }
+  idleWorkers.clear();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::start(ctkCmdLineModuleProcessTask* task)
+{
+  QMutexLocker lock(&pendingMutex);
+  pending.enqueue(task);
+  if (!launchScheduled)
+  {
+    launchScheduled = true;
+    QMetaObject::invokeMethod(this, "launchPending", Qt::QueuedConnection);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::setMaxIdleWorkers(int maxWorkers)
+{
+  QMutexLocker lock(&pendingMutex);
+  maxIdleWorkers = qMax(0, maxWorkers);
+  QMetaObject::invokeMethod(this, "trimIdleWorkers", Qt::QueuedConnection);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::launchPending()
+{
+  while (running.size() < MAX_RUNNING_PROCESSES)
+  {
+    ctkCmdLineModuleProcessTask* task = NULL;
+    {
+      QMutexLocker lock(&pendingMutex);
+      if (pending.isEmpty())
+      {
+        launchScheduled = false;
+        return;
+      }
+      task = pending.dequeue();
+    }
+
+    if (task->isCanceled())
+    {
+      task->reportFinished();
+      delete task;
+      continue;
+    }
+
+    QProcess* process = NULL;
+    if (task->isPersistentWorker())
+    {
+      process = this->takeIdleWorker(task->location());
+    }
+    if (process == NULL)
+    {
+      process = this->startProcess(task);
+    }
+
+    RunningProcess runningProcess;
+    runningProcess.task = task;
+    runningProcess.watcher = new ctkCmdLineModuleProcessWatcher(*process, task->location(), *task);
+    running.insert(process, runningProcess);
+
+    if (task->isPersistentWorker())
+    {
+      connect(runningProcess.watcher, SIGNAL(workerFinished(int)), SLOT(workerFinished(int)));
+      // written as soon as the process is started
+      process->write(workerRequest(task->arguments()));
+    }
+  }
+
+  // More tasks are pending, they are launched when running processes finish.
+  QMutexLocker lock(&pendingMutex);
+  launchScheduled = !pending.isEmpty();
+}
+
+//----------------------------------------------------------------------------
+QProcess* ctkCmdLineModuleProcessSupervisor::startProcess(ctkCmdLineModuleProcessTask* task)
+{
+  // Make room for the new process by stopping the least recently used idle worker
+  if (!idleWorkers.isEmpty() && running.size() + idleWorkers.size() >= MAX_RUNNING_PROCESSES)
+  {
+    this->stopWorker(idleWorkers.takeFirst().process);
+  }
+
+  QProcess* process = new QProcess(this);
+  process->setReadChannel(QProcess::StandardOutput);
+  connect(process, SIGNAL(finished(int)), SLOT(processFinished()));
+  connect(process, SIGNAL(error(QProcess::ProcessError)), SLOT(processError(QProcess::ProcessError)));
+
+  if (task->isPersistentWorker())
+  {
+    qDebug() << "ctkCmdLineModuleProcessSupervisor::launchPending() starting worker location=" << task->location();
+    process->start(task->location(), QStringList("--worker"), QIODevice::ReadWrite | QIODevice::Text);
+  }
+  else
+  {
+    qDebug() << "ctkCmdLineModuleProcessSupervisor::launchPending() starting location=" << task->location() << ", args=" << task->arguments();
+    process->start(task->location(), task->arguments(), QIODevice::ReadOnly | QIODevice::Text);
+  }
+  return process;
+}
+
+//----------------------------------------------------------------------------
+QProcess* ctkCmdLineModuleProcessSupervisor::takeIdleWorker(const QString& location)
+{
+  // prefer the most recently used worker, which is least likely to be swapped out
+  for (int i = idleWorkers.size() - 1; i >= 0; --i)
+  {
+    if (idleWorkers[i].location == location)
+    {
+      QProcess* process = idleWorkers.takeAt(i).process;
+      // discard anything printed after the end of the previous run
+      process->readAllStandardOutput();
+      process->readAllStandardError();
+      return process;
+    }
+  }
+  return NULL;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::stopWorker(QProcess* process)
+{
+  process->disconnect(this);
+  connect(process, SIGNAL(finished(int)), process, SLOT(deleteLater()));
+  QTimer::singleShot(WORKER_STOP_TIMEOUT, process, SLOT(kill()));
+  process->closeWriteChannel();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::processFinished()
+{
+  this->finish(qobject_cast<QProcess*>(this->sender()));
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::processError(QProcess::ProcessError error)
+{
+  // All other errors are followed by the finished() signal or
+  // do not terminate the process.
+  if (error == QProcess::FailedToStart)
+  {
+    this->finish(qobject_cast<QProcess*>(this->sender()));
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::workerFinished(int exitCode)
+{
+  QProcess* process = NULL;
+  QHashIterator<QProcess*, RunningProcess> iter(running);
+  while (iter.hasNext())
+  {
+    iter.next();
+    if (iter.value().watcher == this->sender())
+    {
+      process = iter.key();
+      break;
+    }
+  }
+  if (process == NULL) return;
+
+  RunningProcess runningProcess = running.take(process);
+
+  // The watcher is still emitting the signal which brought us here.
+  runningProcess.watcher->detach();
+  runningProcess.watcher->deleteLater();
+
+  IdleWorker worker;
+  worker.process = process;
+  worker.location = runningProcess.task->location();
+  worker.idleTime.start();
+
+  runningProcess.task->workerFinished(exitCode);
+  delete runningProcess.task;
+
+  idleWorkers.push_back(worker);
+  if (!idleTimer.isActive())
+  {
+    idleTimer.start(WORKER_IDLE_TIMEOUT / 4);
+  }
+  this->trimIdleWorkers();
+
+  this->launchPending();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::trimIdleWorkers()
+{
+  int maxWorkers = 0;
+  {
+    QMutexLocker lock(&pendingMutex);
+    maxWorkers = maxIdleWorkers;
+  }
+  while (idleWorkers.size() > maxWorkers)
+  {
+    this->stopWorker(idleWorkers.takeFirst().process);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::expireIdleWorkers()
+{
+  while (!idleWorkers.isEmpty() && idleWorkers.front().idleTime.elapsed() >= WORKER_IDLE_TIMEOUT)
+  {
+    this->stopWorker(idleWorkers.takeFirst().process);
+  }
+  if (idleWorkers.isEmpty())
+  {
+    idleTimer.stop();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessSupervisor::finish(QProcess* process)
+{
+  if (!running.contains(process))
+  {
+    // An idle worker exited on its own
+    for (int i = 0; i < idleWorkers.size(); ++i)
+    {
+      if (idleWorkers[i].process == process)
+      {
+        idleWorkers.removeAt(i);
+        process->disconnect(this);
+        process->deleteLater();
+        break;
+      }
+    }
+    return;
+  }
+
+  RunningProcess runningProcess = running.take(process);
+  runningProcess.task->processFinished(*process);
+
+  // The process is still emitting the signal which brought us here.
+  delete runningProcess.watcher;
+  process->disconnect(this);
+  process->deleteLater();
+  delete runningProcess.task;
+
+  this->launchPending();
+}
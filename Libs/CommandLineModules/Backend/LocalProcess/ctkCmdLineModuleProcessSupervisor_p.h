@@ -0,0 +1,128 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULEPROCESSSUPERVISOR_P_H
+#define CTKCMDLINEMODULEPROCESSSUPERVISOR_P_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QProcess>
+#include <QQueue>
+#include <QThread>
+#include <QTime>
+#include <QTimer>
+
+class ctkCmdLineModuleProcessTask;
+class ctkCmdLineModuleProcessWatcher;
+
+/**
+ * \class ctkCmdLineModuleProcessSupervisor
+ * \brief Runs the processes of all ctkCmdLineModuleProcessTask instances
+ * from the event loop of a single thread.
+ * \ingroup CommandLineModulesBackendLocalProcess_API
+ *
+ * The QProcess objects and their progress watchers live in the supervisor
+ * thread and are driven by its event loop, so the number of concurrently
+ * running modules does not depend on the number of available threads.
+ * Tasks exceeding the maximum number of running processes are queued
+ * and started in order as soon as a running process finishes.
+ *
+ * Modules supporting the persistent worker protocol are started once with
+ * the "--worker" argument. Each task writes its arguments to the standard
+ * input of the worker, and the worker reports the end of the run with a
+ * "worker-finished" element. Afterwards the worker is kept in a pool of idle
+ * workers and reused by the next task of the same module. Workers which are
+ * idle for too long or exceed the pool size are asked to exit by closing
+ * their standard input.
+ */
+class ctkCmdLineModuleProcessSupervisor : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  static ctkCmdLineModuleProcessSupervisor* instance();
+
+  ctkCmdLineModuleProcessSupervisor();
+  ~ctkCmdLineModuleProcessSupervisor();
+
+  /**
+   * Queues the task for execution. The supervisor takes ownership of
+   * the task and deletes it after reporting it as finished.
+   * This method is thread-safe.
+   */
+  void start(ctkCmdLineModuleProcessTask* task);
+
+  /**
+   * Sets the maximum number of idle workers kept for reuse, summed
+   * over all modules. This method is thread-safe.
+   */
+  void setMaxIdleWorkers(int maxWorkers);
+
+private Q_SLOTS:
+
+  void launchPending();
+
+  void processFinished();
+  void processError(QProcess::ProcessError error);
+  void workerFinished(int exitCode);
+
+  void trimIdleWorkers();
+  void expireIdleWorkers();
+
+private:
+
+  struct RunningProcess
+  {
+    ctkCmdLineModuleProcessTask* task;
+    ctkCmdLineModuleProcessWatcher* watcher;
+  };
+
+  struct IdleWorker
+  {
+    QProcess* process;
+    QString location;
+    QTime idleTime;
+  };
+
+  void finish(QProcess* process);
+
+  QProcess* startProcess(ctkCmdLineModuleProcessTask* task);
+  QProcess* takeIdleWorker(const QString& location);
+  void stopWorker(QProcess* process);
+
+  QThread thread;
+
+  QMutex pendingMutex;
+  QQueue<ctkCmdLineModuleProcessTask*> pending;
+  bool launchScheduled;
+  int maxIdleWorkers;
+
+  // only accessed from the supervisor thread
+  QHash<QProcess*, RunningProcess> running;
+  // least recently used first
+  QList<IdleWorker> idleWorkers;
+  QTimer idleTimer;
+};
+
+#endif // CTKCMDLINEMODULEPROCESSSUPERVISOR_P_H
@@ -20,31 +20,31 @@
 =============================================================================*/
 
 #include "ctkCmdLineModuleProcessTask.h"
-#include "ctkCmdLineModuleProcessWatcher_p.h"
+#include "ctkCmdLineModuleProcessSupervisor_p.h"
 #include "ctkCmdLineModuleRunException.h"
-#include "ctkCmdLineModuleXmlProgressWatcher.h"
 #include "ctkCmdLineModuleFuture.h"
 
-#include <QDebug>
-#include <QEventLoop>
-#include <QThreadPool>
 #include <QProcess>
 
 //----------------------------------------------------------------------------
 struct ctkCmdLineModuleProcessTaskPrivate
 {
-  ctkCmdLineModuleProcessTaskPrivate(const QString& location, const QStringList& args)
+  ctkCmdLineModuleProcessTaskPrivate(const QString& location, const QStringList& args,
+                                     bool persistentWorker)
     : Location(location)
     , Args(args)
+    , PersistentWorker(persistentWorker)
   {}
 
   const QString Location;
   const QStringList Args;
+  const bool PersistentWorker;
 };
 
 //----------------------------------------------------------------------------
-ctkCmdLineModuleProcessTask::ctkCmdLineModuleProcessTask(const QString& location, const QStringList& args)
-  : d(new ctkCmdLineModuleProcessTaskPrivate(location, args))
+ctkCmdLineModuleProcessTask::ctkCmdLineModuleProcessTask(const QString& location, const QStringList& args,
+                                                         bool persistentWorker)
+  : d(new ctkCmdLineModuleProcessTaskPrivate(location, args, persistentWorker))
 {
   this->setCanCancel(true);
 #ifdef Q_OS_UNIX
@@ -60,43 +60,61 @@ ctkCmdLineModuleProcessTask::~ctkCmdLineModuleProcessTask()
 //----------------------------------------------------------------------------
 ctkCmdLineModuleFuture ctkCmdLineModuleProcessTask::start()
 {
-  this->setRunnable(this);
   this->reportStarted();
   ctkCmdLineModuleFuture future = this->future();
-  QThreadPool::globalInstance()->start(this, /*m_priority*/ 0);
+  ctkCmdLineModuleProcessSupervisor::instance()->start(this);
   return future;
 }
 
 //----------------------------------------------------------------------------
-void ctkCmdLineModuleProcessTask::run()
+QString ctkCmdLineModuleProcessTask::location() const
 {
-  if (this->isCanceled())
-  {
-    this->reportFinished();
-    return;
-  }
-
-  QProcess process;
-  process.setReadChannel(QProcess::StandardOutput);
-
-  QEventLoop localLoop;
-  QObject::connect(&process, SIGNAL(finished(int)), &localLoop, SLOT(quit()));
-  QObject::connect(&process, SIGNAL(error(QProcess::ProcessError)), &localLoop, SLOT(quit()));
-
-  qDebug() << "ctkCmdLineModuleProcessTask::run() starting d->Location=" << d->Location << ", d->Args=" << d->Args;
-
-  process.start(d->Location, d->Args, QIODevice::ReadOnly | QIODevice::Text);
+  return d->Location;
+}
 
-  ctkCmdLineModuleProcessWatcher progressWatcher(process, d->Location, *this);
-  Q_UNUSED(progressWatcher)
+//----------------------------------------------------------------------------
+QStringList ctkCmdLineModuleProcessTask::arguments() const
+{
+  return d->Args;
+}
 
-  localLoop.exec();
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleProcessTask::isPersistentWorker() const
+{
+  return d->PersistentWorker;
+}
 
-  if (process.error() != QProcess::UnknownError || process.exitCode() != 0)
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessTask::processFinished(QProcess& process)
+{
+  if (d->PersistentWorker && process.error() == QProcess::UnknownError)
+  {
+    // A worker process only exits between runs, when asked to
+    this->reportException(ctkCmdLineModuleRunException(d->Location, process.exitCode(),
+                                                       QObject::tr("The module worker exited during the run.")));
+  }
+  else if (process.error() != QProcess::UnknownError || process.exitCode() != 0)
   {
     this->reportException(ctkCmdLineModuleRunException(d->Location, process.exitCode(), process.errorString()));
   }
+  this->reportProcessFinished();
+}
 
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessTask::workerFinished(int exitCode)
+{
+  if (exitCode != 0)
+  {
+    this->reportException(ctkCmdLineModuleRunException(d->Location, exitCode,
+                                                       QObject::tr("The module run failed.")));
+  }
+  this->reportProcessFinished();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessTask::reportProcessFinished()
+{
+  this->flushProgress();
   if (this->progressValue() == 1001)
   {
     // We got a "filter-end" progress report, potentially with a comment,
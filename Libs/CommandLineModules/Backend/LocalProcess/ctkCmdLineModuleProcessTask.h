@@ -26,12 +26,7 @@
 
 #include "ctkCommandLineModulesBackendLocalProcessExport.h"
 
-#include <QObject>
-#include <QRunnable>
 #include <QStringList>
-#include <QBuffer>
-#include <QFutureWatcher>
-#include <QTimer>
 
 class QProcess;
 
@@ -42,22 +37,39 @@ struct ctkCmdLineModuleProcessTaskPrivate;
  * \brief Implements ctkCmdLineModuleFutureInterface to enabling
  * running a command line application asynchronously.
  * \ingroup CommandLineModulesBackendLocalProcess_API
+ *
+ * The process is run by a supervisor thread shared by all tasks, which
+ * deletes the task after the process finished.
+ *
+ * Tasks of modules supporting the persistent worker protocol are run by a
+ * pre-started worker process of the module, if one is idle, instead of a new
+ * process.
  */
 class CTK_CMDLINEMODULEBACKENDLP_EXPORT ctkCmdLineModuleProcessTask
-    : public ctkCmdLineModuleFutureInterface, public QRunnable
+    : public ctkCmdLineModuleFutureInterface
 {
 
 public:
 
-  ctkCmdLineModuleProcessTask(const QString& location, const QStringList& args);
+  ctkCmdLineModuleProcessTask(const QString& location, const QStringList& args,
+                              bool persistentWorker = false);
   ~ctkCmdLineModuleProcessTask();
 
   ctkCmdLineModuleFuture start();
 
-  void run();
-
 private:
 
+  friend class ctkCmdLineModuleProcessSupervisor;
+
+  QString location() const;
+  QStringList arguments() const;
+  bool isPersistentWorker() const;
+
+  void processFinished(QProcess& process);
+  void workerFinished(int exitCode);
+
+  void reportProcessFinished();
+
   QScopedPointer<ctkCmdLineModuleProcessTaskPrivate> d;
 
 };
@@ -49,6 +49,7 @@ ctkCmdLineModuleProcessWatcher::ctkCmdLineModuleProcessWatcher(QProcess& process
 
   connect(&processXmlWatcher, SIGNAL(outputDataAvailable(QByteArray)), SLOT(outputDataAvailable(QByteArray)));
   connect(&processXmlWatcher, SIGNAL(errorDataAvailable(QByteArray)), SLOT(errorDataAvailable(QByteArray)));
+  connect(&processXmlWatcher, SIGNAL(workerFinished(int)), SIGNAL(workerFinished(int)));
 
   connect(&futureWatcher, SIGNAL(canceled()), SLOT(cancelProcess()));
 #ifdef Q_OS_UNIX
@@ -63,6 +64,15 @@ ctkCmdLineModuleProcessWatcher::ctkCmdLineModuleProcessWatcher(QProcess& process
   futureWatcher.setFuture(futureInterface.future());
 }
 
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessWatcher::detach()
+{
+  process.disconnect(&processXmlWatcher);
+  processXmlWatcher.disconnect(this);
+  futureWatcher.disconnect(this);
+  pollPauseTimer.stop();
+}
+
 //----------------------------------------------------------------------------
 void ctkCmdLineModuleProcessWatcher::filterStarted(const QString& name, const QString& comment)
 {
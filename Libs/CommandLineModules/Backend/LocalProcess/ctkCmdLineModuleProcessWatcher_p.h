@@ -47,6 +47,16 @@ public:
   ctkCmdLineModuleProcessWatcher(QProcess& process, const QString& location,
                                  ctkCmdLineModuleFutureInterface& futureInterface);
 
+  /**
+   * Stops watching the process, which is reused by the next run
+   * of a persistent worker.
+   */
+  void detach();
+
+Q_SIGNALS:
+
+  void workerFinished(int exitCode);
+
 protected Q_SLOTS:
 
   void filterStarted(const QString& name, const QString& comment);
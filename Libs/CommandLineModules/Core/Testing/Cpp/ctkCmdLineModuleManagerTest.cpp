@@ -35,6 +35,10 @@
 #include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTime>
 
 #if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
 extern int qHash(const QUrl& url);
@@ -122,6 +126,10 @@ private Q_SLOTS:
   void testSkipValidation();
   void testTimeoutHandling();
   void testCaching();
+  void testCacheTornRecord();
+  void testCacheRemovalAndCompaction();
+  void testCacheLegacyFiles();
+  void testDiscovery();
 
 private:
 
@@ -396,6 +404,189 @@ void ctkCmdLineModuleManagerTester::testCaching()
   }
 }
 
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testCacheTornRecord()
+{
+  QUrl location("test://validXml");
+  const QString cacheFileName = cachePath + "/ctkCmdLineModuleCache.dat";
+
+  {
+    BackendMockUp backend;
+    backend.addModule(location, validXml);
+    backend.setTimestamp(location, 1);
+
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, cachePath);
+    manager.registerBackend(&backend);
+    QVERIFY(manager.registerModule(location));
+  }
+
+  // simulate an append which was interrupted after the record size
+  const qint64 validSize = QFileInfo(cacheFileName).size();
+  {
+    QFile cacheFile(cacheFileName);
+    QVERIFY(cacheFile.open(QIODevice::WriteOnly | QIODevice::Append));
+    QDataStream out(&cacheFile);
+    out << quint32(1000);
+    out.writeRawData("torn", 4);
+  }
+  QVERIFY(QFileInfo(cacheFileName).size() > validSize);
+
+  {
+    BackendMockUp backend;
+    backend.addModule(location, validXml);
+    backend.setTimestamp(location, 1);
+
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, cachePath);
+    manager.registerBackend(&backend);
+
+    // the complete records are still used, the torn one is dropped
+    ctkCmdLineModuleReference ref = manager.registerModule(location);
+    QVERIFY(ref);
+    QCOMPARE(ref.rawXmlDescription(), validXml);
+    QCOMPARE(backend.xmlRetrievalCount(location), 0);
+    QCOMPARE(QFileInfo(cacheFileName).size(), validSize);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testCacheRemovalAndCompaction()
+{
+  QUrl location("test://validXml");
+  const QString cacheFileName = cachePath + "/ctkCmdLineModuleCache.dat";
+  const int moduleCount = 500;
+
+  {
+    BackendMockUp backend;
+    backend.addModule(location, validXml);
+    backend.setTimestamp(location, 1);
+    for (int i = 0; i < moduleCount; ++i)
+    {
+      QUrl removedLocation(QString("test://removed%1").arg(i));
+      backend.addModule(removedLocation, validXml);
+      backend.setTimestamp(removedLocation, 1);
+    }
+
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::SKIP_VALIDATION, cachePath);
+    manager.registerBackend(&backend);
+    QVERIFY(manager.registerModule(location));
+
+    // unregistering a module appends a removal record
+    for (int i = 0; i < moduleCount; ++i)
+    {
+      manager.unregisterModule(manager.registerModule(QUrl(QString("test://removed%1").arg(i))));
+    }
+  }
+  const qint64 uncompactedSize = QFileInfo(cacheFileName).size();
+
+  {
+    BackendMockUp backend;
+    backend.addModule(location, validXml);
+    backend.setTimestamp(location, 1);
+    QUrl removedLocation("test://removed0");
+    backend.addModule(removedLocation, validXml);
+    backend.setTimestamp(removedLocation, 1);
+
+    // the outdated records are dropped when loading the cache
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::SKIP_VALIDATION, cachePath);
+    manager.registerBackend(&backend);
+    QVERIFY(QFileInfo(cacheFileName).size() < uncompactedSize / 10);
+
+    QVERIFY(manager.registerModule(location));
+    QCOMPARE(backend.xmlRetrievalCount(location), 0);
+
+    // removed entries stay removed
+    QVERIFY(manager.registerModule(removedLocation));
+    QCOMPARE(backend.xmlRetrievalCount(removedLocation), 1);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testCacheLegacyFiles()
+{
+  QUrl location("test://validXml");
+
+  // the cache used to keep one .timestamp and one .xml file per module
+  QVERIFY(QDir().mkpath(cachePath));
+  const QString legacyBaseName = cachePath + "/legacyModule";
+  QFile legacyTimestamp(legacyBaseName + ".timestamp");
+  QVERIFY(legacyTimestamp.open(QIODevice::WriteOnly));
+  legacyTimestamp.write("1");
+  legacyTimestamp.close();
+  QFile legacyXml(legacyBaseName + ".xml");
+  QVERIFY(legacyXml.open(QIODevice::WriteOnly));
+  legacyXml.write(validXml);
+  legacyXml.close();
+
+  BackendMockUp backend;
+  backend.addModule(location, validXml);
+  backend.setTimestamp(location, 1);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, cachePath);
+  manager.registerBackend(&backend);
+
+  // the legacy files are removed and the module is cached again
+  QVERIFY(!QFile::exists(legacyTimestamp.fileName()));
+  QVERIFY(!QFile::exists(legacyXml.fileName()));
+  QVERIFY(manager.registerModule(location));
+  QCOMPARE(backend.xmlRetrievalCount(location), 1);
+  QVERIFY(QFile::exists(cachePath + "/ctkCmdLineModuleCache.dat"));
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testDiscovery()
+{
+  const int moduleCount = 200;
+
+  BackendMockUp backend;
+  QList<QUrl> locations;
+  for (int i = 0; i < moduleCount; ++i)
+  {
+    QUrl location(QString("test://module%1").arg(i));
+    backend.addModule(location, i % 10 ? validXml : invalidXml);
+    backend.setTimestamp(location, 1);
+    locations << location;
+  }
+
+  // cold discovery fetches and validates all XML descriptions
+  {
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::WEAK_VALIDATION, cachePath);
+    manager.registerBackend(&backend);
+
+    QTime time;
+    time.start();
+    QList<ctkCmdLineModuleReferenceResult> results = manager.registerModules(locations);
+    qDebug() << "Cold discovery of" << moduleCount << "modules took" << time.elapsed() << "ms";
+
+    QCOMPARE(results.size(), moduleCount);
+    for (int i = 0; i < moduleCount; ++i)
+    {
+      QCOMPARE(results[i].m_Url, locations[i]);
+      QVERIFY(results[i].m_Reference);
+      QCOMPARE(results[i].m_Reference.xmlValidationErrorString().isEmpty(), i % 10 != 0);
+      QCOMPARE(backend.xmlRetrievalCount(locations[i]), 1);
+    }
+  }
+
+  // warm discovery uses the cached XML descriptions and validation results
+  {
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::WEAK_VALIDATION, cachePath);
+    manager.registerBackend(&backend);
+
+    QTime time;
+    time.start();
+    QList<ctkCmdLineModuleReferenceResult> results = manager.registerModules(locations);
+    qDebug() << "Warm discovery of" << moduleCount << "modules took" << time.elapsed() << "ms";
+
+    QCOMPARE(results.size(), moduleCount);
+    for (int i = 0; i < moduleCount; ++i)
+    {
+      QVERIFY(results[i].m_Reference);
+      QCOMPARE(results[i].m_Reference.xmlValidationErrorString().isEmpty(), i % 10 != 0);
+      QCOMPARE(backend.xmlRetrievalCount(locations[i]), 1);
+    }
+  }
+}
+
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(ctkCmdLineModuleManagerTest)
 #include "moc_ctkCmdLineModuleManagerTest.cpp"
@@ -29,6 +29,7 @@
 #include <QCoreApplication>
 #include <QBuffer>
 #include <QDataStream>
+#include <QSignalSpy>
 #include <QDebug>
 
 
@@ -95,6 +96,8 @@ private Q_SLOTS:
 
   void testSignalsAndValues();
   void testMalformedXml();
+  void testSplitChunks();
+  void testWorkerFinished();
 };
 
 //-----------------------------------------------------------------------------
@@ -193,6 +196,85 @@ void ctkCmdLineModuleXmlProgressWatcherTester::testMalformedXml()
 }
 
 
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcherTester::testSplitChunks()
+{
+  // Test data
+  QByteArray filterOutput = "Starting\n"
+                            "<filter-start>\n"
+                              "<filter-name>My Filter</filter-name>\n"
+                              "<filter-comment>Awesome filter</filter-comment>\n"
+                            "</filter-start>\n"
+                            "a < b\n"
+                            "<filter-progress>0.25</filter-progress>\n"
+                            "<filter-progress>0.5</filter-progress>\n"
+                            "<filter-end>\n"
+                              "<filter-name>My Filter</filter-name>\n"
+                              "<filter-time>23</filter-time>\n"
+                            "</filter-end>\n"
+                            "Done";
+
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  ctkCmdLineModuleXmlProgressWatcher progressWatcher(&buffer);
+
+  SignalTester signalTester;
+  signalTester.connect(&progressWatcher, SIGNAL(filterStarted(QString,QString)), &signalTester, SLOT(filterStarted(QString,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterProgress(float,QString)), &signalTester, SLOT(filterProgress(float,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterFinished(QString,QString)), &signalTester, SLOT(filterFinished(QString,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterXmlError(QString)), &signalTester, SLOT(filterXmlError(QString)));
+
+  QSignalSpy outputSpy(&progressWatcher, SIGNAL(outputDataAvailable(QByteArray)));
+
+  // deliver the output in small chunks, splitting tags and elements
+  for (int i = 0; i < filterOutput.size(); i += 3)
+  {
+    buffer.write(filterOutput.mid(i, 3));
+    QCoreApplication::processEvents();
+  }
+
+  QList<QString> expectedSignals;
+  expectedSignals << "filter.started";
+  expectedSignals << "filter.progress";
+  expectedSignals << "filter.progress";
+  expectedSignals << "filter.finished";
+
+  if (!signalTester.error.isEmpty())
+  {
+    qDebug() << signalTester.error;
+    QFAIL("XML parsing error");
+  }
+
+  QVERIFY(signalTester.checkSignals(expectedSignals));
+
+  QCOMPARE(signalTester.accumulatedProgress, 0.75f);
+  QByteArray output;
+  for (int i = 0; i < outputSpy.count(); ++i)
+  {
+    output.append(outputSpy.at(i).front().toByteArray());
+  }
+  QCOMPARE(output, QByteArray("Starting\na < b\nDone"));
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcherTester::testWorkerFinished()
+{
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  ctkCmdLineModuleXmlProgressWatcher progressWatcher(&buffer);
+
+  QSignalSpy finishedSpy(&progressWatcher, SIGNAL(workerFinished(int)));
+  QSignalSpy errorSpy(&progressWatcher, SIGNAL(filterXmlError(QString)));
+
+  buffer.write("<filter-progress>0.5</filter-progress>\n"
+               "<worker-finished exit-code=\"3\"/>\n");
+  QCoreApplication::processEvents();
+
+  QCOMPARE(errorSpy.count(), 0);
+  QCOMPARE(finishedSpy.count(), 1);
+  QCOMPARE(finishedSpy.at(0).front().toInt(), 3);
+}
+
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(ctkCmdLineModuleXmlProgressWatcherTest)
 #include "moc_ctkCmdLineModuleXmlProgressWatcherTest.cpp"
@@ -39,3 +39,8 @@ int ctkCmdLineModuleBackend::timeOutForXmlRetrieval() const
 {
   return 0;
 }
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBackend::setMaxConcurrentRuns(int /*maxRuns*/)
+{
+}
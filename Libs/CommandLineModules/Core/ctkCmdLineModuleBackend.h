@@ -126,6 +126,7 @@ struct CTK_CMDLINEMODULECORE_EXPORT ctkCmdLineModuleBackend
 protected:
 
   friend class ctkCmdLineModuleManager;
+  friend class ctkCmdLineModuleScheduler;
 
   /**
    * @brief The main method to actually execute the back-end process.
@@ -137,6 +138,18 @@ protected:
    */
   virtual ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend) = 0;
 
+  /**
+   * @brief Called by the scheduler of the ctkCmdLineModuleManager with the number of
+   * runs of this back-end which it may start concurrently.
+   * @param maxRuns The maximum number of concurrent runs.
+   *
+   * The value changes with the budget of the manager and the concurrency limit of
+   * this back-end. Back-ends which keep resources for running modules, like a pool of
+   * pre-started processes, can use it to size them. The default implementation does
+   * nothing.
+   */
+  virtual void setMaxConcurrentRuns(int maxRuns);
+
 };
 
 #endif // CTKCMDLINEMODULEBACKEND_H
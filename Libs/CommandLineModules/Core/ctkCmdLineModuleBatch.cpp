@@ -0,0 +1,201 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkCmdLineModuleBatch_p.h"
+
+#include "ctkCmdLineModuleFrontendSnapshot_p.h"
+#include "ctkCmdLineModuleRunException.h"
+#include "ctkCmdLineModuleScheduler_p.h"
+
+#include <ctkException.h>
+
+namespace {
+
+// Output parameter names are identifiers, so this key cannot clash with them
+const char* const ErrorKey = "#error";
+
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleBatch::ctkCmdLineModuleBatch(ctkCmdLineModuleScheduler* scheduler,
+                                             ctkCmdLineModuleBackend* backend,
+                                             ctkCmdLineModuleFrontend* frontend,
+                                             const QList<QHash<QString,QVariant> >& overrides,
+                                             const ctkCmdLineModuleJobOptions& options, int window)
+  : Scheduler(scheduler)
+  , Backend(backend)
+  , ModuleRef(frontend->moduleReference())
+  , TemplateValues(frontend->values())
+  , Overrides(overrides)
+  , Options(options)
+  , Window(qMax(1, window))
+  , Next(0)
+  , FinishedItems(0)
+  , AggregateWatcher(this)
+{
+  Aggregate.setCanCancel(true);
+  Aggregate.setCanPause(true);
+  Aggregate.setProgressRange(0, Overrides.size());
+  Aggregate.reportStarted();
+
+  connect(&AggregateWatcher, SIGNAL(canceled()), SLOT(canceled()));
+  connect(&AggregateWatcher, SIGNAL(resumed()), SLOT(submit()));
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleBatch::~ctkCmdLineModuleBatch()
+{
+  if (!Aggregate.isFinished())
+  {
+    foreach(const Item& item, Running)
+    {
+      item.Future.cancel();
+    }
+    qDeleteAll(Running.keys());
+    Aggregate.reportCanceled();
+    Aggregate.reportFinished();
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleBatch::future()
+{
+  return Aggregate.future();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBatch::start()
+{
+  // Batches left over when the scheduler is destroyed are deleted with it
+  this->setParent(Scheduler);
+  AggregateWatcher.setFuture(Aggregate.future());
+  this->submit();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBatch::submit()
+{
+  // The pause state is checked here instead of relying on the "paused"
+  // signal, which is not emitted due to Qt bug 12152.
+  while (!Aggregate.isCanceled() && !Aggregate.isPaused() &&
+         Running.size() < Window && Next < Overrides.size())
+  {
+    const int index = Next++;
+
+    QHash<QString,QVariant> values = TemplateValues;
+    QHashIterator<QString,QVariant> overridesIter(Overrides[index]);
+    while (overridesIter.hasNext())
+    {
+      overridesIter.next();
+      values.insert(overridesIter.key(), overridesIter.value());
+    }
+
+    // The scheduler and the back-ends consume the values before returning
+    ctkCmdLineModuleFrontendSnapshot frontend(ModuleRef, values);
+    ctkCmdLineModuleFuture future;
+    try
+    {
+      future = Scheduler->run(Backend, &frontend, Options);
+    }
+    catch (const ctkException& e)
+    {
+      QVariantHash outputs;
+      outputs.insert(ErrorKey, e.message());
+      this->reportItem(index, outputs);
+      continue;
+    }
+
+    QFutureWatcher<ctkCmdLineModuleResult>* watcher = new QFutureWatcher<ctkCmdLineModuleResult>(this);
+    Item item;
+    item.Index = index;
+    item.Future = future;
+    Running.insert(watcher, item);
+    connect(watcher, SIGNAL(finished()), SLOT(itemFinished()));
+    watcher->setFuture(future);
+  }
+
+  this->finishIfDone();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBatch::itemFinished()
+{
+  QObject* watcher = this->sender();
+  if (!Running.contains(watcher)) return;
+  Item item = Running.take(watcher);
+  watcher->deleteLater();
+
+  QVariantHash outputs;
+  try
+  {
+    foreach(const ctkCmdLineModuleResult& result, item.Future.results())
+    {
+      outputs.insert(result.parameter(), result.value());
+    }
+    if (item.Future.isCanceled())
+    {
+      outputs.insert(ErrorKey, tr("Canceled"));
+    }
+  }
+  catch (const ctkCmdLineModuleRunException& e)
+  {
+    outputs.insert(ErrorKey, e.errorString());
+  }
+  catch (const QtConcurrent::Exception&)
+  {
+    outputs.insert(ErrorKey, tr("Unknown error"));
+  }
+  this->reportItem(item.Index, outputs);
+
+  this->submit();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBatch::canceled()
+{
+  foreach(const Item& item, Running)
+  {
+    item.Future.cancel();
+  }
+  this->finishIfDone();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBatch::reportItem(int index, const QVariantHash& outputs)
+{
+  // Items finish out of order, so each one is reported at its own index
+  Aggregate.reportResult(ctkCmdLineModuleResult(QString::number(index), outputs), index);
+  ++FinishedItems;
+  Aggregate.setProgressValueAndText(FinishedItems, tr("%1 of %2 items finished")
+                                    .arg(FinishedItems).arg(Overrides.size()));
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBatch::finishIfDone()
+{
+  if (Aggregate.isFinished() || !Running.isEmpty()) return;
+  if (Aggregate.isCanceled() || Next == Overrides.size())
+  {
+    Aggregate.reportFinished();
+    this->deleteLater();
+  }
+}
@@ -0,0 +1,101 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKCMDLINEMODULEBATCH_P_H
+#define CTKCMDLINEMODULEBATCH_P_H
+
+#include "ctkCmdLineModuleFuture.h"
+#include "ctkCmdLineModuleFutureInterface.h"
+#include "ctkCmdLineModuleJobOptions.h"
+#include "ctkCmdLineModuleReference.h"
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QVariant>
+
+struct ctkCmdLineModuleBackend;
+class ctkCmdLineModuleFrontend;
+class ctkCmdLineModuleScheduler;
+
+/**
+ * \class ctkCmdLineModuleBatch
+ * \brief Runs a module once for each entry of a parameter override table.
+ *
+ * The items are handed to the scheduler one after another, keeping only
+ * a window of items submitted at a time, so that large tables do not
+ * flood the scheduler queue. Lives in the thread of the scheduler and
+ * deletes itself when all items are done.
+ */
+class ctkCmdLineModuleBatch : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  ctkCmdLineModuleBatch(ctkCmdLineModuleScheduler* scheduler, ctkCmdLineModuleBackend* backend,
+                        ctkCmdLineModuleFrontend* frontend,
+                        const QList<QHash<QString,QVariant> >& overrides,
+                        const ctkCmdLineModuleJobOptions& options, int window);
+  ~ctkCmdLineModuleBatch();
+
+  ctkCmdLineModuleFuture future();
+
+public Q_SLOTS:
+
+  void start();
+
+private Q_SLOTS:
+
+  void submit();
+  void itemFinished();
+  void canceled();
+
+private:
+
+  struct Item
+  {
+    int Index;
+    ctkCmdLineModuleFuture Future;
+  };
+
+  void reportItem(int index, const QVariantHash& outputs);
+  void finishIfDone();
+
+  ctkCmdLineModuleScheduler* const Scheduler;
+  ctkCmdLineModuleBackend* const Backend;
+  const ctkCmdLineModuleReference ModuleRef;
+  const QHash<QString,QVariant> TemplateValues;
+  const QList<QHash<QString,QVariant> > Overrides;
+  const ctkCmdLineModuleJobOptions Options;
+  const int Window;
+
+  int Next;
+  int FinishedItems;
+  QHash<QObject*, Item> Running;
+
+  ctkCmdLineModuleFutureInterface Aggregate;
+  QFutureWatcher<ctkCmdLineModuleResult> AggregateWatcher;
+};
+
+#endif // CTKCMDLINEMODULEBATCH_P_H
@@ -23,10 +23,13 @@
 
 #include <QUrl>
 #include <QFile>
+#include <QBuffer>
+#include <QDataStream>
 #include <QDirIterator>
-#include <QTextStream>
+#include <QFileInfo>
 #include <QMutex>
 #include <QHash>
+#include <QDebug>
 
 #if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
 #include "ctkCommandLineModulesCoreExport.h"
@@ -36,41 +39,292 @@ CTK_CMDLINEMODULECORE_EXPORT int qHash(const QUrl& url)
 }
 #endif
 
+namespace {
+
+const quint32 CacheFileMagic = 0x434d4c43; // "CMLC"
+const quint32 CacheFileVersion = 1;
+const qint64 CacheFileHeaderSize = 2 * sizeof(quint32);
+
+// Outdated records are only compacted if they waste more than this
+const qint64 MinCompactionSize = 64 * 1024;
+
+enum RecordType {
+  EntryRecord = 1,
+  RemovalRecord = 2
+};
+
+}
+
 struct ctkCmdLineModuleCachePrivate
 {
+  struct Entry
+  {
+    qint64 TimeStamp;
+    ctkCmdLineModuleCache::ValidationStatus Status;
+    QString ValidationErrorString;
+    // qCompress'ed XML, referencing the memory-mapped file for loaded entries
+    QByteArray CompressedXml;
+    QByteArray Xml;
+    bool XmlLoaded;
+    qint64 RecordSize;
+  };
+
   QString CacheDir;
 
-  QHash<QUrl, qint64> LocationToTimeStamp;
-  QHash<QUrl, QByteArray> LocationToXmlDescription;
+  QFile CacheFile;
+  uchar* Mapped;
+  qint64 MappedSize;
+
+  QHash<QUrl, Entry> LocationToEntry;
+  qint64 LiveRecordsSize;
 
   QMutex Mutex;
 
-  void LoadTimeStamps()
+  ctkCmdLineModuleCachePrivate()
+    : Mapped(NULL)
+    , MappedSize(0)
+    , LiveRecordsSize(0)
+  {}
+
+  QString cacheFileName() const
   {
-    QDirIterator dirIter(this->CacheDir, QStringList() << "*.timestamp", QDir::Files | QDir::Readable);
+    return this->CacheDir + "/ctkCmdLineModuleCache.dat";
+  }
+
+  void RemoveLegacyFiles()
+  {
+    // The cache used to consist of one .timestamp and one .xml file per module
+    QDirIterator dirIter(this->CacheDir, QStringList() << "*.timestamp", QDir::Files);
     while(dirIter.hasNext())
     {
-      QFile timestampFile(dirIter.next());
-      timestampFile.open(QIODevice::ReadOnly);
-      QUrl url = QUrl(timestampFile.readLine().trimmed().data());
-      QByteArray timestamp = timestampFile.readLine();
-      bool ok = false;
-      qint64 ts = timestamp.toLongLong(&ok);
-      if (ok && !url.isEmpty())
+      QFileInfo timestampFile(dirIter.next());
+      QFile::remove(timestampFile.absolutePath() + "/" + timestampFile.completeBaseName() + ".xml");
+      QFile::remove(timestampFile.absoluteFilePath());
+    }
+  }
+
+  void Load(bool compact = true)
+  {
+    this->LocationToEntry.clear();
+    this->LiveRecordsSize = 0;
+
+    this->CacheFile.setFileName(this->cacheFileName());
+    if (!this->CacheFile.open(QIODevice::ReadWrite))
+    {
+      qWarning() << "Command line module cache file" << this->CacheFile.fileName() << "could not be opened.";
+      return;
+    }
+
+    qint64 validSize = 0;
+    if (this->CacheFile.size() >= CacheFileHeaderSize)
+    {
+      this->MappedSize = this->CacheFile.size();
+      this->Mapped = this->CacheFile.map(0, this->MappedSize);
+      if (this->Mapped)
+      {
+        validSize = this->ParseRecords();
+      }
+    }
+
+    bool truncated = validSize < this->CacheFile.size();
+    bool wasteful = validSize - CacheFileHeaderSize - this->LiveRecordsSize > qMax(MinCompactionSize, this->LiveRecordsSize);
+    if (compact && validSize > 0 && (truncated || wasteful))
+    {
+      this->Compact();
+      return;
+    }
+
+    if (validSize == 0)
+    {
+      // new or unreadable cache file
+      this->Unmap();
+      this->CacheFile.resize(0);
+      this->CacheFile.seek(0);
+      QDataStream out(&this->CacheFile);
+      out << CacheFileMagic << CacheFileVersion;
+      validSize = CacheFileHeaderSize;
+    }
+    else if (truncated)
+    {
+      // An interrupted append. The file must not be truncated while it is
+      // mapped, so the valid records are indexed again from a new mapping.
+      this->LocationToEntry.clear();
+      this->LiveRecordsSize = 0;
+      this->Unmap();
+      this->CacheFile.resize(validSize);
+      this->MappedSize = validSize;
+      this->Mapped = this->CacheFile.map(0, this->MappedSize);
+      if (this->Mapped)
+      {
+        this->ParseRecords();
+      }
+      else
+      {
+        this->MappedSize = 0;
+      }
+    }
+    this->CacheFile.seek(validSize);
+  }
+
+  // Returns the size of the header and all complete records
+  qint64 ParseRecords()
+  {
+    QByteArray header = QByteArray::fromRawData(reinterpret_cast<const char*>(this->Mapped), CacheFileHeaderSize);
+    QDataStream headerIn(header);
+    quint32 magic = 0;
+    quint32 version = 0;
+    headerIn >> magic >> version;
+    if (magic != CacheFileMagic || version != CacheFileVersion)
+    {
+      return 0;
+    }
+
+    qint64 pos = CacheFileHeaderSize;
+    while (pos + static_cast<qint64>(sizeof(quint32)) <= this->MappedSize)
+    {
+      const uchar* record = this->Mapped + pos;
+      quint32 recordSize = (quint32(record[0]) << 24) | (quint32(record[1]) << 16) |
+                           (quint32(record[2]) << 8) | quint32(record[3]);
+      if (pos + qint64(sizeof(quint32)) + qint64(recordSize) > this->MappedSize)
+      {
+        break;
+      }
+
+      QByteArray recordData = QByteArray::fromRawData(reinterpret_cast<const char*>(record + sizeof(quint32)), recordSize);
+      QBuffer buffer(&recordData);
+      buffer.open(QIODevice::ReadOnly);
+      QDataStream in(&buffer);
+      in.setVersion(QDataStream::Qt_4_6);
+
+      quint8 type = 0;
+      QUrl location;
+      in >> type >> location;
+      if (type == RemovalRecord && in.status() == QDataStream::Ok)
+      {
+        this->RemoveEntry(location);
+      }
+      else if (type == EntryRecord)
+      {
+        Entry entry;
+        qint8 status = 0;
+        quint32 xmlSize = 0;
+        in >> entry.TimeStamp >> status >> entry.ValidationErrorString >> xmlSize;
+        if (in.status() != QDataStream::Ok || buffer.pos() + qint64(xmlSize) != qint64(recordSize))
+        {
+          break;
+        }
+        entry.Status = static_cast<ctkCmdLineModuleCache::ValidationStatus>(status);
+        entry.CompressedXml = QByteArray::fromRawData(recordData.constData() + buffer.pos(), xmlSize);
+        entry.XmlLoaded = false;
+        entry.RecordSize = sizeof(quint32) + recordSize;
+        this->InsertEntry(location, entry);
+      }
+      else
+      {
+        break;
+      }
+      pos += sizeof(quint32) + recordSize;
+    }
+    return pos;
+  }
+
+  void InsertEntry(const QUrl& location, const Entry& entry)
+  {
+    this->RemoveEntry(location);
+    this->LocationToEntry.insert(location, entry);
+    this->LiveRecordsSize += entry.RecordSize;
+  }
+
+  void RemoveEntry(const QUrl& location)
+  {
+    QHash<QUrl, Entry>::iterator iter = this->LocationToEntry.find(location);
+    if (iter != this->LocationToEntry.end())
+    {
+      this->LiveRecordsSize -= iter.value().RecordSize;
+      this->LocationToEntry.erase(iter);
+    }
+  }
+
+  QByteArray EncodeRecord(RecordType type, const QUrl& location, const Entry* entry) const
+  {
+    QByteArray record;
+    QDataStream out(&record, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << quint32(0) << quint8(type) << location;
+    if (entry)
+    {
+      out << entry->TimeStamp << qint8(entry->Status) << entry->ValidationErrorString
+          << quint32(entry->CompressedXml.size());
+      out.writeRawData(entry->CompressedXml.constData(), entry->CompressedXml.size());
+    }
+    out.device()->seek(0);
+    out << quint32(record.size() - sizeof(quint32));
+    return record;
+  }
+
+  bool Append(const QByteArray& record)
+  {
+    if (!this->CacheFile.isOpen()) return false;
+    if (this->CacheFile.write(record) != record.size() || !this->CacheFile.flush())
+    {
+      qWarning() << "Writing to the command line module cache file" << this->CacheFile.fileName() << "failed.";
+      return false;
+    }
+    return true;
+  }
+
+  void Compact()
+  {
+    QFile compactFile(this->cacheFileName() + ".tmp");
+    if (compactFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+      QDataStream out(&compactFile);
+      out << CacheFileMagic << CacheFileVersion;
+      QHashIterator<QUrl, Entry> iter(this->LocationToEntry);
+      while (iter.hasNext())
       {
-        this->LocationToTimeStamp[url] = ts;
+        iter.next();
+        QByteArray record = this->EncodeRecord(EntryRecord, iter.key(), &iter.value());
+        out.writeRawData(record.constData(), record.size());
       }
+      compactFile.close();
     }
+
+    this->LocationToEntry.clear();
+    this->Unmap();
+    this->CacheFile.close();
+    if (compactFile.error() != QFile::NoError || !QFile::remove(this->cacheFileName()) ||
+        !compactFile.rename(this->cacheFileName()))
+    {
+      compactFile.remove();
+    }
+    this->Load(false);
   }
 
-  QString timeStampFileName(const QUrl& moduleLocation) const
+  void Unmap()
   {
-    return this->CacheDir + "/" + QString::number(qHash(moduleLocation)) + ".timestamp";
+    if (this->Mapped)
+    {
+      this->CacheFile.unmap(this->Mapped);
+      this->Mapped = NULL;
+      this->MappedSize = 0;
+    }
   }
 
-  QString xmlFileName(const QUrl& moduleLocation) const
+  const Entry* LoadedEntry(const QUrl& location)
   {
-    return this->CacheDir + "/" + QString::number(qHash(moduleLocation)) + ".xml";
+    QHash<QUrl, Entry>::iterator iter = this->LocationToEntry.find(location);
+    if (iter == this->LocationToEntry.end()) return NULL;
+    Entry& entry = iter.value();
+    if (!entry.XmlLoaded)
+    {
+      if (!entry.CompressedXml.isEmpty())
+      {
+        entry.Xml = qUncompress(entry.CompressedXml);
+      }
+      entry.XmlLoaded = true;
+    }
+    return &entry;
   }
 };
 
@@ -78,11 +332,15 @@ ctkCmdLineModuleCache::ctkCmdLineModuleCache(const QString& cacheDir)
   : d(new ctkCmdLineModuleCachePrivate)
 {
   d->CacheDir = cacheDir;
-  d->LoadTimeStamps();
+  d->RemoveLegacyFiles();
+  d->Load();
 }
 
 ctkCmdLineModuleCache::~ctkCmdLineModuleCache()
 {
+  // The loaded entries reference the mapped file
+  d->LocationToEntry.clear();
+  d->Unmap();
 }
 
 QString ctkCmdLineModuleCache::cacheDir() const
@@ -94,98 +352,77 @@ QString ctkCmdLineModuleCache::cacheDir() const
 QByteArray ctkCmdLineModuleCache::rawXmlDescription(const QUrl& moduleLocation) const
 {
   QMutexLocker lock(&d->Mutex);
-
-  if (d->LocationToXmlDescription.contains(moduleLocation))
-  {
-    return d->LocationToXmlDescription[moduleLocation];
-  }
-  // lazily load the XML description from the file system
-  QByteArray xml;
-  QString a = moduleLocation.toString();
-  QString fn = d->xmlFileName(moduleLocation);
-  QFile xmlFile(d->xmlFileName(moduleLocation));
-  if (xmlFile.exists() && xmlFile.open(QIODevice::ReadOnly))
-  {
-    xml = xmlFile.readAll();
-    xmlFile.close();
-  }
-  d->LocationToXmlDescription[moduleLocation] = xml;
-  return xml;
+  const ctkCmdLineModuleCachePrivate::Entry* entry = d->LoadedEntry(moduleLocation);
+  return entry ? entry->Xml : QByteArray();
 }
 
 qint64 ctkCmdLineModuleCache::timeStamp(const QUrl& moduleLocation) const
 {
   QMutexLocker lock(&d->Mutex);
-  if (d->LocationToTimeStamp.contains(moduleLocation))
+  QHash<QUrl, ctkCmdLineModuleCachePrivate::Entry>::const_iterator iter = d->LocationToEntry.find(moduleLocation);
+  if (iter != d->LocationToEntry.end())
   {
-    return d->LocationToTimeStamp[moduleLocation];
+    return iter.value().TimeStamp;
   }
   return -1;
 }
 
-void ctkCmdLineModuleCache::cacheXmlDescription(const QUrl& moduleLocation, qint64 timestamp, const QByteArray& xmlDescription)
+ctkCmdLineModuleCache::ValidationStatus ctkCmdLineModuleCache::validationStatus(const QUrl& moduleLocation) const
 {
-  QFile timestampFile(d->timeStampFileName(moduleLocation));
-  QFile xmlFile(d->xmlFileName(moduleLocation));
-  timestampFile.remove();
-  timestampFile.open(QIODevice::WriteOnly);
-
-  QByteArray ba;
-  QTextStream str(&ba);
-  str << moduleLocation.toString() << '\n' << timestamp;
-  str.flush();
-  if (timestampFile.write(ba) == -1)
+  QMutexLocker lock(&d->Mutex);
+  QHash<QUrl, ctkCmdLineModuleCachePrivate::Entry>::const_iterator iter = d->LocationToEntry.find(moduleLocation);
+  if (iter != d->LocationToEntry.end())
   {
-    timestampFile.close();
-    timestampFile.remove();
-    return;
+    return iter.value().Status;
   }
-  timestampFile.close();
+  return NotValidated;
+}
 
-  xmlFile.remove();
-  if (!xmlDescription.isEmpty())
-  {
-    xmlFile.open(QIODevice::WriteOnly);
-    if (xmlFile.write(xmlDescription) == -1)
-    {
-      timestampFile.remove();
-      xmlFile.close();
-      xmlFile.remove();
-      return;
-    }
-  }
+QString ctkCmdLineModuleCache::validationErrorString(const QUrl& moduleLocation) const
+{
+  QMutexLocker lock(&d->Mutex);
+  return d->LocationToEntry.value(moduleLocation).ValidationErrorString;
+}
 
+void ctkCmdLineModuleCache::cacheXmlDescription(const QUrl& moduleLocation, qint64 timestamp, const QByteArray& xmlDescription,
+                                                ValidationStatus status, const QString& validationErrorString)
+{
+  ctkCmdLineModuleCachePrivate::Entry entry;
+  entry.TimeStamp = timestamp;
+  entry.Status = status;
+  entry.ValidationErrorString = status == Invalid ? validationErrorString : QString();
+  entry.CompressedXml = xmlDescription.isEmpty() ? QByteArray() : qCompress(xmlDescription);
+  entry.Xml = xmlDescription;
+  entry.XmlLoaded = true;
+
+  QByteArray record = d->EncodeRecord(EntryRecord, moduleLocation, &entry);
+  entry.RecordSize = record.size();
+  // only needed when compacting, which re-reads the file
+  entry.CompressedXml.clear();
+
+  QMutexLocker lock(&d->Mutex);
+  if (d->Append(record))
   {
-    QMutexLocker lock(&d->Mutex);
-    d->LocationToXmlDescription[moduleLocation] = xmlDescription;
-    d->LocationToTimeStamp[moduleLocation] = timestamp;
+    d->InsertEntry(moduleLocation, entry);
   }
 }
 
 void ctkCmdLineModuleCache::removeCacheEntry(const QUrl& moduleLocation)
 {
-  {
-    QMutexLocker lock(&d->Mutex);
-    d->LocationToTimeStamp.remove(moduleLocation);
-    d->LocationToXmlDescription.remove(moduleLocation);
-  }
+  QByteArray record = d->EncodeRecord(RemovalRecord, moduleLocation, NULL);
 
-  QFile timestampFile(d->timeStampFileName(moduleLocation));
-  if (timestampFile.exists())
-  {
-    timestampFile.remove();
-  }
-  QFile xmlFile(d->xmlFileName(moduleLocation));
-  if (xmlFile.exists())
-  {
-    xmlFile.remove();
-  }
+  QMutexLocker lock(&d->Mutex);
+  if (!d->LocationToEntry.contains(moduleLocation)) return;
+  d->RemoveEntry(moduleLocation);
+  d->Append(record);
 }
 
 void ctkCmdLineModuleCache::clearCache()
 {
-  foreach(const QUrl &url, d->LocationToXmlDescription.keys())
-  {
-    removeCacheEntry(url);
-  }
+  QMutexLocker lock(&d->Mutex);
+  d->LocationToEntry.clear();
+  d->Unmap();
+  d->CacheFile.close();
+  QFile::remove(d->cacheFileName());
+  d->Load(false);
 }
@@ -23,6 +23,7 @@
 #define CTKCMDLINEMODULECACHE_H
 
 #include <QScopedPointer>
+#include <QString>
 
 struct ctkCmdLineModuleCachePrivate;
 
@@ -31,11 +32,15 @@ class QUrl;
 /**
  * \class ctkCmdLineModuleCache
  * \brief Private non-exported class to contain a cache of
- * XML descriptions and time-stamps.
+ * XML descriptions, time-stamps and validation results.
  *
  * The intention is that this Cache is an in-memory representation
- * of a file-system directory containing XML files and a corresponding
- * timestamp. Hence these should always be in synch.
+ * of a single append-only file in a file-system directory. Each
+ * change of an entry appends a record holding the module location,
+ * its time stamp, its validation result and its compressed XML. The
+ * file is memory-mapped and indexed in one pass at construction, the
+ * XML of an entry is decompressed when it is first requested. Files
+ * containing mostly outdated records are compacted when loading.
  *
  * \ingroup CommandLineModulesCore_API
  */
@@ -44,6 +49,12 @@ class ctkCmdLineModuleCache
 
 public:
 
+  enum ValidationStatus {
+    NotValidated,
+    Valid,
+    Invalid
+  };
+
   ctkCmdLineModuleCache(const QString& cacheDir);
   ~ctkCmdLineModuleCache();
 
@@ -75,8 +86,28 @@ public:
    * for example a file path for a local process.
    * @param timestamp the time
    * @param xmlDescription the XML
+   * @param status the result of validating the XML
+   * @param validationErrorString the validation error, if the XML is invalid
+   */
+  void cacheXmlDescription(const QUrl& moduleLocation, qint64 timestamp, const QByteArray& xmlDescription,
+                           ValidationStatus status = NotValidated,
+                           const QString& validationErrorString = QString());
+
+  /**
+   * @brief Returns the result of validating the cached XML of a module.
+   * @param moduleLocation QUrl representing the location,
+   * for example a file path for a local process.
+   * @return the validation status, NotValidated if there is no entry
+   */
+  ValidationStatus validationStatus(const QUrl& moduleLocation) const;
+
+  /**
+   * @brief Returns the validation error of the cached XML of a module.
+   * @param moduleLocation QUrl representing the location,
+   * for example a file path for a local process.
+   * @return the error string, empty unless the status is Invalid
    */
-  void cacheXmlDescription(const QUrl& moduleLocation, qint64 timestamp, const QByteArray& xmlDescription);
+  QString validationErrorString(const QUrl& moduleLocation) const;
 
   /**
    * @brief Removes an entry from the cache.
@@ -109,6 +109,12 @@ QString ctkCmdLineModuleDescription::contributor() const
   return d->Contributor;
 }
 
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleDescription::persistentWorker() const
+{
+  return d->PersistentWorker;
+}
+
 //----------------------------------------------------------------------------
 QIcon ctkCmdLineModuleDescription::logo() const
 {
@@ -167,6 +173,7 @@ QTextStream & operator<<(QTextStream &os, const ctkCmdLineModuleDescription &mod
   os << "License: " << module.license() << '\n';
   os << "Contributor: " << module.contributor() << '\n';
   os << "Acknowledgements: " << module.acknowledgements() << '\n';
+  os << "PersistentWorker: " << (module.persistentWorker() ? "true" : "false") << '\n';
   //os << "Logo: " << module.GetLogo() << '\n';
 
   os << "ParameterGroups: " << '\n';
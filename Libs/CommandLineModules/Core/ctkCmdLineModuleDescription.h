@@ -100,6 +100,15 @@ public:
    */
   QString contributor() const;
 
+  /**
+   * @brief Returns \c true if the module supports the persistent worker protocol,
+   * derived from the \code <persistent-worker> \endcode tag.
+   *
+   * Back-ends may keep such modules running and hand them several parameter sets,
+   * one after another.
+   */
+  bool persistentWorker() const;
+
   /**
    * @brief Should return a QIcon, but does not appear to be supported yet.
    */
@@ -29,6 +29,10 @@ class ctkCmdLineModuleParameterGroup;
 
 struct ctkCmdLineModuleDescriptionPrivate : public QSharedData
 {
+  ctkCmdLineModuleDescriptionPrivate()
+    : PersistentWorker(false)
+  {}
+
   QString Title;
   QString Category;
   QString Description;
@@ -37,6 +41,7 @@ struct ctkCmdLineModuleDescriptionPrivate : public QSharedData
   QString License;
   QString Acknowledgements;
   QString Contributor;
+  bool PersistentWorker;
   QString Type;
   QString Target;
   QString Location;
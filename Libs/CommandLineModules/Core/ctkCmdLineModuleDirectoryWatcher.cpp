@@ -32,6 +32,7 @@
 #include <QFileInfo>
 #include <QUrl>
 #include <QDebug>
+#include <QTime>
 #include <QtConcurrentMap>
 
 #include <iostream>
@@ -415,8 +416,17 @@ void ctkCmdLineModuleDirectoryWatcherPrivate::updateModules(const QString &direc
 //-----------------------------------------------------------------------------
 QList<ctkCmdLineModuleReferenceResult> ctkCmdLineModuleDirectoryWatcherPrivate::loadModules(const QStringList& executables)
 {
-  QList<ctkCmdLineModuleReferenceResult> refResults = QtConcurrent::blockingMapped(executables,
-                                                                                   ctkCmdLineModuleConcurrentRegister(this->ModuleManager, this->Debug));
+  QList<QUrl> locations;
+  foreach(const QString& executable, executables)
+  {
+    locations << QUrl::fromLocalFile(executable);
+  }
+
+  QTime discoveryTime;
+  discoveryTime.start();
+  QList<ctkCmdLineModuleReferenceResult> refResults = this->ModuleManager->registerModules(locations);
+  if (this->Debug) qDebug() << "ctkCmdLineModuleDirectoryWatcherPrivate::loadModules: discovered" << executables.size()
+                            << "modules in" << discoveryTime.elapsed() << "ms";
 
   for (int i = 0; i < executables.size(); ++i)
   {
@@ -0,0 +1,74 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKCMDLINEMODULEFRONTENDSNAPSHOT_P_H
+#define CTKCMDLINEMODULEFRONTENDSNAPSHOT_P_H
+
+#include "ctkCmdLineModuleFrontend.h"
+
+/**
+ * \class ctkCmdLineModuleFrontendSnapshot
+ * \brief A front-end without a GUI holding a fixed set of parameter values.
+ *
+ * Used for runs which are started later than requested, so that the
+ * original front-end can be changed or deleted in the meantime.
+ */
+class ctkCmdLineModuleFrontendSnapshot : public ctkCmdLineModuleFrontend
+{
+public:
+
+  ctkCmdLineModuleFrontendSnapshot(ctkCmdLineModuleFrontend* frontend)
+    : ctkCmdLineModuleFrontend(frontend->moduleReference())
+    , Values(frontend->values())
+  {}
+
+  ctkCmdLineModuleFrontendSnapshot(const ctkCmdLineModuleReference& moduleRef,
+                                   const QHash<QString,QVariant>& values)
+    : ctkCmdLineModuleFrontend(moduleRef)
+    , Values(values)
+  {}
+
+  virtual QObject* guiHandle() const { return NULL; }
+
+  virtual QVariant value(const QString& parameter, int role = LocalResourceRole) const
+  {
+    Q_UNUSED(role)
+    return Values.value(parameter);
+  }
+
+  virtual void setValue(const QString& parameter, const QVariant& value, int role = DisplayRole)
+  {
+    Q_UNUSED(role)
+    Values.insert(parameter, value);
+  }
+
+  virtual QHash<QString,QVariant> values() const
+  {
+    return Values;
+  }
+
+private:
+
+  QHash<QString,QVariant> Values;
+};
+
+#endif // CTKCMDLINEMODULEFRONTENDSNAPSHOT_P_H
@@ -55,3 +55,9 @@ bool ctkCmdLineModuleFuture::canPause() const
 {
   return d.canPause();
 }
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleFuture::isQueued() const
+{
+  return d.isQueued();
+}
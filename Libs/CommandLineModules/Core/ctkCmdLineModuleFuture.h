@@ -74,6 +74,15 @@ public:
    */
   bool canPause() const;
 
+  /**
+   * @brief Check if this module is waiting for the ctkCmdLineModuleManager to start it.
+   * @return \c true if the module run is queued, \c false otherwise.
+   *
+   * Queued modules report themselves as running. They can be canceled
+   * via cancel() before they are started.
+   */
+  bool isQueued() const;
+
 };
 
 inline ctkCmdLineModuleFuture ctkCmdLineModuleFutureInterface::future()
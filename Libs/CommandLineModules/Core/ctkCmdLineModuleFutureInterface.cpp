@@ -24,6 +24,68 @@
 
 const int ctkCmdLineModuleFutureCallOutEvent::TypeId = QEvent::registerEventType();
 
+//----------------------------------------------------------------------------
+// ctkCmdLineModuleFutureDataBuffer
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFutureDataBuffer::ctkCmdLineModuleFutureDataBuffer()
+  : Offset(0)
+  , MaxSize(0)
+{
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureDataBuffer::append(const QByteArray& data)
+{
+  Data.append(data);
+  // trim only after the buffer doubled, to keep appending amortized constant
+  if (MaxSize > 0 && Data.size() > 2 * MaxSize)
+  {
+    trim();
+  }
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleFutureDataBuffer::read(qint64 position, int size) const
+{
+  const int start = static_cast<int>(qBound<qint64>(0, position - Offset, Data.size()));
+  if (size < 0 || size > Data.size() - start) size = Data.size() - start;
+  return QByteArray(Data.constData() + start, size);
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleFutureDataBuffer::readPending(qint64& position) const
+{
+  QByteArray data = read(position, -1);
+  // skip data which was dropped before it could be read
+  position = Offset + Data.size();
+  return data;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleFutureDataBuffer::isEmpty() const
+{
+  return Data.isEmpty();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureDataBuffer::setMaxSize(int maxSize)
+{
+  MaxSize = maxSize;
+  if (MaxSize > 0 && Data.size() > MaxSize)
+  {
+    trim();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureDataBuffer::trim()
+{
+  const int dropped = Data.size() - MaxSize;
+  Data.remove(0, dropped);
+  Offset += dropped;
+}
+
 //----------------------------------------------------------------------------
 // ctkCmdLineModuleFutureInterfacePrivate
 
@@ -32,6 +94,10 @@ ctkCmdLineModuleFutureInterfacePrivate::ctkCmdLineModuleFutureInterfacePrivate(c
   : RefCount(1)
   , CanCancel(false)
   , CanPause(false)
+  , Queued(false)
+  , ProgressInterval(0)
+  , ProgressPending(false)
+  , PendingProgressValue(0)
   , q(q)
 {
 }
@@ -178,6 +244,102 @@ void QFutureInterface<ctkCmdLineModuleResult>::setCanPause(bool canPause)
   d->CanPause = canPause;
 }
 
+//----------------------------------------------------------------------------
+bool QFutureInterface<ctkCmdLineModuleResult>::isQueued() const
+{
+  QMutexLocker l(&d->Mutex);
+  return d->Queued;
+}
+
+//----------------------------------------------------------------------------
+void QFutureInterface<ctkCmdLineModuleResult>::setQueued(bool queued)
+{
+  QMutexLocker l(&d->Mutex);
+  d->Queued = queued;
+}
+
+//----------------------------------------------------------------------------
+int QFutureInterface<ctkCmdLineModuleResult>::progressInterval() const
+{
+  QMutexLocker l(&d->Mutex);
+  return d->ProgressInterval;
+}
+
+//----------------------------------------------------------------------------
+void QFutureInterface<ctkCmdLineModuleResult>::setProgressInterval(int msecs)
+{
+  QMutexLocker l(&d->Mutex);
+  d->ProgressInterval = msecs;
+}
+
+//----------------------------------------------------------------------------
+void QFutureInterface<ctkCmdLineModuleResult>::setProgressValue(int progressValue)
+{
+  this->setProgressValueAndText(progressValue, QString());
+}
+
+//----------------------------------------------------------------------------
+void QFutureInterface<ctkCmdLineModuleResult>::setProgressValueAndText(int progressValue, const QString& progressText)
+{
+  {
+    QMutexLocker l(&d->Mutex);
+    if (d->ProgressInterval > 0)
+    {
+      if (d->ProgressTimer.isValid() && d->ProgressTimer.elapsed() < d->ProgressInterval)
+      {
+        // last value wins
+        if (!d->ProgressPending)
+        {
+          // let the watchers deliver the value if no further update follows
+          d->sendCallOut(ctkCmdLineModuleFutureCallOutEvent(ctkCmdLineModuleFutureCallOutEvent::ProgressPending));
+        }
+        d->ProgressPending = true;
+        d->PendingProgressValue = progressValue;
+        d->PendingProgressText = progressText;
+        return;
+      }
+      d->ProgressTimer.start();
+    }
+    d->ProgressPending = false;
+  }
+  QFutureInterfaceBase::setProgressValueAndText(progressValue, progressText);
+}
+
+//----------------------------------------------------------------------------
+void QFutureInterface<ctkCmdLineModuleResult>::flushProgress()
+{
+  int progressValue = 0;
+  QString progressText;
+  {
+    QMutexLocker l(&d->Mutex);
+    if (!d->ProgressPending) return;
+    d->ProgressPending = false;
+    if (d->ProgressInterval > 0)
+    {
+      d->ProgressTimer.start();
+    }
+    progressValue = d->PendingProgressValue;
+    progressText = d->PendingProgressText;
+    d->PendingProgressText.clear();
+  }
+  QFutureInterfaceBase::setProgressValueAndText(progressValue, progressText);
+}
+
+//----------------------------------------------------------------------------
+int QFutureInterface<ctkCmdLineModuleResult>::outputBufferSize() const
+{
+  QMutexLocker l(&d->Mutex);
+  return d->OutputData.MaxSize;
+}
+
+//----------------------------------------------------------------------------
+void QFutureInterface<ctkCmdLineModuleResult>::setOutputBufferSize(int bytes)
+{
+  QMutexLocker l(&d->Mutex);
+  d->OutputData.setMaxSize(bytes);
+  d->ErrorData.setMaxSize(bytes);
+}
+
 //----------------------------------------------------------------------------
 void QFutureInterface<ctkCmdLineModuleResult>::reportOutputData(const QByteArray& outputData)
 {
@@ -199,19 +361,15 @@ void QFutureInterface<ctkCmdLineModuleResult>::reportErrorData(const QByteArray&
 }
 
 //----------------------------------------------------------------------------
-QByteArray QFutureInterface<ctkCmdLineModuleResult>::outputData(int position, int size) const
+QByteArray QFutureInterface<ctkCmdLineModuleResult>::outputData(qint64 position, int size) const
 {
   QMutexLocker l(&d->Mutex);
-  if (size < 0) size = d->OutputData.size();
-  if (size > d->OutputData.size() - position) size = d->OutputData.size() - position;
-  return QByteArray(d->OutputData.data() + position, size);
+  return d->OutputData.read(position, size);
 }
 
 //----------------------------------------------------------------------------
-QByteArray QFutureInterface<ctkCmdLineModuleResult>::errorData(int position, int size) const
+QByteArray QFutureInterface<ctkCmdLineModuleResult>::errorData(qint64 position, int size) const
 {
   QMutexLocker l(&d->Mutex);
-  if (size < 0) size = d->ErrorData.size();
-  if (size > d->ErrorData.size() - position) size = d->ErrorData.size() - position;
-  return QByteArray(d->ErrorData.data() + position, size);
+  return d->ErrorData.read(position, size);
 }
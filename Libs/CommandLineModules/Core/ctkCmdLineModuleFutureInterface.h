@@ -45,6 +45,13 @@ class ctkCmdLineModuleFutureInterfacePrivate;
  *
  * This QFutureInterface must be used by custom backend implementations to retrieve
  * a suitable QFuture object and to report state changes to it via this interface.
+ *
+ * Modules reporting progress at a high rate can be throttled by setting a progress
+ * interval. Within one interval, only the last reported progress value is kept. It is
+ * delivered with the next update after the interval, by a ctkCmdLineModuleFutureWatcher
+ * once the interval elapsed without further updates, or when the module finishes.
+ * The reported output and error data can be limited to the most recent bytes by
+ * setting an output buffer size.
  */
 template <>
 class CTK_CMDLINEMODULECORE_EXPORT QFutureInterface<ctkCmdLineModuleResult> : public QFutureInterfaceBase
@@ -68,6 +75,29 @@ public:
   void setCanCancel(bool canCancel);
   bool canPause() const;
   void setCanPause(bool canPause);
+  bool isQueued() const;
+  void setQueued(bool queued);
+
+  int progressInterval() const;
+  void setProgressInterval(int msecs);
+
+  /**
+   * Reports a progress value, subject to the progress interval.
+   *
+   * \note These functions hide the non-virtual QFutureInterfaceBase functions of the
+   *       same name. Progress reported through a QFutureInterfaceBase reference or
+   *       pointer bypasses the progress interval.
+   */
+  void setProgressValue(int progressValue);
+  void setProgressValueAndText(int progressValue, const QString& progressText);
+
+  /**
+   * Delivers the last progress value held back by the progress interval, if any.
+   */
+  void flushProgress();
+
+  int outputBufferSize() const;
+  void setOutputBufferSize(int bytes);
 
   inline void reportResult(const ctkCmdLineModuleResult *result, int index = -1);
   inline void reportResult(const ctkCmdLineModuleResult &result, int index = -1);
@@ -81,8 +111,8 @@ public:
   inline const ctkCmdLineModuleResult *resultPointer(int index) const;
   inline QList<ctkCmdLineModuleResult> results();
 
-  QByteArray outputData(int position = 0, int size = -1) const;
-  QByteArray errorData(int position = 0, int size = -1) const;
+  QByteArray outputData(qint64 position = 0, int size = -1) const;
+  QByteArray errorData(qint64 position = 0, int size = -1) const;
 
 private:
 
@@ -156,6 +186,7 @@ inline void QFutureInterface<ctkCmdLineModuleResult>::reportResults(const QVecto
 
 inline void QFutureInterface<ctkCmdLineModuleResult>::reportFinished(const ctkCmdLineModuleResult *result)
 {
+    flushProgress();
     if (result)
         reportResult(result);
     QFutureInterfaceBase::reportFinished();
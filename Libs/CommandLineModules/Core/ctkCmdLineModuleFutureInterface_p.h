@@ -25,6 +25,8 @@
 #include <QEvent>
 #include <QAtomicInt>
 #include <QMutex>
+#include <QString>
+#include <QTime>
 
 class ctkCmdLineModuleFutureCallOutEvent : public QEvent
 {
@@ -34,7 +36,8 @@ public:
 
   enum CallOutType {
     OutputReady,
-    ErrorReady
+    ErrorReady,
+    ProgressPending
   };
 
   ctkCmdLineModuleFutureCallOutEvent()
@@ -63,6 +66,33 @@ public:
   virtual void cmdLineModuleCallOutInterfaceDisconnected() = 0;
 };
 
+/**
+ * Keeps the data reported by a module. Positions are absolute, counted from the
+ * first byte ever appended. If a maximum size is set, the oldest bytes are dropped
+ * once more than twice the maximum size is kept, retaining the most recent ones.
+ */
+class ctkCmdLineModuleFutureDataBuffer
+{
+public:
+
+  ctkCmdLineModuleFutureDataBuffer();
+
+  void append(const QByteArray& data);
+  QByteArray read(qint64 position, int size) const;
+  QByteArray readPending(qint64& position) const;
+
+  bool isEmpty() const;
+  void setMaxSize(int maxSize);
+
+  QByteArray Data;
+  qint64 Offset;
+  int MaxSize;
+
+private:
+
+  void trim();
+};
+
 class ctkCmdLineModuleFutureInterfacePrivate
 {
 public:
@@ -76,9 +106,16 @@ public:
 
   bool CanCancel;
   bool CanPause;
+  bool Queued;
+
+  ctkCmdLineModuleFutureDataBuffer OutputData;
+  ctkCmdLineModuleFutureDataBuffer ErrorData;
 
-  QByteArray OutputData;
-  QByteArray ErrorData;
+  int ProgressInterval;
+  QTime ProgressTimer;
+  bool ProgressPending;
+  int PendingProgressValue;
+  QString PendingProgressText;
 
   ctkCmdLineModuleFutureInterface* q;
 
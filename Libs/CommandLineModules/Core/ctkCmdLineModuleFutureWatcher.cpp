@@ -25,6 +25,7 @@
 #include "ctkCmdLineModuleFutureInterface_p.h"
 
 #include <QThread>
+#include <QTimerEvent>
 #include <QCoreApplication>
 
 //----------------------------------------------------------------------------
@@ -36,6 +37,7 @@ struct ctkCmdLineModuleFutureWatcherPrivate : public ctkCmdLineModuleFutureCallO
     , pendingErrorReadyEvent(NULL)
     , outputPos(0)
     , errorPos(0)
+    , progressTimerId(0)
   {}
 
   void connectOutputInterface()
@@ -82,14 +84,28 @@ struct ctkCmdLineModuleFutureWatcherPrivate : public ctkCmdLineModuleFutureCallO
     }
   }
 
+  QByteArray readPendingData(ctkCmdLineModuleFutureCallOutEvent::CallOutType callOutType)
+  {
+    ctkCmdLineModuleFutureInterfacePrivate* interfaceData = q->futureInterface().d;
+    QMutexLocker lock(&interfaceData->Mutex);
+    if (callOutType == ctkCmdLineModuleFutureCallOutEvent::OutputReady)
+    {
+      return interfaceData->OutputData.readPending(outputPos);
+    }
+    return interfaceData->ErrorData.readPending(errorPos);
+  }
+
   ctkCmdLineModuleFutureWatcher* q;
 
   ctkCmdLineModuleFuture Future;
 
   ctkCmdLineModuleFutureCallOutEvent* pendingOutputReadyEvent;
   ctkCmdLineModuleFutureCallOutEvent* pendingErrorReadyEvent;
-  int outputPos;
-  int errorPos;
+  qint64 outputPos;
+  qint64 errorPos;
+
+  // timer delivering a progress value held back by the progress interval
+  int progressTimerId;
 };
 
 //----------------------------------------------------------------------------
@@ -112,6 +128,11 @@ void ctkCmdLineModuleFutureWatcher::setFuture(const ctkCmdLineModuleFuture& futu
 
   d->outputPos = 0;
   d->errorPos = 0;
+  if (d->progressTimerId != 0)
+  {
+    killTimer(d->progressTimerId);
+    d->progressTimerId = 0;
+  }
 
   d->disconnectOutputInterface(true);
   d->Future = future;
@@ -132,6 +153,15 @@ bool ctkCmdLineModuleFutureWatcher::event(QEvent *event)
   {
     ctkCmdLineModuleFutureCallOutEvent* callOutEvent = static_cast<ctkCmdLineModuleFutureCallOutEvent*>(event);
 
+    if (callOutEvent->callOutType == ctkCmdLineModuleFutureCallOutEvent::ProgressPending)
+    {
+      if (d->progressTimerId == 0)
+      {
+        d->progressTimerId = startTimer(qMax(1, futureInterface().progressInterval()));
+      }
+      return true;
+    }
+
     if (futureInterface().isPaused())
     {
       if (callOutEvent->callOutType == ctkCmdLineModuleFutureCallOutEvent::OutputReady &&
@@ -172,23 +202,27 @@ bool ctkCmdLineModuleFutureWatcher::event(QEvent *event)
     }
     return result;
   }
+  else if (event->type() == QEvent::Timer &&
+           static_cast<QTimerEvent*>(event)->timerId() == d->progressTimerId)
+  {
+    killTimer(d->progressTimerId);
+    d->progressTimerId = 0;
+    futureInterface().flushProgress();
+    return true;
+  }
   return QFutureWatcher<ctkCmdLineModuleResult>::event(event);
 }
 
 //----------------------------------------------------------------------------
 QByteArray ctkCmdLineModuleFutureWatcher::readPendingOutputData() const
 {
-  QByteArray output = futureInterface().outputData(d->outputPos);
-  d->outputPos += output.size();
-  return output;
+  return d->readPendingData(ctkCmdLineModuleFutureCallOutEvent::OutputReady);
 }
 
 //----------------------------------------------------------------------------
 QByteArray ctkCmdLineModuleFutureWatcher::readPendingErrorData() const
 {
-  QByteArray errorOutput = futureInterface().errorData(d->errorPos);
-  d->errorPos += errorOutput.size();
-  return errorOutput;
+  return d->readPendingData(ctkCmdLineModuleFutureCallOutEvent::ErrorReady);
 }
 
 //----------------------------------------------------------------------------
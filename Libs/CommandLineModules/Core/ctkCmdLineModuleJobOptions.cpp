@@ -0,0 +1,139 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkCmdLineModuleJobOptions.h"
+
+#include <QSharedData>
+
+//----------------------------------------------------------------------------
+struct ctkCmdLineModuleJobOptionsPrivate : public QSharedData
+{
+  ctkCmdLineModuleJobOptionsPrivate()
+    : Priority(0)
+    , CpuCost(1)
+    , MemoryCost(0)
+    , ProgressInterval(0)
+    , OutputBufferSize(0)
+  {}
+
+  int Priority;
+  int CpuCost;
+  qint64 MemoryCost;
+  QString Owner;
+  int ProgressInterval;
+  int OutputBufferSize;
+};
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleJobOptions::ctkCmdLineModuleJobOptions()
+  : d(new ctkCmdLineModuleJobOptionsPrivate)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleJobOptions::~ctkCmdLineModuleJobOptions()
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleJobOptions::ctkCmdLineModuleJobOptions(const ctkCmdLineModuleJobOptions& other)
+  : d(other.d)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleJobOptions& ctkCmdLineModuleJobOptions::operator=(const ctkCmdLineModuleJobOptions& other)
+{
+  d = other.d;
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleJobOptions::priority() const
+{
+  return d->Priority;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleJobOptions::setPriority(int priority)
+{
+  d->Priority = priority;
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleJobOptions::cpuCost() const
+{
+  return d->CpuCost;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleJobOptions::setCpuCost(int cores)
+{
+  d->CpuCost = qMax(0, cores);
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkCmdLineModuleJobOptions::memoryCost() const
+{
+  return d->MemoryCost;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleJobOptions::setMemoryCost(qint64 bytes)
+{
+  d->MemoryCost = qMax(Q_INT64_C(0), bytes);
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleJobOptions::owner() const
+{
+  return d->Owner;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleJobOptions::setOwner(const QString& owner)
+{
+  d->Owner = owner;
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleJobOptions::progressInterval() const
+{
+  return d->ProgressInterval;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleJobOptions::setProgressInterval(int msecs)
+{
+  d->ProgressInterval = qMax(0, msecs);
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleJobOptions::outputBufferSize() const
+{
+  return d->OutputBufferSize;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleJobOptions::setOutputBufferSize(int bytes)
+{
+  d->OutputBufferSize = qMax(0, bytes);
+}
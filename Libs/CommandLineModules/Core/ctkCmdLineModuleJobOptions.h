@@ -0,0 +1,111 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULEJOBOPTIONS_H
+#define CTKCMDLINEMODULEJOBOPTIONS_H
+
+#include <ctkCommandLineModulesCoreExport.h>
+
+#include <QSharedDataPointer>
+#include <QString>
+
+struct ctkCmdLineModuleJobOptionsPrivate;
+
+/**
+ * @ingroup CommandLineModulesCore_API
+ *
+ * @brief Describes how a module run is scheduled by the ctkCmdLineModuleManager.
+ *
+ * Runs which cannot start immediately because the CPU or memory budget of the
+ * manager or the concurrency limit of their back-end is exhausted are queued.
+ * Queued runs are started in order of their priority. Among runs of equal
+ * priority, the owner with the fewest running jobs goes first, so that one
+ * caller submitting a large batch does not starve other callers.
+ *
+ * @see ctkCmdLineModuleManager::run(ctkCmdLineModuleFrontend*, const ctkCmdLineModuleJobOptions&)
+ */
+class CTK_CMDLINEMODULECORE_EXPORT ctkCmdLineModuleJobOptions
+{
+public:
+
+  ctkCmdLineModuleJobOptions();
+  ~ctkCmdLineModuleJobOptions();
+
+  ctkCmdLineModuleJobOptions(const ctkCmdLineModuleJobOptions& other);
+  ctkCmdLineModuleJobOptions& operator=(const ctkCmdLineModuleJobOptions& other);
+
+  /**
+   * @brief Get the priority of the run. Higher values are started first.
+   * @return The priority, 0 by default.
+   */
+  int priority() const;
+  void setPriority(int priority);
+
+  /**
+   * @brief Get the number of CPU cores the run is expected to occupy.
+   * @return The CPU cost, 1 by default.
+   *
+   * Runs which mostly wait for I/O or other processes may declare a cost of 0.
+   */
+  int cpuCost() const;
+  void setCpuCost(int cores);
+
+  /**
+   * @brief Get the number of bytes of memory the run is expected to occupy.
+   * @return The memory cost, 0 (not declared) by default.
+   */
+  qint64 memoryCost() const;
+  void setMemoryCost(qint64 bytes);
+
+  /**
+   * @brief Get the owner of the run, used to share the resources fairly between callers.
+   * @return The owner. All runs without an owner share the empty owner.
+   */
+  QString owner() const;
+  void setOwner(const QString& owner);
+
+  /**
+   * @brief Get the minimum interval between two progress reports of the run.
+   * @return The interval in milliseconds, 0 (no throttling) by default.
+   *
+   * Progress values reported within the interval are coalesced, only the last
+   * one is delivered.
+   *
+   * @see ctkCmdLineModuleFutureInterface::setProgressInterval(int)
+   */
+  int progressInterval() const;
+  void setProgressInterval(int msecs);
+
+  /**
+   * @brief Get the number of most recent output and error bytes kept for the run.
+   * @return The buffer size in bytes, 0 (keep all output) by default.
+   *
+   * @see ctkCmdLineModuleFutureInterface::setOutputBufferSize(int)
+   */
+  int outputBufferSize() const;
+  void setOutputBufferSize(int bytes);
+
+private:
+
+  QSharedDataPointer<ctkCmdLineModuleJobOptionsPrivate> d;
+};
+
+#endif // CTKCMDLINEMODULEJOBOPTIONS_H
@@ -25,7 +25,11 @@
 #include "ctkCmdLineModuleFrontend.h"
 #include "ctkCmdLineModuleTimeoutException.h"
 #include "ctkCmdLineModuleCache_p.h"
+#include "ctkCmdLineModuleConcurrentHelpers.h"
 #include "ctkCmdLineModuleFuture.h"
+#include "ctkCmdLineModuleJobOptions.h"
+#include "ctkCmdLineModuleResultCache_p.h"
+#include "ctkCmdLineModuleScheduler_p.h"
 #include "ctkCmdLineModuleXmlValidator.h"
 #include "ctkCmdLineModuleReference.h"
 #include "ctkCmdLineModuleReference_p.h"
@@ -45,6 +49,11 @@
 #include <QMutex>
 #include <QDebug>
 #include <QFuture>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
 
 #include <algorithm>
 
@@ -52,6 +61,56 @@
 extern int qHash(const QUrl& url);
 #endif
 
+namespace {
+
+// The results of one registerModules() call
+struct ctkCmdLineModuleDiscovery
+{
+  ctkCmdLineModuleDiscovery(int count)
+    : Remaining(count)
+    , Results(count)
+  {}
+
+  QMutex Mutex;
+  QWaitCondition Finished;
+  int Remaining;
+  QVector<ctkCmdLineModuleReferenceResult> Results;
+};
+
+class ctkCmdLineModuleDiscoveryTask : public QRunnable
+{
+public:
+
+  ctkCmdLineModuleDiscoveryTask(ctkCmdLineModuleManager* manager, ctkCmdLineModuleDiscovery* discovery,
+                                int index, const QUrl& location)
+    : Manager(manager)
+    , Discovery(discovery)
+    , Index(index)
+    , Location(location)
+  {}
+
+  void run()
+  {
+    ctkCmdLineModuleReferenceResult result = ctkCmdLineModuleConcurrentRegister(Manager)(Location);
+
+    QMutexLocker lock(&Discovery->Mutex);
+    Discovery->Results[Index] = result;
+    if (--Discovery->Remaining == 0)
+    {
+      Discovery->Finished.wakeAll();
+    }
+  }
+
+private:
+
+  ctkCmdLineModuleManager* const Manager;
+  ctkCmdLineModuleDiscovery* const Discovery;
+  const int Index;
+  const QUrl Location;
+};
+
+}
+
 //----------------------------------------------------------------------------
 struct ctkCmdLineModuleManagerPrivate
 {
@@ -59,6 +118,9 @@ struct ctkCmdLineModuleManagerPrivate
     : XmlTimeOut(30000)
     , ValidationMode(mode)
   {
+    // Module discovery mostly waits for the --xml output of module processes
+    DiscoveryPool.setMaxThreadCount(qMax(4, 4 * QThread::idealThreadCount()));
+
     QFileInfo fileInfo(cacheDir);
     if (!fileInfo.exists())
     {
@@ -91,6 +153,8 @@ struct ctkCmdLineModuleManagerPrivate
   QHash<QString, ctkCmdLineModuleBackend*> SchemeToBackend;
   QHash<QUrl, ctkCmdLineModuleReference> LocationToRef;
   QScopedPointer<ctkCmdLineModuleCache> ModuleCache;
+  ctkCmdLineModuleScheduler Scheduler;
+  QThreadPool DiscoveryPool;
   int XmlTimeOut;
 
   ctkCmdLineModuleManager::ValidationMode ValidationMode;
@@ -269,35 +333,47 @@ ctkCmdLineModuleManager::registerModule(const QUrl &location)
 
   if (d->ValidationMode != SKIP_VALIDATION)
   {
-    // validate the outputted xml description
-    QBuffer input(&xml);
-    input.open(QIODevice::ReadOnly);
+    ctkCmdLineModuleCache::ValidationStatus cachedStatus =
+        fromCache ? d->ModuleCache->validationStatus(location) : ctkCmdLineModuleCache::NotValidated;
 
-    ctkCmdLineModuleXmlValidator validator(&input);
-    if (!validator.validateInput())
+    bool valid = true;
+    QString validationErrorString;
+    if (cachedStatus != ctkCmdLineModuleCache::NotValidated)
+    {
+      // the cached xml description was validated before it was cached
+      valid = (cachedStatus == ctkCmdLineModuleCache::Valid);
+      validationErrorString = d->ModuleCache->validationErrorString(location);
+    }
+    else
     {
-      if (d->ModuleCache)
+      // validate the outputted xml description
+      QBuffer input(&xml);
+      input.open(QIODevice::ReadOnly);
+
+      ctkCmdLineModuleXmlValidator validator(&input);
+      valid = validator.validateInput();
+      validationErrorString = validator.errorString();
+
+      if (d->ModuleCache && (!valid || newTimeStamp > 0))
       {
-        // validation failed, cache the description anyway
-        d->ModuleCache->cacheXmlDescription(location, newTimeStamp, xml);
+        // cache the description together with the validation result,
+        // even if validation failed
+        d->ModuleCache->cacheXmlDescription(location, newTimeStamp, xml,
+                                            valid ? ctkCmdLineModuleCache::Valid : ctkCmdLineModuleCache::Invalid,
+                                            validationErrorString);
       }
+    }
 
+    if (!valid)
+    {
       if (d->ValidationMode == STRICT_VALIDATION)
       {
         throw ctkInvalidArgumentException(QString("Validating module at %1 failed: %2")
-                                          .arg(location.toString()).arg(validator.errorString()));
+                                          .arg(location.toString()).arg(validationErrorString));
       }
       else
       {
-        ref.d->XmlValidationErrorString = validator.errorString();
-      }
-    }
-    else
-    {
-      if (d->ModuleCache && newTimeStamp > 0 && !fromCache)
-      {
-        // successfully validated the xml, cache it
-        d->ModuleCache->cacheXmlDescription(location, newTimeStamp, xml);
+        ref.d->XmlValidationErrorString = validationErrorString;
       }
     }
   }
@@ -325,6 +401,23 @@ ctkCmdLineModuleManager::registerModule(const QUrl &location)
   return ref;
 }
 
+//----------------------------------------------------------------------------
+QList<ctkCmdLineModuleReferenceResult> ctkCmdLineModuleManager::registerModules(const QList<QUrl>& locations)
+{
+  ctkCmdLineModuleDiscovery discovery(locations.size());
+  for (int i = 0; i < locations.size(); ++i)
+  {
+    d->DiscoveryPool.start(new ctkCmdLineModuleDiscoveryTask(this, &discovery, i, locations[i]));
+  }
+
+  QMutexLocker lock(&discovery.Mutex);
+  while (discovery.Remaining > 0)
+  {
+    discovery.Finished.wait(&discovery.Mutex);
+  }
+  return discovery.Results.toList();
+}
+
 //----------------------------------------------------------------------------
 void ctkCmdLineModuleManager::unregisterModule(const ctkCmdLineModuleReference& ref)
 {
@@ -371,11 +464,103 @@ QList<ctkCmdLineModuleReference> ctkCmdLineModuleManager::moduleReferences() con
 //----------------------------------------------------------------------------
 ctkCmdLineModuleFuture ctkCmdLineModuleManager::run(ctkCmdLineModuleFrontend *frontend)
 {
-  QMutexLocker lock(&d->Mutex);
-  d->checkBackends_unlocked(frontend->location());
+  return this->run(frontend, ctkCmdLineModuleJobOptions());
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleManager::run(ctkCmdLineModuleFrontend* frontend,
+                                                    const ctkCmdLineModuleJobOptions& options)
+{
+  ctkCmdLineModuleBackend* backend = NULL;
+  {
+    QMutexLocker lock(&d->Mutex);
+    d->checkBackends_unlocked(frontend->location());
+    backend = d->SchemeToBackend[frontend->location().scheme()];
+  }
 
-  ctkCmdLineModuleFuture future = d->SchemeToBackend[frontend->location().scheme()]->run(frontend);
+  ctkCmdLineModuleFuture future = d->Scheduler.run(backend, frontend, options);
   frontend->setFuture(future);
   emit frontend->started();
   return future;
 }
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleManager::runBatch(ctkCmdLineModuleFrontend* frontend,
+                                                         const QList<QHash<QString,QVariant> >& overrides)
+{
+  return this->runBatch(frontend, overrides, ctkCmdLineModuleJobOptions());
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleManager::runBatch(ctkCmdLineModuleFrontend* frontend,
+                                                         const QList<QHash<QString,QVariant> >& overrides,
+                                                         const ctkCmdLineModuleJobOptions& options)
+{
+  ctkCmdLineModuleBackend* backend = NULL;
+  {
+    QMutexLocker lock(&d->Mutex);
+    d->checkBackends_unlocked(frontend->location());
+    backend = d->SchemeToBackend[frontend->location().scheme()];
+  }
+
+  return d->Scheduler.runBatch(backend, frontend, overrides, options);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManager::setMaxConcurrentJobs(ctkCmdLineModuleBackend* backend, int maxJobs)
+{
+  d->Scheduler.setMaxConcurrentJobs(backend, maxJobs);
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleManager::maxConcurrentJobs(ctkCmdLineModuleBackend* backend) const
+{
+  return d->Scheduler.maxConcurrentJobs(backend);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManager::setCpuBudget(int cores)
+{
+  d->Scheduler.setCpuBudget(cores);
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleManager::cpuBudget() const
+{
+  return d->Scheduler.cpuBudget();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManager::setMemoryBudget(qint64 bytes)
+{
+  d->Scheduler.setMemoryBudget(bytes);
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkCmdLineModuleManager::memoryBudget() const
+{
+  return d->Scheduler.memoryBudget();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManager::setResultCache(const QString& cacheDir, qint64 maxSize)
+{
+  d->Scheduler.setResultCache(cacheDir.isEmpty() ? NULL : new ctkCmdLineModuleResultCache(cacheDir, maxSize));
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleManager::resultCacheDirectory() const
+{
+  QSharedPointer<ctkCmdLineModuleResultCache> resultCache = d->Scheduler.resultCache();
+  return resultCache.isNull() ? QString() : resultCache->cacheDir();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManager::clearResultCache()
+{
+  QSharedPointer<ctkCmdLineModuleResultCache> resultCache = d->Scheduler.resultCache();
+  if (!resultCache.isNull())
+  {
+    resultCache->clear();
+  }
+}
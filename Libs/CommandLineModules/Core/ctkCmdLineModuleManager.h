@@ -24,16 +24,21 @@
 
 #include <ctkCommandLineModulesCoreExport.h>
 
+#include <QHash>
+#include <QList>
 #include <QObject>
 #include <QScopedPointer>
 #include <QString>
 #include <QStringList>
+#include <QVariant>
 #include "ctkCmdLineModuleReference.h"
+#include "ctkCmdLineModuleReferenceResult.h"
 
 struct ctkCmdLineModuleBackend;
 struct ctkCmdLineModuleFrontendFactory;
 class ctkCmdLineModuleFrontend;
 class ctkCmdLineModuleFuture;
+class ctkCmdLineModuleJobOptions;
 
 struct ctkCmdLineModuleManagerPrivate;
 
@@ -160,6 +165,22 @@ public:
    */
   ctkCmdLineModuleReference registerModule(const QUrl& location);
 
+  /**
+   * @brief Registers several modules concurrently.
+   * @param locations The URLs of the new modules.
+   * @return One result for each location, holding the module reference or the error
+   *         which prevented registering the module.
+   *
+   * The modules are registered by a thread pool of this manager, which runs more threads
+   * than there are processor cores because retrieving the XML description of a module
+   * mostly waits for the module process. The XML retrieval of each module is subject to
+   * the time-out of its back-end or setTimeOutForXMLRetrieval(). This method blocks until
+   * all modules are registered.
+   *
+   * @see registerModule()
+   */
+  QList<ctkCmdLineModuleReferenceResult> registerModules(const QList<QUrl>& locations);
+
   /**
    * @brief Unregister a previously registered module.
    * @param moduleRef The reference for the module to unregister.
@@ -203,6 +224,133 @@ public:
    */
   ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend);
 
+  /**
+   * @brief Run a module front-end with the given scheduling options.
+   * @param frontend The module front-end to run.
+   * @param options The priority, cost and owner of the run.
+   * @return A ctkCmdLineModuleFuture object which can be used to interact with the
+   *         running front-end.
+   *
+   * If the run does not fit into the CPU and memory budget of this manager or the
+   * back-end already runs its maximum number of concurrent jobs, the run is queued
+   * and the returned future reports ctkCmdLineModuleFuture::isQueued() until the run
+   * is started. The parameter values of the front-end are captured when calling this
+   * method. Queued runs can be canceled before they are started.
+   *
+   * @see ctkCmdLineModuleJobOptions
+   */
+  ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend, const ctkCmdLineModuleJobOptions& options);
+
+  /**
+   * @brief Run a module front-end once for each entry of a parameter override table.
+   * @param frontend The module front-end holding the parameter values shared by all runs.
+   * @param overrides The parameter values which differ from the front-end values, one
+   *        entry for each run.
+   * @return A ctkCmdLineModuleFuture object for the whole batch.
+   *
+   * The returned future reports one ctkCmdLineModuleResult for each entry, at the index
+   * of the entry in \a overrides, once the run of the entry is finished. Its parameter
+   * is the index as a string and its value is a QVariantHash mapping the output parameter
+   * names of the module to the values reported by the run. If the run failed or was
+   * canceled, the hash contains the error message under the key \c "#error".
+   *
+   * The progress value of the future is the number of finished entries. Canceling the
+   * future cancels all runs of the batch, pausing it stops starting new runs.
+   *
+   * The front-end values are captured when calling this method. The runs are handed
+   * to the scheduler one after another, at most as many at a time as the budget of
+   * this manager allows to run concurrently.
+   *
+   * @see run(ctkCmdLineModuleFrontend*, const ctkCmdLineModuleJobOptions&)
+   */
+  ctkCmdLineModuleFuture runBatch(ctkCmdLineModuleFrontend* frontend,
+                                  const QList<QHash<QString,QVariant> >& overrides);
+
+  /**
+   * @brief Run a batch with the given scheduling options for each of its runs.
+   *
+   * @see runBatch(ctkCmdLineModuleFrontend*, const QList<QHash<QString,QVariant> >&)
+   */
+  ctkCmdLineModuleFuture runBatch(ctkCmdLineModuleFrontend* frontend,
+                                  const QList<QHash<QString,QVariant> >& overrides,
+                                  const ctkCmdLineModuleJobOptions& options);
+
+  /**
+   * @brief Limit the number of concurrently running jobs of a back-end.
+   * @param backend The back-end.
+   * @param maxJobs The maximum number of running jobs, or 0 for no limit (the default).
+   */
+  void setMaxConcurrentJobs(ctkCmdLineModuleBackend* backend, int maxJobs);
+
+  /**
+   * @brief Get the maximum number of concurrently running jobs of a back-end.
+   * @return The maximum number of running jobs, or 0 if there is no limit.
+   */
+  int maxConcurrentJobs(ctkCmdLineModuleBackend* backend) const;
+
+  /**
+   * @brief Set the number of CPU cores shared by all running jobs.
+   *
+   * The default value of 0 disables the limit, so runs are only queued if a budget
+   * is set explicitly, for example to QThread::idealThreadCount().
+   *
+   * @param cores The CPU budget.
+   * @see ctkCmdLineModuleJobOptions::setCpuCost()
+   */
+  void setCpuBudget(int cores);
+
+  /**
+   * @brief Get the number of CPU cores shared by all running jobs.
+   * @return The CPU budget.
+   */
+  int cpuBudget() const;
+
+  /**
+   * @brief Set the number of bytes of memory shared by all running jobs.
+   *
+   * The default value of 0 disables the limit.
+   *
+   * @param bytes The memory budget.
+   * @see ctkCmdLineModuleJobOptions::setMemoryCost()
+   */
+  void setMemoryBudget(qint64 bytes);
+
+  /**
+   * @brief Get the number of bytes of memory shared by all running jobs.
+   * @return The memory budget.
+   */
+  qint64 memoryBudget() const;
+
+  /**
+   * @brief Cache the results of module runs in the given directory.
+   *
+   * A run is looked up by the module location and time stamp, its parameter values
+   * and the content of its input files. If a successful run with the same inputs was
+   * cached, its output files are copied to the output locations of the new run and the
+   * returned future reports the cached results, output and error data without running
+   * the module. Only use the cache for modules which are deterministic.
+   *
+   * Input files are hashed when starting a run, unless they did not change since they
+   * were last hashed. The least recently used runs are removed from the cache when it
+   * grows beyond \a maxSize bytes.
+   *
+   * @param cacheDir The directory holding the cached runs, or an empty string to
+   *        disable the cache (the default).
+   * @param maxSize The maximum size of the cache in bytes, or 0 for no limit.
+   */
+  void setResultCache(const QString& cacheDir, qint64 maxSize);
+
+  /**
+   * @brief Get the directory of the result cache.
+   * @return The cache directory or an empty string if results are not cached.
+   */
+  QString resultCacheDirectory() const;
+
+  /**
+   * @brief Remove all cached runs from the result cache.
+   */
+  void clearResultCache();
+
 Q_SIGNALS:
 
   /**
@@ -0,0 +1,510 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkCmdLineModuleResultCache_p.h"
+
+#include "ctkCmdLineModuleBackend.h"
+#include "ctkCmdLineModuleDescription.h"
+#include "ctkCmdLineModuleFrontend.h"
+#include "ctkCmdLineModuleParameter.h"
+#include "ctkCmdLineModuleReference.h"
+
+#include <ctkUtils.h>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QUrl>
+
+namespace {
+
+const quint32 ResultsFormatVersion = 1;
+
+qint64 now()
+{
+  return ctk::msecsTo(QDateTime::fromTime_t(0), QDateTime::currentDateTime());
+}
+
+void writeLastUsed(const QString& dir, qint64 lastUsed)
+{
+  QFile lastUsedFile(dir + "/lastused");
+  if (lastUsedFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    lastUsedFile.write(QByteArray::number(lastUsed));
+  }
+}
+
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleResultCache::ctkCmdLineModuleResultCache(const QString& cacheDir, qint64 maxSize)
+  : CacheDir(cacheDir)
+  , MaxSize(maxSize)
+  , totalSize(0)
+{
+  QDir().mkpath(CacheDir);
+  this->loadEntries();
+
+  this->moveToThread(&thread);
+  thread.start();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleResultCache::~ctkCmdLineModuleResultCache()
+{
+  // Runs which did not finish yet are not cached
+  thread.quit();
+  thread.wait();
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleResultCache::cacheDir() const
+{
+  return CacheDir;
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkCmdLineModuleResultCache::maxSize() const
+{
+  return MaxSize;
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkCmdLineModuleResultCache::size() const
+{
+  QMutexLocker lock(&mutex);
+  return totalSize;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleResultCache::Run ctkCmdLineModuleResultCache::prepare(ctkCmdLineModuleBackend* backend,
+                                                                      ctkCmdLineModuleFrontend* frontend)
+{
+  Run run;
+  const ctkCmdLineModuleReference moduleRef = frontend->moduleReference();
+  const ctkCmdLineModuleDescription description = moduleRef.description();
+  const QHash<QString,QVariant> values = frontend->values();
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(moduleRef.location().toString().toUtf8());
+  hash.addData("\n" + QByteArray::number(backend->timeStamp(moduleRef.location())));
+
+  QStringList names = values.keys();
+  qSort(names);
+  foreach(const QString& name, names)
+  {
+    QString value = values[name].toString();
+    hash.addData("\n" + name.toUtf8() + "=");
+
+    if (!description.hasParameter(name))
+    {
+      hash.addData(value.toUtf8());
+      continue;
+    }
+
+    const ctkCmdLineModuleParameter parameter = description.parameter(name);
+    const QString tag = parameter.tag();
+    if (tag == "boolean")
+    {
+      hash.addData(values[name].toBool() ? "true" : "false");
+      continue;
+    }
+    if (tag != "string")
+    {
+      value = value.trimmed();
+    }
+    if (tag != "file" && tag != "image" && tag != "geometry")
+    {
+      hash.addData(value.toUtf8());
+      continue;
+    }
+
+    QStringList paths;
+    foreach(const QString& path, parameter.multiple() ? value.split(',') : QStringList(value))
+    {
+      if (!path.trimmed().isEmpty()) paths << path.trimmed();
+    }
+
+    if (parameter.channel() == "output")
+    {
+      // The names of the output files do not change the result
+      hash.addData("<output:" + QByteArray::number(paths.size()) + ">");
+      run.OutputFiles << paths;
+      continue;
+    }
+
+    foreach(const QString& path, paths)
+    {
+      QByteArray contentHash = this->fileHash(path);
+      if (contentHash.isEmpty())
+      {
+        // A run with missing input files fails anyway
+        return Run();
+      }
+      hash.addData(contentHash);
+    }
+  }
+
+  run.Key = hash.result().toHex();
+  return run;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleResultCache::restore(const Run& run, ctkCmdLineModuleFuture* future)
+{
+  if (run.Key.isEmpty()) return false;
+  {
+    QMutexLocker lock(&mutex);
+    if (!entries.contains(run.Key)) return false;
+  }
+
+  // The entry might be evicted while it is read, in which case the
+  // run is not restored but started as usual.
+  const QString dir = this->entryDir(run.Key);
+  QFile resultsFile(dir + "/results");
+  if (!resultsFile.open(QIODevice::ReadOnly)) return false;
+
+  QDataStream in(&resultsFile);
+  in.setVersion(QDataStream::Qt_4_6);
+  quint32 version = 0;
+  in >> version;
+  if (version != ResultsFormatVersion) return false;
+
+  qint32 resultCount = 0;
+  in >> resultCount;
+  QList<ctkCmdLineModuleResult> results;
+  for (qint32 i = 0; i < resultCount && in.status() == QDataStream::Ok; ++i)
+  {
+    QString parameter;
+    QVariant value;
+    in >> parameter >> value;
+    results.push_back(ctkCmdLineModuleResult(parameter, value));
+  }
+  QStringList cachedOutputFiles;
+  QByteArray outputData;
+  QByteArray errorData;
+  in >> cachedOutputFiles >> outputData >> errorData;
+  if (in.status() != QDataStream::Ok || cachedOutputFiles.size() != run.OutputFiles.size())
+  {
+    return false;
+  }
+
+  for (int i = 0; i < run.OutputFiles.size(); ++i)
+  {
+    // The cached run did not write this file
+    const QString cachedFile = dir + "/" + QString::number(i);
+    if (!QFile::exists(cachedFile)) continue;
+
+    QFile::remove(run.OutputFiles[i]);
+    if (!QFile::copy(cachedFile, run.OutputFiles[i]))
+    {
+      return false;
+    }
+  }
+
+  ctkCmdLineModuleFutureInterface futureInterface;
+  futureInterface.reportStarted();
+  futureInterface.setProgressRange(0, 1);
+  futureInterface.reportOutputData(outputData);
+  futureInterface.reportErrorData(errorData);
+  foreach(const ctkCmdLineModuleResult& result, results)
+  {
+    // Results naming an output file refer to the files of the cached run
+    int outputIndex = cachedOutputFiles.indexOf(result.value().toString());
+    if (outputIndex > -1)
+    {
+      futureInterface.reportResult(ctkCmdLineModuleResult(result.parameter(), run.OutputFiles[outputIndex]));
+    }
+    else
+    {
+      futureInterface.reportResult(result);
+    }
+  }
+  futureInterface.setProgressValue(1);
+  futureInterface.reportFinished();
+  *future = futureInterface.future();
+
+  {
+    QMutexLocker lock(&mutex);
+    this->touch_unlocked(run.Key);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::store(const Run& run, const ctkCmdLineModuleFuture& future)
+{
+  if (run.Key.isEmpty()) return;
+
+  PendingRun pendingRun;
+  pendingRun.Info = run;
+  pendingRun.Future = future;
+
+  QMutexLocker lock(&mutex);
+  newRuns.push_back(pendingRun);
+  QMetaObject::invokeMethod(this, "watchNewRuns", Qt::QueuedConnection);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::clear()
+{
+  QMutexLocker lock(&mutex);
+  foreach(const QString& key, entries.keys())
+  {
+    removeDir(this->entryDir(key));
+  }
+  entries.clear();
+  totalSize = 0;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::watchNewRuns()
+{
+  QList<PendingRun> runs;
+  {
+    QMutexLocker lock(&mutex);
+    runs = newRuns;
+    newRuns.clear();
+  }
+
+  foreach(const PendingRun& run, runs)
+  {
+    QFutureWatcher<ctkCmdLineModuleResult>* watcher = new QFutureWatcher<ctkCmdLineModuleResult>(this);
+    watchedRuns.insert(watcher, run);
+    connect(watcher, SIGNAL(finished()), SLOT(runFinished()));
+    watcher->setFuture(run.Future);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::runFinished()
+{
+  QObject* watcher = this->sender();
+  if (!watchedRuns.contains(watcher)) return;
+  PendingRun run = watchedRuns.take(watcher);
+  watcher->deleteLater();
+
+  try
+  {
+    run.Future.waitForFinished();
+  }
+  catch (const QtConcurrent::Exception&)
+  {
+    return;
+  }
+  if (run.Future.isCanceled()) return;
+
+  {
+    QMutexLocker lock(&mutex);
+    if (entries.contains(run.Info.Key))
+    {
+      this->touch_unlocked(run.Info.Key);
+      return;
+    }
+  }
+  this->writeEntry(run);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::loadEntries()
+{
+  QDir cacheDir(CacheDir);
+  foreach(const QFileInfo& dirInfo, cacheDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+  {
+    const QString dir = dirInfo.absoluteFilePath();
+    QFileInfo resultsInfo(dir + "/results");
+    if (dirInfo.suffix() == "tmp" || !resultsInfo.exists())
+    {
+      // left over from an interrupted write
+      removeDir(dir);
+      continue;
+    }
+
+    Entry entry;
+    entry.Size = 0;
+    foreach(const QFileInfo& fileInfo, QDir(dir).entryInfoList(QDir::Files | QDir::Hidden))
+    {
+      entry.Size += fileInfo.size();
+    }
+
+    QFile lastUsedFile(dir + "/lastused");
+    bool ok = false;
+    if (lastUsedFile.open(QIODevice::ReadOnly))
+    {
+      entry.LastUsed = lastUsedFile.readAll().toLongLong(&ok);
+    }
+    if (!ok)
+    {
+      entry.LastUsed = ctk::msecsTo(QDateTime::fromTime_t(0), resultsInfo.lastModified());
+    }
+
+    entries.insert(dirInfo.fileName(), entry);
+    totalSize += entry.Size;
+  }
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleResultCache::fileHash(const QString& path)
+{
+  QFileInfo fileInfo(path);
+  if (!fileInfo.isFile()) return QByteArray();
+
+  {
+    QMutexLocker lock(&mutex);
+    QHash<QString, FileHash>::const_iterator iter = fileHashes.find(fileInfo.absoluteFilePath());
+    if (iter != fileHashes.end() && iter.value().Size == fileInfo.size() &&
+        iter.value().LastModified == fileInfo.lastModified())
+    {
+      return iter.value().Hash;
+    }
+  }
+
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  while (!file.atEnd())
+  {
+    hash.addData(file.read(1024 * 1024));
+  }
+
+  FileHash fileHash;
+  fileHash.Size = fileInfo.size();
+  fileHash.LastModified = fileInfo.lastModified();
+  fileHash.Hash = hash.result();
+
+  QMutexLocker lock(&mutex);
+  fileHashes.insert(fileInfo.absoluteFilePath(), fileHash);
+  return fileHash.Hash;
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleResultCache::entryDir(const QString& key) const
+{
+  return CacheDir + "/" + key;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::writeEntry(const PendingRun& run)
+{
+  const QString dir = this->entryDir(run.Info.Key);
+  const QString tmpDir = dir + ".tmp";
+  removeDir(tmpDir);
+  if (!QDir().mkpath(tmpDir)) return;
+
+  Entry entry;
+  entry.Size = 0;
+  entry.LastUsed = now();
+
+  for (int i = 0; i < run.Info.OutputFiles.size(); ++i)
+  {
+    // Modules do not always write all their output files
+    if (!QFile::exists(run.Info.OutputFiles[i])) continue;
+
+    const QString cachedFile = tmpDir + "/" + QString::number(i);
+    if (!QFile::copy(run.Info.OutputFiles[i], cachedFile))
+    {
+      removeDir(tmpDir);
+      return;
+    }
+    entry.Size += QFileInfo(cachedFile).size();
+  }
+
+  QFile resultsFile(tmpDir + "/results");
+  if (!resultsFile.open(QIODevice::WriteOnly))
+  {
+    removeDir(tmpDir);
+    return;
+  }
+  QList<ctkCmdLineModuleResult> results = run.Future.results();
+  QDataStream out(&resultsFile);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << ResultsFormatVersion << qint32(results.size());
+  foreach(const ctkCmdLineModuleResult& result, results)
+  {
+    out << result.parameter() << result.value();
+  }
+  out << run.Info.OutputFiles << run.Future.readAllOutputData() << run.Future.readAllErrorData();
+  resultsFile.close();
+  if (out.status() != QDataStream::Ok || resultsFile.error() != QFile::NoError)
+  {
+    removeDir(tmpDir);
+    return;
+  }
+  entry.Size += resultsFile.size();
+
+  writeLastUsed(tmpDir, entry.LastUsed);
+  if (!QDir().rename(tmpDir, dir))
+  {
+    removeDir(tmpDir);
+    return;
+  }
+
+  QMutexLocker lock(&mutex);
+  entries.insert(run.Info.Key, entry);
+  totalSize += entry.Size;
+  this->evict_unlocked();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::touch_unlocked(const QString& key)
+{
+  QHash<QString, Entry>::iterator iter = entries.find(key);
+  if (iter == entries.end()) return;
+  iter.value().LastUsed = now();
+  writeLastUsed(this->entryDir(key), iter.value().LastUsed);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::evict_unlocked()
+{
+  while (MaxSize > 0 && totalSize > MaxSize && !entries.isEmpty())
+  {
+    QHash<QString, Entry>::const_iterator oldest = entries.begin();
+    for (QHash<QString, Entry>::const_iterator iter = entries.begin(); iter != entries.end(); ++iter)
+    {
+      if (iter.value().LastUsed < oldest.value().LastUsed)
+      {
+        oldest = iter;
+      }
+    }
+
+    const QString key = oldest.key();
+    totalSize -= oldest.value().Size;
+    entries.remove(key);
+    removeDir(this->entryDir(key));
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleResultCache::removeDir(const QString& path)
+{
+  QDir dir(path);
+  if (!dir.exists()) return;
+  foreach(const QString& fileName, dir.entryList(QDir::Files | QDir::Hidden))
+  {
+    dir.remove(fileName);
+  }
+  QDir().rmdir(path);
+}
@@ -0,0 +1,142 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKCMDLINEMODULERESULTCACHE_P_H
+#define CTKCMDLINEMODULERESULTCACHE_P_H
+
+#include "ctkCmdLineModuleFuture.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QThread>
+
+struct ctkCmdLineModuleBackend;
+class ctkCmdLineModuleFrontend;
+
+/**
+ * \class ctkCmdLineModuleResultCache
+ * \brief Private non-exported class memoizing the results of module runs.
+ *
+ * A run is identified by the module location and time stamp, the normalized
+ * parameter values and the content of its input files. The results, the
+ * output and error data and the output files of successful runs are kept in
+ * one sub-directory of the cache directory per run. The least recently used
+ * entries are removed when the cache grows beyond its maximum size.
+ *
+ * Storing a run waits for its future in the cache thread, restoring a run
+ * happens synchronously in the calling thread.
+ */
+class ctkCmdLineModuleResultCache : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  struct Run
+  {
+    // empty if the run cannot be cached
+    QString Key;
+    QStringList OutputFiles;
+  };
+
+  ctkCmdLineModuleResultCache(const QString& cacheDir, qint64 maxSize);
+  ~ctkCmdLineModuleResultCache();
+
+  QString cacheDir() const;
+  qint64 maxSize() const;
+  qint64 size() const;
+
+  /**
+   * @brief Computes the key and the output files of a run.
+   *
+   * The content hashes of input files are remembered as long as the
+   * size and modification time of the files do not change.
+   */
+  Run prepare(ctkCmdLineModuleBackend* backend, ctkCmdLineModuleFrontend* frontend);
+
+  /**
+   * @brief Restores the output files of a cached run.
+   * @return true and a finished future if the run was found in the cache.
+   */
+  bool restore(const Run& run, ctkCmdLineModuleFuture* future);
+
+  /**
+   * @brief Adds the run to the cache once its future finished successfully.
+   */
+  void store(const Run& run, const ctkCmdLineModuleFuture& future);
+
+  void clear();
+
+private Q_SLOTS:
+
+  void watchNewRuns();
+  void runFinished();
+
+private:
+
+  struct Entry
+  {
+    qint64 Size;
+    qint64 LastUsed;
+  };
+
+  struct FileHash
+  {
+    qint64 Size;
+    QDateTime LastModified;
+    QByteArray Hash;
+  };
+
+  struct PendingRun
+  {
+    Run Info;
+    ctkCmdLineModuleFuture Future;
+  };
+
+  void loadEntries();
+  QByteArray fileHash(const QString& path);
+  QString entryDir(const QString& key) const;
+  void writeEntry(const PendingRun& run);
+  void touch_unlocked(const QString& key);
+  void evict_unlocked();
+  static void removeDir(const QString& path);
+
+  QThread thread;
+
+  const QString CacheDir;
+  const qint64 MaxSize;
+
+  mutable QMutex mutex;
+  QHash<QString, Entry> entries;
+  qint64 totalSize;
+  QHash<QString, FileHash> fileHashes;
+  QList<PendingRun> newRuns;
+
+  // only accessed from the cache thread
+  QHash<QObject*, PendingRun> watchedRuns;
+};
+
+#endif // CTKCMDLINEMODULERESULTCACHE_P_H
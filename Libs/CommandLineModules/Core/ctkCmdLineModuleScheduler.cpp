@@ -0,0 +1,745 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkCmdLineModuleScheduler_p.h"
+
+#include "ctkCmdLineModuleBackend.h"
+#include "ctkCmdLineModuleBatch_p.h"
+#include "ctkCmdLineModuleFrontendSnapshot_p.h"
+#include "ctkCmdLineModuleFutureWatcher.h"
+#include "ctkCmdLineModuleReference.h"
+#include "ctkCmdLineModuleResultCache_p.h"
+#include "ctkCmdLineModuleRunException.h"
+
+#include <ctkException.h>
+
+#include <QFutureWatcher>
+#include <QPair>
+#include <QSet>
+#include <QUrl>
+
+#include <climits>
+
+//----------------------------------------------------------------------------
+struct ctkCmdLineModuleScheduler::Job
+{
+  Job(ctkCmdLineModuleBackend* backend, const ctkCmdLineModuleJobOptions& options, qint64 sequence)
+    : Backend(backend)
+    , Options(options)
+    , Sequence(sequence)
+    , Frontend(NULL)
+    , Queued(false)
+    , Started(false)
+    , Watcher(NULL)
+    , ProxyWatcher(NULL)
+    , ForwardedResults(0)
+    , ProxyPaused(false)
+  {}
+
+  ~Job()
+  {
+    delete Watcher;
+    delete ProxyWatcher;
+    delete Frontend;
+  }
+
+  void applyOutputOptions(ctkCmdLineModuleFutureInterface& futureInterface) const
+  {
+    if (Options.progressInterval() > 0)
+    {
+      futureInterface.setProgressInterval(Options.progressInterval());
+    }
+    if (Options.outputBufferSize() > 0)
+    {
+      futureInterface.setOutputBufferSize(Options.outputBufferSize());
+    }
+  }
+
+  ctkCmdLineModuleBackend* const Backend;
+  const ctkCmdLineModuleJobOptions Options;
+  const qint64 Sequence;
+
+  // values snapshot of a queued job
+  ctkCmdLineModuleFrontend* Frontend;
+
+  // true if the caller got the proxy future instead of the back-end future
+  bool Queued;
+  // true if the back-end was asked to run the job
+  bool Started;
+
+  ctkCmdLineModuleFutureInterface Proxy;
+  ctkCmdLineModuleFuture Future;
+
+  ctkCmdLineModuleFutureWatcher* Watcher;
+  QFutureWatcher<ctkCmdLineModuleResult>* ProxyWatcher;
+
+  int ForwardedResults;
+  bool ProxyPaused;
+};
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::ctkCmdLineModuleScheduler()
+  : sequence(0)
+  , cpuLimit(0)
+  , memoryLimit(0)
+  , runningCount(0)
+  , cpuInUse(0)
+  , memoryInUse(0)
+  , pausePollTimer(this)
+{
+  // Due to Qt bug 12152, the "paused" signal of a QFutureWatcher is not
+  // emitted when the future is paused, so the pause state of the proxy
+  // futures is polled.
+  connect(&pausePollTimer, SIGNAL(timeout()), SLOT(forwardPauseState()));
+
+  this->moveToThread(&thread);
+  thread.start();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::~ctkCmdLineModuleScheduler()
+{
+  thread.quit();
+  thread.wait();
+
+  QSet<Job*> jobs = pending.toSet();
+  jobs.unite(newJobs.toSet());
+  foreach(Job* job, watchedJobs)
+  {
+    jobs.insert(job);
+  }
+
+  // Nobody would finish the proxy futures anymore
+  foreach(Job* job, jobs)
+  {
+    if (job->Queued && !job->Proxy.isFinished())
+    {
+      if (job->Started)
+      {
+        job->Future.cancel();
+      }
+      job->Proxy.setQueued(false);
+      job->Proxy.reportCanceled();
+      job->Proxy.reportFinished();
+    }
+    delete job;
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleScheduler::run(ctkCmdLineModuleBackend* backend,
+                                                      ctkCmdLineModuleFrontend* frontend,
+                                                      const ctkCmdLineModuleJobOptions& options)
+{
+  QSharedPointer<ctkCmdLineModuleResultCache> resultCache = this->resultCache();
+  if (resultCache.isNull())
+  {
+    return this->schedule(backend, frontend, options);
+  }
+
+  ctkCmdLineModuleResultCache::Run cachedRun = resultCache->prepare(backend, frontend);
+  ctkCmdLineModuleFuture future;
+  if (resultCache->restore(cachedRun, &future))
+  {
+    return future;
+  }
+
+  future = this->schedule(backend, frontend, options);
+  resultCache->store(cachedRun, future);
+  return future;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleScheduler::schedule(ctkCmdLineModuleBackend* backend,
+                                                           ctkCmdLineModuleFrontend* frontend,
+                                                           const ctkCmdLineModuleJobOptions& options)
+{
+  bool knownBackend = false;
+  {
+    QMutexLocker lock(&mutex);
+    knownBackend = backendCapacities.contains(backend);
+  }
+  if (!knownBackend)
+  {
+    updateCapacities(QList<ctkCmdLineModuleBackend*>() << backend);
+  }
+
+  QMutexLocker lock(&mutex);
+  Job* job = new Job(backend, options, ++sequence);
+
+  if (pending.isEmpty() && fitsBudget_unlocked(job))
+  {
+    // Start the job right away in the calling thread, there is no need for a proxy.
+    reserve_unlocked(job);
+    job->Started = true;
+    lock.unlock();
+
+    try
+    {
+      job->Future = backend->run(frontend);
+      job->applyOutputOptions(job->Future.d);
+    }
+    catch (...)
+    {
+      lock.relock();
+      release_unlocked(job);
+      delete job;
+      throw;
+    }
+
+    lock.relock();
+    newJobs.push_back(job);
+    QMetaObject::invokeMethod(this, "watchNewJobs", Qt::QueuedConnection);
+    return job->Future;
+  }
+
+  lock.unlock();
+  job->Queued = true;
+  job->Frontend = new ctkCmdLineModuleFrontendSnapshot(frontend);
+  job->Proxy.setCanCancel(true);
+  job->Proxy.setQueued(true);
+  job->applyOutputOptions(job->Proxy);
+  job->Proxy.reportStarted();
+  ctkCmdLineModuleFuture future = job->Proxy.future();
+
+  lock.relock();
+  pending.push_back(job);
+  newJobs.push_back(job);
+  QMetaObject::invokeMethod(this, "watchNewJobs", Qt::QueuedConnection);
+  return future;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleScheduler::runBatch(ctkCmdLineModuleBackend* backend,
+                                                           ctkCmdLineModuleFrontend* frontend,
+                                                           const QList<QHash<QString,QVariant> >& overrides,
+                                                           const ctkCmdLineModuleJobOptions& options)
+{
+  int window = 0;
+  {
+    QMutexLocker lock(&mutex);
+    window = capacity_unlocked(backend, options);
+  }
+
+  ctkCmdLineModuleBatch* batch = new ctkCmdLineModuleBatch(this, backend, frontend, overrides, options, window);
+  ctkCmdLineModuleFuture future = batch->future();
+  batch->moveToThread(&thread);
+  QMetaObject::invokeMethod(batch, "start", Qt::QueuedConnection);
+  return future;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::setMaxConcurrentJobs(ctkCmdLineModuleBackend* backend, int maxJobs)
+{
+  {
+    QMutexLocker lock(&mutex);
+    if (maxJobs > 0)
+    {
+      maxJobsPerBackend.insert(backend, maxJobs);
+    }
+    else
+    {
+      maxJobsPerBackend.remove(backend);
+    }
+  }
+  updateCapacities(QList<ctkCmdLineModuleBackend*>() << backend);
+  QMetaObject::invokeMethod(this, "dispatch", Qt::QueuedConnection);
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleScheduler::maxConcurrentJobs(ctkCmdLineModuleBackend* backend) const
+{
+  QMutexLocker lock(&mutex);
+  return maxJobsPerBackend.value(backend, 0);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::setCpuBudget(int cores)
+{
+  {
+    QMutexLocker lock(&mutex);
+    cpuLimit = cores;
+  }
+  updateCapacities();
+  QMetaObject::invokeMethod(this, "dispatch", Qt::QueuedConnection);
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleScheduler::cpuBudget() const
+{
+  QMutexLocker lock(&mutex);
+  return cpuLimit;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::setMemoryBudget(qint64 bytes)
+{
+  {
+    QMutexLocker lock(&mutex);
+    memoryLimit = bytes;
+  }
+  updateCapacities();
+  QMetaObject::invokeMethod(this, "dispatch", Qt::QueuedConnection);
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkCmdLineModuleScheduler::memoryBudget() const
+{
+  QMutexLocker lock(&mutex);
+  return memoryLimit;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::setResultCache(ctkCmdLineModuleResultCache* resultCache)
+{
+  QMutexLocker lock(&mutex);
+  // Runs still using the previous cache keep it alive
+  cache = QSharedPointer<ctkCmdLineModuleResultCache>(resultCache);
+}
+
+//----------------------------------------------------------------------------
+QSharedPointer<ctkCmdLineModuleResultCache> ctkCmdLineModuleScheduler::resultCache() const
+{
+  QMutexLocker lock(&mutex);
+  return cache;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::watchNewJobs()
+{
+  QList<Job*> jobs;
+  {
+    QMutexLocker lock(&mutex);
+    jobs = newJobs;
+    newJobs.clear();
+  }
+
+  foreach(Job* job, jobs)
+  {
+    if (job->Queued)
+    {
+      job->ProxyWatcher = new QFutureWatcher<ctkCmdLineModuleResult>();
+      watchedJobs.insert(job->ProxyWatcher, job);
+      connect(job->ProxyWatcher, SIGNAL(canceled()), SLOT(jobCanceled()));
+      job->ProxyWatcher->setFuture(job->Proxy.future());
+    }
+    else
+    {
+      job->Watcher = new ctkCmdLineModuleFutureWatcher();
+      watchedJobs.insert(job->Watcher, job);
+      connect(job->Watcher, SIGNAL(finished()), SLOT(jobFinished()));
+      job->Watcher->setFuture(job->Future);
+    }
+  }
+
+  this->dispatch();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::dispatch()
+{
+  forever
+  {
+    Job* job = NULL;
+    {
+      QMutexLocker lock(&mutex);
+      job = takeNextJob_unlocked();
+    }
+    if (job == NULL) return;
+    this->start(job);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::jobCanceled()
+{
+  Job* job = this->senderJob();
+  if (job == NULL) return;
+
+  if (job->Started)
+  {
+    job->Future.cancel();
+    return;
+  }
+
+  {
+    QMutexLocker lock(&mutex);
+    pending.removeOne(job);
+  }
+  job->Proxy.setQueued(false);
+  job->Proxy.reportFinished();
+  this->finish(job);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::jobFinished()
+{
+  Job* job = this->senderJob();
+  if (job == NULL) return;
+
+  if (job->Queued)
+  {
+    this->forwardPendingData(job);
+    try
+    {
+      job->Future.waitForFinished();
+    }
+    catch (const QtConcurrent::Exception& e)
+    {
+      job->Proxy.reportException(e);
+    }
+    if (job->Future.isCanceled())
+    {
+      job->Proxy.reportCanceled();
+    }
+    job->Proxy.reportFinished();
+  }
+  this->finish(job);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::forwardProgressRange(int minimum, int maximum)
+{
+  Job* job = this->senderJob();
+  if (job == NULL) return;
+  job->Proxy.setProgressRange(minimum, maximum);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::forwardProgressValue(int value)
+{
+  Job* job = this->senderJob();
+  if (job == NULL) return;
+
+  QString text = job->Future.progressText();
+  if (text != job->Proxy.progressText())
+  {
+    job->Proxy.setProgressValueAndText(value, text);
+  }
+  else
+  {
+    job->Proxy.setProgressValue(value);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::forwardData()
+{
+  Job* job = this->senderJob();
+  if (job == NULL) return;
+  this->forwardPendingData(job);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::forwardPauseState()
+{
+  foreach(Job* job, forwardedJobs)
+  {
+    bool paused = job->Proxy.isPaused();
+    if (paused != job->ProxyPaused)
+    {
+      job->ProxyPaused = paused;
+      job->Future.setPaused(paused);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleScheduler::fitsBudget_unlocked(const Job* job) const
+{
+  // A job exceeding the whole budget still has to run eventually
+  if (runningCount == 0) return true;
+
+  int maxJobs = maxJobsPerBackend.value(job->Backend, 0);
+  if (maxJobs > 0 && runningPerBackend.value(job->Backend, 0) >= maxJobs)
+  {
+    return false;
+  }
+  if (cpuLimit > 0 && cpuInUse + job->Options.cpuCost() > cpuLimit)
+  {
+    return false;
+  }
+  if (memoryLimit > 0 && memoryInUse + job->Options.memoryCost() > memoryLimit)
+  {
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleScheduler::capacity_unlocked(ctkCmdLineModuleBackend* backend,
+                                                 const ctkCmdLineModuleJobOptions& options) const
+{
+  int capacity = 0;
+  int maxJobs = maxJobsPerBackend.value(backend, 0);
+  if (maxJobs > 0)
+  {
+    capacity = maxJobs;
+  }
+  if (cpuLimit > 0 && options.cpuCost() > 0)
+  {
+    int cpuCapacity = cpuLimit / options.cpuCost();
+    capacity = capacity > 0 ? qMin(capacity, cpuCapacity) : cpuCapacity;
+  }
+  if (memoryLimit > 0 && options.memoryCost() > 0)
+  {
+    int memoryCapacity = static_cast<int>(qMin<qint64>(memoryLimit / options.memoryCost(), INT_MAX));
+    capacity = capacity > 0 ? qMin(capacity, memoryCapacity) : memoryCapacity;
+  }
+  if (capacity <= 0)
+  {
+    capacity = QThread::idealThreadCount();
+  }
+  return qMax(1, capacity);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::updateCapacities()
+{
+  QList<ctkCmdLineModuleBackend*> backends;
+  {
+    QMutexLocker lock(&mutex);
+    backends = backendCapacities.keys();
+  }
+  updateCapacities(backends);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::updateCapacities(const QList<ctkCmdLineModuleBackend*>& backends)
+{
+  // The back-ends are called without holding the scheduler mutex. The
+  // capacity mutex keeps concurrent updates from reaching them out of order.
+  QMutexLocker capacityLock(&capacityMutex);
+
+  QList<QPair<ctkCmdLineModuleBackend*, int> > changes;
+  {
+    QMutexLocker lock(&mutex);
+    foreach(ctkCmdLineModuleBackend* backend, backends)
+    {
+      int capacity = capacity_unlocked(backend, ctkCmdLineModuleJobOptions());
+      if (backendCapacities.value(backend, 0) != capacity)
+      {
+        backendCapacities.insert(backend, capacity);
+        changes.push_back(qMakePair(backend, capacity));
+      }
+    }
+  }
+
+  for (int i = 0; i < changes.size(); ++i)
+  {
+    changes[i].first->setMaxConcurrentRuns(changes[i].second);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleScheduler::isBefore_unlocked(const Job* job, const Job* other) const
+{
+  if (job->Options.priority() != other->Options.priority())
+  {
+    return job->Options.priority() > other->Options.priority();
+  }
+
+  int jobShare = runningPerOwner.value(job->Options.owner(), 0);
+  int otherShare = runningPerOwner.value(other->Options.owner(), 0);
+  if (jobShare != otherShare)
+  {
+    return jobShare < otherShare;
+  }
+
+  return job->Sequence < other->Sequence;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::Job* ctkCmdLineModuleScheduler::takeNextJob_unlocked()
+{
+  Job* next = NULL;
+  foreach(Job* job, pending)
+  {
+    // Jobs of a back-end running at its limit do not hold up other back-ends
+    int maxJobs = maxJobsPerBackend.value(job->Backend, 0);
+    if (maxJobs > 0 && runningPerBackend.value(job->Backend, 0) >= maxJobs)
+    {
+      continue;
+    }
+    if (next == NULL || isBefore_unlocked(job, next))
+    {
+      next = job;
+    }
+  }
+
+  // The next job waits for resources instead of being overtaken by
+  // cheaper jobs, which could starve it.
+  if (next == NULL || !fitsBudget_unlocked(next))
+  {
+    return NULL;
+  }
+
+  pending.removeOne(next);
+  reserve_unlocked(next);
+  return next;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::reserve_unlocked(Job* job)
+{
+  ++runningCount;
+  ++runningPerBackend[job->Backend];
+  ++runningPerOwner[job->Options.owner()];
+  cpuInUse += job->Options.cpuCost();
+  memoryInUse += job->Options.memoryCost();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::release_unlocked(Job* job)
+{
+  --runningCount;
+  if (--runningPerBackend[job->Backend] == 0)
+  {
+    runningPerBackend.remove(job->Backend);
+  }
+  if (--runningPerOwner[job->Options.owner()] == 0)
+  {
+    runningPerOwner.remove(job->Options.owner());
+  }
+  cpuInUse -= job->Options.cpuCost();
+  memoryInUse -= job->Options.memoryCost();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::start(Job* job)
+{
+  job->Started = true;
+  job->Proxy.setQueued(false);
+
+  try
+  {
+    job->Future = job->Backend->run(job->Frontend);
+  }
+  catch (const QtConcurrent::Exception& e)
+  {
+    job->Proxy.reportException(e);
+    job->Proxy.reportFinished();
+  }
+  catch (const ctkException& e)
+  {
+    job->Proxy.reportException(ctkCmdLineModuleRunException(job->Frontend->location(), 0, e.message()));
+    job->Proxy.reportFinished();
+  }
+
+  if (job->Proxy.isFinished())
+  {
+    this->finish(job);
+    return;
+  }
+
+  job->Proxy.setCanCancel(job->Future.canCancel());
+  job->Proxy.setCanPause(job->Future.canPause());
+  job->applyOutputOptions(job->Future.d);
+
+  job->Watcher = new ctkCmdLineModuleFutureWatcher();
+  watchedJobs.insert(job->Watcher, job);
+  connect(job->Watcher, SIGNAL(progressRangeChanged(int,int)), SLOT(forwardProgressRange(int,int)));
+  connect(job->Watcher, SIGNAL(progressValueChanged(int)), SLOT(forwardProgressValue(int)));
+  connect(job->Watcher, SIGNAL(resultsReadyAt(int,int)), SLOT(forwardData()));
+  connect(job->Watcher, SIGNAL(outputDataReady()), SLOT(forwardData()));
+  connect(job->Watcher, SIGNAL(errorDataReady()), SLOT(forwardData()));
+  connect(job->Watcher, SIGNAL(finished()), SLOT(jobFinished()));
+  job->Watcher->setFuture(job->Future);
+
+  forwardedJobs.push_back(job);
+  if (!pausePollTimer.isActive())
+  {
+    pausePollTimer.start(100);
+  }
+
+  // The proxy might have been canceled while the job was started
+  if (job->Proxy.isCanceled())
+  {
+    job->Future.cancel();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::finish(Job* job)
+{
+  {
+    QMutexLocker lock(&mutex);
+    // A queued job may be started, and finished, by dispatch() before
+    // watchNewJobs() got to it
+    newJobs.removeOne(job);
+    if (job->Started)
+    {
+      release_unlocked(job);
+    }
+  }
+
+  forwardedJobs.removeOne(job);
+  if (forwardedJobs.isEmpty())
+  {
+    pausePollTimer.stop();
+  }
+
+  // One of the watchers is emitting the signal which brought us here
+  if (job->Watcher)
+  {
+    watchedJobs.remove(job->Watcher);
+    job->Watcher->disconnect(this);
+    job->Watcher->deleteLater();
+    job->Watcher = NULL;
+  }
+  if (job->ProxyWatcher)
+  {
+    watchedJobs.remove(job->ProxyWatcher);
+    job->ProxyWatcher->disconnect(this);
+    job->ProxyWatcher->deleteLater();
+    job->ProxyWatcher = NULL;
+  }
+  delete job;
+
+  this->dispatch();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::forwardPendingData(Job* job)
+{
+  int count = job->Future.resultCount();
+  for (; job->ForwardedResults < count; ++job->ForwardedResults)
+  {
+    job->Proxy.reportResult(job->Future.resultAt(job->ForwardedResults));
+  }
+
+  QByteArray outputData = job->Watcher->readPendingOutputData();
+  if (!outputData.isEmpty())
+  {
+    job->Proxy.reportOutputData(outputData);
+  }
+  QByteArray errorData = job->Watcher->readPendingErrorData();
+  if (!errorData.isEmpty())
+  {
+    job->Proxy.reportErrorData(errorData);
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::Job* ctkCmdLineModuleScheduler::senderJob() const
+{
+  return watchedJobs.value(this->sender());
+}
@@ -0,0 +1,150 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULESCHEDULER_P_H
+#define CTKCMDLINEMODULESCHEDULER_P_H
+
+#include "ctkCmdLineModuleFuture.h"
+#include "ctkCmdLineModuleJobOptions.h"
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QThread>
+#include <QTimer>
+#include <QVariant>
+
+struct ctkCmdLineModuleBackend;
+class ctkCmdLineModuleFrontend;
+class ctkCmdLineModuleResultCache;
+
+/**
+ * \class ctkCmdLineModuleScheduler
+ * \brief Starts module runs within the resource budget of a ctkCmdLineModuleManager.
+ *
+ * Runs which fit into the budget are started immediately in the calling thread
+ * and the future of the back-end is returned as is. All other runs are queued
+ * with a snapshot of the front-end values and a proxy future, which is fed
+ * from the back-end future once the run was started by the scheduler thread.
+ *
+ * Runs found in the result cache, if any, are restored without being
+ * scheduled at all.
+ *
+ * Batches are driven by a ctkCmdLineModuleBatch object in the scheduler
+ * thread, which submits as many items as the budget can run at a time.
+ *
+ * The number of runs a back-end may start concurrently is reported to it
+ * via ctkCmdLineModuleBackend::setMaxConcurrentRuns().
+ */
+class ctkCmdLineModuleScheduler : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  ctkCmdLineModuleScheduler();
+  ~ctkCmdLineModuleScheduler();
+
+  ctkCmdLineModuleFuture run(ctkCmdLineModuleBackend* backend, ctkCmdLineModuleFrontend* frontend,
+                             const ctkCmdLineModuleJobOptions& options);
+
+  ctkCmdLineModuleFuture runBatch(ctkCmdLineModuleBackend* backend, ctkCmdLineModuleFrontend* frontend,
+                                  const QList<QHash<QString,QVariant> >& overrides,
+                                  const ctkCmdLineModuleJobOptions& options);
+
+  void setMaxConcurrentJobs(ctkCmdLineModuleBackend* backend, int maxJobs);
+  int maxConcurrentJobs(ctkCmdLineModuleBackend* backend) const;
+
+  void setCpuBudget(int cores);
+  int cpuBudget() const;
+
+  void setMemoryBudget(qint64 bytes);
+  qint64 memoryBudget() const;
+
+  // takes ownership of the cache, NULL disables caching
+  void setResultCache(ctkCmdLineModuleResultCache* cache);
+  QSharedPointer<ctkCmdLineModuleResultCache> resultCache() const;
+
+private Q_SLOTS:
+
+  void watchNewJobs();
+  void dispatch();
+
+  void jobCanceled();
+  void jobFinished();
+  void forwardProgressRange(int minimum, int maximum);
+  void forwardProgressValue(int value);
+  void forwardData();
+
+  void forwardPauseState();
+
+private:
+
+  struct Job;
+
+  ctkCmdLineModuleFuture schedule(ctkCmdLineModuleBackend* backend, ctkCmdLineModuleFrontend* frontend,
+                                  const ctkCmdLineModuleJobOptions& options);
+
+  bool fitsBudget_unlocked(const Job* job) const;
+  int capacity_unlocked(ctkCmdLineModuleBackend* backend, const ctkCmdLineModuleJobOptions& options) const;
+  void updateCapacities();
+  void updateCapacities(const QList<ctkCmdLineModuleBackend*>& backends);
+  bool isBefore_unlocked(const Job* job, const Job* other) const;
+  Job* takeNextJob_unlocked();
+  void reserve_unlocked(Job* job);
+  void release_unlocked(Job* job);
+
+  void start(Job* job);
+  void finish(Job* job);
+  void forwardPendingData(Job* job);
+  Job* senderJob() const;
+
+  QThread thread;
+
+  mutable QMutex mutex;
+  QList<Job*> pending;
+  QList<Job*> newJobs;
+  qint64 sequence;
+
+  QHash<ctkCmdLineModuleBackend*, int> maxJobsPerBackend;
+  int cpuLimit;
+  qint64 memoryLimit;
+  QSharedPointer<ctkCmdLineModuleResultCache> cache;
+  // the maximum number of concurrent runs last reported to each back-end
+  QHash<ctkCmdLineModuleBackend*, int> backendCapacities;
+  // serializes reporting the capacities to the back-ends
+  QMutex capacityMutex;
+
+  QHash<ctkCmdLineModuleBackend*, int> runningPerBackend;
+  QHash<QString, int> runningPerOwner;
+  int runningCount;
+  int cpuInUse;
+  qint64 memoryInUse;
+
+  // only accessed from the scheduler thread
+  QHash<QObject*, Job*> watchedJobs;
+  QList<Job*> forwardedJobs;
+  QTimer pausePollTimer;
+};
+
+#endif // CTKCMDLINEMODULESCHEDULER_P_H
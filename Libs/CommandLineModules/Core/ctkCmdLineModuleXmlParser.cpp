@@ -127,6 +127,12 @@ void ctkCmdLineModuleXmlParser::handleExecutableElement()
     {
       _md->d->Acknowledgements = _xmlReader.readElementText().trimmed();
     }
+    else if (name.compare("persistent-worker", Qt::CaseInsensitive) == 0)
+    {
+      QString persistentWorker = _xmlReader.readElementText().trimmed();
+      _md->d->PersistentWorker = persistentWorker.compare("true", Qt::CaseInsensitive) == 0 ||
+                                 persistentWorker == "1";
+    }
     else if (name.compare("contributor", Qt::CaseInsensitive) == 0)
     {
       _md->d->Contributor = _xmlReader.readElementText().trimmed();
@@ -27,6 +27,8 @@
 
 #include <QDebug>
 
+#include <algorithm>
+
 namespace {
 
 static QString FILTER_START = "filter-start";
@@ -36,6 +38,35 @@ static QString FILTER_PROGRESS = "filter-progress";
 static QString FILTER_PROGRESS_TEXT = "filter-progress-text";
 static QString FILTER_RESULT = "filter-result";
 static QString FILTER_END = "filter-end";
+static QString WORKER_FINISHED = "worker-finished";
+
+// Tag names longer than this are never filter elements.
+static const int MAX_NAME_SIZE = 32;
+
+// Filter elements which are not closed within this many bytes are passed on as output.
+static const int MAX_ELEMENT_SIZE = 1024 * 1024;
+
+bool isNameEnd(char c)
+{
+  return c == '>' || c == '/' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool isFilterElement(const QByteArray& lowerName)
+{
+  return lowerName == FILTER_START || lowerName == FILTER_PROGRESS ||
+      lowerName == FILTER_PROGRESS_TEXT || lowerName == FILTER_RESULT ||
+      lowerName == FILTER_END || lowerName == WORKER_FINISHED;
+}
+
+int indexOfIgnoreCase(const QByteArray& data, const QByteArray& lowerStr, int from)
+{
+  const int last = data.size() - lowerStr.size();
+  for (int i = from; i <= last; ++i)
+  {
+    if (qstrnicmp(data.constData() + i, lowerStr.constData(), lowerStr.size()) == 0) return i;
+  }
+  return -1;
+}
 
 }
 
@@ -45,31 +76,28 @@ class ctkCmdLineModuleXmlProgressWatcherPrivate
 public:
 
   ctkCmdLineModuleXmlProgressWatcherPrivate(QIODevice* input, ctkCmdLineModuleXmlProgressWatcher* qq)
-    : input(input), process(NULL), readPos(0), q(qq), error(false), currentProgress(0)
+    : input(input), process(NULL), readPos(0), q(qq), error(false),
+      scanPos(0), startTagClosed(false), skipNewline(false), lineNumber(1), currentProgress(0),
+      currentExitCode(0)
   {
-    // wrap the content in an artifical root element
-    reader.addData("<module-root>");
   }
 
   ctkCmdLineModuleXmlProgressWatcherPrivate(QProcess* input, ctkCmdLineModuleXmlProgressWatcher* qq)
-    : input(input), process(input), readPos(0), q(qq), error(false), currentProgress(0)
+    : input(input), process(input), readPos(0), q(qq), error(false),
+      scanPos(0), startTagClosed(false), skipNewline(false), lineNumber(1), currentProgress(0),
+      currentExitCode(0)
   {
-    // wrap the content in an artifical root element
-    reader.addData("<module-root>");
   }
 
   void _q_readyRead()
   {
-    input->seek(readPos);
+    // A QBuffer shares its position between reading and writing
+    if (!input->isSequential()) input->seek(readPos);
 
     QByteArray buffer = input->readAll();
 
-    buffer.prepend("<module-snippet>");
-    buffer.append("</module-snippet>");
-
-    reader.addData(buffer);
-    readPos = input->pos();
-    parseProgressXml();
+    if (!input->isSequential()) readPos = input->pos();
+    addData(buffer);
   }
 
   void _q_readyReadError()
@@ -77,26 +105,150 @@ public:
     emit q->errorDataAvailable(process->readAllStandardError());
   }
 
-  void parseProgressXml()
+  /**
+   * Scans the new data for filter elements. Text outside of filter elements
+   * is reported as output data. Only an incomplete filter element is kept
+   * until more data arrives, and scanning for its end resumes where the
+   * previous scan stopped.
+   */
+  void addData(const QByteArray& data)
   {
-    QXmlStreamReader::TokenType type = reader.readNext();
+    pending.append(data);
+
     QByteArray outputData;
-    while(type != QXmlStreamReader::Invalid)
+    int pos = 0;
+    while (pos < pending.size())
     {
-      switch(type)
-      {
-      case QXmlStreamReader::NoToken: break;
-      case QXmlStreamReader::Characters:
+      if (elementName.isEmpty())
       {
-        if (stack.empty())
+        if (skipNewline)
         {
-          QByteArray output(reader.text().toString().toLatin1());
           // get rid of a possible newline after the last xml end tag
-          if (output.startsWith('\n')) output = output.remove(0,1);
-          outputData.append(output);
+          skipNewline = false;
+          if (pending.at(pos) == '\n')
+          {
+            consume(pos, pos + 1);
+          }
+          continue;
+        }
+
+        int tagStart = pending.indexOf('<', pos);
+        if (tagStart < 0) tagStart = pending.size();
+        outputData.append(pending.constData() + pos, tagStart - pos);
+        consume(pos, tagStart);
+        if (pos == pending.size()) break;
+
+        int nameEnd = pos + 1;
+        while (nameEnd < pending.size() && nameEnd - pos <= MAX_NAME_SIZE && !isNameEnd(pending.at(nameEnd)))
+        {
+          ++nameEnd;
+        }
+        if (nameEnd == pending.size() && nameEnd - pos <= MAX_NAME_SIZE)
+        {
+          // wait for the rest of the tag name
           break;
         }
 
+        QByteArray name = pending.mid(pos + 1, nameEnd - pos - 1).toLower();
+        if (!isFilterElement(name))
+        {
+          outputData.append('<');
+          consume(pos, pos + 1);
+          continue;
+        }
+        elementName = name;
+        scanPos = nameEnd;
+        startTagClosed = false;
+      }
+
+      int elementEnd = findElementEnd();
+      if (elementEnd < 0)
+      {
+        if (pending.size() - pos > MAX_ELEMENT_SIZE)
+        {
+          xmlError(QString("\"%1\" is not closed within %2 bytes, starting at line %3.")
+                   .arg(QString(elementName)).arg(MAX_ELEMENT_SIZE).arg(lineNumber));
+          outputData.append(pending.constData() + pos, pending.size() - pos);
+          consume(pos, pending.size());
+          elementName.clear();
+        }
+        break;
+      }
+
+      // keep the order of output data and filter signals
+      if (!outputData.isEmpty())
+      {
+        emit q->outputDataAvailable(outputData);
+        outputData.clear();
+      }
+
+      parseElement(pending.mid(pos, elementEnd - pos));
+      consume(pos, elementEnd);
+      elementName.clear();
+      skipNewline = true;
+    }
+
+    pending.remove(0, pos);
+    scanPos -= pos;
+
+    if (!outputData.isEmpty())
+    {
+      emit q->outputDataAvailable(outputData);
+    }
+  }
+
+  /**
+   * Returns the end of the filter element starting at the beginning of the
+   * pending data, or -1 if the element is not complete yet.
+   */
+  int findElementEnd()
+  {
+    if (!startTagClosed)
+    {
+      int tagEnd = pending.indexOf('>', scanPos);
+      if (tagEnd < 0)
+      {
+        scanPos = pending.size();
+        return -1;
+      }
+      if (pending.at(tagEnd - 1) == '/')
+      {
+        return tagEnd + 1;
+      }
+      startTagClosed = true;
+      scanPos = tagEnd + 1;
+    }
+
+    QByteArray endTag = "</" + elementName;
+    int endTagStart = indexOfIgnoreCase(pending, endTag, scanPos);
+    if (endTagStart < 0)
+    {
+      // the end tag may have been split
+      scanPos = qMax(scanPos, pending.size() - endTag.size() + 1);
+      return -1;
+    }
+    scanPos = endTagStart;
+    int endTagEnd = pending.indexOf('>', endTagStart + endTag.size());
+    return endTagEnd < 0 ? -1 : endTagEnd + 1;
+  }
+
+  void consume(int& pos, int to)
+  {
+    lineNumber += std::count(pending.constData() + pos, pending.constData() + to, '\n');
+    pos = to;
+  }
+
+  void parseElement(const QByteArray& element)
+  {
+    QXmlStreamReader reader(element);
+    QList<QString> stack;
+
+    while (!reader.atEnd())
+    {
+      switch(reader.readNext())
+      {
+      case QXmlStreamReader::Characters:
+      {
         if (stack.size() == 2 &&
             (stack.front() == FILTER_START || stack.front() == FILTER_END))
         {
@@ -126,26 +278,11 @@ public:
       case QXmlStreamReader::StartElement:
       {
         QStringRef name = reader.name();
-        QString parent;
-        if (!stack.empty()) parent = stack.back();
+        bool nested = !stack.empty();
+        stack.push_back(name.toString().toLower());
 
-        if (name.compare("module-root") != 0 && name.compare("module-snippet") != 0)
+        if (!nested)
         {
-          stack.push_back(name.toString());
-        }
-
-        if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_PROGRESS, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_PROGRESS_TEXT, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_RESULT, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_END, Qt::CaseInsensitive) == 0)
-        {
-          if (!parent.isEmpty())
-          {
-            unexpectedNestedElement(name.toString());
-            break;
-          }
-
           if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0)
           {
             currentName = QString();
@@ -161,81 +298,73 @@ public:
             currentResultParameter = reader.attributes().value("name").toString();
             currentResultValue.clear();
           }
+          else if (name.compare(WORKER_FINISHED, Qt::CaseInsensitive) == 0)
+          {
+            currentExitCode = reader.attributes().value("exit-code").toString().toInt();
+          }
+        }
+        else if (isFilterElement(name.toString().toLower().toLatin1()))
+        {
+          xmlError(QString("\"%1\" must be a top-level element, found at line %2.")
+                   .arg(name.toString()).arg(lineNumber + reader.lineNumber() - 1));
         }
         break;
       }
       case QXmlStreamReader::EndElement:
       {
-        QStringRef name = reader.name();
+        if (!stack.empty()) stack.pop_back();
+        if (!stack.empty()) break;
 
-        QString curr;
-        QString parent;
-        if (!stack.empty())
+        QStringRef name = reader.name();
+        if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0)
         {
-          curr = stack.back();
-          stack.pop_back();
-          if (!stack.empty()) parent = stack.back();
+          emit q->filterStarted(currentName, currentComment);
+          currentComment = QString();
         }
-
-        if (parent.isEmpty() && name.compare("module-snippet") != 0)
+        else if (name.compare(FILTER_PROGRESS, Qt::CaseInsensitive) == 0)
         {
-          if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0)
-          {
-            emit q->filterStarted(currentName, currentComment);
-            currentComment = QString();
-          }
-          else if (name.compare(FILTER_PROGRESS, Qt::CaseInsensitive) == 0)
-          {
-            emit q->filterProgress(currentProgress, QString());
-          }
-          else if (name.compare(FILTER_PROGRESS_TEXT, Qt::CaseInsensitive) == 0)
-          {
-            emit q->filterProgress(currentProgress, currentComment);
-            currentComment = QString();
-          }
-          else if (name.compare(FILTER_RESULT, Qt::CaseInsensitive) == 0)
-          {
-            emit q->filterResult(currentResultParameter, currentResultValue);
-          }
-          else if (name.compare(FILTER_END, Qt::CaseInsensitive) == 0)
-          {
-            emit q->filterFinished(currentName, currentComment);
-            currentName = QString();
-            currentComment = QString();
-          }
+          emit q->filterProgress(currentProgress, QString());
+        }
+        else if (name.compare(FILTER_PROGRESS_TEXT, Qt::CaseInsensitive) == 0)
+        {
+          emit q->filterProgress(currentProgress, currentComment);
+          currentComment = QString();
+        }
+        else if (name.compare(FILTER_RESULT, Qt::CaseInsensitive) == 0)
+        {
+          emit q->filterResult(currentResultParameter, currentResultValue);
+        }
+        else if (name.compare(FILTER_END, Qt::CaseInsensitive) == 0)
+        {
+          emit q->filterFinished(currentName, currentComment);
+          currentName = QString();
+          currentComment = QString();
+        }
+        else if (name.compare(WORKER_FINISHED, Qt::CaseInsensitive) == 0)
+        {
+          emit q->workerFinished(currentExitCode);
         }
         break;
       }
       default:
         break;
       }
-
-      if (!outputData.isEmpty())
-      {
-        emit q->outputDataAvailable(outputData);
-        outputData.clear();
-      }
-      type = reader.readNext();
     }
 
-    if (type == QXmlStreamReader::Invalid && reader.error() != QXmlStreamReader::PrematureEndOfDocumentError)
+    if (reader.hasError())
     {
-      if (!error)
-      {
-        error = true;
-        emit q->filterXmlError(QString("Error parsing XML at line %1, column %2: ")
-                               .arg(reader.lineNumber()).arg(reader.columnNumber()) + reader.errorString());
-      }
+      xmlError(QString("Error parsing XML at line %1, column %2: ")
+               .arg(lineNumber + reader.lineNumber() - 1).arg(reader.columnNumber()) + reader.errorString());
     }
   }
 
-  void unexpectedNestedElement(const QString& element)
+  void xmlError(const QString& message)
   {
+    // only report the first error
     if (!error)
     {
       error = true;
-      emit q->filterXmlError(QString("\"%1\" must be a top-level element, found at line %2.")
-                             .arg(element).arg(reader.lineNumber()));
+      emit q->filterXmlError(message);
     }
   }
 
@@ -244,13 +373,20 @@ public:
   qint64 readPos;
   ctkCmdLineModuleXmlProgressWatcher* q;
   bool error;
-  QXmlStreamReader reader;
-  QList<QString> stack;
+
+  QByteArray pending;
+  QByteArray elementName;
+  int scanPos;
+  bool startTagClosed;
+  bool skipNewline;
+  int lineNumber;
+
   QString currentName;
   QString currentComment;
   float currentProgress;
   QString currentResultParameter;
   QString currentResultValue;
+  int currentExitCode;
 };
 
 
@@ -58,6 +58,12 @@ Q_SIGNALS:
   void filterFinished(const QString& name, const QString& comment);
   void filterXmlError(const QString& error);
 
+  /**
+   * Emitted when a module running as a persistent worker reports the end of
+   * a run with a \code <worker-finished exit-code="0"/> \endcode element.
+   */
+  void workerFinished(int exitCode);
+
   void outputDataAvailable(const QByteArray& outputData);
   void errorDataAvailable(const QByteArray& errorData);
 
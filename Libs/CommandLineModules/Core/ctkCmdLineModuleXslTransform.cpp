@@ -21,8 +21,10 @@
 
 // Qt includes
 #include <QBuffer>
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QFile>
+#include <QMap>
 #include <QXmlQuery>
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
@@ -50,6 +52,8 @@ public:
 
   bool validateOutput();
 
+  static QByteArray readAll(QIODevice* device);
+
   bool Validate;
   bool Format;
 
@@ -59,6 +63,7 @@ public:
 
   QXmlQuery XslTransform;
   QList<QIODevice*> ExtraTransformations;
+  QMap<QString, QVariant> Variables;
   ctkCmdLineModuleXmlMsgHandler MsgHandler;
 
   QString ErrorStr;
@@ -110,6 +115,20 @@ bool ctkCmdLineModuleXslTransformPrivate::validateOutput()
   return true;
 }
 
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleXslTransformPrivate::readAll(QIODevice* device)
+{
+  // Read from the start, the device may already have been read before
+  if (!device->isOpen())
+  {
+    device->open(QIODevice::ReadOnly);
+  }
+  device->reset();
+  QByteArray content = device->readAll();
+  device->reset();
+  return content;
+}
+
 //----------------------------------------------------------------------------
 ctkCmdLineModuleXslTransform::ctkCmdLineModuleXslTransform(QIODevice *input, QIODevice *output)
   : ctkCmdLineModuleXmlValidator(input)
@@ -188,13 +207,11 @@ bool ctkCmdLineModuleXslTransform::transform()
     return false;
   }
 
-  d->Transformation->open(QIODevice::ReadOnly);
-  QString query(d->Transformation->readAll());
+  QString query(ctkCmdLineModuleXslTransformPrivate::readAll(d->Transformation));
   QString extra;
   foreach(QIODevice* extraIODevice, d->ExtraTransformations)
   {
-    extraIODevice->open(QIODevice::ReadOnly);
-    extra += extraIODevice->readAll();
+    extra += ctkCmdLineModuleXslTransformPrivate::readAll(extraIODevice);
   }
   query.replace("<!-- EXTRA TRANSFORMATIONS -->", extra);
 #if 0
@@ -257,6 +274,29 @@ void ctkCmdLineModuleXslTransform::setXslTransformation(QIODevice *transformatio
 void ctkCmdLineModuleXslTransform::bindVariable(const QString& name, const QVariant& value)
 {
   d->XslTransform.bindVariable(name, value);
+  d->Variables[name] = value;
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleXslTransform::transformationHash() const
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  if (d->Transformation)
+  {
+    hash.addData(ctkCmdLineModuleXslTransformPrivate::readAll(d->Transformation));
+  }
+  foreach(QIODevice* extraIODevice, d->ExtraTransformations)
+  {
+    hash.addData(ctkCmdLineModuleXslTransformPrivate::readAll(extraIODevice));
+  }
+  QMapIterator<QString, QVariant> iter(d->Variables);
+  while (iter.hasNext())
+  {
+    iter.next();
+    hash.addData(iter.key().toUtf8() + '=' + iter.value().toString().toUtf8() + '\n');
+  }
+  hash.addData(QByteArray::number((d->Format ? 1 : 0) + (d->Validate ? 2 : 0)));
+  return hash.result();
 }
 
 //----------------------------------------------------------------------------
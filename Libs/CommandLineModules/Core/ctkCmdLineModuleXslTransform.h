@@ -129,6 +129,18 @@ public:
    */
   void bindVariable(const QString& name, const QVariant& value);
 
+  /**
+   * @brief Returns a hash of the XSL transformation and its settings.
+   *
+   * The hash covers the XSL transformation, the extra transformations, the
+   * bound variables and the output settings. Transforming the same input with
+   * transformations of equal hash gives the same output, so the hash can be
+   * used to key cached transformation results.
+   *
+   * @return The SHA-1 hash of the transformation.
+   */
+  QByteArray transformationHash() const;
+
   /**
    * @brief Sets the output validation mode.
    * @param validate If \c true, the output will be validated against the XML schema
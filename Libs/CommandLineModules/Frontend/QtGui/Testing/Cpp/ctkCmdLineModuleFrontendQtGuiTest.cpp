@@ -22,6 +22,8 @@
 // Qt includes
 #include <QSpinBox>
 #include <QComboBox>
+#include <QDir>
+#include <QTime>
 #include <QVariant>
 
 #if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
@@ -37,6 +39,7 @@ Q_DECLARE_METATYPE(QVariant)
 #include "ctkCmdLineModuleParameter.h"
 
 #include "ctkTest.h"
+#include "ctkUtils.h"
 
 #if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
 extern int qHash(const QUrl& url);
@@ -105,6 +108,8 @@ private Q_SLOTS:
   void testValueSetterAndGetter();
   void testValueSetterAndGetter_data();
 
+  void testUiCache();
+
 };
 
 // ----------------------------------------------------------------------------
@@ -238,6 +243,38 @@ void ctkCmdLineModuleFrontendQtGuiTester::testValueSetterAndGetter_data()
 }
 
 
+// ----------------------------------------------------------------------------
+void ctkCmdLineModuleFrontendQtGuiTester::testUiCache()
+{
+  QString cachePath = QDir::tempPath() + "/ctkCmdLineModuleFrontendQtGuiTest-UiCache";
+  ctk::removeDirRecursively(cachePath);
+  ctkCmdLineModuleFrontendQtGui::setUiCacheDirectory(cachePath);
+  // drop the .ui documents generated by previous tests
+  ctkCmdLineModuleFrontendQtGui::clearUiCache();
+
+  QTime time;
+  time.start();
+  QScopedPointer<ctkCmdLineModuleFrontend> frontend1(new ctkCmdLineModuleFrontendQtGui(this->ModuleRef));
+  QVERIFY(frontend1->guiHandle());
+  int uncachedTime = time.elapsed();
+  QCOMPARE(QDir(cachePath).entryList(QStringList("*.ui"), QDir::Files).size(), 1);
+
+  time.restart();
+  QScopedPointer<ctkCmdLineModuleFrontend> frontend2(new ctkCmdLineModuleFrontendQtGui(this->ModuleRef));
+  QVERIFY(frontend2->guiHandle());
+  int cachedTime = time.elapsed();
+  qDebug() << "Creating the GUI took" << uncachedTime << "ms, with a cached .ui document" << cachedTime << "ms";
+
+  QCOMPARE(frontend2->parameterNames(), frontend1->parameterNames());
+  QCOMPARE(frontend2->value("intParam"), QVariant(1));
+
+  ctkCmdLineModuleFrontendQtGui::clearUiCache();
+  QVERIFY(QDir(cachePath).entryList(QStringList("*.ui"), QDir::Files).isEmpty());
+
+  ctkCmdLineModuleFrontendQtGui::setUiCacheDirectory(QString());
+  ctk::removeDirRecursively(cachePath);
+}
+
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(ctkCmdLineModuleFrontendQtGuiTest)
 #include "moc_ctkCmdLineModuleFrontendQtGuiTest.cpp"
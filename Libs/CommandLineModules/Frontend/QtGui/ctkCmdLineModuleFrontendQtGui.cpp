@@ -24,9 +24,11 @@
 #include "ctkCmdLineModuleReference.h"
 #include "ctkCmdLineModuleXslTransform.h"
 #include "ctkCmdLineModuleObjectTreeWalker_p.h"
+#include "ctkCmdLineModuleQtUiCache_p.h"
 #include "ctkCmdLineModuleQtUiLoader.h"
 
 #include <QBuffer>
+#include <QCryptographicHash>
 #include <QFile>
 #include <QUiLoader>
 #include <QWidget>
@@ -127,23 +129,42 @@ QObject* ctkCmdLineModuleFrontendQtGui::guiHandle() const
 {
   if (d->Widget) return d->Widget;
 
-  QBuffer input;
-  input.setData(moduleReference().rawXmlDescription());
-
-  QBuffer uiForm;
-  uiForm.open(QIODevice::ReadWrite);
-
+  ctkCmdLineModuleReference moduleRef = moduleReference();
   ctkCmdLineModuleXslTransform* xslTransform = this->xslTransform();
-  xslTransform->setInput(&input);
-  xslTransform->setOutput(&uiForm);
 
-  if (!xslTransform->transform())
+  // The .ui document only depends on the XML description and the transformation
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(moduleRef.rawXmlDescription());
+  hash.addData(xslTransform->transformationHash());
+  QByteArray key = hash.result();
+
+  ctkCmdLineModuleQtUiCache* uiCache = ctkCmdLineModuleQtUiCache::instance();
+  QByteArray ui = uiCache->ui(moduleRef.location(), key);
+  if (ui.isEmpty())
   {
-    // maybe throw an exception
-    qCritical() << xslTransform->errorString();
-    return 0;
+    QBuffer input;
+    input.setData(moduleRef.rawXmlDescription());
+
+    QBuffer output;
+    output.open(QIODevice::ReadWrite);
+
+    xslTransform->setInput(&input);
+    xslTransform->setOutput(&output);
+
+    if (!xslTransform->transform())
+    {
+      // maybe throw an exception
+      qCritical() << xslTransform->errorString();
+      return 0;
+    }
+
+    ui = output.data();
+    uiCache->cacheUi(moduleRef.location(), key, ui);
   }
 
+  QBuffer uiForm(&ui);
+  uiForm.open(QIODevice::ReadOnly);
+
   QUiLoader* uiLoader = this->uiLoader();
 #ifdef CMAKE_INTDIR
   QString appPath = QCoreApplication::applicationDirPath();
@@ -220,3 +241,24 @@ void ctkCmdLineModuleFrontendQtGui::setParameterContainerEnabled(const bool& ena
     walker.setValue(value, "enabled");
   }
 }
+
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFrontendQtGui::setUiCacheDirectory(const QString& cacheDir)
+{
+  ctkCmdLineModuleQtUiCache::instance()->setCacheDirectory(cacheDir);
+}
+
+
+//-----------------------------------------------------------------------------
+QString ctkCmdLineModuleFrontendQtGui::uiCacheDirectory()
+{
+  return ctkCmdLineModuleQtUiCache::instance()->cacheDirectory();
+}
+
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFrontendQtGui::clearUiCache()
+{
+  ctkCmdLineModuleQtUiCache::instance()->clear();
+}
@@ -54,6 +54,8 @@ struct ctkCmdLineModuleFrontendQtGuiPrivate;
  * <li>Advanced: Override fragments of the XML stylesheet using ctkCmdLineModuleXslTranform::setXslExtraTransformation()</li>
  * </ul>
  *
+ * The generated .ui file is cached, see setUiCacheDirectory().
+ *
  * All widget classes are assumed to expose a readable and writable QObject property for storing and
  * retrieving current front-end values via the DisplayRole role.
  *
@@ -177,6 +179,30 @@ public:
    */
   virtual void setParameterContainerEnabled(const bool& enabled);
 
+  /**
+   * @brief Set the directory for storing the generated .ui documents.
+   * @param cacheDir The cache directory, or an empty string to keep the
+   *        documents in memory only (the default).
+   *
+   * The .ui document generated for a module is cached and re-used by all
+   * front-ends for the same module reference, as long as its XML description
+   * and the XSL transformation do not change. If a cache directory is set,
+   * the documents are also re-used by later processes. The directory can be
+   * the cache directory of the ctkCmdLineModuleManager.
+   */
+  static void setUiCacheDirectory(const QString& cacheDir);
+
+  /**
+   * @brief Get the directory for storing the generated .ui documents.
+   * @return The cache directory or an empty string.
+   */
+  static QString uiCacheDirectory();
+
+  /**
+   * @brief Remove all cached .ui documents.
+   */
+  static void clearUiCache();
+
 protected:
 
   /**
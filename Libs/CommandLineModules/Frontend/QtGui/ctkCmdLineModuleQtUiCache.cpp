@@ -0,0 +1,145 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkCmdLineModuleQtUiCache_p.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+
+namespace {
+
+const quint32 MAGIC = 0x434d5549; // "CMUI"
+const qint32 VERSION = 1;
+
+}
+
+Q_GLOBAL_STATIC(ctkCmdLineModuleQtUiCache, globalUiCache)
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleQtUiCache* ctkCmdLineModuleQtUiCache::instance()
+{
+  return globalUiCache();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleQtUiCache::setCacheDirectory(const QString& cacheDir)
+{
+  QMutexLocker lock(&this->Mutex);
+  if (!cacheDir.isEmpty())
+  {
+    QDir().mkpath(cacheDir);
+  }
+  this->CacheDir = cacheDir;
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleQtUiCache::cacheDirectory() const
+{
+  QMutexLocker lock(&this->Mutex);
+  return this->CacheDir;
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleQtUiCache::ui(const QUrl& moduleLocation, const QByteArray& key)
+{
+  QMutexLocker lock(&this->Mutex);
+
+  QHash<QUrl, Entry>::const_iterator iter = this->Entries.find(moduleLocation);
+  if (iter != this->Entries.end())
+  {
+    return iter.value().Key == key ? iter.value().Ui : QByteArray();
+  }
+
+  if (this->CacheDir.isEmpty()) return QByteArray();
+
+  QFile file(this->cacheFile_unlocked(moduleLocation));
+  if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_4_6);
+  quint32 magic = 0;
+  qint32 version = 0;
+  QUrl location;
+  Entry entry;
+  in >> magic >> version;
+  if (magic != MAGIC || version != VERSION) return QByteArray();
+  in >> location >> entry.Key >> entry.Ui;
+  if (in.status() != QDataStream::Ok || location != moduleLocation) return QByteArray();
+
+  this->Entries.insert(moduleLocation, entry);
+  return entry.Key == key ? entry.Ui : QByteArray();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleQtUiCache::cacheUi(const QUrl& moduleLocation, const QByteArray& key, const QByteArray& ui)
+{
+  QMutexLocker lock(&this->Mutex);
+
+  Entry entry;
+  entry.Key = key;
+  entry.Ui = ui;
+  this->Entries.insert(moduleLocation, entry);
+
+  if (this->CacheDir.isEmpty()) return;
+
+  // Write to a temporary file first, so that other processes never read
+  // a partially written entry.
+  QString fileName = this->cacheFile_unlocked(moduleLocation);
+  QFile file(fileName + ".tmp");
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return;
+  {
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << MAGIC << VERSION << moduleLocation << key << ui;
+  }
+  file.close();
+  QFile::remove(fileName);
+  if (!file.rename(fileName))
+  {
+    file.remove();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleQtUiCache::clear()
+{
+  QMutexLocker lock(&this->Mutex);
+  this->Entries.clear();
+
+  if (this->CacheDir.isEmpty()) return;
+
+  QDir cacheDir(this->CacheDir);
+  foreach(const QString& fileName, cacheDir.entryList(QStringList("*.ui"), QDir::Files))
+  {
+    cacheDir.remove(fileName);
+  }
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleQtUiCache::cacheFile_unlocked(const QUrl& moduleLocation) const
+{
+  QByteArray hash = QCryptographicHash::hash(moduleLocation.toString().toUtf8(), QCryptographicHash::Sha1);
+  return this->CacheDir + "/" + QString::fromLatin1(hash.toHex()) + ".ui";
+}
@@ -0,0 +1,85 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKCMDLINEMODULEQTUICACHE_P_H
+#define CTKCMDLINEMODULEQTUICACHE_P_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QUrl>
+
+#if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
+extern int qHash(const QUrl& url);
+#endif
+
+/**
+ * \class ctkCmdLineModuleQtUiCache
+ * \brief Non-exported process wide cache of the Qt .ui documents generated
+ * from module XML descriptions.
+ * \ingroup CommandLineModulesFrontendQtGui
+ *
+ * There is one entry per module location. An entry holds the .ui document
+ * together with a key identifying the XML description and the XSL
+ * transformation it was generated from. If a cache directory is set, entries
+ * are also stored in a file per module location and are available to later
+ * processes.
+ */
+class ctkCmdLineModuleQtUiCache
+{
+
+public:
+
+  static ctkCmdLineModuleQtUiCache* instance();
+
+  void setCacheDirectory(const QString& cacheDir);
+  QString cacheDirectory() const;
+
+  /**
+   * @brief Get the cached .ui document of a module.
+   * @param moduleLocation The module location.
+   * @param key The key of the XML description and XSL transformation.
+   * @return The .ui document or an empty byte array if there is no entry for
+   *         the location or if the entry was created with a different key.
+   */
+  QByteArray ui(const QUrl& moduleLocation, const QByteArray& key);
+
+  void cacheUi(const QUrl& moduleLocation, const QByteArray& key, const QByteArray& ui);
+
+  void clear();
+
+private:
+
+  struct Entry
+  {
+    QByteArray Key;
+    QByteArray Ui;
+  };
+
+  QString cacheFile_unlocked(const QUrl& moduleLocation) const;
+
+  mutable QMutex Mutex;
+  QString CacheDir;
+  QHash<QUrl, Entry> Entries;
+};
+
+#endif // CTKCMDLINEMODULEQTUICACHE_P_H
@@ -28,6 +28,7 @@
 #include <ctkCmdLineModuleRunException.h>
 #include <ctkCmdLineModuleFuture.h>
 #include <ctkCmdLineModuleFutureWatcher.h>
+#include <ctkCmdLineModuleJobOptions.h>
 
 #include "ctkCmdLineModuleSignalTester.h"
 
@@ -38,8 +39,32 @@
 #include <QVariant>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
 #include <QFutureWatcher>
+#include <QThreadPool>
+#include <QTime>
 
+namespace {
+
+QString resultValue(const ctkCmdLineModuleFuture& future, const QString& parameter)
+{
+  foreach(const ctkCmdLineModuleResult& result, future.results())
+  {
+    if (result.parameter() == parameter) return result.value().toString();
+  }
+  return QString();
+}
+
+// Ids of the worker processes which exited after their standard input was closed
+QStringList exitedWorkers(const QString& logFileName)
+{
+  QFile logFile(logFileName);
+  if (!logFile.open(QIODevice::ReadOnly | QIODevice::Text)) return QStringList();
+  return QString::fromLatin1(logFile.readAll()).split('\n', QString::SkipEmptyParts);
+}
+
+}
 
 //-----------------------------------------------------------------------------
 class ctkCmdLineModuleFrontendMockupFactory : public ctkCmdLineModuleFrontendFactory
@@ -104,6 +129,16 @@ private Q_SLOTS:
   void testPauseAndCancel();
   void testOutput();
   void testError();
+  void testConcurrentModules();
+  void testQueuedModules();
+  void testBatch();
+  void testResultCache();
+  void testOutputBufferAndProgressInterval();
+  void testWorkerReuse();
+  void testWorkerExitCode();
+  void testWorkerExitDuringRun();
+  void testWorkerCancel();
+  void testWorkerIdleTrimming();
 
 private:
 
@@ -119,6 +154,10 @@ private:
 
   ctkCmdLineModuleReference moduleRef;
   ctkCmdLineModuleFrontend* frontend;
+
+  ctkCmdLineModuleReference workerRef;
+  ctkCmdLineModuleFrontend* workerFrontend;
+  QString workerLogFileName;
 };
 
 //-----------------------------------------------------------------------------
@@ -146,6 +185,15 @@ void ctkCmdLineModuleFutureTester::initTestCase()
 
   QUrl moduleUrl = QUrl::fromLocalFile(QCoreApplication::applicationDirPath() + "/ctkCmdLineModuleTestBed");
   moduleRef = manager.registerModule(moduleUrl);
+
+  // The worker processes inherit the environment and log their id when they exit
+  workerLogFileName = QDir::tempPath() + "/ctkCmdLineModuleFutureTestWorkers.log";
+  QFile::remove(workerLogFileName);
+  qputenv("CTK_CMDLINEMODULE_WORKER_LOG", QFile::encodeName(workerLogFileName));
+
+  QUrl workerUrl = QUrl::fromLocalFile(QCoreApplication::applicationDirPath() + "/ctkCmdLineModuleWorker");
+  workerRef = manager.registerModule(workerUrl);
+  QVERIFY(workerRef.description().persistentWorker());
 }
 
 //-----------------------------------------------------------------------------
@@ -153,12 +201,14 @@ void ctkCmdLineModuleFutureTester::init()
 {
   currentWatcher = 0;
   frontend = factory.create(moduleRef);
+  workerFrontend = factory.create(workerRef);
 }
 
 //-----------------------------------------------------------------------------
 void ctkCmdLineModuleFutureTester::cleanup()
 {
   delete frontend;
+  delete workerFrontend;
   outputData.clear();
   errorData.clear();
 }
@@ -474,6 +524,392 @@ void ctkCmdLineModuleFutureTester::testError()
   }
 }
 
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testConcurrentModules()
+{
+  const int moduleCount = 300;
+
+  QList<ctkCmdLineModuleFrontend*> frontends;
+  QList<ctkCmdLineModuleFuture> futures;
+  for (int i = 0; i < moduleCount; ++i)
+  {
+    ctkCmdLineModuleFrontend* moduleFrontend = factory.create(moduleRef);
+    moduleFrontend->setValue("runtimeVar", 0);
+    frontends.push_back(moduleFrontend);
+    futures.push_back(manager.run(moduleFrontend));
+  }
+
+  // The running modules must not occupy threads of the global thread pool
+  QCOMPARE(QThreadPool::globalInstance()->activeThreadCount(), 0);
+
+  foreach(ctkCmdLineModuleFuture future, futures)
+  {
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QVERIFY(!future.isCanceled());
+
+    QList<ctkCmdLineModuleResult> results = future.results();
+    QVERIFY(!results.isEmpty());
+    QCOMPARE(results.back(), ctkCmdLineModuleResult("exitStatusOutput", "Normal exit"));
+  }
+
+  qDeleteAll(frontends);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testQueuedModules()
+{
+  const int cpuBudget = manager.cpuBudget();
+  manager.setCpuBudget(1);
+
+  QList<ctkCmdLineModuleFrontend*> frontends;
+  for (int i = 0; i < 4; ++i)
+  {
+    frontends.push_back(factory.create(moduleRef));
+    frontends.back()->setValue("runtimeVar", 0);
+  }
+
+  ctkCmdLineModuleJobOptions highPriority;
+  highPriority.setPriority(10);
+
+  ctkCmdLineModuleFuture running = manager.run(frontends[0]);
+  ctkCmdLineModuleFuture queued = manager.run(frontends[1]);
+  ctkCmdLineModuleFuture canceled = manager.run(frontends[2]);
+  ctkCmdLineModuleFuture preferred = manager.run(frontends[3], highPriority);
+
+  QVERIFY(!running.isQueued());
+  QVERIFY(queued.isQueued());
+  QVERIFY(queued.isRunning());
+  QVERIFY(canceled.isQueued());
+  QVERIFY(preferred.isQueued());
+
+  // a queued module can be canceled before it is started
+  canceled.cancel();
+  canceled.waitForFinished();
+  QVERIFY(canceled.isCanceled());
+  QVERIFY(canceled.results().isEmpty());
+
+  // the module with the higher priority is started next
+  running.waitForFinished();
+  QTime timeout = QTime::currentTime().addSecs(5);
+  while (preferred.isQueued() && QTime::currentTime() < timeout)
+  {
+    QTest::qWait(10);
+  }
+  QVERIFY(!preferred.isQueued());
+  QVERIFY(queued.isQueued());
+
+  // results and output data of queued modules are reported through their future
+  preferred.waitForFinished();
+  queued.waitForFinished();
+  QVERIFY(!queued.isQueued());
+  QVERIFY(!queued.isCanceled());
+  QCOMPARE(queued.progressValue(), 1002);
+  QCOMPARE(queued.results().back(), ctkCmdLineModuleResult("exitStatusOutput", "Normal exit"));
+  QCOMPARE(queued.readAllErrorData().data(), "A superficial error message.\n");
+
+  qDeleteAll(frontends);
+  manager.setCpuBudget(cpuBudget);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testBatch()
+{
+  const int itemCount = 10;
+  const int cpuBudget = manager.cpuBudget();
+  manager.setCpuBudget(2);
+
+  frontend->setValue("runtimeVar", 0);
+
+  QList<QHash<QString,QVariant> > overrides;
+  for (int i = 0; i < itemCount; ++i)
+  {
+    QHash<QString,QVariant> values;
+    values.insert("errorTextVar", QString("Item %1").arg(i));
+    if (i == 3)
+    {
+      values.insert("exitCodeVar", 24);
+    }
+    overrides.push_back(values);
+  }
+
+  ctkCmdLineModuleFuture future = manager.runBatch(frontend, overrides);
+  future.waitForFinished();
+
+  QVERIFY(!future.isCanceled());
+  QCOMPARE(future.progressValue(), itemCount);
+  QCOMPARE(future.resultCount(), itemCount);
+  for (int i = 0; i < itemCount; ++i)
+  {
+    ctkCmdLineModuleResult result = future.resultAt(i);
+    QCOMPARE(result.parameter(), QString::number(i));
+    QVariantHash outputs = result.value().toHash();
+    if (i == 3)
+    {
+      QVERIFY(outputs.contains("#error"));
+    }
+    else
+    {
+      QVERIFY(!outputs.contains("#error"));
+      QCOMPARE(outputs.value("errorMsgOutput").toString(), QString("Item %1").arg(i));
+      QCOMPARE(outputs.value("exitStatusOutput").toString(), QString("Normal exit"));
+    }
+  }
+
+  // canceling a batch cancels its runs and does not start any more runs
+  QList<QHash<QString,QVariant> > longOverrides;
+  for (int i = 0; i < itemCount; ++i)
+  {
+    QHash<QString,QVariant> values;
+    values.insert("runtimeVar", 60);
+    longOverrides.push_back(values);
+  }
+  ctkCmdLineModuleFuture canceled = manager.runBatch(frontend, longOverrides);
+  QTest::qWait(200);
+  canceled.cancel();
+  canceled.waitForFinished();
+  QVERIFY(canceled.isCanceled());
+  QVERIFY(canceled.progressValue() < itemCount);
+
+  manager.setCpuBudget(cpuBudget);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testResultCache()
+{
+  const QString cacheDir = QDir::tempPath() + "/ctkCmdLineModuleFutureTestResultCache";
+  manager.setResultCache(cacheDir, 0);
+  manager.clearResultCache();
+  QCOMPARE(manager.resultCacheDirectory(), cacheDir);
+
+  frontend->setValue("runtimeVar", 0);
+  frontend->setValue("imageOutput", "output1");
+  ctkCmdLineModuleFuture future = manager.run(frontend);
+  future.waitForFinished();
+  QVERIFY(!future.isCanceled());
+
+  // the run is written to the cache after it finished
+  QTime timeout = QTime::currentTime().addSecs(5);
+  QStringList entries;
+  while (entries.isEmpty() && QTime::currentTime() < timeout)
+  {
+    QTest::qWait(10);
+    entries = QDir(cacheDir).entryList(QDir::Dirs | QDir::NoDotAndDotDot).filter(QRegExp("^[0-9a-f]+$"));
+  }
+  QCOMPARE(entries.size(), 1);
+
+  // the same run with another output location is restored from the cache
+  frontend->setValue("imageOutput", "output2");
+  ctkCmdLineModuleFuture cached = manager.run(frontend);
+  QVERIFY(cached.isFinished());
+  QCOMPARE(cached.resultCount(), future.resultCount());
+  QVERIFY(cached.results().contains(ctkCmdLineModuleResult("imageOutput", "output2")));
+  QCOMPARE(cached.results().back(), ctkCmdLineModuleResult("exitStatusOutput", "Normal exit"));
+  QCOMPARE(cached.readAllErrorData(), future.readAllErrorData());
+
+  // a changed parameter value runs the module again
+  frontend->setValue("numOutputsVar", 1);
+  ctkCmdLineModuleFuture changed = manager.run(frontend);
+  QVERIFY(!changed.isFinished());
+  changed.waitForFinished();
+
+  manager.clearResultCache();
+  manager.setResultCache(QString(), 0);
+  QVERIFY(manager.resultCacheDirectory().isEmpty());
+  QDir().rmdir(cacheDir);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testOutputBufferAndProgressInterval()
+{
+  ctkCmdLineModuleFutureInterface futureInterface;
+  futureInterface.setOutputBufferSize(4);
+  futureInterface.reportStarted();
+
+  ctkCmdLineModuleFutureWatcher watcher;
+  watcher.setFuture(futureInterface.future());
+
+  // only the most recent output is kept, pending reads skip dropped data
+  futureInterface.reportOutputData("0123");
+  futureInterface.reportOutputData("4567");
+  futureInterface.reportOutputData("89");
+  QCOMPARE(futureInterface.future().readAllOutputData(), QByteArray("6789"));
+  QCOMPARE(watcher.readPendingOutputData(), QByteArray("6789"));
+  futureInterface.reportOutputData("ab");
+  QCOMPARE(watcher.readPendingOutputData(), QByteArray("ab"));
+
+  // progress values within the interval are coalesced, the last one wins
+  futureInterface.setProgressRange(0, 100);
+  futureInterface.setProgressInterval(60000);
+  futureInterface.setProgressValue(10);
+  futureInterface.setProgressValue(20);
+  futureInterface.setProgressValue(30);
+  QCOMPARE(futureInterface.progressValue(), 10);
+
+  // without further updates, the watcher delivers the held back value
+  futureInterface.setProgressInterval(50);
+  QTime timeout = QTime::currentTime().addSecs(5);
+  while (futureInterface.progressValue() != 30 && QTime::currentTime() < timeout)
+  {
+    QTest::qWait(10);
+  }
+  QCOMPARE(futureInterface.progressValue(), 30);
+
+  // the last held back value is delivered when the module finishes
+  futureInterface.setProgressInterval(60000);
+  futureInterface.setProgressValue(40);
+  futureInterface.setProgressValueAndText(50, "Almost done");
+  QCOMPARE(futureInterface.progressValue(), 30);
+
+  futureInterface.reportFinished();
+  QCOMPARE(futureInterface.progressValue(), 50);
+  QCOMPARE(futureInterface.progressText(), QString("Almost done"));
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testWorkerReuse()
+{
+  ctkCmdLineModuleFuture first = manager.run(workerFrontend);
+  first.waitForFinished();
+  QVERIFY(!first.isCanceled());
+  QCOMPARE(first.progressValue(), 1002);
+  const QString pid = resultValue(first, "pidOutput");
+  QVERIFY(!pid.isEmpty());
+
+  // the second run is served by the same process
+  ctkCmdLineModuleFuture second = manager.run(workerFrontend);
+  second.waitForFinished();
+  QVERIFY(!second.isCanceled());
+  QCOMPARE(resultValue(second, "pidOutput"), pid);
+  QCOMPARE(resultValue(second, "runCountOutput").toInt(), resultValue(first, "runCountOutput").toInt() + 1);
+  QCOMPARE(second.readAllErrorData().count("Run "), 1);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testWorkerExitCode()
+{
+  ctkCmdLineModuleFuture previous = manager.run(workerFrontend);
+  previous.waitForFinished();
+  const QString pid = resultValue(previous, "pidOutput");
+
+  workerFrontend->setValue("exitCodeVar", 3);
+  ctkCmdLineModuleFuture failed = manager.run(workerFrontend);
+  try
+  {
+    failed.waitForFinished();
+    QFAIL("Expected exception not thrown.");
+  }
+  catch (const ctkCmdLineModuleRunException& e)
+  {
+    QCOMPARE(e.errorCode(), 3);
+  }
+
+  // a failed run does not end the worker
+  workerFrontend->setValue("exitCodeVar", 0);
+  ctkCmdLineModuleFuture next = manager.run(workerFrontend);
+  next.waitForFinished();
+  QCOMPARE(resultValue(next, "pidOutput"), pid);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testWorkerExitDuringRun()
+{
+  ctkCmdLineModuleFuture previous = manager.run(workerFrontend);
+  previous.waitForFinished();
+  const QString pid = resultValue(previous, "pidOutput");
+  QVERIFY(!pid.isEmpty());
+
+  // the idle worker of the previous run exits during this run
+  workerFrontend->setValue("exitDuringRunVar", true);
+  ctkCmdLineModuleFuture failed = manager.run(workerFrontend);
+  try
+  {
+    failed.waitForFinished();
+    QFAIL("Expected exception not thrown.");
+  }
+  catch (const ctkCmdLineModuleRunException&)
+  {
+  }
+
+  // the next run starts a new worker
+  workerFrontend->setValue("exitDuringRunVar", false);
+  ctkCmdLineModuleFuture next = manager.run(workerFrontend);
+  next.waitForFinished();
+  QVERIFY(!next.isCanceled());
+  QVERIFY(!resultValue(next, "pidOutput").isEmpty());
+  QVERIFY(resultValue(next, "pidOutput") != pid);
+  QCOMPARE(resultValue(next, "runCountOutput").toInt(), 1);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testWorkerCancel()
+{
+  workerFrontend->setValue("runtimeVar", 60000);
+  ctkCmdLineModuleFuture canceled = manager.run(workerFrontend);
+
+  // wait until the worker reported its process id
+  QTime timeout = QTime::currentTime().addSecs(10);
+  while (canceled.resultCount() == 0 && QTime::currentTime() < timeout)
+  {
+    QTest::qWait(10);
+  }
+  QVERIFY(canceled.resultCount() > 0);
+  const QString pid = canceled.resultAt(0).value().toString();
+
+  canceled.cancel();
+  canceled.waitForFinished();
+  QVERIFY(canceled.isCanceled());
+  QVERIFY(canceled.isFinished());
+
+  // the canceled worker is killed and not reused
+  workerFrontend->setValue("runtimeVar", 0);
+  ctkCmdLineModuleFuture next = manager.run(workerFrontend);
+  next.waitForFinished();
+  QVERIFY(!next.isCanceled());
+  QVERIFY(resultValue(next, "pidOutput") != pid);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureTester::testWorkerIdleTrimming()
+{
+  QFile::remove(workerLogFileName);
+
+  // keep two workers busy at the same time
+  manager.setMaxConcurrentJobs(&backend, 2);
+  ctkCmdLineModuleFrontend* otherFrontend = factory.create(workerRef);
+  workerFrontend->setValue("runtimeVar", 1000);
+  otherFrontend->setValue("runtimeVar", 1000);
+  ctkCmdLineModuleFuture first = manager.run(workerFrontend);
+  ctkCmdLineModuleFuture second = manager.run(otherFrontend);
+  first.waitForFinished();
+  second.waitForFinished();
+  QStringList pids;
+  pids << resultValue(first, "pidOutput") << resultValue(second, "pidOutput");
+  QVERIFY(pids[0] != pids[1]);
+  QVERIFY(exitedWorkers(workerLogFileName).isEmpty());
+
+  // shrinking the pool stops the surplus idle worker
+  manager.setMaxConcurrentJobs(&backend, 1);
+  QTime timeout = QTime::currentTime().addSecs(10);
+  while (exitedWorkers(workerLogFileName).isEmpty() && QTime::currentTime() < timeout)
+  {
+    QTest::qWait(10);
+  }
+  QStringList exited = exitedWorkers(workerLogFileName);
+  QCOMPARE(exited.size(), 1);
+  QVERIFY(pids.contains(exited.front()));
+
+  // the remaining worker serves the next run
+  pids.removeAll(exited.front());
+  workerFrontend->setValue("runtimeVar", 0);
+  ctkCmdLineModuleFuture next = manager.run(workerFrontend);
+  next.waitForFinished();
+  QCOMPARE(resultValue(next, "pidOutput"), pids.front());
+
+  delete otherFrontend;
+  manager.setMaxConcurrentJobs(&backend, 0);
+}
+
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(ctkCmdLineModuleFutureTest)
 #include "moc_ctkCmdLineModuleFutureTest.cpp"
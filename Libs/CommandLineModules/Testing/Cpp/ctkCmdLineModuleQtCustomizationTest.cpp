@@ -29,6 +29,7 @@
 #include "ctkCmdLineModuleManager.h"
 #include "ctkCmdLineModuleFrontendQtGui.h"
 #include "ctkCmdLineModuleBackendFunctionPointer.h"
+#include "ctkCmdLineModuleDataRegistry.h"
 #include "ctkCmdLineModuleParameter.h"
 #include "ctkCmdLineModuleParameterGroup.h"
 #include "ctkCmdLineModuleDescription.h"
@@ -50,6 +51,7 @@ struct MyImageData : public ctk::CmdLineModuleBackendFunctionPointer::ImageType
 
 Q_DECLARE_METATYPE(MyImageData)
 Q_DECLARE_METATYPE(const MyImageData*)
+Q_DECLARE_METATYPE(MyImageData*)
 
 // ----------------------------------------------------------------------------
 namespace ctk {
@@ -234,6 +236,46 @@ void CustomImageTypeModule(const MyImageData* imageData)
   CustomImageDataPath = imageData->Path;
 }
 
+// ----------------------------------------------------------------------------
+void FillImageModule(MyImageData* imageData)
+{
+  imageData->Path = "/in/memory/image";
+}
+
+// ----------------------------------------------------------------------------
+const MyImageData* ReadImageData = NULL;
+void ReadImageModule(const MyImageData* imageData)
+{
+  ReadImageData = imageData;
+  CustomImageDataPath = imageData->Path;
+}
+
+// ----------------------------------------------------------------------------
+class MyFrontendMockup : public ctkCmdLineModuleFrontend
+{
+
+public:
+
+  MyFrontendMockup(const ctkCmdLineModuleReference& moduleRef)
+    : ctkCmdLineModuleFrontend(moduleRef) {}
+
+  virtual QObject* guiHandle() const { return NULL; }
+
+  virtual QVariant value(const QString& parameter, int /*role*/) const
+  {
+    return currentValues[parameter];
+  }
+
+  virtual void setValue(const QString& parameter, const QVariant& value, int /*role*/ = DisplayRole)
+  {
+    currentValues[parameter] = value;
+  }
+
+private:
+
+  QHash<QString, QVariant> currentValues;
+};
+
 // ----------------------------------------------------------------------------
 class ctkCmdLineModuleQtCustomizationTester: public QObject
 {
@@ -243,6 +285,8 @@ private Q_SLOTS:
 
   void testCustomization();
 
+  void testDataRegistry();
+
 };
 
 // ----------------------------------------------------------------------------
@@ -289,6 +333,45 @@ void ctkCmdLineModuleQtCustomizationTester::testCustomization()
   QCOMPARE(CustomImageDataPath, expectedImageValue);
 }
 
+// ----------------------------------------------------------------------------
+void ctkCmdLineModuleQtCustomizationTester::testDataRegistry()
+{
+  ctkCmdLineModuleManager moduleManager;
+
+  ctkCmdLineModuleBackendFunctionPointer fpBackend;
+  QUrl fillUrl = fpBackend.registerFunctionPointer("Fill Image", FillImageModule)->moduleLocation();
+  QUrl readUrl = fpBackend.registerFunctionPointer("Read Image", ReadImageModule)->moduleLocation();
+
+  moduleManager.registerBackend(&fpBackend);
+  ctkCmdLineModuleReference fillRef = moduleManager.registerModule(fillUrl);
+  ctkCmdLineModuleReference readRef = moduleManager.registerModule(readUrl);
+  QVERIFY(fillRef);
+  QVERIFY(readRef);
+
+  ctkCmdLineModuleDataRegistry* dataRegistry = ctkCmdLineModuleDataRegistry::instance();
+  QSharedPointer<MyImageData> image(new MyImageData);
+  QString imageRef = dataRegistry->registerData(image);
+  QVERIFY(dataRegistry->contains(imageRef));
+  QVERIFY(dataRegistry->data<MyImageData>(imageRef) == image);
+  QVERIFY(dataRegistry->data<int>(imageRef).isNull());
+
+  // the first module writes into the registered image, the second one reads it
+  QScopedPointer<ctkCmdLineModuleFrontend> fillFrontend(new MyFrontendMockup(fillRef));
+  fillFrontend->setValue("param0", imageRef);
+  moduleManager.run(fillFrontend.data()).waitForFinished();
+  QCOMPARE(image->Path, QString("/in/memory/image"));
+
+  QScopedPointer<ctkCmdLineModuleFrontend> readFrontend(new MyFrontendMockup(readRef));
+  readFrontend->setValue("param0", imageRef);
+  moduleManager.run(readFrontend.data()).waitForFinished();
+  QVERIFY(ReadImageData == image.data());
+  QCOMPARE(CustomImageDataPath, QString("/in/memory/image"));
+
+  dataRegistry->unregisterData(imageRef);
+  QVERIFY(!dataRegistry->contains(imageRef));
+  QVERIFY(dataRegistry->data<MyImageData>(imageRef).isNull());
+}
+
 
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(ctkCmdLineModuleQtCustomizationTest)
@@ -0,0 +1,186 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include <ctkCommandLineParser.h>
+
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QFile>
+#include <QUrl>
+
+#include <cstdlib>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+void sleep_ms(int ms)
+{
+#ifdef Q_OS_WIN
+  Sleep(ms);
+#else
+  struct timespec nanostep;
+  nanostep.tv_sec = static_cast<time_t>(ms / 1000);
+  nanostep.tv_nsec = ((ms % 1000) * 1000.0 * 1000.0);
+  nanosleep(&nanostep, NULL);
+#endif
+}
+
+void addArguments(ctkCommandLineParser& parser)
+{
+  // Use Unix-style argument names
+  parser.setArgumentPrefix("--", "-");
+
+  parser.addArgument("help", "h", QVariant::Bool, "Show this help text");
+  parser.addArgument("xml", "", QVariant::Bool, "Print a XML description of this modules command line interface");
+  parser.addArgument("worker", "", QVariant::Bool, "Read the arguments of each run from the standard input");
+  parser.addArgument("runtime", "", QVariant::Int, "Runtime in milliseconds", 0);
+  parser.addArgument("exitCode", "", QVariant::Int, "Exit code", 0);
+  parser.addArgument("exitDuringRun", "", QVariant::Bool, "Exit the process during the run", false);
+}
+
+// Appends the process id to the file named by the CTK_CMDLINEMODULE_WORKER_LOG
+// environment variable, so tests can observe when a worker was stopped.
+void logWorkerExit()
+{
+  QString logFileName = QString::fromLocal8Bit(qgetenv("CTK_CMDLINEMODULE_WORKER_LOG"));
+  if (logFileName.isEmpty()) return;
+
+  QFile logFile(logFileName);
+  if (logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+  {
+    logFile.write(QByteArray::number(QCoreApplication::applicationPid()) + '\n');
+  }
+}
+
+// Returns false if the process has to exit in the middle of the run
+bool run(const QHash<QString, QVariant>& parsedArgs, int runCount, QTextStream& out, QTextStream& err)
+{
+  err << "Run " << runCount << " of worker " << QCoreApplication::applicationPid() << endl;
+
+  out << "<filter-start>\n";
+  out << "<filter-name>Worker</filter-name>\n";
+  out << "<filter-comment>Running</filter-comment>\n";
+  out << "</filter-start>" << endl;
+
+  // reported first, so tests can identify the process of a running module
+  out << "<filter-result name=\"pidOutput\">" << QCoreApplication::applicationPid() << "</filter-result>" << endl;
+
+  if (parsedArgs["exitDuringRun"].toBool())
+  {
+    return false;
+  }
+
+  sleep_ms(parsedArgs["runtime"].toInt());
+
+  out << "<filter-result name=\"runCountOutput\">" << runCount << "</filter-result>" << endl;
+  out << "<filter-progress>1</filter-progress>" << endl;
+  out << "<filter-end><filter-comment>Finished successfully.</filter-comment></filter-end>" << endl;
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  // This is used by QSettings
+  QCoreApplication::setOrganizationName("CommonTK");
+  QCoreApplication::setApplicationName("CmdLineModuleWorker");
+
+  ctkCommandLineParser parser;
+  addArguments(parser);
+
+  QTextStream out(stdout, QIODevice::WriteOnly | QIODevice::Text);
+  QTextStream err(stderr, QIODevice::WriteOnly | QIODevice::Text);
+
+  // Parse the command line arguments
+  bool ok = false;
+  QHash<QString, QVariant> parsedArgs = parser.parseArguments(QCoreApplication::arguments(), &ok);
+  if (!ok)
+  {
+    err << "Error parsing arguments:" << parser.errorString() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Show a help message
+  if (parsedArgs.contains("help") || parsedArgs.contains("h"))
+  {
+    out << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  if (parsedArgs.contains("xml"))
+  {
+    QFile xmlDescription(":/ctkCmdLineModuleWorker.xml");
+    xmlDescription.open(QIODevice::ReadOnly);
+    out << xmlDescription.readAll();
+    return EXIT_SUCCESS;
+  }
+
+  if (!parsedArgs.contains("worker"))
+  {
+    // A single run, as started by back-ends without worker support
+    return run(parsedArgs, 1, out, err) ? parsedArgs["exitCode"].toInt() : EXIT_SUCCESS;
+  }
+
+  // Serve runs until the standard input is closed. Each run is requested by a line
+  // with the number of arguments, followed by one percent-encoded argument per line.
+  QTextStream in(stdin, QIODevice::ReadOnly | QIODevice::Text);
+  int runCount = 0;
+  forever
+  {
+    QString countLine = in.readLine();
+    if (countLine.isNull()) break;
+
+    QStringList runArgs;
+    runArgs << QCoreApplication::applicationFilePath();
+    const int argCount = countLine.toInt();
+    for (int i = 0; i < argCount; ++i)
+    {
+      runArgs << QUrl::fromPercentEncoding(in.readLine().toLatin1());
+    }
+
+    ctkCommandLineParser runParser;
+    addArguments(runParser);
+    QHash<QString, QVariant> runParsedArgs = runParser.parseArguments(runArgs, &ok);
+
+    int exitCode = EXIT_FAILURE;
+    if (!ok)
+    {
+      err << "Error parsing arguments:" << runParser.errorString() << endl;
+    }
+    else if (!run(runParsedArgs, ++runCount, out, err))
+    {
+      return EXIT_SUCCESS;
+    }
+    else
+    {
+      exitCode = runParsedArgs["exitCode"].toInt();
+    }
+
+    err.flush();
+    out << "<worker-finished exit-code=\"" << exitCode << "\"/>" << endl;
+  }
+
+  logWorkerExit();
+  return EXIT_SUCCESS;
+}
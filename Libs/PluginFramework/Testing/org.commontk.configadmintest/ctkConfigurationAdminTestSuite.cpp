@@ -313,3 +313,44 @@ void ctkConfigurationAdminTestSuite::testPersistentFactoryConfig()
   config = cm->getConfiguration(pid);
   QVERIFY(config->getProperties().isEmpty());
 }
+
+//----------------------------------------------------------------------------
+void ctkConfigurationAdminTestSuite::testPersistentConfigUpdates()
+{
+  // enough superseded updates to compact the configuration store
+  const int configCount = 20;
+  const int updateCount = 20;
+
+  QStringList pids;
+  for (int i = 0; i < configCount; ++i)
+  {
+    ctkConfigurationPtr config = cm->createFactoryConfiguration("test");
+    pids << config->getPid();
+  }
+  for (int update = 0; update < updateCount; ++update)
+  {
+    foreach (QString pid, pids)
+    {
+      ctkDictionary props;
+      props.insert("testkey", update);
+      cm->getConfiguration(pid)->update(props);
+    }
+  }
+
+  cleanup();
+  init();
+  foreach (QString pid, pids)
+  {
+    ctkConfigurationPtr config = cm->getConfiguration(pid);
+    QCOMPARE(config->getFactoryPid(), QString("test"));
+    QCOMPARE(config->getProperties().value("testkey").toInt(), updateCount - 1);
+    config->remove();
+  }
+
+  cleanup();
+  init();
+  foreach (QString pid, pids)
+  {
+    QVERIFY(cm->getConfiguration(pid)->getProperties().isEmpty());
+  }
+}
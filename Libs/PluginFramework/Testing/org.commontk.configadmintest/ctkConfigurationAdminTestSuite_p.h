@@ -65,6 +65,7 @@ private Q_SLOTS:
   void testListConfigurationNull();
   void testPersistentConfig();
   void testPersistentFactoryConfig();
+  void testPersistentConfigUpdates();
 
 private:
 
@@ -30,6 +30,10 @@
 
 #include <QTest>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QVector>
+
+#include <algorithm>
 
 
 //----------------------------------------------------------------------------
@@ -43,12 +47,42 @@ void TestEventHandler::handleEvent(const ctkEvent& )
   counter++;
 }
 
+//----------------------------------------------------------------------------
+TestAtomicEventHandler::TestAtomicEventHandler(QAtomicInt& counter)
+  : counter(counter)
+{}
+
+//----------------------------------------------------------------------------
+void TestAtomicEventHandler::handleEvent(const ctkEvent& )
+{
+  counter.ref();
+}
+
+//----------------------------------------------------------------------------
+ctkEventPublisherThread::ctkEventPublisherThread(ctkEventAdmin* eventAdmin, int nEvents)
+  : eventAdmin(eventAdmin)
+  , nEvents(nEvents)
+{}
+
+//----------------------------------------------------------------------------
+void ctkEventPublisherThread::run()
+{
+  ctkEvent event("org/throughput/1");
+  for (int i = 0; i < nEvents; ++i)
+  {
+    eventAdmin->postEvent(event);
+  }
+}
+
 //----------------------------------------------------------------------------
 ctkEventAdminPerfTestSuite::ctkEventAdminPerfTestSuite(ctkPluginContext *context, int pluginId)
   : pc(context)
   , pluginId(pluginId)
   , nSendEvents(400)
   , nHandlers(40)
+  , nLatencyEvents(100000)
+  , nPublisherThreads(16)
+  , nPublisherEvents(20000)
   , nEvent1Handled(0)
   , nEvent2Handled(0)
   , eventAdmin(0)
@@ -172,6 +206,87 @@ void ctkEventAdminPerfTestSuite::testPostEvents()
   QTest::qWait(10000);
 }
 
+//----------------------------------------------------------------------------
+void ctkEventAdminPerfTestSuite::testSendEventLatency()
+{
+  int nLatencyHandled = 0;
+  TestEventHandler handler(nLatencyHandled);
+  ctkDictionary props;
+  props.insert(ctkEventConstants::EVENT_TOPIC, "org/latency/1");
+  ctkServiceRegistration reg = pc->registerService<ctkEventHandler>(&handler, props);
+
+  ctkEvent event("org/latency/1");
+  // warm up
+  eventAdmin->sendEvent(event);
+
+  QVector<qint64> nsecs(nLatencyEvents);
+  QElapsedTimer t;
+  for (int i = 0; i < nLatencyEvents; ++i)
+  {
+    t.start();
+    eventAdmin->sendEvent(event);
+    nsecs[i] = t.nsecsElapsed();
+  }
+
+  reg.unregister();
+  QCOMPARE(nLatencyHandled, nLatencyEvents + 1);
+
+  std::sort(nsecs.begin(), nsecs.end());
+  qint64 total = 0;
+  foreach(qint64 ns, nsecs)
+  {
+    total += ns;
+  }
+  qDebug() << "sendEvent latency to one handler over" << nLatencyEvents << "events:"
+           << "mean" << (total / nLatencyEvents) / 1000.0 << "us,"
+           << "median" << nsecs[nLatencyEvents / 2] / 1000.0 << "us,"
+           << "99th percentile" << nsecs[nLatencyEvents * 99 / 100] / 1000.0 << "us";
+}
+
+//----------------------------------------------------------------------------
+void ctkEventAdminPerfTestSuite::testPostEventThroughput()
+{
+  QAtomicInt nThroughputHandled(0);
+  TestAtomicEventHandler handler(nThroughputHandled);
+  ctkDictionary props;
+  props.insert(ctkEventConstants::EVENT_TOPIC, "org/throughput/1");
+  ctkServiceRegistration reg = pc->registerService<ctkEventHandler>(&handler, props);
+
+  QList<ctkEventPublisherThread*> publishers;
+  for (int i = 0; i < nPublisherThreads; ++i)
+  {
+    publishers.push_back(new ctkEventPublisherThread(eventAdmin, nPublisherEvents));
+  }
+
+  const int nTotal = nPublisherThreads * nPublisherEvents;
+  QElapsedTimer t;
+  t.start();
+  foreach(ctkEventPublisherThread* publisher, publishers)
+  {
+    publisher->start();
+  }
+  foreach(ctkEventPublisherThread* publisher, publishers)
+  {
+    publisher->wait();
+  }
+  qint64 postMs = t.elapsed();
+
+  // wait for the asynchronous delivery, at most one minute
+  while (nThroughputHandled.fetchAndAddOrdered(0) < nTotal && t.elapsed() < 60000)
+  {
+    QTest::qWait(1);
+  }
+  qint64 deliverMs = t.elapsed();
+
+  reg.unregister();
+  qDeleteAll(publishers);
+  QCOMPARE(nThroughputHandled.fetchAndAddOrdered(0), nTotal);
+
+  qDebug() << "Posting" << nTotal << "events from" << nPublisherThreads << "threads took"
+           << postMs << "ms," << (postMs ? nTotal / postMs : nTotal) << "events/ms";
+  qDebug() << "Delivering them took" << deliverMs << "ms";
+}
+
 //----------------------------------------------------------------------------
 void ctkEventAdminPerfTestSuite::cleanupTestCase()
 {
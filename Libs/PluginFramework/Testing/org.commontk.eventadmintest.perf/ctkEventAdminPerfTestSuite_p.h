@@ -29,6 +29,7 @@
 #include <ctkServiceRegistration.h>
 
 #include <QDebug>
+#include <QThread>
 
 struct ctkEventAdmin;
 
@@ -44,6 +45,9 @@ private:
 
   int nSendEvents;
   int nHandlers;
+  int nLatencyEvents;
+  int nPublisherThreads;
+  int nPublisherEvents;
 
   int nEvent1Handled;
   int nEvent2Handled;
@@ -70,6 +74,8 @@ private Q_SLOTS:
   void initTestCase();
   void testSendEvents();
   void testPostEvents();
+  void testSendEventLatency();
+  void testPostEventThroughput();
   void cleanupTestCase();
 };
 
@@ -84,4 +90,26 @@ public:
   void handleEvent(const ctkEvent& );
 };
 
+class TestAtomicEventHandler : public QObject, public ctkEventHandler
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkEventHandler)
+private:
+  QAtomicInt& counter;
+public:
+  TestAtomicEventHandler(QAtomicInt& counter);
+  void handleEvent(const ctkEvent& );
+};
+
+class ctkEventPublisherThread : public QThread
+{
+public:
+  ctkEventPublisherThread(ctkEventAdmin* eventAdmin, int nEvents);
+protected:
+  void run();
+private:
+  ctkEventAdmin* eventAdmin;
+  int nEvents;
+};
+
 #endif // CTKEAPERFTESTSUITE_P_H
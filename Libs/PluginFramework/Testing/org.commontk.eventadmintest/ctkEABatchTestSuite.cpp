@@ -0,0 +1,195 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkEABatchTestSuite_p.h"
+
+#include <ctkPluginContext.h>
+#include <ctkPluginConstants.h>
+
+#include <service/event/ctkEventAdmin.h>
+#include <service/event/ctkEventConstants.h>
+
+#include <QTest>
+
+//----------------------------------------------------------------------------
+static QList<ctkEvent> createEvents(const QString& topic, const QStringList& ids)
+{
+  QList<ctkEvent> events;
+  for (int i = 0; i < ids.size(); ++i)
+  {
+    ctkDictionary properties;
+    properties.insert("id", ids[i]);
+    properties.insert("seq", i);
+    events.push_back(ctkEvent(topic, properties));
+  }
+  return events;
+}
+
+//----------------------------------------------------------------------------
+ctkEABatchTestHelper::ctkEABatchTestHelper()
+  : calls(0)
+{
+
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestHelper::handleEvent(const ctkEvent& event)
+{
+  QMutexLocker l(&mutex);
+  events.push_back(event);
+  ++calls;
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestHelper::handleEvents(const QList<ctkEvent>& events)
+{
+  QMutexLocker l(&mutex);
+  this->events.append(events);
+  ++calls;
+}
+
+//----------------------------------------------------------------------------
+QList<ctkEvent> ctkEABatchTestHelper::waitForEvents(int count) const
+{
+  for (int i = 0; i < 500; ++i)
+  {
+    {
+      QMutexLocker l(&mutex);
+      if (events.size() >= count) return events;
+    }
+    QTest::qWait(10);
+  }
+  QMutexLocker l(&mutex);
+  return events;
+}
+
+//----------------------------------------------------------------------------
+int ctkEABatchTestHelper::getCalls() const
+{
+  QMutexLocker l(&mutex);
+  return calls;
+}
+
+//----------------------------------------------------------------------------
+ctkEABatchTestSuite::ctkEABatchTestSuite(ctkPluginContext* pc, long eventPluginId)
+  : context(pc), eventPluginId(eventPluginId), eventAdmin(0)
+{
+
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestSuite::init()
+{
+  context->getPlugin(eventPluginId)->start();
+  reference = context->getServiceReference<ctkEventAdmin>();
+  eventAdmin = context->getService<ctkEventAdmin>(reference);
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestSuite::cleanup()
+{
+  context->ungetService(reference);
+  context->getPlugin(eventPluginId)->stop();
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestSuite::testPostEvents()
+{
+  ctkDictionary properties;
+  properties.insert(ctkEventConstants::EVENT_TOPIC, "batch/post");
+  ctkEABatchTestHelper handler;
+  ctkServiceRegistration handlerRegistration = context->registerService<ctkEventHandler>(&handler, properties);
+
+  QStringList ids;
+  ids << "a" << "b" << "a" << "c" << "b";
+  eventAdmin->postEvents(createEvents("batch/post", ids));
+  QList<ctkEvent> received = handler.waitForEvents(ids.size());
+  handlerRegistration.unregister();
+
+  QCOMPARE(received.size(), ids.size());
+  for (int i = 0; i < received.size(); ++i)
+  {
+    QCOMPARE(received[i].getProperty("seq").toInt(), i);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestSuite::testBatchDelivery()
+{
+  ctkDictionary properties;
+  properties.insert(ctkEventConstants::EVENT_TOPIC, "batch/deliver");
+  ctkEABatchTestHelper handler;
+  ctkServiceRegistration handlerRegistration = context->registerService<ctkEventHandler>(&handler, properties);
+
+  QStringList ids;
+  for (int i = 0; i < 10; ++i) ids << QString::number(i);
+  eventAdmin->postEvents(createEvents("batch/deliver", ids));
+  QList<ctkEvent> received = handler.waitForEvents(ids.size());
+  handlerRegistration.unregister();
+
+  QCOMPARE(received.size(), ids.size());
+  QCOMPARE(handler.getCalls(), 1);
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestSuite::testCoalescePostedEvents()
+{
+  ctkDictionary properties;
+  properties.insert(ctkEventConstants::EVENT_TOPIC, "batch/coalesce/*");
+  properties.insert(ctkEventConstants::EVENT_COALESCE, "id");
+  ctkEABatchTestHelper handler;
+  ctkServiceRegistration handlerRegistration = context->registerService<ctkEventHandler>(&handler, properties);
+
+  QStringList ids;
+  ids << "a" << "b" << "a" << "b" << "c";
+  QList<ctkEvent> events = createEvents("batch/coalesce/x", ids);
+  // same id, but a different topic
+  events.push_back(createEvents("batch/coalesce/y", QStringList("a")).front());
+  eventAdmin->postEvents(events);
+  QList<ctkEvent> received = handler.waitForEvents(4);
+  handlerRegistration.unregister();
+
+  QCOMPARE(received.size(), 4);
+  QCOMPARE(received[0].getProperty("seq").toInt(), 2);
+  QCOMPARE(received[1].getProperty("seq").toInt(), 3);
+  QCOMPARE(received[2].getProperty("seq").toInt(), 4);
+  QCOMPARE(received[3].getTopic(), QString("batch/coalesce/y"));
+}
+
+//----------------------------------------------------------------------------
+void ctkEABatchTestSuite::testNoCoalesceSentEvents()
+{
+  ctkDictionary properties;
+  properties.insert(ctkEventConstants::EVENT_TOPIC, "batch/send");
+  properties.insert(ctkEventConstants::EVENT_COALESCE, "id");
+  ctkEABatchTestHelper handler;
+  ctkServiceRegistration handlerRegistration = context->registerService<ctkEventHandler>(&handler, properties);
+
+  QStringList ids;
+  ids << "a" << "a" << "a";
+  foreach(const ctkEvent& event, createEvents("batch/send", ids))
+  {
+    eventAdmin->sendEvent(event);
+  }
+  handlerRegistration.unregister();
+
+  QCOMPARE(handler.getCalls(), ids.size());
+}
@@ -0,0 +1,113 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKEABATCHTESTSUITE_P_H
+#define CTKEABATCHTESTSUITE_P_H
+
+#include <QObject>
+#include <QMutex>
+
+#include <ctkServiceReference.h>
+#include <ctkTestSuiteInterface.h>
+
+#include <service/event/ctkBatchEventHandler.h>
+
+class ctkPluginContext;
+struct ctkEventAdmin;
+
+class ctkEABatchTestHelper : public QObject, public ctkBatchEventHandler
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkEventHandler ctkBatchEventHandler)
+
+private:
+
+  mutable QMutex mutex;
+  QList<ctkEvent> events;
+  int calls;
+
+public:
+
+  ctkEABatchTestHelper();
+
+  void handleEvent(const ctkEvent& event);
+  void handleEvents(const QList<ctkEvent>& events);
+
+  /**
+   * Waits until at least <code>count</code> events have been received
+   * or a timeout occurred.
+   */
+  QList<ctkEvent> waitForEvents(int count) const;
+
+  /** The number of handleEvent() and handleEvents() calls */
+  int getCalls() const;
+
+};
+
+
+class ctkEABatchTestSuite : public QObject,
+    public ctkTestSuiteInterface
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkTestSuiteInterface)
+
+public:
+
+  ctkEABatchTestSuite(ctkPluginContext* pc, long eventPluginId);
+
+private Q_SLOTS:
+
+  void init();
+  void cleanup();
+
+  /*
+   * Ensures ctkEventAdmin delivers the events of ctkEventAdmin::postEvents()
+   * in order to a ctkEventHandler.
+   */
+  void testPostEvents();
+
+  /*
+   * Ensures ctkEventAdmin delivers the events of one ctkEventAdmin::postEvents()
+   * call with a single ctkBatchEventHandler::handleEvents() call.
+   */
+  void testBatchDelivery();
+
+  /*
+   * Ensures ctkEventAdmin only delivers the latest posted event per
+   * topic and coalescing property value to a ctkEventHandler registered
+   * with the ctkEventConstants::EVENT_COALESCE property.
+   */
+  void testCoalescePostedEvents();
+
+  /*
+   * Ensures ctkEventAdmin never coalesces synchronously sent events.
+   */
+  void testNoCoalesceSentEvents();
+
+private:
+
+  ctkPluginContext* context;
+  long eventPluginId;
+  ctkEventAdmin* eventAdmin;
+  ctkServiceReference reference;
+};
+
+#endif // CTKEABATCHTESTSUITE_P_H
@@ -0,0 +1,135 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkEAEventBuilderTestSuite_p.h"
+
+#include <ctkException.h>
+
+#include <service/event/ctkEventBuilder.h>
+#include <service/event/ctkEventConstants.h>
+
+#include <QTest>
+
+//----------------------------------------------------------------------------
+void ctkEAEventBuilderTestSuite::testBuild()
+{
+  ctkEvent event = ctkEventBuilder("builder/build")
+                   .setProperty("id", 1)
+                   .setProperty("name", "first")
+                   .setProperty("name", "second")
+                   .build();
+
+  QCOMPARE(event.getTopic(), QString("builder/build"));
+  QCOMPARE(event.getProperty("id").toInt(), 1);
+  QCOMPARE(event.getProperty("name").toString(), QString("second"));
+  QCOMPARE(event.getProperty(ctkEventConstants::EVENT_TOPIC).toString(), QString("builder/build"));
+  QVERIFY(!event.getProperty("missing").isValid());
+  QVERIFY(event.containsProperty("id"));
+  QVERIFY(!event.containsProperty("ID"));
+
+  QStringList names = event.getPropertyNames();
+  names.sort();
+  QStringList expected;
+  expected << "id" << "name" << ctkEventConstants::EVENT_TOPIC;
+  expected.sort();
+  QCOMPARE(names, expected);
+}
+
+//----------------------------------------------------------------------------
+void ctkEAEventBuilderTestSuite::testEqualsDictionaryEvent()
+{
+  ctkDictionary properties;
+  properties.insert("id", 1);
+  properties.insert("name", "value");
+
+  ctkEvent event("builder/equals", properties);
+  ctkEvent built = ctkEventBuilder("builder/equals")
+                   .setProperty("name", "value")
+                   .setProperties(properties)
+                   .build();
+  QVERIFY(built == event);
+
+  ctkEvent other = ctkEventBuilder("builder/equals")
+                   .setProperties(properties)
+                   .setProperty("name", "other")
+                   .build();
+  QVERIFY(!(other == event));
+}
+
+//----------------------------------------------------------------------------
+void ctkEAEventBuilderTestSuite::testSharedPayload()
+{
+  QByteArray pixels(1024 * 1024, 'x');
+  ctkEvent event = ctkEventBuilder("builder/payload")
+                   .setProperty("pixels", pixels)
+                   .build();
+
+  ctkEvent copy(event);
+  QVERIFY(event.getProperty("pixels").toByteArray().constData() == pixels.constData());
+  QVERIFY(copy.getProperty("pixels").toByteArray().constData() == pixels.constData());
+}
+
+//----------------------------------------------------------------------------
+void ctkEAEventBuilderTestSuite::testInvalidUse()
+{
+  ctkEventBuilder builder("builder/invalid");
+  builder.build();
+
+  try
+  {
+    builder.build();
+    QFAIL("Expected a ctkIllegalStateException");
+  }
+  catch (const ctkIllegalStateException&)
+  {}
+
+  try
+  {
+    builder.setProperty("id", 1);
+    QFAIL("Expected a ctkIllegalStateException");
+  }
+  catch (const ctkIllegalStateException&)
+  {}
+
+  try
+  {
+    ctkEventBuilder("builder//invalid");
+    QFAIL("Expected a ctkInvalidArgumentException");
+  }
+  catch (const ctkInvalidArgumentException&)
+  {}
+}
+
+//----------------------------------------------------------------------------
+void ctkEAEventBuilderTestSuite::testMatches()
+{
+  ctkEvent event = ctkEventBuilder("builder/matches")
+                   .setProperty("id", 5)
+                   .setProperty("name", "abc")
+                   .build();
+
+  QVERIFY(event.matches(ctkLDAPSearchFilter("(&(id=5)(name=abc))")));
+  QVERIFY(event.matches(ctkLDAPSearchFilter("(name=a*)")));
+  QVERIFY(event.matches(ctkLDAPSearchFilter("(event.topics=builder/matches)")));
+  QVERIFY(!event.matches(ctkLDAPSearchFilter("(id=6)")));
+  QVERIFY(!event.matches(ctkLDAPSearchFilter("(NAME=abc)")));
+  QVERIFY(!event.matches(ctkLDAPSearchFilter("(missing=*)")));
+}
@@ -0,0 +1,68 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKEAEVENTBUILDERTESTSUITE_P_H
+#define CTKEAEVENTBUILDERTESTSUITE_P_H
+
+#include <QObject>
+
+#include <ctkTestSuiteInterface.h>
+
+class ctkEAEventBuilderTestSuite : public QObject,
+    public ctkTestSuiteInterface
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkTestSuiteInterface)
+
+private Q_SLOTS:
+
+  /*
+   * Ensures ctkEventBuilder creates an event with the set properties and
+   * the event topic, keeping the last value of a property set twice.
+   */
+  void testBuild();
+
+  /*
+   * Ensures an event created by ctkEventBuilder equals the event created
+   * from a ctkDictionary with the same properties.
+   */
+  void testEqualsDictionaryEvent();
+
+  /*
+   * Ensures large property values are shared instead of copied.
+   */
+  void testSharedPayload();
+
+  /*
+   * Ensures a ctkEventBuilder cannot be used after build() was called and
+   * rejects invalid topics.
+   */
+  void testInvalidUse();
+
+  /*
+   * Ensures filters are evaluated case sensitively against the properties
+   * of a built event.
+   */
+  void testMatches();
+
+};
+
+#endif // CTKEAEVENTBUILDERTESTSUITE_P_H
@@ -32,6 +32,8 @@
 #include "ctkEAScenario2TestSuite_p.h"
 #include "ctkEAScenario3TestSuite_p.h"
 #include "ctkEAScenario4TestSuite_p.h"
+#include "ctkEABatchTestSuite_p.h"
+#include "ctkEAEventBuilderTestSuite_p.h"
 
 //----------------------------------------------------------------------------
 ctkEventAdminTestActivator::ctkEventAdminTestActivator()
@@ -42,6 +44,8 @@ ctkEventAdminTestActivator::ctkEventAdminTestActivator()
   , scenario2TestSuite(0)
   , scenario3TestSuite(0)
   , scenario4TestSuite(0)
+  , batchTestSuite(0)
+  , eventBuilderTestSuite(0)
 {
 
 }
@@ -56,6 +60,8 @@ ctkEventAdminTestActivator::~ctkEventAdminTestActivator()
   delete scenario2TestSuite;
   delete scenario3TestSuite;
   delete scenario4TestSuite;
+  delete batchTestSuite;
+  delete eventBuilderTestSuite;
 }
 
 //----------------------------------------------------------------------------
@@ -105,6 +111,12 @@ void ctkEventAdminTestActivator::start(ctkPluginContext* context)
 
   scenario4TestSuite = new ctkEAScenario4TestSuite(context, eventPluginId);
   context->registerService<ctkTestSuiteInterface>(scenario4TestSuite);
+
+  batchTestSuite = new ctkEABatchTestSuite(context, eventPluginId);
+  context->registerService<ctkTestSuiteInterface>(batchTestSuite);
+
+  eventBuilderTestSuite = new ctkEAEventBuilderTestSuite();
+  context->registerService<ctkTestSuiteInterface>(eventBuilderTestSuite);
 }
 
 //----------------------------------------------------------------------------
@@ -119,6 +131,8 @@ void ctkEventAdminTestActivator::stop(ctkPluginContext* context)
   delete scenario2TestSuite;
   delete scenario3TestSuite;
   delete scenario4TestSuite;
+  delete batchTestSuite;
+  delete eventBuilderTestSuite;
 
   topicWildcardTestSuite = 0;
   topicWildcardTestSuiteSS = 0;
@@ -127,6 +141,8 @@ void ctkEventAdminTestActivator::stop(ctkPluginContext* context)
   scenario2TestSuite = 0;
   scenario3TestSuite = 0;
   scenario4TestSuite = 0;
+  batchTestSuite = 0;
+  eventBuilderTestSuite = 0;
 }
 
 #if QT_VERSION < QT_VERSION_CHECK(5,0,0)
@@ -52,6 +52,8 @@ private:
   QObject* scenario2TestSuite;
   QObject* scenario3TestSuite;
   QObject* scenario4TestSuite;
+  QObject* batchTestSuite;
+  QObject* eventBuilderTestSuite;
 };
 
 #endif // CTKEVENTADMINTESTACTIVATOR_H
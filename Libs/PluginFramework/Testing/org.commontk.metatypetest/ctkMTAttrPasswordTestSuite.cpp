@@ -160,3 +160,35 @@ void ctkMTAttrPasswordTestSuite::testAttributeTypePassword6()
   }
  }
 
+//----------------------------------------------------------------------------
+void ctkMTAttrPasswordTestSuite::testCachedAttributeDefinitions()
+{
+  ctkMetaTypeInformationPtr mti = mts->getMetaTypeInformation(plugin);
+  ctkObjectClassDefinitionPtr ocd = mti->getObjectClassDefinition("org.commontk.metatype.tests.attrpwd");
+  QVERIFY(ocd);
+  QList<ctkAttributeDefinitionPtr> parsedAds = ocd->getAttributeDefinitions(ctkObjectClassDefinition::ALL);
+  QVERIFY(!parsedAds.isEmpty());
+
+  // restart the MetaType service, which then reads the cache
+  cleanupTestCase();
+  context->getPlugin(mtPluginId)->start();
+  reference = context->getServiceReference<ctkMetaTypeService>();
+  mts = context->getService<ctkMetaTypeService>(reference);
+
+  mti = mts->getMetaTypeInformation(plugin);
+  ocd = mti->getObjectClassDefinition("org.commontk.metatype.tests.attrpwd");
+  QVERIFY(ocd);
+  QList<ctkAttributeDefinitionPtr> cachedAds = ocd->getAttributeDefinitions(ctkObjectClassDefinition::ALL);
+  QCOMPARE(cachedAds.size(), parsedAds.size());
+  for (int i = 0; i < cachedAds.size(); i++)
+  {
+    QCOMPARE(cachedAds[i]->getID(), parsedAds[i]->getID());
+    QCOMPARE(cachedAds[i]->getType(), parsedAds[i]->getType());
+    QCOMPARE(cachedAds[i]->getCardinality(), parsedAds[i]->getCardinality());
+    QCOMPARE(cachedAds[i]->getDefaultValue(), parsedAds[i]->getDefaultValue());
+    QCOMPARE(cachedAds[i]->getOptionValues(), parsedAds[i]->getOptionValues());
+    QCOMPARE(cachedAds[i]->getOptionLabels(), parsedAds[i]->getOptionLabels());
+    QCOMPARE(cachedAds[i]->validate("12"), parsedAds[i]->validate("12"));
+    QCOMPARE(cachedAds[i]->validate("1234567"), parsedAds[i]->validate("1234567"));
+  }
+}
@@ -83,6 +83,12 @@ private Q_SLOTS:
    */
   void testAttributeTypePassword6();
 
+  /*
+   * Ensures the attribute definitions read from the metatype cache of a
+   * restarted MetaType service equal the parsed ones.
+   */
+  void testCachedAttributeDefinitions();
+
 private:
 
   QSharedPointer<ctkPlugin> plugin;
@@ -23,6 +23,7 @@
 #include "ctkPluginFrameworkPerfRegistryTestSuite_p.h"
 
 #include <ctkPluginContext.h>
+#include <ctkServiceObjects.h>
 #include <ctkHighPrecisionTimer.h>
 
 #undef REGISTERED
@@ -37,6 +38,8 @@ ctkPluginFrameworkPerfRegistryTestSuite::ctkPluginFrameworkPerfRegistryTestSuite
   , pc(context)
   , nListeners(100)
   , nServices(1000)
+  , nUsageThreads(8)
+  , nUsageIterations(100000)
   , nRegistered(0)
   , nUnregistering(0)
   , nModified(0)
@@ -166,6 +169,58 @@ void ctkPluginFrameworkPerfRegistryTestSuite::modifyServices()
   }
 }
 
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkPerfRegistryTestSuite::testServiceUsage()
+{
+  qDebug() << "Get and unget a service concurrently from" << nUsageThreads
+           << "threads using the plugin context";
+
+  QVERIFY2(useServices(false) == 0, "All getService() calls must succeed");
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkPerfRegistryTestSuite::testServiceObjectsUsage()
+{
+  qDebug() << "Get and unget a service concurrently from" << nUsageThreads
+           << "threads using ctkServiceObjects handles";
+
+  QVERIFY2(useServices(true) == 0, "All getService() calls must succeed");
+}
+
+//----------------------------------------------------------------------------
+int ctkPluginFrameworkPerfRegistryTestSuite::useServices(bool useServiceObjects)
+{
+  if (regs.isEmpty()) return -1;
+  ctkServiceReference ref = regs.front().getReference();
+
+  QList<ctkServiceUsageThread*> threads;
+  for (int i = 0; i < nUsageThreads; ++i)
+  {
+    threads.push_back(new ctkServiceUsageThread(pc, ref, nUsageIterations, useServiceObjects));
+  }
+
+  ctkHighPrecisionTimer t;
+  t.start();
+  foreach (ctkServiceUsageThread* thread, threads)
+  {
+    thread->start();
+  }
+  int failures = 0;
+  foreach (ctkServiceUsageThread* thread, threads)
+  {
+    thread->wait();
+    failures += thread->failures;
+  }
+  int ms = t.elapsedMilli();
+  log() << (useServiceObjects ? "ctkServiceObjects" : "ctkPluginContext")
+        << "get/unget of" << nUsageThreads * nUsageIterations << "services took" << ms << "ms";
+  qDeleteAll(threads);
+
+  // All uses must have been released
+  if (!ref.getUsingPlugins().isEmpty()) ++failures;
+  return failures;
+}
+
 //----------------------------------------------------------------------------
 void ctkPluginFrameworkPerfRegistryTestSuite::testUnregisterServices()
 {
@@ -195,6 +250,48 @@ void ctkPluginFrameworkPerfRegistryTestSuite::unregisterServices()
 }
 
 
+//----------------------------------------------------------------------------
+ctkServiceUsageThread::ctkServiceUsageThread(ctkPluginContext* pc, const ctkServiceReference& ref,
+                                             int iterations, bool useServiceObjects)
+  : failures(0), pc(pc), ref(ref), iterations(iterations), useServiceObjects(useServiceObjects)
+{
+}
+
+//----------------------------------------------------------------------------
+void ctkServiceUsageThread::run()
+{
+  if (useServiceObjects)
+  {
+    // Keep the service held by the handle, like a long-lived request
+    // handler would, so that the loop exercises the fast path.
+    ctkServiceObjects so = pc->getServiceObjects(ref);
+    QObject* held = so.getService();
+    for (int i = 0; i < iterations; ++i)
+    {
+      QObject* service = so.getService();
+      if (service == 0)
+      {
+        ++failures;
+        continue;
+      }
+      so.ungetService(service);
+    }
+    if (held) so.ungetService(held);
+  }
+  else
+  {
+    for (int i = 0; i < iterations; ++i)
+    {
+      if (pc->getService(ref) == 0)
+      {
+        ++failures;
+        continue;
+      }
+      pc->ungetService(ref);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 ctkServiceListener::ctkServiceListener(ctkPluginFrameworkPerfRegistryTestSuite* ts)
   : ts(ts)
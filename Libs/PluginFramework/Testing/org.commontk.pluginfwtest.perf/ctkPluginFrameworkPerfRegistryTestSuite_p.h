@@ -27,6 +27,7 @@
 #include "ctkServiceRegistration.h"
 
 #include <QDebug>
+#include <QThread>
 
 class ctkPluginContext;
 class ctkServiceEvent;
@@ -44,6 +45,8 @@ private:
 
   int nListeners;
   int nServices;
+  int nUsageThreads;
+  int nUsageIterations;
 
   int nRegistered;
   int nUnregistering;
@@ -70,6 +73,7 @@ private:
   void registerServices(int n);
   void modifyServices();
   void unregisterServices();
+  int useServices(bool useServiceObjects);
 
 private Q_SLOTS:
 
@@ -80,9 +84,33 @@ private Q_SLOTS:
   void testRegisterServices();
 
   void testModifyServices();
+  void testServiceUsage();
+  void testServiceObjectsUsage();
   void testUnregisterServices();
 };
 
+class ctkServiceUsageThread : public QThread
+{
+
+public:
+
+  ctkServiceUsageThread(ctkPluginContext* pc, const ctkServiceReference& ref,
+                        int iterations, bool useServiceObjects);
+
+  int failures;
+
+protected:
+
+  void run();
+
+private:
+
+  ctkPluginContext* pc;
+  ctkServiceReference ref;
+  int iterations;
+  bool useServiceObjects;
+};
+
 class ctkServiceListener : public QObject
 {
   Q_OBJECT
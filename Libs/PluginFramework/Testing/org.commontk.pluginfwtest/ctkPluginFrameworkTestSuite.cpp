@@ -26,6 +26,7 @@
 #include <ctkPluginConstants.h>
 #include <ctkPluginException.h>
 #include <ctkServiceException.h>
+#include <service/debug/ctkPluginFrameworkMetrics.h>
 
 #include <QDir>
 #include <QTest>
@@ -539,6 +540,46 @@ void ctkPluginFrameworkTestSuite::frame070a()
   QVERIFY2(versionA1 != versionA, "framework test plug-in, update of plug-in failed, version info unchanged :FRAME070A:Fail");
 }
 
+//----------------------------------------------------------------------------
+// Get the framework metrics service and check that service lookups are counted
+void ctkPluginFrameworkTestSuite::frame075a()
+{
+  ctkServiceReference sr = pc->getServiceReference<ctkPluginFrameworkMetrics>();
+  QVERIFY2(sr, "Framework metrics service registered");
+  ctkPluginFrameworkMetrics* metrics = pc->getService<ctkPluginFrameworkMetrics>(sr);
+  QVERIFY(metrics != 0);
+
+  // nothing is recorded by default
+  QVERIFY(!metrics->isEnabled());
+  qint64 lookups = metrics->getCount(ctkPluginFrameworkMetrics::SERVICE_LOOKUP);
+  pc->getServiceReferences<ctkPluginFrameworkMetrics>();
+  QCOMPARE(metrics->getCount(ctkPluginFrameworkMetrics::SERVICE_LOOKUP), lookups);
+
+  metrics->setEnabled(true);
+  lookups = metrics->getCount(ctkPluginFrameworkMetrics::SERVICE_LOOKUP);
+  pc->getServiceReferences<ctkPluginFrameworkMetrics>();
+  QVERIFY(metrics->getCount(ctkPluginFrameworkMetrics::SERVICE_LOOKUP) > lookups);
+
+  qint64 histogramTotal = 0;
+  foreach (qint64 bucket, metrics->getHistogram(ctkPluginFrameworkMetrics::SERVICE_LOOKUP))
+  {
+    histogramTotal += bucket;
+  }
+  QCOMPARE(histogramTotal, metrics->getCount(ctkPluginFrameworkMetrics::SERVICE_LOOKUP));
+
+  metrics->setTracingEnabled(true);
+  pc->getServiceReference<ctkPluginFrameworkMetrics>();
+  metrics->setTracingEnabled(false);
+
+  QByteArray trace = metrics->toChromeTrace();
+  QVERIFY(trace.startsWith("{\"traceEvents\":["));
+  QVERIFY(trace.contains("\"name\":\"service_lookup\",\"cat\":\"ctk.pluginfw\",\"ph\":\"X\""));
+
+  metrics->setEnabled(false);
+
+  pc->ungetService(sr);
+}
+
 //----------------------------------------------------------------------------
 void ctkPluginFrameworkTestSuite::frameworkListener(const ctkPluginFrameworkEvent& fwEvent)
 {
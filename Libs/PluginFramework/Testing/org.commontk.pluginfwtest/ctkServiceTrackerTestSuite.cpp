@@ -188,6 +188,8 @@ void ctkServiceTrackerTestSuite::runTest()
   h1 = st1->getServiceReference();
   QList<ctkServiceReference> sa3 = st1->getServiceReferences();
   QVERIFY(sa3.size() == 3);
+  // the references are sorted, highest ranking first
+  QVERIFY(sa3.front() == h1);
   for (int i = 0; i < sa3.size(); ++i)
   {
     QString name = pc->getService(sa3[i])->metaObject()->className();
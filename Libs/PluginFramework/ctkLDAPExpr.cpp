@@ -281,35 +281,60 @@ bool ctkLDAPExpr::query( const QString &filter, const ctkDictionary &pd )
 }
 
 //----------------------------------------------------------------------------
-bool ctkLDAPExpr::evaluate( const ctkServiceProperties &p, bool matchCase ) const
+template<class Properties>
+bool ctkLDAPExpr::evaluateProperties( const Properties &p, bool matchCase ) const
 {
   if ((d->m_operator & SIMPLE) != 0) {
-    // try case sensitive match first
-    int index = p.findCaseSensitive(d->m_attrName);
-    if (index < 0 && !matchCase) index = p.find(d->m_attrName);
-    return index < 0 ? false : compare(p.value(index), d->m_operator, d->m_attrValue);
+    return compare(lookup(p, d->m_attrName, matchCase), d->m_operator, d->m_attrValue);
   } else { // (d->m_operator & COMPLEX) != 0
     switch (d->m_operator) {
     case AND:
       for (int i = 0; i < d->m_args.length( ); i++) {
-        if (!d->m_args[i].evaluate(p, matchCase))
+        if (!d->m_args[i].evaluateProperties(p, matchCase))
           return false;
       }
       return true;
     case OR:
       for (int i = 0; i < d->m_args.length( ); i++) {
-        if (d->m_args[i].evaluate(p, matchCase))
+        if (d->m_args[i].evaluateProperties(p, matchCase))
           return true;
       }
       return false;
     case NOT:
-      return !d->m_args[0].evaluate(p, matchCase);
+      return !d->m_args[0].evaluateProperties(p, matchCase);
     default:
       return false; // Cannot happen
     }
   }
 }
 
+//----------------------------------------------------------------------------
+bool ctkLDAPExpr::evaluate( const ctkServiceProperties &p, bool matchCase ) const
+{
+  return evaluateProperties(p, matchCase);
+}
+
+//----------------------------------------------------------------------------
+bool ctkLDAPExpr::evaluate( const ctkLDAPPropertyLookup &p, bool matchCase ) const
+{
+  return evaluateProperties(p, matchCase);
+}
+
+//----------------------------------------------------------------------------
+QVariant ctkLDAPExpr::lookup( const ctkServiceProperties &p, const QString &key, bool matchCase )
+{
+  // try case sensitive match first
+  int index = p.findCaseSensitive(key);
+  if (index < 0 && !matchCase) index = p.find(key);
+  return index < 0 ? QVariant() : p.value(index);
+}
+
+//----------------------------------------------------------------------------
+QVariant ctkLDAPExpr::lookup( const ctkLDAPPropertyLookup &p, const QString &key, bool matchCase )
+{
+  return p.value(key, matchCase);
+}
+
 //----------------------------------------------------------------------------
 bool ctkLDAPExpr::compare( const QVariant &obj, int op, const QString &s ) const
 {
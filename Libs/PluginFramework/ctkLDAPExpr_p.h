@@ -30,9 +30,27 @@ limitations under the License.
 #include <QSharedDataPointer>
 #include <QVector>
 #include <QStringList>
+#include <QVariant>
 
 class ctkLDAPExprData;
 
+/**
+\ingroup PluginFramework
+\brief Provides the attribute values a ctkLDAPExpr is evaluated
+against, for property containers other than ctkServiceProperties.
+*/
+class ctkLDAPPropertyLookup {
+
+public:
+
+  virtual ~ctkLDAPPropertyLookup() {}
+
+  //! Returns the value of the given key, or an invalid QVariant if there is none.
+  //! If matchCase is false and no key matches exactly, the key is matched ignoring case.
+  virtual QVariant value(const QString &key, bool matchCase) const = 0;
+
+};
+
 /**
 \ingroup PluginFramework
 \brief LDAP Expression
@@ -126,6 +144,9 @@ public:
   //! Evaluate this LDAP filter.
   bool evaluate(const ctkServiceProperties &p, bool matchCase) const;
 
+  //! Evaluate this LDAP filter against the values of a property lookup.
+  bool evaluate(const ctkLDAPPropertyLookup &p, bool matchCase) const;
+
   //!
   const QString toString() const;
 
@@ -149,6 +170,16 @@ private:
   //!
   bool compare(const QVariant &obj, int op, const QString &s) const;
 
+  //!
+  template<class Properties>
+  bool evaluateProperties(const Properties &p, bool matchCase) const;
+
+  //!
+  static QVariant lookup(const ctkServiceProperties &p, const QString &key, bool matchCase);
+
+  //!
+  static QVariant lookup(const ctkLDAPPropertyLookup &p, const QString &key, bool matchCase);
+
   //!
   static bool compareString(const QString &s1, int op, const QString &s2);
 
@@ -22,6 +22,7 @@
 #include "ctkLDAPSearchFilter.h"
 
 #include "ctkLDAPExpr_p.h"
+#include "ctkPluginFrameworkMetricsRecorder_p.h"
 #include "ctkServiceReference_p.h"
 
 //----------------------------------------------------------------------------
@@ -76,21 +77,31 @@ ctkLDAPSearchFilter::operator bool() const
 //----------------------------------------------------------------------------
 bool ctkLDAPSearchFilter::match(const ctkServiceReference& reference) const
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LDAP_EVALUATION);
   return d->ldapExpr.evaluate(reference.d_func()->getProperties(), true);
 }
 
 //----------------------------------------------------------------------------
 bool ctkLDAPSearchFilter::match(const ctkDictionary& dictionary) const
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LDAP_EVALUATION);
   return d->ldapExpr.evaluate(dictionary, false);
 }
 
 //----------------------------------------------------------------------------
 bool ctkLDAPSearchFilter::matchCase(const ctkDictionary& dictionary) const
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LDAP_EVALUATION);
   return d->ldapExpr.evaluate(dictionary, true);
 }
 
+//----------------------------------------------------------------------------
+bool ctkLDAPSearchFilter::matchCase(const ctkLDAPPropertyLookup& properties) const
+{
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LDAP_EVALUATION);
+  return d->ldapExpr.evaluate(properties, true);
+}
+
 //----------------------------------------------------------------------------
 QString ctkLDAPSearchFilter::toString() const
 {
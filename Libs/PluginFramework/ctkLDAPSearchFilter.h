@@ -30,6 +30,7 @@
 #include <QSharedDataPointer>
 #include <QDebug>
 
+class ctkLDAPPropertyLookup;
 class ctkLDAPSearchFilterData;
 
 /**
@@ -157,6 +158,12 @@ protected:
 
   QSharedDataPointer<ctkLDAPSearchFilterData> d;
 
+private:
+
+  friend class ctkEvent;
+
+  bool matchCase(const ctkLDAPPropertyLookup& properties) const;
+
 };
 
 /**
@@ -28,6 +28,7 @@
 #include "ctkPluginFrameworkUtil_p.h"
 #include "ctkPluginArchive_p.h"
 #include "ctkPluginFrameworkContext_p.h"
+#include "ctkPluginFrameworkMetricsRecorder_p.h"
 #include "ctkServices_p.h"
 #include "ctkUtils.h"
 
@@ -105,12 +106,14 @@ void ctkPlugin::start(const StartOptions& options)
     if (STARTING == d->state) return;
     d->state = STARTING;
     d->pluginContext.reset(new ctkPluginContext(this->d_func()));
+    d->registerLazyServices();
     ctkPluginEvent pluginEvent(ctkPluginEvent::LAZY_ACTIVATION, d->q_ptr);
     d->fwCtx->listeners.emitPluginChanged(pluginEvent);
   }
   else
   {
     d->finalizeActivation();
+    d->unregisterLazyServices();
   }
 }
 
@@ -118,6 +121,7 @@ void ctkPlugin::start(const StartOptions& options)
 void ctkPlugin::stop(const StopOptions& options)
 {
   Q_D(ctkPlugin);
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::PLUGIN_STOP);
 
   const ctkRuntimeException* savedException = 0;
 
@@ -330,6 +334,13 @@ QString ctkPlugin::getLocation() const
   return d->location;
 }
 
+//----------------------------------------------------------------------------
+QDateTime ctkPlugin::getLastModified() const
+{
+  Q_D(const ctkPlugin);
+  return d->lastModified;
+}
+
 //----------------------------------------------------------------------------
 QHash<QString, QString> ctkPlugin::getHeaders()
 {
@@ -375,6 +386,7 @@ QStringList ctkPlugin::findResources(const QString& path,
 QByteArray ctkPlugin::getResource(const QString& path) const
 {
   Q_D(const ctkPlugin);
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::RESOURCE_READ);
   return d->archive->getPluginResource(path);
 }
 
@@ -26,6 +26,7 @@
 #include <QWeakPointer>
 #include <QMetaType>
 #include <QUrl>
+#include <QDateTime>
 
 #include "ctkVersion.h"
 #include "ctkPluginLocalization.h"
@@ -286,9 +287,13 @@ public:
    * <li>If this plugin's state is <code>STARTING</code> then this method
    * returns immediately.
    * <li>This plugin's state is set to <code>STARTING</code>.
+   * <li>The services declared in the {@link ctkPluginConstants#PLUGIN_LAZYSERVICES
+   * Plugin-LazyServices} manifest header are registered, without loading
+   * the plugin library.
    * <li>A plugin event of type {@link ctkPluginEvent::LAZY_ACTIVATION} is fired.
    * <li>This method returns immediately and the remaining steps will be
-   * followed when this plugin's activation is later triggered.
+   * followed when this plugin's activation is later triggered by the
+   * first request for one of its services.
    * </ul>
    * If the {@link #START_ACTIVATION_POLICY} option is set and this
    * plugin's declared activation policy is {@link ctkPluginConstants#ACTIVATION_EAGER
@@ -631,6 +636,17 @@ public:
    */
   QString getLocation() const;
 
+  /**
+   * Returns the time when this plugin was last modified. A plugin is
+   * considered to be modified when it is installed or updated.
+   *
+   * <p>
+   * The time value is the local time at which the plugin was last modified.
+   *
+   * @return The time when this plugin was last modified.
+   */
+  QDateTime getLastModified() const;
+
   /**
    * Returns this plugin's Manifest headers and values. This method returns
    * all the Manifest headers and values from the main section of this
@@ -61,6 +61,18 @@ void ctkPluginArchiveSQL::readManifest(const QByteArray& manifestResource)
   manifest.read(manifestRes);
 }
 
+//----------------------------------------------------------------------------
+const ctkPluginManifest& ctkPluginArchiveSQL::getManifest() const
+{
+  return manifest;
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginArchiveSQL::setManifest(const ctkPluginManifest& manifest)
+{
+  this->manifest = manifest;
+}
+
 //----------------------------------------------------------------------------
 QString ctkPluginArchiveSQL::getAttribute(const QString& key) const
 {
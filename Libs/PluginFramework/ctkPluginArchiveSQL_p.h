@@ -184,6 +184,17 @@ public:
    */
   void readManifest(const QByteArray &manifestResource = QByteArray());
 
+  /**
+   * Get the parsed manifest of this archive.
+   */
+  const ctkPluginManifest& getManifest() const;
+
+  /**
+   * Set an already parsed manifest, e.g. one restored from the
+   * plugin storage snapshot.
+   */
+  void setManifest(const ctkPluginManifest& manifest);
+
 public:
 
   int key;
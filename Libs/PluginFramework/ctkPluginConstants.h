@@ -249,6 +249,29 @@ struct CTK_PLUGINFW_EXPORT ctkPluginConstants {
    */
   static const QString PLUGIN_UPDATELOCATION; // = "Plugin-UpdateLocation"
 
+  /**
+   * Manifest header declaring the services a lazily activated plugin
+   * provides.
+   * <p>
+   * For a plugin with the lazy activation policy, the framework registers
+   * a placeholder service for each entry when the plugin is started with
+   * the ctkPlugin#START_ACTIVATION_POLICY option. The plugin library is not
+   * loaded until one of these services is requested. The first
+   * <code>getService()</code> call then activates the plugin and returns
+   * the service object the plugin registered in its activator. Once the
+   * plugin is active, the placeholders are unregistered and only the
+   * services registered by the activator remain. Each entry
+   * lists the interface names of one service object, optionally followed by
+   * service properties:
+   *
+   * <pre>
+   *       Plugin-LazyServices: ctkEventAdmin, ctkFooService;ctkBarService;service.ranking=10
+   * </pre>
+   *
+   * @see #ACTIVATION_LAZY
+   */
+  static const QString PLUGIN_LAZYSERVICES; // = "Plugin-LazyServices"
+
   /**
    * Plugin activation policy declaring the plugin must be activated immediately.
    *
@@ -28,6 +28,7 @@
 #include "ctkServiceRegistration.h"
 #include "ctkServiceReference.h"
 #include "ctkServiceReference_p.h"
+#include "ctkServiceObjects_p.h"
 
 #include <stdexcept>
 
@@ -174,6 +175,19 @@ bool ctkPluginContext::ungetService(const ctkServiceReference& reference)
   return ref.d_func()->ungetService(d->plugin->q_func(), true);
 }
 
+//----------------------------------------------------------------------------
+ctkServiceObjects ctkPluginContext::getServiceObjects(const ctkServiceReference& reference)
+{
+  Q_D(ctkPluginContext);
+  d->isPluginContextValid();
+
+  if (!reference)
+  {
+    throw ctkInvalidArgumentException("Default constructed ctkServiceReference is not a valid input to getServiceObjects()");
+  }
+  return ctkServiceObjects(new ctkServiceObjectsPrivate(d->plugin->q_func(), reference));
+}
+
 //----------------------------------------------------------------------------
 bool ctkPluginContext::connectPluginListener(const QObject* receiver, const char* slot,
                                              Qt::ConnectionType type)
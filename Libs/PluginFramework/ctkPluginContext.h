@@ -34,6 +34,7 @@
 #include "ctkPluginEvent.h"
 #include "ctkServiceException.h"
 #include "ctkServiceReference.h"
+#include "ctkServiceObjects.h"
 #include "ctkServiceRegistration.h"
 
 #include "ctkPluginFrameworkExport.h"
@@ -509,6 +510,28 @@ public:
    */
   bool ungetService(const ctkServiceReference& reference);
 
+  /**
+   * Returns a <code>ctkServiceObjects</code> handle for the service
+   * referenced by the specified <code>ctkServiceReference</code> object.
+   *
+   * <p>
+   * The handle gets and releases the service on behalf of the context
+   * plugin. Repeated calls to ctkServiceObjects::getService() and
+   * ctkServiceObjects::ungetService() on the same handle do not access the
+   * service registry as long as the service is held by the handle. This is
+   * the preferred way to use a service on a per-request basis.
+   *
+   * @param reference A reference to the service.
+   * @return A <code>ctkServiceObjects</code> object for the service
+   *         associated with <code>reference</code>.
+   * @throws ctkIllegalStateException If this ctkPluginContext is no
+   *         longer valid.
+   * @throws ctkInvalidArgumentException If the specified
+   *         <code>ctkServiceReference</code> is invalid (default constructed).
+   * @see ctkServiceObjects
+   */
+  ctkServiceObjects getServiceObjects(const ctkServiceReference& reference);
+
   /**
    * Creates a <code>QFileInfo</code> object for a file or directoryin the
    * persistent storage area provided for the plugin by the Framework.
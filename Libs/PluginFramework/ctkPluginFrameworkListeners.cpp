@@ -25,6 +25,7 @@
 #include "ctkPluginFrameworkContext_p.h"
 #include "ctkPluginConstants.h"
 #include "ctkLDAPExpr_p.h"
+#include "ctkPluginFrameworkMetricsRecorder_p.h"
 #include "ctkServiceReference_p.h"
 
 #include <QStringListIterator>
@@ -121,7 +122,13 @@ QSet<ctkServiceSlotEntry> ctkPluginFrameworkListeners::getMatchingServiceSlots(
   {
     ++n;
     expr = sse.getLDAPExpr();
-    if (expr.isNull() || expr.evaluate(sr.d_func()->getProperties(), false))
+    bool match = expr.isNull();
+    if (!match)
+    {
+      ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LDAP_EVALUATION);
+      match = expr.evaluate(sr.d_func()->getProperties(), false);
+    }
+    if (match)
     {
       set.insert(sse);
     }
@@ -165,12 +172,14 @@ void ctkPluginFrameworkListeners::frameworkError(QSharedPointer<ctkPlugin> p, co
 //----------------------------------------------------------------------------
 void ctkPluginFrameworkListeners::emitFrameworkEvent(const ctkPluginFrameworkEvent& event)
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LISTENER_DISPATCH);
   emit frameworkEvent(event);
 }
 
 //----------------------------------------------------------------------------
 void ctkPluginFrameworkListeners::emitPluginChanged(const ctkPluginEvent& event)
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LISTENER_DISPATCH);
   emit pluginChangedDirect(event);
 
   if (!(event.getType() == ctkPluginEvent::STARTING ||
@@ -216,6 +225,7 @@ void ctkPluginFrameworkListeners::serviceChanged(
     try
     {
       ++n;
+      ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LISTENER_DISPATCH);
       l.invokeSlot(evt);
     }
     catch (const ctkException& pe)
@@ -0,0 +1,242 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkPluginFrameworkMetricsRecorder_p.h"
+
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QThread>
+
+namespace {
+
+const char* const probeNames[ctkPluginFrameworkMetrics::PROBE_COUNT] = {
+  "service_lookup",
+  "ldap_evaluation",
+  "listener_dispatch",
+  "plugin_start",
+  "plugin_stop",
+  "resource_read"
+};
+
+// Appends a microsecond value with nanosecond precision, as expected by
+// the "ts" and "dur" fields of the trace event format.
+void appendMicros(QByteArray& out, qint64 nsecs)
+{
+  out.append(QByteArray::number(nsecs / 1000));
+  out.append('.');
+  out.append(QByteArray::number(nsecs % 1000).rightJustified(3, '0'));
+}
+
+}
+
+QAtomicInt ctkPluginFrameworkMetricsRecorder::enabled(0);
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkMetricsRecorder::ctkPluginFrameworkMetricsRecorder()
+  : tracing(0), nextSpan(0)
+{
+  epoch.start();
+}
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkMetricsRecorder* ctkPluginFrameworkMetricsRecorder::getDefault()
+{
+  static ctkPluginFrameworkMetricsRecorder singleton;
+  return &singleton;
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkPluginFrameworkMetricsRecorder::load(const Counter& counter)
+{
+  return const_cast<Counter&>(counter).fetchAndAddRelaxed(0);
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkMetricsRecorder::record(Probe probe, qint64 nsecs)
+{
+  ProbeData& data = probes[probe];
+  const qint64 usecs = nsecs / 1000;
+
+  int bucket = 0;
+  for (qint64 v = usecs; v != 0 && bucket < HISTOGRAM_BUCKETS - 1; v >>= 1)
+  {
+    ++bucket;
+  }
+
+  data.count.fetchAndAddRelaxed(1);
+  data.totalTime.fetchAndAddRelaxed(usecs);
+  data.histogram[bucket].fetchAndAddRelaxed(1);
+
+  if (tracing.fetchAndAddRelaxed(0))
+  {
+    Span span;
+    span.probe = probe;
+    span.duration = nsecs;
+    span.start = epoch.elapsedMicro() * 1000 - nsecs;
+    span.thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+    QMutexLocker lock(&spanMutex);
+    if (spans.size() < MAX_SPANS)
+    {
+      spans.push_back(span);
+    }
+    else
+    {
+      spans[nextSpan] = span;
+      nextSpan = (nextSpan + 1) % MAX_SPANS;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+QString ctkPluginFrameworkMetricsRecorder::getProbeName(Probe probe) const
+{
+  if (probe < 0 || probe >= PROBE_COUNT) return QString();
+  return QString::fromLatin1(probeNames[probe]);
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkPluginFrameworkMetricsRecorder::getCount(Probe probe) const
+{
+  if (probe < 0 || probe >= PROBE_COUNT) return 0;
+  return load(probes[probe].count);
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkPluginFrameworkMetricsRecorder::getTotalTime(Probe probe) const
+{
+  if (probe < 0 || probe >= PROBE_COUNT) return 0;
+  return load(probes[probe].totalTime);
+}
+
+//----------------------------------------------------------------------------
+QList<qint64> ctkPluginFrameworkMetricsRecorder::getHistogram(Probe probe) const
+{
+  QList<qint64> histogram;
+  if (probe < 0 || probe >= PROBE_COUNT) return histogram;
+  for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+  {
+    histogram.push_back(load(probes[probe].histogram[i]));
+  }
+  return histogram;
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkMetricsRecorder::reset()
+{
+  for (int p = 0; p < PROBE_COUNT; ++p)
+  {
+    probes[p].count.fetchAndStoreRelaxed(0);
+    probes[p].totalTime.fetchAndStoreRelaxed(0);
+    for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+    {
+      probes[p].histogram[i].fetchAndStoreRelaxed(0);
+    }
+  }
+
+  QMutexLocker lock(&spanMutex);
+  spans.clear();
+  nextSpan = 0;
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkMetricsRecorder::setEnabled(bool enabled)
+{
+  ctkPluginFrameworkMetricsRecorder::enabled.fetchAndStoreOrdered(enabled ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginFrameworkMetricsRecorder::isEnabled() const
+{
+  return isRecording();
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkMetricsRecorder::setTracingEnabled(bool enabled)
+{
+  tracing.fetchAndStoreOrdered(enabled ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginFrameworkMetricsRecorder::isTracingEnabled() const
+{
+  return const_cast<QAtomicInt&>(tracing).fetchAndAddRelaxed(0) != 0;
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkPluginFrameworkMetricsRecorder::toChromeTrace() const
+{
+  const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+  const qint64 now = epoch.elapsedMicro() * 1000;
+
+  QByteArray out;
+  out.append("{\"traceEvents\":[");
+
+  bool first = true;
+  {
+    QMutexLocker lock(&spanMutex);
+    // Oldest spans first
+    for (int i = 0; i < spans.size(); ++i)
+    {
+      const Span& span = spans[(nextSpan + i) % spans.size()];
+      out.append(first ? "\n" : ",\n");
+      first = false;
+      out.append("{\"name\":\"").append(probeNames[span.probe]);
+      out.append("\",\"cat\":\"ctk.pluginfw\",\"ph\":\"X\",\"ts\":");
+      appendMicros(out, span.start);
+      out.append(",\"dur\":");
+      appendMicros(out, span.duration);
+      out.append(",\"pid\":").append(pid);
+      out.append(",\"tid\":").append(QByteArray::number(static_cast<quint64>(span.thread)));
+      out.append('}');
+    }
+  }
+
+  // One counter sample per probe, holding the current totals
+  for (int p = 0; p < PROBE_COUNT; ++p)
+  {
+    out.append(first ? "\n" : ",\n");
+    first = false;
+    out.append("{\"name\":\"").append(probeNames[p]);
+    out.append("\",\"cat\":\"ctk.pluginfw\",\"ph\":\"C\",\"ts\":");
+    appendMicros(out, now);
+    out.append(",\"pid\":").append(pid);
+    out.append(",\"args\":{\"count\":").append(QByteArray::number(load(probes[p].count)));
+    out.append(",\"total_us\":").append(QByteArray::number(load(probes[p].totalTime)));
+    out.append("}}");
+  }
+
+  out.append("\n],\"displayTimeUnit\":\"ns\",\"otherData\":{");
+  for (int p = 0; p < PROBE_COUNT; ++p)
+  {
+    if (p > 0) out.append(',');
+    out.append("\n\"").append(probeNames[p]).append("_histogram_us\":[");
+    for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+    {
+      if (i > 0) out.append(',');
+      out.append(QByteArray::number(load(probes[p].histogram[i])));
+    }
+    out.append(']');
+  }
+  out.append("\n}}\n");
+
+  return out;
+}
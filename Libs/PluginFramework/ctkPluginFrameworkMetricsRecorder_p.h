@@ -0,0 +1,200 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKPLUGINFRAMEWORKMETRICSRECORDER_P_H
+#define CTKPLUGINFRAMEWORKMETRICSRECORDER_P_H
+
+#include <service/debug/ctkPluginFrameworkMetrics.h>
+
+#include <ctkHighPrecisionTimer.h>
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+/**
+ * \ingroup PluginFramework
+ *
+ * Process wide implementation of the ctkPluginFrameworkMetrics service.
+ *
+ * Framework code measures an operation by placing a Scope object on
+ * the stack. Measurements are only taken while recording is enabled:
+ *
+ * \code
+ * ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::SERVICE_LOOKUP);
+ * \endcode
+ */
+class ctkPluginFrameworkMetricsRecorder : public QObject, public ctkPluginFrameworkMetrics
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkPluginFrameworkMetrics)
+
+public:
+
+  /**
+   * Measures the time between its construction and destruction and
+   * records it for the given probe.
+   */
+  class Scope
+  {
+  public:
+
+    /**
+     * Nothing is measured if <code>measure</code> is <code>false</code>
+     * or recording is disabled.
+     */
+    Scope(Probe probe, bool measure = true)
+      : probe(probe), active(measure && isRecording())
+    {
+      if (active) timer.start();
+    }
+
+    ~Scope()
+    {
+      if (active)
+      {
+        ctkPluginFrameworkMetricsRecorder::getDefault()->record(probe, timer.elapsedMicro() * 1000);
+      }
+    }
+
+  private:
+
+    Q_DISABLE_COPY(Scope)
+
+    const Probe probe;
+    const bool active;
+    ctkHighPrecisionTimer timer;
+  };
+
+  /**
+   * Returns <code>true</code> if measurements are recorded. This is a
+   * relaxed read, cheap enough for every measured call.
+   */
+  static bool isRecording()
+  {
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+    return enabled.load() != 0;
+#else
+    return enabled != 0;
+#endif
+  }
+
+  static ctkPluginFrameworkMetricsRecorder* getDefault();
+
+  /**
+   * Records a measurement of <code>nsecs</code> nanoseconds for the
+   * given probe.
+   */
+  void record(Probe probe, qint64 nsecs);
+
+  QString getProbeName(Probe probe) const;
+  qint64 getCount(Probe probe) const;
+  qint64 getTotalTime(Probe probe) const;
+  QList<qint64> getHistogram(Probe probe) const;
+
+  void reset();
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const;
+
+  void setTracingEnabled(bool enabled);
+  bool isTracingEnabled() const;
+
+  QByteArray toChromeTrace() const;
+
+private:
+
+#if QT_VERSION >= QT_VERSION_CHECK(5,3,0)
+  typedef QAtomicInteger<qint64> Counter;
+#else
+  // 64 bit atomics are not available before Qt 5.3. A 32 bit counter
+  // would wrap after about 35 minutes of accumulated microseconds.
+  class Counter
+  {
+  public:
+
+    Counter() : value(0) {}
+
+    qint64 fetchAndAddRelaxed(qint64 valueToAdd)
+    {
+      QMutexLocker lock(&mutex);
+      const qint64 old = value;
+      value += valueToAdd;
+      return old;
+    }
+
+    qint64 fetchAndStoreRelaxed(qint64 newValue)
+    {
+      QMutexLocker lock(&mutex);
+      const qint64 old = value;
+      value = newValue;
+      return old;
+    }
+
+  private:
+
+    Q_DISABLE_COPY(Counter)
+
+    QMutex mutex;
+    qint64 value;
+  };
+#endif
+
+  struct ProbeData
+  {
+    Counter count;
+    Counter totalTime;
+    Counter histogram[HISTOGRAM_BUCKETS];
+  };
+
+  struct Span
+  {
+    int probe;
+    qint64 start;
+    qint64 duration;
+    quintptr thread;
+  };
+
+  /** Maximum number of trace spans kept in the ring buffer. */
+  static const int MAX_SPANS = 65536;
+
+  ctkPluginFrameworkMetricsRecorder();
+
+  static qint64 load(const Counter& counter);
+
+  ProbeData probes[PROBE_COUNT];
+
+  /** Recording is process wide, so the flag is read without the singleton. */
+  static QAtomicInt enabled;
+
+  QAtomicInt tracing;
+
+  /** Reference point of the span timestamps. */
+  mutable ctkHighPrecisionTimer epoch;
+
+  mutable QMutex spanMutex;
+  QVector<Span> spans;
+  int nextSpan;
+
+};
+
+#endif // CTKPLUGINFRAMEWORKMETRICSRECORDER_P_H
@@ -30,6 +30,7 @@
 #include "ctkPluginFrameworkContext_p.h"
 #include "ctkPluginFrameworkUtil_p.h"
 #include "ctkPluginFrameworkDebugOptions_p.h"
+#include "ctkPluginFrameworkMetricsRecorder_p.h"
 
 #include "ctkBasicLocation_p.h"
 
@@ -100,6 +101,9 @@ void ctkPluginFrameworkPrivate::activate(ctkPluginContext* context)
   ctkPluginFrameworkDebugOptions* dbgOptions = ctkPluginFrameworkDebugOptions::getDefault();
   dbgOptions->start(context);
   context->registerService<ctkDebugOptions>(dbgOptions);
+
+  registrations.push_back(context->registerService<ctkPluginFrameworkMetrics>(
+                            ctkPluginFrameworkMetricsRecorder::getDefault()));
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,141 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkPluginLazyServiceFactory_p.h"
+
+#include "ctkPlugin_p.h"
+#include "ctkPluginConstants.h"
+#include "ctkPluginContext.h"
+#include "ctkPluginFrameworkContext_p.h"
+#include "ctkServiceException.h"
+
+#include <ctkException.h>
+
+//----------------------------------------------------------------------------
+ctkPluginLazyServiceFactory::ctkPluginLazyServiceFactory(ctkPluginPrivate* plugin, const QStringList& classes)
+  : plugin(plugin), classes(classes)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkServiceReference ctkPluginLazyServiceFactory::findDelegate(const ctkServiceReference& placeholder)
+{
+  if (plugin->isActivatingThread())
+  {
+    throw ctkServiceException(QString("Lazy service %1 requested during the activation of plugin %2")
+                              .arg(classes.join(", ")).arg(plugin->symbolicName),
+                              ctkServiceException::FACTORY_ERROR);
+  }
+
+  {
+    // Wait for an activation in progress in another thread
+    ctkPluginPrivate::Locker sync(&plugin->operationLock);
+    plugin->waitOnOperation(&plugin->operationLock, "ctkPluginLazyServiceFactory::getService", true);
+    if (plugin->state != ctkPlugin::ACTIVE || !plugin->pluginContext)
+    {
+      throw ctkServiceException(QString("Plugin %1 was not activated").arg(plugin->symbolicName),
+                                ctkServiceException::FACTORY_ERROR);
+    }
+  }
+
+  // Find the best matching service registered by the plugin itself, which
+  // provides all classes declared in the manifest.
+  QSharedPointer<ctkPlugin> owner = plugin->q_func().toStrongRef();
+  ctkServiceReference best;
+  foreach (ctkServiceReference ref, plugin->pluginContext->getServiceReferences(classes.front()))
+  {
+    if (ref == placeholder || ref.getPlugin() != owner) continue;
+
+    const QStringList objectClasses = ref.getProperty(ctkPluginConstants::OBJECTCLASS).toStringList();
+    bool providesAll = true;
+    foreach (const QString& clazz, classes)
+    {
+      if (!objectClasses.contains(clazz))
+      {
+        providesAll = false;
+        break;
+      }
+    }
+
+    if (providesAll && (!best || best < ref))
+    {
+      best = ref;
+    }
+  }
+
+  if (!best)
+  {
+    throw ctkServiceException(QString("Plugin %1 declares the lazy service %2, but did not register it during activation")
+                              .arg(plugin->symbolicName).arg(classes.join(", ")),
+                              ctkServiceException::FACTORY_ERROR);
+  }
+  return best;
+}
+
+//----------------------------------------------------------------------------
+QObject* ctkPluginLazyServiceFactory::getService(QSharedPointer<ctkPlugin> requester,
+                                                 ctkServiceRegistration registration)
+{
+  ctkServiceReference best = findDelegate(registration.getReference());
+
+  ctkPluginContext* context = requester->getPluginContext();
+  if (!context)
+  {
+    throw ctkServiceException(QString("Plugin %1 has no valid plugin context").arg(requester->getSymbolicName()),
+                              ctkServiceException::FACTORY_ERROR);
+  }
+
+  QObject* service = context->getService(best);
+  if (service)
+  {
+    QMutexLocker lock(&delegatesMutex);
+    delegates.insert(requester, best);
+  }
+  return service;
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginLazyServiceFactory::ungetService(QSharedPointer<ctkPlugin> requester,
+                                               ctkServiceRegistration registration, QObject* service)
+{
+  Q_UNUSED(registration)
+  Q_UNUSED(service)
+
+  ctkServiceReference ref;
+  {
+    QMutexLocker lock(&delegatesMutex);
+    ref = delegates.take(requester);
+  }
+
+  ctkPluginContext* context = requester->getPluginContext();
+  if (!ref || !context) return;
+
+  try
+  {
+    context->ungetService(ref);
+  }
+  catch (const ctkIllegalStateException&)
+  {
+    // The requesting plugin is being stopped and its used services
+    // have already been released by the framework.
+  }
+}
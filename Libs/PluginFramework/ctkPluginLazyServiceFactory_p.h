@@ -0,0 +1,85 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKPLUGINLAZYSERVICEFACTORY_P_H
+#define CTKPLUGINLAZYSERVICEFACTORY_P_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+#include "ctkServiceFactory.h"
+#include "ctkServiceReference.h"
+
+class ctkPluginPrivate;
+
+/**
+ * \ingroup PluginFramework
+ *
+ * Service factory registered by the framework on behalf of a lazily
+ * started plugin, for each service declared in its
+ * ctkPluginConstants::PLUGIN_LAZYSERVICES manifest header.
+ *
+ * The plugin library is not loaded until one of these services is
+ * requested. The first getService() call activates the plugin (see
+ * ctkServiceReferencePrivate::getService) and the factory then hands
+ * out the matching service object the plugin registered in its
+ * ctkPluginActivator::start() method.
+ */
+class ctkPluginLazyServiceFactory : public QObject, public ctkServiceFactory
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkServiceFactory)
+
+public:
+
+  ctkPluginLazyServiceFactory(ctkPluginPrivate* plugin, const QStringList& classes);
+
+  /**
+   * Waits for the activation of the plugin and returns the best matching
+   * service the plugin registered in place of the placeholder.
+   *
+   * @throws ctkServiceException if the plugin was not activated or did
+   *         not register a matching service.
+   */
+  ctkServiceReference findDelegate(const ctkServiceReference& placeholder);
+
+  QObject* getService(QSharedPointer<ctkPlugin> plugin, ctkServiceRegistration registration);
+  void ungetService(QSharedPointer<ctkPlugin> plugin, ctkServiceRegistration registration, QObject* service);
+
+private:
+
+  ctkPluginPrivate* const plugin;
+  const QStringList classes;
+
+  QMutex delegatesMutex;
+
+  /**
+   * The service references of the real services, handed out to
+   * each requesting plugin.
+   */
+  QHash<QSharedPointer<ctkPlugin>, ctkServiceReference> delegates;
+
+};
+
+#endif // CTKPLUGINLAZYSERVICEFACTORY_P_H
@@ -23,6 +23,7 @@
 
 #include <QStringList>
 #include <QIODevice>
+#include <QDataStream>
 #include <QDebug>
 
 #include <ctkException.h>
@@ -144,3 +145,17 @@ QStringList ctkPluginManifest::getSections() const
 {
   return sections.keys();
 }
+
+//----------------------------------------------------------------------------
+QDataStream& operator<<(QDataStream& out, const ctkPluginManifest& manifest)
+{
+  out << manifest.mainAttributes << manifest.sections;
+  return out;
+}
+
+//----------------------------------------------------------------------------
+QDataStream& operator>>(QDataStream& in, ctkPluginManifest& manifest)
+{
+  in >> manifest.mainAttributes >> manifest.sections;
+  return in;
+}
@@ -26,6 +26,7 @@
 #include <QStringList>
 
 class QIODevice;
+class QDataStream;
 
 /**
  * \ingroup PluginFramework
@@ -53,7 +54,19 @@ private:
   Attributes mainAttributes;
   QHash<QString, Attributes> sections;
 
+  friend QDataStream& operator<<(QDataStream& out, const ctkPluginManifest& manifest);
+  friend QDataStream& operator>>(QDataStream& in, ctkPluginManifest& manifest);
+
 };
 
+/**
+ * \ingroup PluginFramework
+ *
+ * Serializes the already parsed manifest attributes, so that
+ * they can be restored without parsing the MANIFEST.MF again.
+ */
+QDataStream& operator<<(QDataStream& out, const ctkPluginManifest& manifest);
+QDataStream& operator>>(QDataStream& in, ctkPluginManifest& manifest);
+
 
 #endif // CTKPLUGINMANIFEST_P_H
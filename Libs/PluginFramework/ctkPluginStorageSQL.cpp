@@ -28,6 +28,7 @@
 #include "ctkPluginStorage_p.h"
 #include "ctkPluginFrameworkUtil_p.h"
 #include "ctkPluginFrameworkContext_p.h"
+#include "ctkPluginStorageSnapshot_p.h"
 #include "ctkServiceException.h"
 
 #include <QFileInfo>
@@ -54,20 +55,31 @@ enum TBindIndexes
 ctkPluginStorageSQL::ctkPluginStorageSQL(ctkPluginFrameworkContext *framework)
   : m_isDatabaseOpen(false)
   , m_inTransaction(false)
+  , m_openDeferred(false)
+  , m_openLock(QMutex::Recursive)
+  , m_snapshotCurrent(false)
   , m_framework(framework)
   , m_nextFreeId(-1)
 {
   // See if we have a storage database
-  m_databasePath = ctkPluginFrameworkUtil::getFileStorage(framework, "").absoluteFilePath("plugins.db");
+  QDir storageDir = ctkPluginFrameworkUtil::getFileStorage(framework, "");
+  m_databasePath = storageDir.absoluteFilePath("plugins.db");
+  m_snapshotPath = storageDir.absoluteFilePath("plugins.snapshot");
 
-  this->open();
-  restorePluginArchives();
+  // A warm start with unchanged plug-ins does not need the database
+  if (!restoreSnapshot())
+  {
+    this->open();
+    initNextFreeIds();
+    restorePluginArchives();
+  }
 }
 
 //----------------------------------------------------------------------------
 ctkPluginStorageSQL::~ctkPluginStorageSQL()
 {
   close();
+  writeSnapshot();
 }
 
 //----------------------------------------------------------------------------
@@ -124,6 +136,11 @@ void ctkPluginStorageSQL::open()
     }
   }
   m_isDatabaseOpen = true;
+  m_openDeferred = false;
+
+  // The database may change from here on, so the snapshot must not
+  // be used again until it is re-written when the storage is closed
+  discardSnapshot();
 
   //Check if the sqlite version supports foreign key constraints
   QSqlQuery query(database);
@@ -175,8 +192,6 @@ void ctkPluginStorageSQL::open()
 
   //Update database based on the recorded timestamps
   updateDB();
-
-  initNextFreeIds();
 }
 
 //----------------------------------------------------------------------------
@@ -362,6 +377,9 @@ QSharedPointer<ctkPluginArchive> ctkPluginStorageSQL::insertPlugin(const QUrl& l
 {
   QMutexLocker lock(&m_archivesLock);
 
+  // Open a deferred database before using the next free id
+  checkConnection();
+
   QFileInfo fileInfo(localPath);
   if (!fileInfo.exists())
   {
@@ -466,6 +484,7 @@ void ctkPluginStorageSQL::insertArchive(QSharedPointer<ctkPluginArchiveSQL> pa,
   executeQuery(query, statement, bindValues);
 
   pa->key = query->lastInsertId().toInt();
+  m_libTimestamps.insert(pa->key, libTimestamp);
 
   // Write the plug-in resource data into the database
   QDirIterator dirIter(resourcePrefix, QDirIterator::Subdirectories);
@@ -992,6 +1011,19 @@ int ctkPluginStorageSQL::find(ctkPluginArchive *pa) const
 //----------------------------------------------------------------------------
 void ctkPluginStorageSQL::checkConnection() const
 {
+  {
+    // The plugin archives were restored from the snapshot, open
+    // the database on first use. Several threads may access the
+    // storage concurrently, so only one of them may open it.
+    // open() itself calls back into checkConnection() on this
+    // thread, hence the lock is recursive.
+    QMutexLocker lock(&m_openLock);
+    if (m_openDeferred)
+    {
+      const_cast<ctkPluginStorageSQL*>(this)->open();
+    }
+  }
+
   if(!m_isDatabaseOpen)
   {
     throw ctkPluginDatabaseException("Database not open.", ctkPluginDatabaseException::DB_NOT_OPEN_ERROR);
@@ -1065,7 +1097,7 @@ void ctkPluginStorageSQL::restorePluginArchives()
   checkConnection();
 
   QSqlQuery query(QSqlDatabase::database(m_connectionName));
-  QString statement = "SELECT ID, Location, LocalPath, StartLevel, LastModified, AutoStart, K, MAX(Generation)"
+  QString statement = "SELECT ID, Location, LocalPath, StartLevel, LastModified, AutoStart, K, Timestamp, MAX(Generation)"
                       " FROM " PLUGINS_TABLE " WHERE StartLevel != -2 GROUP BY ID"
                       " ORDER BY ID";
 
@@ -1094,6 +1126,7 @@ void ctkPluginStorageSQL::restorePluginArchives()
       pa->key = query.value(EBindIndex6).toInt();
       pa->readManifest();
       m_archives.append(pa);
+      m_libTimestamps.insert(pa->key, query.value(EBindIndex7).toString());
     }
     catch (const ctkPluginException& exc)
     {
@@ -1113,3 +1146,67 @@ QDateTime ctkPluginStorageSQL::getQDateTimeFromString(const QString& dateTimeStr
 {
   return QDateTime::fromString(dateTimeString, Qt::ISODate);
 }
+
+//----------------------------------------------------------------------------
+bool ctkPluginStorageSQL::restoreSnapshot()
+{
+  ctkPluginStorageSnapshot snapshot(m_snapshotPath, m_databasePath);
+  if (!snapshot.read())
+  {
+    return false;
+  }
+
+  foreach(const ctkPluginStorageSnapshot::Entry& entry, snapshot.entries)
+  {
+    QSharedPointer<ctkPluginArchiveSQL> pa(new ctkPluginArchiveSQL(this, entry.location, entry.localPath, entry.id,
+                                                                   entry.startLevel,
+                                                                   getQDateTimeFromString(entry.lastModified),
+                                                                   entry.autostartSetting));
+    pa->key = entry.key;
+    pa->setManifest(entry.manifest);
+    m_archives.append(pa);
+    m_libTimestamps.insert(entry.key, entry.libTimestamp);
+  }
+
+  m_generations = snapshot.generations;
+  m_nextFreeId = snapshot.nextFreeId;
+  m_openDeferred = true;
+  m_snapshotCurrent = true;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginStorageSQL::writeSnapshot()
+{
+  if (m_snapshotCurrent || m_openDeferred) return;
+
+  ctkPluginStorageSnapshot snapshot(m_snapshotPath, m_databasePath);
+  snapshot.nextFreeId = m_nextFreeId;
+  snapshot.generations = m_generations;
+
+  foreach(QSharedPointer<ctkPluginArchive> archive, m_archives)
+  {
+    ctkPluginArchiveSQL* pa = static_cast<ctkPluginArchiveSQL*>(archive.data());
+
+    ctkPluginStorageSnapshot::Entry entry;
+    entry.key = pa->key;
+    entry.id = pa->getPluginId();
+    entry.location = pa->getPluginLocation();
+    entry.localPath = pa->getLibLocation();
+    entry.libTimestamp = m_libTimestamps.value(pa->key);
+    entry.startLevel = pa->getStartLevel();
+    entry.lastModified = getStringFromQDateTime(pa->getLastModified());
+    entry.autostartSetting = pa->getAutostartSetting();
+    entry.manifest = pa->getManifest();
+    snapshot.entries.push_back(entry);
+  }
+
+  m_snapshotCurrent = snapshot.write();
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginStorageSQL::discardSnapshot()
+{
+  ctkPluginStorageSnapshot(m_snapshotPath, m_databasePath).remove();
+  m_snapshotCurrent = false;
+}
@@ -235,7 +235,29 @@ private:
    * @throws ctkPluginDatabaseException
    */
   void restorePluginArchives();
-  
+
+  /**
+   * Restores the plugin archives from the binary meta-data snapshot,
+   * without opening the database.
+   *
+   * @return \c true if a valid snapshot was found and all plugin archives
+   *         have been restored.
+   */
+  bool restoreSnapshot();
+
+  /**
+   * Writes the current plugin archive state to the binary meta-data
+   * snapshot, used for fast warm starts.
+   */
+  void writeSnapshot();
+
+  /**
+   * Removes the on-disk snapshot when the database is opened, so that
+   * a stale snapshot is never used if the framework terminates
+   * unexpectedly.
+   */
+  void discardSnapshot();
+
   /**
    * Get load hints from the framework for plugins.
    */
@@ -334,6 +356,30 @@ private:
   bool m_isDatabaseOpen;
   bool m_inTransaction;
 
+  QString m_snapshotPath;
+
+  /**
+   * True if the plugin archives were restored from the snapshot and
+   * the database has not been opened yet.
+   */
+  bool m_openDeferred;
+
+  /**
+   * Serializes opening the database on first use. Recursive, as
+   * open() re-enters checkConnection().
+   */
+  mutable QMutex m_openLock;
+
+  /**
+   * True if the on-disk snapshot reflects the current state.
+   */
+  bool m_snapshotCurrent;
+
+  /**
+   * The library time stamps as recorded in the database
+   */
+  QHash<int,QString> /* <archive key, timestamp> */ m_libTimestamps;
+
   QMutex m_archivesLock;
 
   /**
@@ -0,0 +1,192 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkPluginStorageSnapshot_p.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+
+namespace {
+
+// "CTKS" in ASCII
+const quint32 SNAPSHOT_MAGIC = 0x43544b53;
+// Increase the version whenever the snapshot layout changes
+const quint32 SNAPSHOT_VERSION = 1;
+
+}
+
+//----------------------------------------------------------------------------
+ctkPluginStorageSnapshot::Entry::Entry()
+  : key(-1), id(-1), startLevel(-1), autostartSetting(-1)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkPluginStorageSnapshot::ctkPluginStorageSnapshot(const QString& snapshotPath, const QString& databasePath)
+  : nextFreeId(-1), snapshotPath(snapshotPath), databasePath(databasePath)
+{
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginStorageSnapshot::getDatabaseStamp(qint64* size, qint64* lastModified) const
+{
+  QFileInfo dbFileInfo(databasePath);
+  if (!dbFileInfo.exists()) return false;
+
+  *size = dbFileInfo.size();
+  *lastModified = dbFileInfo.lastModified().toMSecsSinceEpoch();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginStorageSnapshot::read()
+{
+  entries.clear();
+  generations.clear();
+
+  qint64 dbSize = 0;
+  qint64 dbLastModified = 0;
+  if (!getDatabaseStamp(&dbSize, &dbLastModified)) return false;
+
+  QFile file(snapshotPath);
+  if (!file.open(QIODevice::ReadOnly) || file.size() == 0) return false;
+
+  uchar* data = file.map(0, file.size());
+  QByteArray buffer = data ? QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size())
+                           : file.readAll();
+
+  QDataStream in(buffer);
+  in.setVersion(QDataStream::Qt_4_6);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  qint64 snapshotDbSize = -1;
+  qint64 snapshotDbLastModified = -1;
+  quint32 count = 0;
+  in >> magic >> version;
+  if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+  {
+    return false;
+  }
+
+  in >> snapshotDbSize >> snapshotDbLastModified;
+  if (snapshotDbSize != dbSize || snapshotDbLastModified != dbLastModified)
+  {
+    // the database was changed behind our back
+    return false;
+  }
+
+  in >> nextFreeId >> generations >> count;
+
+  bool valid = in.status() == QDataStream::Ok;
+  for (quint32 i = 0; valid && i < count; ++i)
+  {
+    Entry entry;
+    qint64 id = 0;
+    in >> entry.key >> id >> entry.location >> entry.localPath
+       >> entry.libTimestamp >> entry.startLevel >> entry.lastModified
+       >> entry.autostartSetting >> entry.manifest;
+    entry.id = static_cast<long>(id);
+
+    if (in.status() != QDataStream::Ok)
+    {
+      valid = false;
+      break;
+    }
+
+    // A plugin library has been modified since the snapshot was taken,
+    // so its meta-data must be refreshed from the plugin itself.
+    const QDateTime libLastModified = QFileInfo(entry.localPath).lastModified();
+    if (libLastModified.toString(Qt::ISODate) != entry.libTimestamp)
+    {
+      valid = false;
+      break;
+    }
+
+    entries.push_back(entry);
+  }
+
+  // QByteArray::fromRawData does not copy, so release the buffer
+  // before unmapping the file.
+  buffer.clear();
+  if (data) file.unmap(data);
+
+  if (!valid)
+  {
+    entries.clear();
+    generations.clear();
+  }
+  return valid;
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginStorageSnapshot::write() const
+{
+  qint64 dbSize = 0;
+  qint64 dbLastModified = 0;
+  if (!getDatabaseStamp(&dbSize, &dbLastModified)) return false;
+
+  const QString tmpPath = snapshotPath + ".tmp";
+  QFile file(tmpPath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    qWarning() << "Could not write plugin storage snapshot" << tmpPath << ":" << file.errorString();
+    return false;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_4_6);
+
+  out << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << dbSize << dbLastModified
+      << nextFreeId << generations << static_cast<quint32>(entries.size());
+
+  foreach(const Entry& entry, entries)
+  {
+    out << entry.key << static_cast<qint64>(entry.id) << entry.location << entry.localPath
+        << entry.libTimestamp << entry.startLevel << entry.lastModified
+        << entry.autostartSetting << entry.manifest;
+  }
+
+  file.close();
+  if (out.status() != QDataStream::Ok || file.error() != QFile::NoError)
+  {
+    QFile::remove(tmpPath);
+    return false;
+  }
+
+  QFile::remove(snapshotPath);
+  if (!QFile::rename(tmpPath, snapshotPath))
+  {
+    QFile::remove(tmpPath);
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginStorageSnapshot::remove() const
+{
+  QFile::remove(snapshotPath);
+}
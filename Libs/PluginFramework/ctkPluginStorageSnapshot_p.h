@@ -0,0 +1,112 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKPLUGINSTORAGESNAPSHOT_P_H
+#define CTKPLUGINSTORAGESNAPSHOT_P_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QUrl>
+
+#include "ctkPluginManifest_p.h"
+
+/**
+ * \ingroup PluginFramework
+ *
+ * Compact binary snapshot of the plugin storage meta-data.
+ *
+ * The snapshot contains everything which is needed to re-create the
+ * plugin archives on a warm start: the parsed manifests, start levels,
+ * auto-start settings and the library time stamps which were recorded
+ * in the plugin database. It is memory-mapped when read and validated
+ * by comparing file system time stamps only. If the snapshot is valid,
+ * the plugin database does not need to be opened until a plugin resource
+ * is requested or the persistent state changes.
+ */
+class ctkPluginStorageSnapshot
+{
+
+public:
+
+  struct Entry
+  {
+    Entry();
+
+    int key;
+    long id;
+    QUrl location;
+    QString localPath;
+    QString libTimestamp;
+    int startLevel;
+    QString lastModified;
+    int autostartSetting;
+    ctkPluginManifest manifest;
+  };
+
+  /**
+   * Create a snapshot located at \a snapshotPath, which describes the
+   * content of the plugin database at \a databasePath.
+   */
+  ctkPluginStorageSnapshot(const QString& snapshotPath, const QString& databasePath);
+
+  /**
+   * Memory-map and read the snapshot file.
+   *
+   * @return \c false if the snapshot does not exist, is corrupt or
+   *         outdated with respect to the plugin database or any of
+   *         the plugin libraries. The snapshot content is undefined
+   *         in that case.
+   */
+  bool read();
+
+  /**
+   * Write the snapshot to disk, replacing an existing snapshot file.
+   *
+   * @return \c true on success.
+   */
+  bool write() const;
+
+  /**
+   * Remove the snapshot file from disk.
+   */
+  void remove() const;
+
+  QList<Entry> entries;
+
+  qint64 nextFreeId;
+
+  /**
+   * Next free generation for each plugin id
+   */
+  QHash<int,int> generations;
+
+private:
+
+  bool getDatabaseStamp(qint64* size, qint64* lastModified) const;
+
+  QString snapshotPath;
+  QString databasePath;
+
+};
+
+#endif // CTKPLUGINSTORAGESNAPSHOT_P_H
@@ -24,9 +24,11 @@
 #include "ctkPluginDatabaseException.h"
 #include "ctkPluginArchive_p.h"
 #include "ctkPluginFrameworkContext_p.h"
+#include "ctkPluginFrameworkMetricsRecorder_p.h"
 #include "ctkPluginFrameworkUtil_p.h"
 #include "ctkPluginActivator.h"
 #include "ctkPluginContext_p.h"
+#include "ctkPluginLazyServiceFactory_p.h"
 
 #include "ctkServiceReference_p.h"
 #include "ctkServiceRegistration.h"
@@ -35,6 +37,8 @@
 // for ctk::msecsTo() - remove after switching to Qt 4.7
 #include <ctkUtils.h>
 
+#include <QThread>
+
 #include <typeinfo>
 
 const ctkPlugin::States ctkPluginPrivate::RESOLVED_FLAGS = ctkPlugin::RESOLVED | ctkPlugin::STARTING | ctkPlugin::ACTIVE | ctkPlugin::STOPPING;
@@ -168,6 +172,7 @@ ctkPluginPrivate::ctkPluginPrivate(QWeakPointer<ctkPlugin> qq,
 ctkPluginPrivate::~ctkPluginPrivate()
 {
   qDeleteAll(require);
+  qDeleteAll(lazyServiceFactories);
 }
 
 //----------------------------------------------------------------------------
@@ -338,6 +343,7 @@ void ctkPluginPrivate::checkManifestHeaders()
 //----------------------------------------------------------------------------
 void ctkPluginPrivate::finalizeActivation()
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::PLUGIN_START);
   Locker sync(&operationLock);
 
   // 4: Resolve plugin (if needed)
@@ -367,7 +373,9 @@ void ctkPluginPrivate::finalizeActivation()
     startDependencies();
     //TODO plugin threading
     //ctkRuntimeException* e = bundleThread().callStart0(this);
+    activatingThread.fetchAndStoreOrdered(QThread::currentThread());
     ctkRuntimeException* e = start0();
+    activatingThread.fetchAndStoreOrdered(0);
     operation.fetchAndStoreOrdered(IDLE);
     operationLock.wakeAll();
     if (e)
@@ -556,6 +564,7 @@ void ctkPluginPrivate::update0(const QUrl& updateLocation, bool wasActive)
   archive = newArchive;
   cachedRawHeaders.clear();
   state = ctkPlugin::INSTALLED;
+  modified();
 
   // Purge old archive
   if (purgeOld)
@@ -716,6 +725,85 @@ void ctkPluginPrivate::startDependencies()
   }
 }
 
+//----------------------------------------------------------------------------
+void ctkPluginPrivate::registerLazyServices()
+{
+  const QString lazyServices = archive->getAttribute(ctkPluginConstants::PLUGIN_LAZYSERVICES);
+  if (lazyServices.isEmpty()) return;
+
+  QList<QMap<QString, QStringList> > entries;
+  try
+  {
+    entries = ctkPluginFrameworkUtil::parseEntries(ctkPluginConstants::PLUGIN_LAZYSERVICES,
+                                                   lazyServices, false, true, false);
+  }
+  catch (const ctkInvalidArgumentException& e)
+  {
+    fwCtx->listeners.frameworkError(this->q_func(), e);
+    return;
+  }
+
+  QListIterator<QMap<QString, QStringList> > i(entries);
+  while (i.hasNext())
+  {
+    const QMap<QString, QStringList>& e = i.next();
+    const QStringList classes = e.value("$keys");
+
+    ctkDictionary props;
+    for (QMap<QString, QStringList>::const_iterator attr = e.begin(); attr != e.end(); ++attr)
+    {
+      if (!attr.key().startsWith('$'))
+      {
+        props.insert(attr.key(), attr.value().front());
+      }
+    }
+
+    ctkPluginLazyServiceFactory* factory = new ctkPluginLazyServiceFactory(this, classes);
+    lazyServiceFactories.push_back(factory);
+    if (fwCtx->debug.lazy_activation)
+    {
+      qDebug() << "registering lazy service" << classes << "for #" << id;
+    }
+    lazyServiceRegistrations.push_back(pluginContext->registerService(classes, factory, props));
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginPrivate::isActivatingThread()
+{
+  QThread* current = QThread::currentThread();
+  return activatingThread.testAndSetOrdered(current, current);
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginPrivate::unregisterLazyServices()
+{
+  QList<ctkServiceRegistration> srs;
+  {
+    Locker sync(&operationLock);
+    if (state != ctkPlugin::ACTIVE) return;
+    srs = lazyServiceRegistrations;
+    lazyServiceRegistrations.clear();
+  }
+
+  QMutableListIterator<ctkServiceRegistration> i(srs);
+  while (i.hasNext())
+  {
+    if (fwCtx->debug.lazy_activation)
+    {
+      qDebug() << "unregistering lazy service placeholder for #" << id;
+    }
+    try
+    {
+      i.next().unregister();
+    }
+    catch (const ctkIllegalStateException& /*ignore*/)
+    {
+      // The placeholder was already removed by stopping the plugin
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 ctkPluginException* ctkPluginPrivate::start0()
 {
@@ -819,4 +907,9 @@ void ctkPluginPrivate::removePluginResources()
     i2.next().getReference().d_func()->ungetService(q_func(), false);
   }
 
+  // The lazy service placeholders have been unregistered above
+  lazyServiceRegistrations.clear();
+  qDeleteAll(lazyServiceFactories);
+  lazyServiceFactories.clear();
+
 }
@@ -25,7 +25,9 @@
 #include "ctkPlugin.h"
 #include "ctkPluginException.h"
 #include "ctkRequirePlugin_p.h"
+#include "ctkServiceRegistration.h"
 
+#include <QAtomicPointer>
 #include <QHash>
 #include <QPluginLoader>
 #include <QDateTime>
@@ -33,10 +35,12 @@
 #include <QMutex>
 #include <QWaitCondition>
 
+class QThread;
 
 class ctkPluginActivator;
 class ctkPluginArchive;
 class ctkPluginFrameworkContext;
+class ctkPluginLazyServiceFactory;
 
 /**
  * \ingroup PluginFramework
@@ -275,6 +279,11 @@ public:
 
   LockObject operationLock;
 
+  /**
+   * The thread running the activator while operation is ACTIVATING.
+   */
+  QAtomicPointer<QThread> activatingThread;
+
   /** Saved exception of resolve failure. */
   ctkPluginException* resolveFailException;
 
@@ -287,6 +296,31 @@ public:
   /** List of ctkRequirePlugin entries. */
   QList<ctkRequirePlugin*> require;
 
+  /**
+   * Placeholder factories for the services declared in the
+   * Plugin-LazyServices manifest header.
+   */
+  QList<ctkPluginLazyServiceFactory*> lazyServiceFactories;
+
+  /**
+   * Registrations of the lazy service placeholders, unregistered
+   * once the plugin is active.
+   */
+  QList<ctkServiceRegistration> lazyServiceRegistrations;
+
+  /**
+   * Check if the activator of this plugin is currently running in the
+   * calling thread.
+   */
+  bool isActivatingThread();
+
+  /**
+   * Unregister the lazy service placeholders after the plugin has been
+   * activated. Requests are then served by the services registered by
+   * the activator.
+   */
+  void unregisterLazyServices();
+
 private:
 
   /** Rember if plugin was started */
@@ -303,6 +337,12 @@ private:
 
   void startDependencies();
 
+  /**
+   * Register the services declared in the Plugin-LazyServices manifest
+   * header, without loading the plugin library.
+   */
+  void registerLazyServices();
+
   /**
    * Remove a plugins registered listeners, registered services and
    * used services.
@@ -0,0 +1,211 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkServiceObjects.h"
+#include "ctkServiceObjects_p.h"
+
+#include "ctkException.h"
+#include "ctkPlugin.h"
+#include "ctkServiceReference_p.h"
+#include "ctkServiceRegistration_p.h"
+
+#include <QMutexLocker>
+#include <QReadWriteLock>
+
+//----------------------------------------------------------------------------
+ctkServiceObjectsPrivate::ctkServiceObjectsPrivate(QSharedPointer<ctkPlugin> plugin,
+                                                   const ctkServiceReference& reference)
+  : ref(1), plugin(plugin), reference(reference), useCount(0), service(0)
+{
+
+}
+
+//----------------------------------------------------------------------------
+ctkServiceObjectsPrivate::~ctkServiceObjectsPrivate()
+{
+  if (useCount.fetchAndStoreOrdered(0) > 0)
+  {
+    release();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkServiceObjectsPrivate::release()
+{
+  QSharedPointer<ctkPlugin> p = plugin.toStrongRef();
+  if (p)
+  {
+    reference.d_func()->ungetService(p, true);
+  }
+  service = 0;
+}
+
+//----------------------------------------------------------------------------
+ctkServiceObjects::ctkServiceObjects()
+  : d(0)
+{
+
+}
+
+//----------------------------------------------------------------------------
+ctkServiceObjects::ctkServiceObjects(ctkServiceObjectsPrivate* d)
+  : d(d)
+{
+
+}
+
+//----------------------------------------------------------------------------
+ctkServiceObjects::ctkServiceObjects(const ctkServiceObjects& other)
+  : d(other.d)
+{
+  if (d) d->ref.ref();
+}
+
+//----------------------------------------------------------------------------
+ctkServiceObjects& ctkServiceObjects::operator=(const ctkServiceObjects& other)
+{
+  ctkServiceObjectsPrivate* curr_d = d;
+  d = other.d;
+  if (d) d->ref.ref();
+
+  if (curr_d && !curr_d->ref.deref())
+    delete curr_d;
+
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+ctkServiceObjects::~ctkServiceObjects()
+{
+  if (d && !d->ref.deref())
+    delete d;
+}
+
+//----------------------------------------------------------------------------
+ctkServiceObjects::operator bool() const
+{
+  return d != 0;
+}
+
+//----------------------------------------------------------------------------
+QObject* ctkServiceObjects::getService()
+{
+  if (!d) return 0;
+
+  ctkServiceRegistrationPrivate* registration = d->reference.d_func()->registration;
+
+  // Fast path: the service is already held by this handle. The read lock
+  // keeps the registration from being unregistered while the cached
+  // service object is handed out.
+  {
+    QReadLocker lock(&registration->usageLock);
+    if (registration->available)
+    {
+      for (int c = d->useCount.fetchAndAddOrdered(0); c > 0; c = d->useCount.fetchAndAddOrdered(0))
+      {
+        if (d->useCount.testAndSetOrdered(c, c + 1))
+        {
+          return d->service;
+        }
+      }
+    }
+  }
+
+  QMutexLocker lock(&d->acquireLock);
+  if (d->useCount.fetchAndAddOrdered(0) > 0)
+  {
+    QReadLocker lock2(&registration->usageLock);
+    if (registration->available)
+    {
+      d->useCount.ref();
+      return d->service;
+    }
+  }
+
+  // The service was unregistered since it was acquired. The Framework
+  // already released it, so just forget the stale service object.
+  if (d->useCount.fetchAndStoreOrdered(0) > 0)
+  {
+    d->service = 0;
+  }
+
+  QSharedPointer<ctkPlugin> p = d->plugin.toStrongRef();
+  if (!p) return 0;
+
+  QObject* s = d->reference.d_func()->getService(p);
+  if (s)
+  {
+    d->service = s;
+    d->useCount.fetchAndStoreOrdered(1);
+  }
+  return s;
+}
+
+//----------------------------------------------------------------------------
+void ctkServiceObjects::ungetService(QObject* service)
+{
+  if (service == 0) return;
+
+  if (d)
+  {
+    ctkServiceRegistrationPrivate* registration = d->reference.d_func()->registration;
+    QReadLocker lock(&registration->usageLock);
+    if (!registration->available)
+    {
+      // The Framework released the service when it was unregistered
+      return;
+    }
+  }
+
+  if (!d || d->useCount.fetchAndAddOrdered(0) <= 0 || d->service != service)
+  {
+    throw ctkInvalidArgumentException("The provided service object was not "
+                                      "provided by this ctkServiceObjects object");
+  }
+
+  // Fast path: the use count does not drop to zero
+  for (int c = d->useCount.fetchAndAddOrdered(0); c > 1; c = d->useCount.fetchAndAddOrdered(0))
+  {
+    if (d->useCount.testAndSetOrdered(c, c - 1))
+    {
+      return;
+    }
+  }
+
+  QMutexLocker lock(&d->acquireLock);
+  if (d->useCount.testAndSetOrdered(1, 0))
+  {
+    d->release();
+  }
+  else if (d->useCount.fetchAndAddOrdered(0) > 1)
+  {
+    // A concurrent getService() incremented the use count
+    d->useCount.deref();
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkServiceReference ctkServiceObjects::getServiceReference() const
+{
+  if (!d) return ctkServiceReference();
+  return d->reference;
+}
@@ -0,0 +1,123 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKSERVICEOBJECTS_H
+#define CTKSERVICEOBJECTS_H
+
+#include "ctkServiceReference.h"
+
+#include "ctkPluginFrameworkExport.h"
+
+class ctkServiceObjectsPrivate;
+
+/**
+ * \ingroup PluginFramework
+ *
+ * A handle for repeatedly getting and releasing the service object of a
+ * registered service on behalf of a plugin.
+ *
+ * <p>
+ * A <code>ctkServiceObjects</code> object is obtained by calling
+ * ctkPluginContext::getServiceObjects(const ctkServiceReference&). The
+ * first call to getService() acquires the service object from the
+ * Framework, exactly like ctkPluginContext::getService(). As long as the
+ * handle holds the service, further getService() and ungetService() calls
+ * only update a counter local to this handle and do not touch the service
+ * registry. The service is released to the Framework when the number of
+ * outstanding getService() calls drops to zero or when the last copy of the
+ * handle is destroyed.
+ *
+ * <p>
+ * This is intended for code which gets and ungets the same service for
+ * each request it processes. Such code should keep the handle around, for
+ * example as a member of the request handler or in thread-local storage.
+ *
+ * @remarks This class is thread safe.
+ */
+class CTK_PLUGINFW_EXPORT ctkServiceObjects
+{
+
+public:
+
+  /**
+   * Creates an invalid ctkServiceObjects object.
+   */
+  ctkServiceObjects();
+
+  ctkServiceObjects(const ctkServiceObjects& other);
+
+  ctkServiceObjects& operator=(const ctkServiceObjects& other);
+
+  ~ctkServiceObjects();
+
+  /**
+   * Returns <code>true</code> if this handle was obtained from a
+   * ctkPluginContext and <code>false</code> if it was default constructed.
+   */
+  operator bool() const;
+
+  /**
+   * Returns the service object for the associated service.
+   *
+   * @return A service object for the associated service or <code>0</code>
+   *         if the service is not registered or the service object could
+   *         not be created.
+   * @see ctkPluginContext::getService(const ctkServiceReference&)
+   */
+  QObject* getService();
+
+  /**
+   * Convenience method which casts the result of getService() to the
+   * supplied template argument type.
+   */
+  template<class S>
+  S* getService()
+  {
+    return qobject_cast<S*>(getService());
+  }
+
+  /**
+   * Releases a service object previously returned by getService().
+   *
+   * @param service A service object previously provided by this
+   *        <code>ctkServiceObjects</code> object.
+   * @throws ctkInvalidArgumentException If the specified service was not
+   *         provided by this <code>ctkServiceObjects</code> object.
+   */
+  void ungetService(QObject* service);
+
+  /**
+   * Returns the ctkServiceReference for the service associated with this
+   * <code>ctkServiceObjects</code> object.
+   */
+  ctkServiceReference getServiceReference() const;
+
+private:
+
+  friend class ctkPluginContext;
+
+  ctkServiceObjects(ctkServiceObjectsPrivate* d);
+
+  ctkServiceObjectsPrivate* d;
+};
+
+#endif // CTKSERVICEOBJECTS_H
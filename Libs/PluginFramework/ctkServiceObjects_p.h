@@ -0,0 +1,75 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKSERVICEOBJECTS_P_H
+#define CTKSERVICEOBJECTS_P_H
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QSharedPointer>
+
+#include "ctkServiceReference.h"
+
+class ctkPlugin;
+
+/**
+ * \ingroup PluginFramework
+ */
+class ctkServiceObjectsPrivate
+{
+public:
+
+  ctkServiceObjectsPrivate(QSharedPointer<ctkPlugin> plugin, const ctkServiceReference& reference);
+
+  ~ctkServiceObjectsPrivate();
+
+  /**
+   * Releases the Framework use of the service. Must be called
+   * after useCount has been set to zero.
+   */
+  void release();
+
+  QAtomicInt ref;
+
+  QWeakPointer<ctkPlugin> plugin;
+  ctkServiceReference reference;
+
+  /**
+   * Number of unbalanced getService() calls made through this handle.
+   * The Framework use count of the service is incremented once while
+   * this is greater than zero.
+   */
+  QAtomicInt useCount;
+
+  /**
+   * The service object, only valid while useCount is greater than zero
+   * and the service registration is still available.
+   */
+  QObject* service;
+
+  /**
+   * Serializes acquiring and releasing the service from the Framework.
+   */
+  QMutex acquireLock;
+};
+
+#endif // CTKSERVICEOBJECTS_P_H
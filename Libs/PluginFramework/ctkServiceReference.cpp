@@ -111,7 +111,7 @@ QList<QSharedPointer<ctkPlugin> > ctkServiceReference::getUsingPlugins() const
 {
   Q_D(const ctkServiceReference);
 
-  QMutexLocker lock(&d->registration->propsLock);
+  QReadLocker lock(&d->registration->usageLock);
 
   return d->registration->dependents.keys();
 }
@@ -201,6 +201,7 @@ protected:
   friend class ctkPluginContext;
   friend class ctkPluginPrivate;
   friend class ctkPluginFrameworkListeners;
+  friend class ctkServiceObjectsPrivate;
   template<class S, class T> friend class ctkServiceTracker;
   template<class S, class T> friend class ctkServiceTrackerPrivate;
   template<class S, class R, class T> friend class ctkPluginAbstractTracked;
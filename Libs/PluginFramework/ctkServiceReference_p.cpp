@@ -26,6 +26,8 @@
 
 #include "ctkPlugin_p.h"
 #include "ctkPluginConstants.h"
+#include "ctkPluginContext.h"
+#include "ctkPluginLazyServiceFactory_p.h"
 #include "ctkPluginFrameworkContext_p.h"
 #include "ctkServiceFactory.h"
 #include "ctkServiceException.h"
@@ -49,19 +51,89 @@ ctkServiceReferencePrivate::~ctkServiceReferencePrivate()
 //----------------------------------------------------------------------------
 QObject* ctkServiceReferencePrivate::getService(QSharedPointer<ctkPlugin> plugin)
 {
+  // A plugin started with its lazy activation policy is activated on the
+  // first request for one of its services. This must happen before the
+  // registration is locked, since the activator registers services and
+  // failed activations unregister them. If another thread is activating
+  // the plugin, finalizeActivation() waits for it to finish. Requests made
+  // by the activator itself are served by the placeholder, which rejects
+  // them.
+  ctkPluginPrivate* owner = registration->plugin;
+  if (owner && owner->state == ctkPlugin::STARTING && !owner->isActivatingThread())
+  {
+    try
+    {
+      owner->finalizeActivation();
+    }
+    catch (const ctkException& e)
+    {
+      owner->fwCtx->listeners.frameworkError(owner->q_func(), e);
+      return 0;
+    }
+
+    ctkPluginLazyServiceFactory* factory = 0;
+    {
+      QReadLocker lock(&registration->usageLock);
+      if (registration->available)
+      {
+        factory = qobject_cast<ctkPluginLazyServiceFactory*>(registration->getService());
+      }
+    }
+
+    if (factory)
+    {
+      // Serve this request with the service the activator registered, so
+      // the placeholder can be unregistered right away. The use is
+      // released again through the placeholder, see ungetService().
+      ctkPluginContext* context = plugin->getPluginContext();
+      QObject* s = 0;
+      try
+      {
+        ctkServiceReference delegate = factory->findDelegate(registration->reference);
+        s = context ? context->getService(delegate) : 0;
+        if (s)
+        {
+          QWriteLocker lock(&registration->usageLock);
+          registration->forwards.insert(plugin, delegate);
+        }
+      }
+      catch (const ctkException& e)
+      {
+        owner->fwCtx->listeners.frameworkError(owner->q_func(), e);
+      }
+      owner->unregisterLazyServices();
+      return s;
+    }
+  }
+
+  // Fast path: the plugin already uses the service, so only its use
+  // count needs to be incremented.
+  {
+    QReadLocker lock(&registration->usageLock);
+    if (!registration->available) return 0;
+
+    QHash<QSharedPointer<ctkPlugin>, QAtomicInt>::const_iterator i =
+        registration->dependents.constFind(plugin);
+    if (i != registration->dependents.constEnd())
+    {
+      // The counter is never zero while the read lock is held
+      const_cast<QAtomicInt&>(i.value()).ref();
+      QObject* s = registration->serviceInstances.value(plugin);
+      return s ? s : registration->getService();
+    }
+  }
+
   QObject* s = 0;
   {
-    QMutexLocker lock(&registration->propsLock);
+    QWriteLocker lock(&registration->usageLock);
     if (registration->available)
     {
-      int count = registration->dependents.value(plugin);
-      if (count == 0)
+      QHash<QSharedPointer<ctkPlugin>, QAtomicInt>::iterator i = registration->dependents.find(plugin);
+      if (i == registration->dependents.end())
       {
-        QStringList classes =
-            registration->properties.value(ctkPluginConstants::OBJECTCLASS).toStringList();
-        registration->dependents[plugin] = 1;
         if (ctkServiceFactory* serviceFactory = qobject_cast<ctkServiceFactory*>(registration->getService()))
         {
+          QStringList classes = getProperty(ctkPluginConstants::OBJECTCLASS, true).toStringList();
           try
           {
             s = serviceFactory->getService(plugin, ctkServiceRegistration(registration));
@@ -98,15 +170,14 @@ QObject* ctkServiceReferencePrivate::getService(QSharedPointer<ctkPlugin> plugin
         {
           s = registration->getService();
         }
+        registration->dependents.insert(plugin, QAtomicInt(1));
       }
       else
       {
-        registration->dependents.insert(plugin, count + 1);
-        if (qobject_cast<ctkServiceFactory*>(registration->getService()))
-        {
-          s = registration->serviceInstances.value(plugin);
-        }
-        else
+        // Another thread acquired the service for this plugin in the meantime
+        i.value().ref();
+        s = registration->serviceInstances.value(plugin);
+        if (s == 0)
         {
           s = registration->getService();
         }
@@ -119,52 +190,76 @@ QObject* ctkServiceReferencePrivate::getService(QSharedPointer<ctkPlugin> plugin
 //----------------------------------------------------------------------------
 bool ctkServiceReferencePrivate::ungetService(QSharedPointer<ctkPlugin> plugin, bool checkRefCounter)
 {
-  QMutexLocker lock(&registration->propsLock);
-  bool hadReferences = false;
-  bool removeService = false;
-
-  int count= registration->dependents.value(plugin);
-  if (count > 0)
+  if (checkRefCounter)
   {
-    hadReferences = true;
-  }
-
-  if(checkRefCounter)
-  {
-    if (count > 1)
+    // Fast path: decrement the use count as long as it does not drop
+    // to zero, which would require removing the plugin from the
+    // dependents.
+    QReadLocker lock(&registration->usageLock);
+    QHash<QSharedPointer<ctkPlugin>, QAtomicInt>::const_iterator i =
+        registration->dependents.constFind(plugin);
+    if (i == registration->dependents.constEnd())
     {
-      registration->dependents[plugin] = count - 1;
+      if (registration->forwards.isEmpty()) return false;
+      lock.unlock();
+      return ungetForward(plugin);
     }
-    else if(count == 1)
+
+    QAtomicInt& count = const_cast<QAtomicInt&>(i.value());
+    for (int c = count.fetchAndAddOrdered(0); c > 1; c = count.fetchAndAddOrdered(0))
     {
-      removeService = true;
+      if (count.testAndSetOrdered(c, c - 1))
+      {
+        return true;
+      }
     }
   }
-  else
+
+  QWriteLocker lock(&registration->usageLock);
+
+  QHash<QSharedPointer<ctkPlugin>, QAtomicInt>::iterator i = registration->dependents.find(plugin);
+  if (i == registration->dependents.end())
+  {
+    if (!checkRefCounter || registration->forwards.isEmpty()) return false;
+    lock.unlock();
+    return ungetForward(plugin);
+  }
+
+  if (checkRefCounter && i.value().deref())
   {
-    removeService = true;
+    return true;
   }
 
-  if (removeService)
+  QObject* sfi = registration->serviceInstances.take(plugin);
+  registration->dependents.erase(i);
+  if (sfi != 0)
   {
-    QObject* sfi = registration->serviceInstances[plugin];
-    registration->serviceInstances.remove(plugin);
-    if (sfi != 0)
+    try
     {
-      try
-      {
-        qobject_cast<ctkServiceFactory*>(
-              registration->getService())->ungetService(plugin, ctkServiceRegistration(registration), sfi);
-      }
-      catch (const ctkException& e)
-      {
-        plugin->d_func()->fwCtx->listeners.frameworkError(registration->plugin->q_func(), e);
-      }
+      qobject_cast<ctkServiceFactory*>(
+            registration->getService())->ungetService(plugin, ctkServiceRegistration(registration), sfi);
+    }
+    catch (const ctkException& e)
+    {
+      plugin->d_func()->fwCtx->listeners.frameworkError(registration->plugin->q_func(), e);
     }
-    registration->dependents.remove(plugin);
   }
 
-  return hadReferences;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkServiceReferencePrivate::ungetForward(QSharedPointer<ctkPlugin> plugin)
+{
+  ctkServiceReference delegate;
+  {
+    QWriteLocker lock(&registration->usageLock);
+    delegate = registration->forwards.take(plugin);
+  }
+
+  ctkPluginContext* context = plugin->getPluginContext();
+  if (!delegate || !context) return false;
+  return context->ungetService(delegate);
 }
 
 //----------------------------------------------------------------------------
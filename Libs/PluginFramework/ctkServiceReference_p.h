@@ -64,6 +64,15 @@ public:
    */
   bool ungetService(QSharedPointer<ctkPlugin> plugin, bool checkRefCounter);
 
+  /**
+   * Unget a service handed out in place of this lazy service placeholder.
+   *
+   * @param plugin Plugin who wants remove service.
+   * @return The result of ungetting the real service, or false if the
+   *         plugin got no service through this placeholder.
+   */
+  bool ungetForward(QSharedPointer<ctkPlugin> plugin);
+
   /**
    * Get all properties registered with this service.
    *
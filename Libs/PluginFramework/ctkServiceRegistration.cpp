@@ -176,7 +176,8 @@ void ctkServiceRegistration::unregister()
   {
     QMutexLocker lock(&d->eventLock);
     {
-      QMutexLocker lock2(&d->propsLock);
+      QWriteLocker lock2(&d->usageLock);
+      QMutexLocker lock3(&d->propsLock);
       d->available = false;
       if (d->plugin)
       {
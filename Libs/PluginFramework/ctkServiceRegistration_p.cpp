@@ -27,7 +27,7 @@ ctkServiceRegistrationPrivate::ctkServiceRegistrationPrivate(
   const ctkDictionary& props)
   : ref(1), service(service), plugin(plugin), reference(this),
     properties(props), available(true), unregistering(false),
-    propsLock()
+    propsLock(), usageLock()
 {
 
 }
@@ -41,8 +41,8 @@ ctkServiceRegistrationPrivate::~ctkServiceRegistrationPrivate()
 //----------------------------------------------------------------------------
 bool ctkServiceRegistrationPrivate::isUsedByPlugin(QSharedPointer<ctkPlugin> p)
 {
-  QHash<QSharedPointer<ctkPlugin>, int> deps = dependents;
-  return deps.contains(p);
+  QReadLocker lock(&usageLock);
+  return dependents.contains(p);
 }
 
 //----------------------------------------------------------------------------
@@ -23,8 +23,10 @@
 #ifndef CTKSERVICEREGISTRATIONPRIVATE_H
 #define CTKSERVICEREGISTRATIONPRIVATE_H
 
+#include <QAtomicInt>
 #include <QHash>
 #include <QMutex>
+#include <QReadWriteLock>
 
 #include "ctkServiceProperties_p.h"
 #include "ctkServiceReference.h"
@@ -80,14 +82,29 @@ public:
   /**
    * Plugins dependent on this service. Integer is used as
    * reference counter, counting number of unbalanced getService().
+   * <p>
+   * Entries are only added or removed while holding the write lock of
+   * usageLock. Existing counters are updated atomically while holding
+   * the read lock, as long as they do not drop to zero. This keeps
+   * repeated getService()/ungetService() calls from different threads
+   * from serializing on a single mutex.
    */
-  QHash<QSharedPointer<ctkPlugin>,int> dependents;
+  QHash<QSharedPointer<ctkPlugin>, QAtomicInt> dependents;
 
   /**
    * Object instances that factory has produced.
    */
   QHash<QSharedPointer<ctkPlugin>, QObject*> serviceInstances;
 
+  /**
+   * For a lazy service placeholder, the real services handed out in its
+   * place to the requests which activated the plugin, by requesting
+   * plugin. These requests are released through the placeholder's
+   * reference, which may have been unregistered meanwhile. Guarded by
+   * usageLock.
+   */
+  QMultiHash<QSharedPointer<ctkPlugin>, ctkServiceReference> forwards;
+
   /**
    * Is service available. I.e., if <code>true</code> then holders
    * of a ctkServiceReference for the service are allowed to get it.
@@ -108,6 +125,12 @@ public:
 
   QMutex propsLock;
 
+  /**
+   * Lock protecting dependents and serviceInstances. It must not be
+   * acquired while holding propsLock.
+   */
+  QReadWriteLock usageLock;
+
   ctkServiceRegistrationPrivate(ctkPluginPrivate* plugin, QObject* service,
                                 const ctkDictionary& props);
 
@@ -215,6 +215,11 @@ public:
    * Return a list of <code>ctkServiceReference</code>s for all services being
    * tracked by this <code>ctkServiceTracker</code>.
    *
+   * <p>
+   * The list is sorted by descending service ranking and ascending service
+   * id. It is shared with the tracker and only rebuilt when the set of
+   * tracked services changes, so calling this method is cheap.
+   *
    * @return List of <code>ctkServiceReference</code>s.
    */
   virtual QList<ctkServiceReference> getServiceReferences() const;
@@ -257,10 +262,9 @@ public:
    * <code>ctkServiceTracker</code>.
    *
    * <p>
-   * This implementation calls getServiceReferences() to get the list
-   * of references for the tracked services and then calls
-   * getService(const ctkServiceReference&) for each reference to get the
-   * tracked service object.
+   * The list is in the same order as the one returned by
+   * getServiceReferences(). Like that list, it is shared with the tracker
+   * and only rebuilt when the set of tracked services changes.
    *
    * @return A list of service objects or an empty list if no services
    *         are being tracked.
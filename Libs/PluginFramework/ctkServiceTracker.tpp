@@ -26,11 +26,9 @@
 #include "ctkPluginConstants.h"
 #include "ctkPluginContext.h"
 
-#include <QVarLengthArray>
 #include <QDebug>
 
 #include <stdexcept>
-#include <limits>
 
 //----------------------------------------------------------------------------
 template<class S, class T>
@@ -169,8 +167,7 @@ void ctkServiceTracker<S,T>::close()
 
   if (d->DEBUG_FLAG)
   {
-    QMutexLocker lock(&d->mutex);
-    if ((d->cachedReference.getPlugin().isNull()) && (d->cachedService == 0))
+    if (d->currentSnapshot()->references.isEmpty())
     {
       qDebug() << "ctkServiceTracker<S,T>::close[cached cleared]:"
           << d->filter;
@@ -217,10 +214,7 @@ QList<ctkServiceReference> ctkServiceTracker<S,T>::getServiceReferences() const
   { /* if ServiceTracker is not open */
     return QList<ctkServiceReference>();
   }
-  {
-    QMutexLocker lockT(t.data());
-    return d->getServiceReferences_unlocked(t.data());
-  }
+  return d->currentSnapshot()->references;
 }
 
 //----------------------------------------------------------------------------
@@ -228,80 +222,23 @@ template<class S, class T>
 ctkServiceReference ctkServiceTracker<S,T>::getServiceReference() const
 {
   Q_D(const ServiceTracker);
-  ctkServiceReference reference(0);
-  {
-    QMutexLocker lock(&d->mutex);
-    reference = d->cachedReference;
-  }
-  if (!reference.getPlugin().isNull())
-  {
-    if (d->DEBUG_FLAG)
-    {
-      qDebug() << "ctkServiceTracker<S,T>::getServiceReference[cached]:"
-                   << d->filter;
-    }
-    return reference;
-  }
   if (d->DEBUG_FLAG)
   {
     qDebug() << "ctkServiceTracker<S,T>::getServiceReference:" << d->filter;
   }
-  QList<ctkServiceReference> references = getServiceReferences();
-  int length = references.size();
-  if (length == 0)
-  { /* if no service is being tracked */
-    throw ctkServiceException("No service is being tracked");
-  }
-  int index = 0;
-  if (length > 1)
-  { /* if more than one service, select highest ranking */
-    QVarLengthArray<int, 10> rankings(length);
-    int count = 0;
-    int maxRanking = std::numeric_limits<int>::min();
-    for (int i = 0; i < length; i++)
+  QSharedPointer<TrackedService> t = d->tracked();
+  if (!t.isNull())
+  {
+    /* the snapshot is sorted, the first reference has the highest
+     * ranking and the lowest service id */
+    QSharedPointer<const typename ServiceTrackerPrivate::Snapshot> snapshot = d->currentSnapshot();
+    if (!snapshot->references.isEmpty())
     {
-      bool ok = false;
-      int ranking = references[i].getProperty(ctkPluginConstants::SERVICE_RANKING).toInt(&ok);
-      if (!ok) ranking = 0;
-
-      rankings[i] = ranking;
-      if (ranking > maxRanking)
-      {
-        index = i;
-        maxRanking = ranking;
-        count = 1;
-      }
-      else
-      {
-        if (ranking == maxRanking)
-        {
-          count++;
-        }
-      }
-    }
-    if (count > 1)
-    { /* if still more than one service, select lowest id */
-      qlonglong minId = std::numeric_limits<qlonglong>::max();
-      for (int i = 0; i < length; i++)
-      {
-        if (rankings[i] == maxRanking)
-        {
-          qlonglong id = references[i].getProperty(ctkPluginConstants::SERVICE_ID).toLongLong();
-          if (id < minId)
-          {
-            index = i;
-            minId = id;
-          }
-        }
-      }
+      return snapshot->references.front();
     }
   }
-
-  {
-    QMutexLocker lock(&d->mutex);
-    d->cachedReference = references[index];
-    return d->cachedReference;
-  }
+  /* if no service is being tracked */
+  throw ctkServiceException("No service is being tracked");
 }
 
 //----------------------------------------------------------------------------
@@ -314,10 +251,7 @@ T ctkServiceTracker<S,T>::getService(const ctkServiceReference& reference) const
   { /* if ServiceTracker is not open */
     return 0;
   }
-  {
-    QMutexLocker lockT(t.data());
-    return t->getCustomizedObject(reference);
-  }
+  return d->currentSnapshot()->objects.value(reference);
 }
 
 //----------------------------------------------------------------------------
@@ -330,17 +264,7 @@ QList<T> ctkServiceTracker<S,T>::getServices() const
   { /* if ServiceTracker is not open */
     return QList<T>();
   }
-  {
-    QMutexLocker lockT(t.data());
-    QList<ctkServiceReference> references = d->getServiceReferences_unlocked(t.data());
-    QList<T> objects;
-    foreach (ctkServiceReference ref, references)
-    {
-      //objects << getService(ref);
-      objects << t->getCustomizedObject(ref);
-    }
-    return objects;
-  }
+  return d->currentSnapshot()->services;
 }
 
 //----------------------------------------------------------------------------
@@ -348,16 +272,6 @@ template<class S, class T>
 T ctkServiceTracker<S,T>::getService() const
 {
   Q_D(const ServiceTracker);
-  T service = d->cachedService;
-  if (service != 0)
-  {
-    if (d->DEBUG_FLAG)
-    {
-      qDebug() << "ctkServiceTracker<S,T>::getService[cached]:"
-               << d->filter;
-    }
-    return service;
-  }
   if (d->DEBUG_FLAG)
   {
     qDebug() << "ctkServiceTracker<S,T>::getService:" << d->filter;
@@ -370,7 +284,7 @@ T ctkServiceTracker<S,T>::getService() const
     {
       return 0;
     }
-    return d->cachedService = getService(reference);
+    return getService(reference);
   }
   catch (const ctkServiceException&)
   {
@@ -401,10 +315,7 @@ int ctkServiceTracker<S,T>::size() const
   { /* if ServiceTracker is not open */
     return 0;
   }
-  {
-    QMutexLocker lockT(t.data());
-    return t->size();
-  }
+  return d->currentSnapshot()->references.size();
 }
 
 //----------------------------------------------------------------------------
@@ -434,10 +345,12 @@ QMap<ctkServiceReference, T> ctkServiceTracker<S,T>::getTracked() const
   { /* if ServiceTracker is not open */
     return map;
   }
+  QSharedPointer<const typename ServiceTrackerPrivate::Snapshot> snapshot = d->currentSnapshot();
+  for (int i = 0; i < snapshot->references.size(); ++i)
   {
-    QMutexLocker lockT(t.data());
-    return t->copyEntries(map);
+    map.insert(snapshot->references[i], snapshot->services[i]);
   }
+  return map;
 }
 
 //----------------------------------------------------------------------------
@@ -450,10 +363,7 @@ bool ctkServiceTracker<S,T>::isEmpty() const
   { /* if ServiceTracker is not open */
     return true;
   }
-  {
-    QMutexLocker lockT(t.data());
-    return t->isEmpty();
-  }
+  return d->currentSnapshot()->references.isEmpty();
 }
 
 //----------------------------------------------------------------------------
@@ -26,7 +26,9 @@
 #include "ctkServiceReference.h"
 #include "ctkLDAPSearchFilter.h"
 
+#include <QHash>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <QSharedPointer>
 
 /**
@@ -69,8 +71,6 @@ public:
   QList<ctkServiceReference> getInitialReferences(const QString& className,
                                                   const QString& filterString);
 
-  QList<ctkServiceReference> getServiceReferences_unlocked(ctkTrackedService<S,T>* t) const;
-
   /* set this to true to compile in debug messages */
   static const bool	DEBUG_FLAG; //	= false;
 
@@ -124,28 +124,60 @@ public:
    */
   QSharedPointer<ctkTrackedService<S,T> > tracked() const;
 
+  /**
+   * Immutable view of the tracked services. A new snapshot is created
+   * whenever the set of tracked services or their properties change, so
+   * that the read-only accessors of ctkServiceTracker neither take the
+   * tracked lock nor build new containers.
+   */
+  struct Snapshot
+  {
+    /**
+     * Tracked references, sorted by descending service ranking and
+     * ascending service id. The first entry is the one returned by
+     * ctkServiceTracker::getServiceReference().
+     */
+    QList<ctkServiceReference> references;
+
+    /**
+     * Customized objects, in the same order as <code>references</code>.
+     */
+    QList<T> services;
+
+    /**
+     * Tracked references mapped to their customized objects.
+     */
+    QHash<ctkServiceReference, T> objects;
+  };
+
+  /**
+   * Returns the current snapshot of tracked services. The returned
+   * snapshot is never null.
+   */
+  QSharedPointer<const Snapshot> currentSnapshot() const;
+
   /**
    * Called by the ctkTrackedService object whenever the set of tracked services is
-   * modified. Clears the cache.
+   * modified. Publishes a new snapshot of the services tracked by <code>t</code>,
+   * or an empty snapshot if <code>t</code> is null or closed.
    */
   /*
    * This method must not be synchronized since it is called by ctkTrackedService while
    * ctkTrackedService is synchronized. We don't want synchronization interactions
    * between the listener thread and the user thread.
    */
-  void modified();
+  void modified(ctkTrackedService<S,T>* t = 0);
 
   /**
-   * Cached ctkServiceReference for getServiceReference.
+   * Current snapshot of tracked services.
    */
-  mutable ctkServiceReference cachedReference;
+  QSharedPointer<const Snapshot> snapshot;
 
   /**
-   * Cached service object for getService.
-   *
-   * This field is volatile since it is accessed by multiple threads.
+   * Protects the <code>snapshot</code> pointer. It is only held for
+   * copying or replacing the pointer, never while a snapshot is built.
    */
-  mutable T volatile cachedService;
+  mutable QReadWriteLock snapshotLock;
 
   mutable QMutex mutex;
 
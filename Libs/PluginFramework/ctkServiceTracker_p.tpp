@@ -26,6 +26,9 @@
 #include "ctkPluginConstants.h"
 #include "ctkLDAPSearchFilter.h"
 
+#include <QMap>
+#include <QPair>
+
 //----------------------------------------------------------------------------
 template<class S, class T>
 const bool ctkServiceTrackerPrivate<S,T>::DEBUG_FLAG = false;
@@ -37,7 +40,7 @@ ctkServiceTrackerPrivate<S,T>::ctkServiceTrackerPrivate(
     const ctkServiceReference& reference,
     ctkServiceTrackerCustomizer<T>* customizer)
   : context(context), customizer(customizer), trackReference(reference),
-    trackedService(0), cachedReference(0), cachedService(0), q_ptr(st)
+    trackedService(0), snapshot(new Snapshot()), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   this->listenerFilter = QString("(") + ctkPluginConstants::SERVICE_ID +
@@ -64,8 +67,8 @@ ctkServiceTrackerPrivate<S,T>::ctkServiceTrackerPrivate(
     ctkPluginContext* context, const QString& clazz,
     ctkServiceTrackerCustomizer<T>* customizer)
       : context(context), customizer(customizer), trackClass(clazz),
-        trackReference(0), trackedService(0), cachedReference(0),
-        cachedService(0), q_ptr(st)
+        trackReference(0), trackedService(0), snapshot(new Snapshot()),
+        q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   this->listenerFilter = QString("(") + ctkPluginConstants::OBJECTCLASS + "="
@@ -94,7 +97,7 @@ ctkServiceTrackerPrivate<S,T>::ctkServiceTrackerPrivate(
     ctkServiceTrackerCustomizer<T>* customizer)
       : context(context), filter(filter), customizer(customizer),
         listenerFilter(filter.toString()), trackReference(0),
-        trackedService(0), cachedReference(0), cachedService(0), q_ptr(st)
+        trackedService(0), snapshot(new Snapshot()), q_ptr(st)
 {
   this->customizer = customizer ? customizer : q_func();
   if (context == 0)
@@ -120,28 +123,55 @@ QList<ctkServiceReference> ctkServiceTrackerPrivate<S,T>::getInitialReferences(c
 
 //----------------------------------------------------------------------------
 template<class S, class T>
-QList<ctkServiceReference> ctkServiceTrackerPrivate<S,T>::getServiceReferences_unlocked(ctkTrackedService<S,T>* t) const
+QSharedPointer<ctkTrackedService<S,T> > ctkServiceTrackerPrivate<S,T>::tracked() const
 {
-  if (t->size() == 0)
-  {
-    return QList<ctkServiceReference>();
-  }
-  return t->getTracked();
+  return trackedService;
 }
 
 //----------------------------------------------------------------------------
 template<class S, class T>
-QSharedPointer<ctkTrackedService<S,T> > ctkServiceTrackerPrivate<S,T>::tracked() const
+QSharedPointer<const typename ctkServiceTrackerPrivate<S,T>::Snapshot>
+ctkServiceTrackerPrivate<S,T>::currentSnapshot() const
 {
-  return trackedService;
+  QReadLocker lock(&snapshotLock);
+  return snapshot;
 }
 
 //----------------------------------------------------------------------------
 template<class S, class T>
-void ctkServiceTrackerPrivate<S,T>::modified()
+void ctkServiceTrackerPrivate<S,T>::modified(ctkTrackedService<S,T>* t)
 {
-  cachedReference = 0; /* clear cached value */
-  cachedService = 0; /* clear cached value */
+  Snapshot* newSnapshot = new Snapshot();
+  if (t != 0 && !t->closed)
+  {
+    QList<ctkServiceReference> references = t->getTracked();
+
+    // Sort by descending ranking and ascending service id, which is the
+    // order used to select the service returned by getServiceReference()
+    QMap<QPair<qlonglong, qlonglong>, ctkServiceReference> sorted;
+    foreach (ctkServiceReference ref, references)
+    {
+      bool ok = false;
+      int ranking = ref.getProperty(ctkPluginConstants::SERVICE_RANKING).toInt(&ok);
+      if (!ok) ranking = 0;
+      qlonglong id = ref.getProperty(ctkPluginConstants::SERVICE_ID).toLongLong();
+      sorted.insert(qMakePair(-static_cast<qlonglong>(ranking), id), ref);
+    }
+
+    foreach (ctkServiceReference ref, sorted)
+    {
+      T object = t->getCustomizedObject(ref);
+      newSnapshot->references.push_back(ref);
+      newSnapshot->services.push_back(object);
+      newSnapshot->objects.insert(ref, object);
+    }
+  }
+
+  {
+    QWriteLocker lock(&snapshotLock);
+    snapshot = QSharedPointer<const Snapshot>(newSnapshot);
+  }
+
   if (DEBUG_FLAG)
   {
     qDebug() << "ctkServiceTracker::modified:" << filter;
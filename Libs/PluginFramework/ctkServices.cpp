@@ -33,6 +33,7 @@
 #include "ctkServiceException.h"
 #include "ctkServiceRegistration_p.h"
 #include "ctkLDAPExpr_p.h"
+#include "ctkPluginFrameworkMetricsRecorder_p.h"
 
 //----------------------------------------------------------------------------
 struct ServiceRegistrationComparator
@@ -164,6 +165,7 @@ QList<ctkServiceRegistration> ctkServices::get(const QString& clazz) const
 //----------------------------------------------------------------------------
 ctkServiceReference ctkServices::get(ctkPluginPrivate* plugin, const QString& clazz) const
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::SERVICE_LOOKUP);
   QMutexLocker lock(&mutex);
   try {
     QList<ctkServiceReference> srs = get_unlocked(clazz, QString(), plugin);
@@ -186,6 +188,7 @@ ctkServiceReference ctkServices::get(ctkPluginPrivate* plugin, const QString& cl
 QList<ctkServiceReference> ctkServices::get(const QString& clazz, const QString& filter,
                                             ctkPluginPrivate* plugin) const
 {
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::SERVICE_LOOKUP);
   QMutexLocker lock(&mutex);
   return get_unlocked(clazz, filter, plugin);
 }
@@ -249,6 +252,9 @@ QList<ctkServiceReference> ctkServices::get_unlocked(const QString& clazz, const
     }
   }
 
+  // One measurement covers the evaluation of the filter against all candidates
+  ctkPluginFrameworkMetricsRecorder::Scope scope(ctkPluginFrameworkMetrics::LDAP_EVALUATION, !filter.isEmpty());
+
   QList<ctkServiceReference> res;
   while (s->hasNext())
   {
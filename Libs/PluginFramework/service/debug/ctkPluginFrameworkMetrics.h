@@ -0,0 +1,144 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKPLUGINFRAMEWORKMETRICS_H
+#define CTKPLUGINFRAMEWORKMETRICS_H
+
+#include <ctkPluginFrameworkExport.h>
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+/**
+ * \ingroup PluginFramework
+ *
+ * Gives access to counters and latency histograms which the Framework
+ * maintains for its hot paths.
+ *
+ * <p>
+ * The Framework registers an implementation of this interface when it is
+ * started. Nothing is recorded until recording is enabled with
+ * setEnabled(); while it is disabled, a measured operation only reads a
+ * flag. Recording a measurement costs a few relaxed atomic increments.
+ * Recording of individual trace spans is more expensive and must
+ * additionally be enabled with setTracingEnabled().
+ *
+ * @remarks This class is thread safe.
+ */
+struct CTK_PLUGINFW_EXPORT ctkPluginFrameworkMetrics
+{
+
+  /**
+   * The measured Framework operations.
+   */
+  enum Probe {
+    /** Service registry lookups by class name and filter. */
+    SERVICE_LOOKUP = 0,
+    /** Evaluations of LDAP filters against service properties. */
+    LDAP_EVALUATION,
+    /** Delivery of a service, plugin or framework event to listeners. */
+    LISTENER_DISPATCH,
+    /** Activation of a plugin, including its activator's start method. */
+    PLUGIN_START,
+    /** Stopping of a plugin, including its activator's stop method. */
+    PLUGIN_STOP,
+    /** Reads of plugin resources. */
+    RESOURCE_READ,
+
+    PROBE_COUNT
+  };
+
+  /**
+   * Number of buckets of the latency histograms. Bucket 0 counts
+   * measurements shorter than one microsecond, bucket <code>i</code>
+   * counts measurements in the range [2<sup>i-1</sup>, 2<sup>i</sup>)
+   * microseconds. The last bucket also counts all longer measurements.
+   */
+  static const int HISTOGRAM_BUCKETS = 24;
+
+  virtual ~ctkPluginFrameworkMetrics() {}
+
+  /**
+   * Returns the name of the specified probe, as used in the exported
+   * trace, e.g. <code>service_lookup</code>.
+   */
+  virtual QString getProbeName(Probe probe) const = 0;
+
+  /**
+   * Returns the number of measurements recorded for the specified probe.
+   */
+  virtual qint64 getCount(Probe probe) const = 0;
+
+  /**
+   * Returns the accumulated duration of all measurements recorded for the
+   * specified probe, in microseconds.
+   */
+  virtual qint64 getTotalTime(Probe probe) const = 0;
+
+  /**
+   * Returns the latency histogram of the specified probe. The list
+   * contains <code>HISTOGRAM_BUCKETS</code> entries.
+   */
+  virtual QList<qint64> getHistogram(Probe probe) const = 0;
+
+  /**
+   * Resets all counters and histograms and discards recorded trace spans.
+   */
+  virtual void reset() = 0;
+
+  /**
+   * Enables or disables recording of measurements, including trace spans.
+   * Recording is disabled by default. The counters keep their values while
+   * recording is disabled.
+   */
+  virtual void setEnabled(bool enabled) = 0;
+
+  /**
+   * Returns <code>true</code> if measurements are recorded.
+   */
+  virtual bool isEnabled() const = 0;
+
+  /**
+   * Enables or disables the recording of individual trace spans while
+   * recording is enabled. Only the most recent spans are kept.
+   */
+  virtual void setTracingEnabled(bool enabled) = 0;
+
+  /**
+   * Returns <code>true</code> if trace spans are recorded.
+   */
+  virtual bool isTracingEnabled() const = 0;
+
+  /**
+   * Exports the recorded trace spans and the current counter values in
+   * the Chrome trace event JSON format, which can be loaded in
+   * <code>chrome://tracing</code> or compatible viewers. Histograms are
+   * exported in the <code>otherData</code> section.
+   */
+  virtual QByteArray toChromeTrace() const = 0;
+
+};
+
+Q_DECLARE_INTERFACE(ctkPluginFrameworkMetrics, "org.commontk.service.debug.PluginFrameworkMetrics")
+
+#endif // CTKPLUGINFRAMEWORKMETRICS_H
@@ -0,0 +1,64 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKBATCHEVENTHANDLER_H
+#define CTKBATCHEVENTHANDLER_H
+
+#include "ctkEventHandler.h"
+
+#include <QList>
+
+/**
+ * \ingroup EventAdmin
+ *
+ * Listener for batches of Events.
+ *
+ * <p>
+ * An event handler implementing this interface is registered like any
+ * other <code>ctkEventHandler</code> service. If several posted events for
+ * the handler are pending, the Event Admin service may deliver them with a
+ * single call to handleEvents() instead of one call to handleEvent() per
+ * event. Synchronously sent events are always delivered with handleEvent().
+ * <p>
+ * Together with the {@link ctkEventConstants#EVENT_COALESCE} service
+ * property, high-frequency publishers can be consumed with little overhead.
+ *
+ * @see ctkEventHandler
+ *
+ * @remarks This class is thread safe.
+ */
+struct ctkBatchEventHandler : public ctkEventHandler
+{
+  virtual ~ctkBatchEventHandler() {}
+
+  /**
+   * Called by the {@link ctkEventAdmin} service to notify the listener of
+   * several events, in the order they were posted.
+   *
+   * @param events The events that occurred.
+   */
+  virtual void handleEvents(const QList<ctkEvent>& events) = 0;
+};
+
+Q_DECLARE_INTERFACE(ctkBatchEventHandler, "org.commontk.service.event.BatchEventHandler")
+
+#endif // CTKBATCHEVENTHANDLER_H
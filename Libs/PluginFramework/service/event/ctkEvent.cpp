@@ -20,56 +20,88 @@
 =============================================================================*/
 
 #include "ctkEvent.h"
+#include "ctkEvent_p.h"
 
 #include "ctkEventConstants.h"
 
 #include <ctkException.h>
+#include <ctkLDAPExpr_p.h>
 
-class ctkEventData : public QSharedData
-{
+namespace {
 
+class ctkEventPropertyLookup : public ctkLDAPPropertyLookup
+{
 public:
 
-  ctkEventData(const QString& topic, const ctkDictionary& properties)
-    : topic(topic), properties(properties)
+  ctkEventPropertyLookup(const ctkEventProperties& properties)
+    : properties(properties)
+  {}
+
+  QVariant value(const QString& key, bool matchCase) const
   {
-    validateTopicName(topic);
-    this->properties.insert(ctkEventConstants::EVENT_TOPIC, topic);
+    // try case sensitive match first
+    int index = properties.findCaseSensitive(key);
+    if (index < 0 && !matchCase) index = properties.find(key);
+    return properties.value(index);
   }
 
-  static void validateTopicName(const QString& topic)
+private:
+
+  const ctkEventProperties& properties;
+};
+
+}
+
+//----------------------------------------------------------------------------
+ctkEventData::ctkEventData(const QString& topic)
+  : topic(topic)
+{
+  validateTopicName(topic);
+}
+
+//----------------------------------------------------------------------------
+ctkEventData::ctkEventData(const QString& topic, const ctkDictionary& properties)
+  : topic(topic)
+{
+  validateTopicName(topic);
+  for (ctkDictionary::ConstIterator i = properties.begin(), end = properties.end();
+       i != end; ++i)
   {
-    if (topic.isEmpty())
-    {
-      throw ctkInvalidArgumentException("empty topic");
-    }
-
-    // Can't start or end with a '/' but anywhere else is okay
-    // Can't have "//" as that implies empty token
-    if (topic.startsWith("/") || topic.endsWith("/") ||
-        topic.contains("//"))
-    {
-      throw ctkInvalidArgumentException(QString("invalid topic: %1").arg(topic));
-    }
-
-    QString::const_iterator topicEnd = topic.end();
-    QChar A('A'), Z('Z'), a('a'), z('z'), zero('0'), nine('9');
-    QChar dash('-'), slash('/'), underscore('_');
-    for (QString::const_iterator i = topic.begin(); i < topicEnd; ++i)
-    {
-      QChar c(*i);
-      if ((A <= c) && (c <= Z)) continue;
-      if ((a <= c) && (c <= z)) continue;
-      if ((zero <= c) && (c <= nine)) continue;
-      if ((c == underscore) || (c == dash) || (c == slash)) continue;
-      throw ctkInvalidArgumentException(QString("invalid topic: %1").arg(topic));
-    }
+    this->properties.insert(i.key(), i.value());
   }
+  this->properties.insert(ctkEventConstants::EVENT_TOPIC, topic);
+  this->properties.seal();
+}
 
-  const QString topic;
-  ctkDictionary properties;
+//----------------------------------------------------------------------------
+void ctkEventData::validateTopicName(const QString& topic)
+{
+  if (topic.isEmpty())
+  {
+    throw ctkInvalidArgumentException("empty topic");
+  }
 
-};
+  // Can't start or end with a '/' but anywhere else is okay
+  // Can't have "//" as that implies empty token
+  if (topic.startsWith("/") || topic.endsWith("/") ||
+      topic.contains("//"))
+  {
+    throw ctkInvalidArgumentException(QString("invalid topic: %1").arg(topic));
+  }
+
+  QString::const_iterator topicEnd = topic.end();
+  QChar A('A'), Z('Z'), a('a'), z('z'), zero('0'), nine('9');
+  QChar dash('-'), slash('/'), underscore('_');
+  for (QString::const_iterator i = topic.begin(); i < topicEnd; ++i)
+  {
+    QChar c(*i);
+    if ((A <= c) && (c <= Z)) continue;
+    if ((a <= c) && (c <= z)) continue;
+    if ((zero <= c) && (c <= nine)) continue;
+    if ((c == underscore) || (c == dash) || (c == slash)) continue;
+    throw ctkInvalidArgumentException(QString("invalid topic: %1").arg(topic));
+  }
+}
 
 //----------------------------------------------------------------------------
 ctkEvent::ctkEvent()
@@ -85,6 +117,13 @@ ctkEvent::ctkEvent(const QString& topic, const ctkDictionary& properties)
 
 }
 
+//----------------------------------------------------------------------------
+ctkEvent::ctkEvent(ctkEventData* data)
+  : d(data)
+{
+
+}
+
 //----------------------------------------------------------------------------
 // This is fast thanks to implicit sharing
 ctkEvent::ctkEvent(const ctkEvent &event)
@@ -127,7 +166,7 @@ bool ctkEvent::operator==(const ctkEvent& other) const
 //----------------------------------------------------------------------------
 QVariant ctkEvent::getProperty(const QString& name) const
 {
-  return d->properties[name];
+  return d->properties.value(name);
 }
 
 //----------------------------------------------------------------------------
@@ -137,7 +176,7 @@ bool ctkEvent::containsProperty(const QString& name) const
   {
    return true;
   }
-  return d->properties.contains(name);
+  return d->properties.findCaseSensitive(name) >= 0;
 }
 
 //----------------------------------------------------------------------------
@@ -155,5 +194,5 @@ const QString& ctkEvent::getTopic() const
 //----------------------------------------------------------------------------
 bool ctkEvent::matches(const ctkLDAPSearchFilter& filter) const
 {
-  return filter.matchCase(d->properties);
+  return filter.matchCase(ctkEventPropertyLookup(d->properties));
 }
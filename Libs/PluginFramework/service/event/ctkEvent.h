@@ -31,6 +31,7 @@
 #include <ctkLDAPSearchFilter.h>
 
 
+class ctkEventBuilder;
 class ctkEventData;
 
 /**
@@ -40,12 +41,22 @@ class ctkEventData;
  *
  * <code>ctkEvent</code> objects are delivered to <code>ctkEventHandler</code>
  * or Qt slots which subscribe to the topic of the event.
+ *
+ * Events are immutable. Copies share the topic and the property values,
+ * so an event and its payload (e.g. a large QByteArray) can be handed to
+ * any number of handlers and threads without being copied. Use
+ * ctkEventBuilder to create an event without an intermediate
+ * ctkDictionary.
  */
 class CTK_PLUGINFW_EXPORT ctkEvent
 {
 
   QSharedDataPointer<ctkEventData> d;
 
+  friend class ctkEventBuilder;
+
+  ctkEvent(ctkEventData* data);
+
 public:
 
   /**
@@ -0,0 +1,81 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkEventBuilder.h"
+#include "ctkEvent_p.h"
+
+#include "ctkEventConstants.h"
+
+#include <ctkException.h>
+
+//----------------------------------------------------------------------------
+ctkEventBuilder::ctkEventBuilder(const QString& topic)
+  : d(new ctkEventData(topic))
+{
+
+}
+
+//----------------------------------------------------------------------------
+ctkEventBuilder::~ctkEventBuilder()
+{
+  delete d;
+}
+
+//----------------------------------------------------------------------------
+ctkEventBuilder& ctkEventBuilder::setProperty(const QString& name, const QVariant& value)
+{
+  checkNotBuilt();
+  d->properties.insert(name, value);
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+ctkEventBuilder& ctkEventBuilder::setProperties(const ctkDictionary& properties)
+{
+  checkNotBuilt();
+  for (ctkDictionary::ConstIterator i = properties.begin(), end = properties.end();
+       i != end; ++i)
+  {
+    d->properties.insert(i.key(), i.value());
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+ctkEvent ctkEventBuilder::build()
+{
+  checkNotBuilt();
+  d->properties.insert(ctkEventConstants::EVENT_TOPIC, d->topic);
+  d->properties.seal();
+
+  ctkEventData* data = d;
+  d = 0;
+  return ctkEvent(data);
+}
+
+//----------------------------------------------------------------------------
+void ctkEventBuilder::checkNotBuilt() const
+{
+  if (!d)
+  {
+    throw ctkIllegalStateException("The event has already been built");
+  }
+}
@@ -0,0 +1,98 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKEVENTBUILDER_H
+#define CTKEVENTBUILDER_H
+
+#include "ctkEvent.h"
+
+/**
+ * \ingroup EventAdmin
+ *
+ * Creates a ctkEvent without an intermediate ctkDictionary.
+ *
+ * The properties are added directly to the storage of the new event,
+ * which build() hands over to the event without copying it. A builder
+ * creates a single event; it cannot be used after build() was called.
+ *
+ * \code
+ * eventAdmin->postEvent(ctkEventBuilder("org/commontk/image")
+ *                       .setProperty("id", id)
+ *                       .setProperty("pixels", pixels)
+ *                       .build());
+ * \endcode
+ *
+ * @remarks This class is not thread safe.
+ */
+class CTK_PLUGINFW_EXPORT ctkEventBuilder
+{
+
+public:
+
+  /**
+   * Starts building an event.
+   *
+   * @param topic The topic of the event.
+   * @throws ctkInvalidArgumentException If topic is not a valid topic name.
+   */
+  ctkEventBuilder(const QString& topic);
+
+  ~ctkEventBuilder();
+
+  /**
+   * Sets an event property. Setting a property again replaces
+   * its value.
+   *
+   * @param name The name of the property.
+   * @param value The value of the property.
+   * @return This builder.
+   * @throws ctkIllegalStateException If the event was already built.
+   */
+  ctkEventBuilder& setProperty(const QString& name, const QVariant& value);
+
+  /**
+   * Sets all the given event properties.
+   *
+   * @param properties The properties to set.
+   * @return This builder.
+   * @throws ctkIllegalStateException If the event was already built.
+   */
+  ctkEventBuilder& setProperties(const ctkDictionary& properties);
+
+  /**
+   * Creates the event.
+   *
+   * @return The event.
+   * @throws ctkIllegalStateException If the event was already built.
+   */
+  ctkEvent build();
+
+private:
+
+  Q_DISABLE_COPY(ctkEventBuilder)
+
+  ctkEventData* d;
+
+  void checkNotBuilt() const;
+
+};
+
+#endif // CTKEVENTBUILDER_H
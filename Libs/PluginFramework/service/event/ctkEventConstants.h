@@ -125,6 +125,22 @@ struct CTK_PLUGINFW_EXPORT ctkEventConstants {
    */
   static const QString DELIVERY_ASYNC_UNORDERED; // = "async.unordered"
 
+  /**
+   * Registration property (named <code>event.coalesce</code>) requesting
+   * coalescing of asynchronously delivered events for an Event Handler.
+   * <p>
+   * Event handlers MAY be registered with this property. The value of the
+   * property is a QString naming an event property. A posted event which
+   * has not yet been delivered to the handler is dropped in favor of a
+   * later event from the same publisher if both events have the same topic
+   * and the same value for the named property. Events without the named
+   * property are coalesced by their topic only. Synchronously delivered
+   * events are never coalesced.
+   *
+   * @see ctkBatchEventHandler
+   */
+  static const QString EVENT_COALESCE; // = "event.coalesce"
+
   /**
    * The Plugin Symbolic Name of the plugin relevant to the event. The type of
    * the value for this event property is <code>QString</code>.
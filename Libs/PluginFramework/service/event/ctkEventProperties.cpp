@@ -0,0 +1,157 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkEventProperties_p.h"
+
+#include <QHash>
+
+#include <algorithm>
+
+namespace {
+
+bool entryLessThan(const ctkEventProperties::Entry& e1, const ctkEventProperties::Entry& e2)
+{
+  if (e1.key != e2.key) return e1.key < e2.key;
+  return e1.name < e2.name;
+}
+
+}
+
+//----------------------------------------------------------------------------
+ctkEventProperties::ctkEventProperties()
+{
+
+}
+
+//----------------------------------------------------------------------------
+uint ctkEventProperties::keyId(const QString& key)
+{
+  return qHash(key);
+}
+
+//----------------------------------------------------------------------------
+void ctkEventProperties::insert(const QString& key, const QVariant& value)
+{
+  Entry entry;
+  entry.key = keyId(key);
+  entry.name = key;
+  entry.value = value;
+  entries.push_back(entry);
+}
+
+//----------------------------------------------------------------------------
+void ctkEventProperties::seal()
+{
+  std::stable_sort(entries.begin(), entries.end(), entryLessThan);
+
+  // keep the last inserted value of equal keys
+  int last = -1;
+  for (int i = 0; i < entries.size(); ++i)
+  {
+    if (last >= 0 && entries[last].key == entries[i].key &&
+        entries[last].name == entries[i].name)
+    {
+      entries[last].value = entries[i].value;
+    }
+    else
+    {
+      entries[++last] = entries[i];
+    }
+  }
+  entries.resize(last + 1);
+  entries.squeeze();
+}
+
+//----------------------------------------------------------------------------
+int ctkEventProperties::find(const QString& key) const
+{
+  int index = findCaseSensitive(key);
+  if (index >= 0) return index;
+
+  for (int i = 0; i < entries.size(); ++i)
+  {
+    if (entries[i].name.compare(key, Qt::CaseInsensitive) == 0)
+      return i;
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+int ctkEventProperties::findCaseSensitive(const QString& key) const
+{
+  const uint id = keyId(key);
+
+  // find the first entry with the given id
+  int low = 0;
+  int high = entries.size();
+  while (low < high)
+  {
+    int mid = (low + high) / 2;
+    if (entries[mid].key < id) low = mid + 1;
+    else high = mid;
+  }
+
+  for (int i = low; i < entries.size() && entries[i].key == id; ++i)
+  {
+    if (entries[i].name == key) return i;
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+QVariant ctkEventProperties::value(const QString& key) const
+{
+  return value(findCaseSensitive(key));
+}
+
+//----------------------------------------------------------------------------
+QVariant ctkEventProperties::value(int index) const
+{
+  return (index < 0 || index >= entries.size()) ? QVariant() : entries[index].value;
+}
+
+//----------------------------------------------------------------------------
+QStringList ctkEventProperties::keys() const
+{
+  QStringList result;
+  result.reserve(entries.size());
+  for (int i = 0; i < entries.size(); ++i)
+  {
+    result.push_back(entries[i].name);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+bool ctkEventProperties::operator==(const ctkEventProperties& other) const
+{
+  if (entries.size() != other.entries.size()) return false;
+  for (int i = 0; i < entries.size(); ++i)
+  {
+    if (entries[i].key != other.entries[i].key ||
+        entries[i].name != other.entries[i].name ||
+        entries[i].value != other.entries[i].value)
+    {
+      return false;
+    }
+  }
+  return true;
+}
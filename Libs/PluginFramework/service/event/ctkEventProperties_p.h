@@ -0,0 +1,89 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKEVENTPROPERTIES_P_H
+#define CTKEVENTPROPERTIES_P_H
+
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+/**
+ * \ingroup EventAdmin
+ *
+ * The immutable property storage of a ctkEvent.
+ *
+ * Each property key is identified by an integer id computed from the key
+ * itself, so creating events and looking up their properties needs no
+ * shared key table and no locking. The properties are kept in a flat array
+ * sorted by key id, so a lookup is a binary search over a contiguous array.
+ * The values are implicitly shared QVariant objects; large payloads like
+ * QByteArray are never deep copied when events are created, copied or
+ * delivered to several handlers.
+ */
+class ctkEventProperties
+{
+
+public:
+
+  struct Entry
+  {
+    uint key;
+    QString name;
+    QVariant value;
+  };
+
+  ctkEventProperties();
+
+  /**
+   * Returns the id of the given key. Different keys may share an id.
+   */
+  static uint keyId(const QString& key);
+
+  /**
+   * Appends a property. The properties must be sealed before
+   * they are looked up.
+   */
+  void insert(const QString& key, const QVariant& value);
+
+  /**
+   * Sorts the properties by key id. If a key was inserted several
+   * times, the value inserted last is kept.
+   */
+  void seal();
+
+  int find(const QString& key) const;
+  int findCaseSensitive(const QString& key) const;
+
+  QVariant value(const QString& key) const;
+  QVariant value(int index) const;
+
+  QStringList keys() const;
+
+  bool operator==(const ctkEventProperties& other) const;
+
+private:
+
+  QVector<Entry> entries;
+
+};
+
+#endif // CTKEVENTPROPERTIES_P_H
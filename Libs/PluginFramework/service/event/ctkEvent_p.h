@@ -19,11 +19,29 @@
 
 =============================================================================*/
 
+#ifndef CTKEVENT_P_H
+#define CTKEVENT_P_H
 
-#include "ctkEASyncThread_p.h"
+#include "ctkEventProperties_p.h"
 
-ctkEASyncThread::ctkEASyncThread(ctkEARunnable* target, QObject* parent)
-  : ctkEAInterruptibleThread(target, parent)
+#include <QSharedData>
+
+/**
+ * \ingroup EventAdmin
+ */
+class ctkEventData : public QSharedData
 {
-  this->setObjectName(QString("ctkEASyncThread") + QString::number(reinterpret_cast<qint64>(target)));
-}
+
+public:
+
+  ctkEventData(const QString& topic);
+  ctkEventData(const QString& topic, const ctkDictionary& properties);
+
+  static void validateTopicName(const QString& topic);
+
+  const QString topic;
+  ctkEventProperties properties;
+
+};
+
+#endif // CTKEVENT_P_H
@@ -0,0 +1,441 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkCMJournal_p.h"
+
+#include <service/log/ctkLogService.h>
+
+#include <QDataStream>
+#include <QThread>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// "CTKJ" in ASCII
+const quint32 JOURNAL_MAGIC = 0x43544b4a;
+// Increase the version whenever the record layout changes
+const quint32 JOURNAL_VERSION = 1;
+
+const quint8 RECORD_PUT = 1;
+const quint8 RECORD_REMOVE = 2;
+
+// The record size and checksum preceding each record
+const int RECORD_HEADER_SIZE = sizeof(quint32) + sizeof(quint16);
+
+}
+
+class ctkCMJournalWriterThread : public QThread
+{
+public:
+
+  ctkCMJournalWriterThread(ctkCMJournal* journal)
+    : journal(journal)
+  {
+    setObjectName("ConfigurationAdmin Journal Writer");
+  }
+
+protected:
+
+  void run()
+  {
+    journal->writeRecords();
+  }
+
+private:
+
+  ctkCMJournal* const journal;
+};
+
+const QString ctkCMJournal::JOURNAL_FILE = "configurations.journal";
+const QString ctkCMJournal::COMPACT_EXT = ".compact";
+const int ctkCMJournal::COMMIT_DELAY = 5;
+const int ctkCMJournal::MIN_COMPACT_RECORDS = 256;
+
+ctkCMJournal::ctkCMJournal(const QDir& store, ctkLogService* log)
+  : store(store), log(log), journalPath(store.filePath(JOURNAL_FILE)),
+    deadRecords(0), queuedCount(0), writtenCount(0), writeFailed(false), stopping(false),
+    writer(new ctkCMJournalWriterThread(this))
+{
+}
+
+ctkCMJournal::~ctkCMJournal()
+{
+  {
+    QMutexLocker lock(&mutex);
+    stopping = true;
+    recordsQueued.wakeAll();
+    commitRequested.wakeAll();
+  }
+  // The writer thread writes all pending records before it terminates
+  writer->wait();
+  delete writer;
+}
+
+QHash<QString, ctkDictionary> ctkCMJournal::load()
+{
+  // Finish or discard a compaction which was interrupted
+  const QString compactPath = journalPath + COMPACT_EXT;
+  if (QFile::exists(compactPath))
+  {
+    if (QFile::exists(journalPath))
+    {
+      // the old journal was not removed yet, so it is still complete
+      QFile::remove(compactPath);
+    }
+    else
+    {
+      QFile::rename(compactPath, journalPath);
+    }
+  }
+
+  QHash<QString, ctkDictionary> configurations;
+  qint64 validSize = 0;
+
+  file.setFileName(journalPath);
+  if (file.open(QIODevice::ReadOnly) && file.size() > 0)
+  {
+    uchar* data = file.map(0, file.size());
+    QByteArray buffer = data ? QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size())
+                             : file.readAll();
+
+    QDataStream in(buffer);
+    in.setVersion(QDataStream::Qt_4_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != JOURNAL_MAGIC || version != JOURNAL_VERSION)
+    {
+      CTK_ERROR(log) << "{Configuration Admin} unknown journal format, discarding " << journalPath;
+    }
+    else
+    {
+      validSize = in.device()->pos();
+      while (buffer.size() - validSize >= RECORD_HEADER_SIZE)
+      {
+        quint32 size = 0;
+        quint16 checksum = 0;
+        in >> size >> checksum;
+        qint64 recordStart = validSize + RECORD_HEADER_SIZE;
+        if (buffer.size() - recordStart < size)
+        {
+          break; // incomplete record
+        }
+
+        const char* recordData = buffer.constData() + recordStart;
+        if (qChecksum(recordData, size) != checksum)
+        {
+          break;
+        }
+
+        quint8 type = 0;
+        QString pid;
+        ctkDictionary properties;
+        in >> type >> pid;
+        if (type == RECORD_PUT)
+        {
+          in >> properties;
+        }
+        if (in.status() != QDataStream::Ok || in.device()->pos() != recordStart + size ||
+            (type != RECORD_PUT && type != RECORD_REMOVE))
+        {
+          break;
+        }
+
+        if (liveRecords.contains(pid))
+        {
+          ++deadRecords;
+        }
+        if (type == RECORD_PUT)
+        {
+          // copy the record, the mapped file is released below
+          liveRecords.insert(pid, QByteArray(recordData - RECORD_HEADER_SIZE,
+                                             RECORD_HEADER_SIZE + size));
+          configurations.insert(pid, properties);
+        }
+        else
+        {
+          ++deadRecords;
+          liveRecords.remove(pid);
+          configurations.remove(pid);
+        }
+        validSize = recordStart + size;
+      }
+    }
+
+    // QByteArray::fromRawData does not copy, so release the buffer
+    // before unmapping the file.
+    in.setDevice(0);
+    buffer.clear();
+    if (data) file.unmap(data);
+
+    if (validSize > 0 && validSize < file.size())
+    {
+      CTK_WARN(log) << "{Configuration Admin} discarding " << (file.size() - validSize)
+                    << " bytes of incomplete records at the end of " << journalPath;
+    }
+  }
+  file.close();
+
+  bool opened = false;
+  if (validSize > 0 && needsCompaction())
+  {
+    opened = compact(liveRecords);
+    if (opened) deadRecords = 0;
+  }
+  if (!opened && validSize > 0)
+  {
+    opened = file.resize(validSize) && openForAppend();
+  }
+  if (!opened)
+  {
+    // start a new journal
+    opened = compact(liveRecords);
+  }
+  if (!opened)
+  {
+    CTK_ERROR(log) << "{Configuration Admin} could not open " << journalPath << ": "
+                   << file.errorString();
+  }
+
+  writer->start();
+  return configurations;
+}
+
+void ctkCMJournal::put(const QString& pid, const ctkDictionary& properties)
+{
+  queue(RECORD_PUT, pid, encodeRecord(RECORD_PUT, pid, properties));
+}
+
+void ctkCMJournal::remove(const QString& pid)
+{
+  queue(RECORD_REMOVE, pid, encodeRecord(RECORD_REMOVE, pid, ctkDictionary()));
+}
+
+bool ctkCMJournal::flush()
+{
+  QMutexLocker lock(&mutex);
+  qint64 target = queuedCount;
+  commitRequested.wakeAll();
+  while (writtenCount < target)
+  {
+    recordsWritten.wait(&mutex);
+  }
+  return !writeFailed;
+}
+
+void ctkCMJournal::queue(quint8 type, const QString& pid, const QByteArray& record)
+{
+  QMutexLocker lock(&mutex);
+  pending.append(record);
+  ++queuedCount;
+
+  QHash<QString, QByteArray>::iterator live = liveRecords.find(pid);
+  if (live != liveRecords.end())
+  {
+    ++deadRecords;
+  }
+
+  if (type == RECORD_PUT)
+  {
+    if (live != liveRecords.end())
+    {
+      live.value() = record;
+    }
+    else
+    {
+      liveRecords.insert(pid, record);
+    }
+  }
+  else
+  {
+    // the removal record itself is dead as well
+    ++deadRecords;
+    if (live != liveRecords.end())
+    {
+      liveRecords.erase(live);
+    }
+  }
+
+  recordsQueued.wakeOne();
+}
+
+void ctkCMJournal::writeRecords()
+{
+  forever
+  {
+    QByteArray records;
+    QHash<QString, QByteArray> snapshot;
+    bool compactNow = false;
+    qint64 batchCount = 0;
+    {
+      QMutexLocker lock(&mutex);
+      while (pending.isEmpty() && !stopping)
+      {
+        recordsQueued.wait(&mutex);
+      }
+      if (pending.isEmpty())
+      {
+        break;
+      }
+      if (!stopping)
+      {
+        // let a burst of updates pile up, to write it with one fsync
+        commitRequested.wait(&mutex, COMMIT_DELAY);
+      }
+
+      records = pending;
+      pending.clear();
+      batchCount = queuedCount;
+      compactNow = needsCompaction();
+      if (compactNow)
+      {
+        // all queued records are reflected in the live records
+        snapshot = liveRecords;
+        deadRecords = 0;
+      }
+    }
+
+    bool written = compactNow ? compact(snapshot) : false;
+    if (!written)
+    {
+      written = append(records);
+    }
+    if (!written)
+    {
+      CTK_ERROR(log) << "{Configuration Admin} could not write to " << journalPath << ": "
+                     << file.errorString();
+    }
+
+    {
+      QMutexLocker lock(&mutex);
+      // the records of a failed batch are lost, remember that for flush()
+      if (!written) writeFailed = true;
+      writtenCount = batchCount;
+      recordsWritten.wakeAll();
+    }
+  }
+}
+
+bool ctkCMJournal::openForAppend()
+{
+  file.close();
+  file.setFileName(journalPath);
+  return file.open(QIODevice::WriteOnly | QIODevice::Append);
+}
+
+bool ctkCMJournal::append(const QByteArray& records)
+{
+  if (!file.isOpen())
+  {
+    return false;
+  }
+  if (file.write(records) != records.size())
+  {
+    return false;
+  }
+  return sync(file);
+}
+
+bool ctkCMJournal::compact(const QHash<QString, QByteArray>& records)
+{
+  const QString compactPath = journalPath + COMPACT_EXT;
+  QFile compactFile(compactPath);
+  if (!compactFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || !writeHeader(compactFile))
+  {
+    return false;
+  }
+
+  foreach (const QByteArray& record, records)
+  {
+    if (compactFile.write(record) != record.size())
+    {
+      compactFile.close();
+      QFile::remove(compactPath);
+      return false;
+    }
+  }
+  if (!sync(compactFile))
+  {
+    compactFile.close();
+    QFile::remove(compactPath);
+    return false;
+  }
+  compactFile.close();
+
+  file.close();
+  QFile::remove(journalPath);
+  if (!QFile::rename(compactPath, journalPath))
+  {
+    return false;
+  }
+  return openForAppend();
+}
+
+bool ctkCMJournal::needsCompaction() const
+{
+  return deadRecords >= MIN_COMPACT_RECORDS && deadRecords > liveRecords.size();
+}
+
+QByteArray ctkCMJournal::encodeRecord(quint8 type, const QString& pid,
+                                      const ctkDictionary& properties)
+{
+  QByteArray record;
+  QDataStream out(&record, QIODevice::WriteOnly);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << quint32(0) << quint16(0) << type << pid;
+  if (type == RECORD_PUT)
+  {
+    out << properties;
+  }
+
+  quint32 size = record.size() - RECORD_HEADER_SIZE;
+  out.device()->seek(0);
+  out << size << qChecksum(record.constData() + RECORD_HEADER_SIZE, size);
+  return record;
+}
+
+bool ctkCMJournal::writeHeader(QFile& file)
+{
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << JOURNAL_MAGIC << JOURNAL_VERSION;
+  return out.status() == QDataStream::Ok;
+}
+
+bool ctkCMJournal::sync(QFile& file)
+{
+  if (!file.flush())
+  {
+    return false;
+  }
+#ifdef Q_OS_WIN
+  return _commit(file.handle()) == 0;
+#else
+  return fsync(file.handle()) == 0;
+#endif
+}
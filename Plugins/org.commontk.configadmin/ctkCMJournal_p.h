@@ -0,0 +1,141 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKCMJOURNAL_P_H
+#define CTKCMJOURNAL_P_H
+
+#include <ctkDictionary.h>
+
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+
+struct ctkLogService;
+class ctkCMJournalWriterThread;
+
+/**
+ * ctkCMJournal persists configuration dictionaries in a single append-only
+ * journal file.
+ *
+ * Every update or removal of a configuration appends one checksummed record
+ * to the journal. The records are written by a writer thread which lets a
+ * burst of updates pile up for a few milliseconds and then writes them with
+ * one write and one fsync (group commit). Once the superseded records
+ * outnumber the live ones, the writer rewrites the journal with only the
+ * live records (compaction).
+ *
+ * At startup the journal is memory-mapped and replayed. An incomplete record
+ * at the end of the journal, left by a crash in the middle of a write, is
+ * discarded.
+ */
+class ctkCMJournal
+{
+
+public:
+
+  ctkCMJournal(const QDir& store, ctkLogService* log);
+
+  /**
+   * Writes all pending records and stops the writer thread.
+   */
+  ~ctkCMJournal();
+
+  /**
+   * Reads the journal and starts the writer thread. Must be called once,
+   * before any other method.
+   *
+   * @return The dictionaries of all stored configurations, by pid.
+   */
+  QHash<QString, ctkDictionary> load();
+
+  /**
+   * Queues the dictionary of a configuration to be written. Returns
+   * without waiting for the record to be written.
+   */
+  void put(const QString& pid, const ctkDictionary& properties);
+
+  /**
+   * Queues the removal of a configuration to be written. Returns without
+   * waiting for the record to be written.
+   */
+  void remove(const QString& pid);
+
+  /**
+   * Waits until all records queued so far have been written to disk.
+   *
+   * @return <code>false</code> if writing any record to the journal
+   *         failed, i.e. the journal may not contain all configurations.
+   */
+  bool flush();
+
+private:
+
+  friend class ctkCMJournalWriterThread;
+
+  static const QString JOURNAL_FILE; // = "configurations.journal"
+  static const QString COMPACT_EXT; // = ".compact"
+  static const int COMMIT_DELAY; // = 5
+  static const int MIN_COMPACT_RECORDS; // = 256
+
+  QDir store;
+  ctkLogService* log;
+  QString journalPath;
+
+  // Only used by the writer thread, once the journal has been loaded
+  QFile file;
+
+  QMutex mutex;
+  QWaitCondition recordsQueued;
+  QWaitCondition recordsWritten;
+  QWaitCondition commitRequested;
+
+  QByteArray pending;
+  // The encoded record of each live configuration, used for compaction
+  QHash<QString, QByteArray> liveRecords;
+  int deadRecords;
+  qint64 queuedCount;
+  qint64 writtenCount;
+  // Set once a batch of records could not be written
+  bool writeFailed;
+  bool stopping;
+
+  ctkCMJournalWriterThread* writer;
+
+  // The loop of the writer thread
+  void writeRecords();
+
+  void queue(quint8 type, const QString& pid, const QByteArray& record);
+  bool openForAppend();
+  bool append(const QByteArray& records);
+  bool compact(const QHash<QString, QByteArray>& records);
+  bool needsCompaction() const;
+
+  static QByteArray encodeRecord(quint8 type, const QString& pid,
+                                 const ctkDictionary& properties);
+  static bool writeHeader(QFile& file);
+  static bool sync(QFile& file);
+
+};
+
+#endif // CTKCMJOURNAL_P_H
@@ -22,6 +22,7 @@
 
 #include "ctkConfigurationStore_p.h"
 #include "ctkConfigurationAdminFactory_p.h"
+#include "ctkCMJournal_p.h"
 
 #include <ctkPluginContext.h>
 #include <service/log/ctkLogService.h>
@@ -36,7 +37,7 @@ ctkConfigurationStore::ctkConfigurationStore(
   ctkConfigurationAdminFactory* configurationAdminFactory,
   ctkPluginContext* context)
   : configurationAdminFactory(configurationAdminFactory),
-    createdPidCount(0)
+    createdPidCount(0), journal(0)
 {
   store = context->getDataFile(STORE_DIR).absoluteDir();
 
@@ -45,83 +46,43 @@ ctkConfigurationStore::ctkConfigurationStore(
     return; // no persistent store
   }
 
-  QStringList nameFilters;
-  nameFilters << QString('*') + PID_EXT;
-  QFileInfoList configurationFiles = store.entryInfoList(nameFilters, QDir::Files | QDir::CaseSensitive);
-  foreach (QFileInfo configFileInfo, configurationFiles)
+  journal = new ctkCMJournal(store, configurationAdminFactory->getLogService());
+  QHash<QString, ctkDictionary> dictionaries = journal->load();
+  QHash<QString, ctkDictionary>::const_iterator it = dictionaries.constBegin();
+  for (; it != dictionaries.constEnd(); ++it)
   {
-    QString configurationFilePath = configFileInfo.absoluteFilePath();
-    QString configurationFileName = configFileInfo.fileName();
-    QString pid = configurationFileName.mid(0, configurationFileName.size() - PID_EXT.size());
-
-    bool deleteFile = false;
-    QIODevice* iodevice = new QFile(configurationFilePath);
-    iodevice->open(QIODevice::ReadOnly);
-    QDataStream dataStream(iodevice);
-
-    ctkDictionary dictionary;
-    dataStream >> dictionary;
-    if (dataStream.status() == QDataStream::Ok)
-    {
-      ctkConfigurationImplPtr config(new ctkConfigurationImpl(configurationAdminFactory, this, dictionary));
-      configurations.insert(config->getPid(), config);
-    }
-    else
-    {
-      QString message = iodevice->errorString();
-      QString errorMessage = QString("{Configuration Admin - pid = %1} could not be restored. %2").arg(pid).arg(message);
-      CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
-      deleteFile = true;
-    }
+    ctkConfigurationImplPtr config(new ctkConfigurationImpl(configurationAdminFactory, this, it.value()));
+    configurations.insert(config->getPid(), config);
+  }
 
-    iodevice->close();
-    delete iodevice;
+  importConfigurationFiles();
+}
 
-    if (deleteFile)
-    {
-      QFile::remove(configurationFilePath);
-    }
-  }
+ctkConfigurationStore::~ctkConfigurationStore()
+{
+  // writes all pending updates
+  delete journal;
 }
 
 void ctkConfigurationStore::saveConfiguration(const QString& pid, ctkConfigurationImpl* config)
 {
-  if (!store.exists())
+  if (!journal)
     return; // no persistent store
 
   config->checkLocked();
-  QFile configFile(store.filePath(pid + PID_EXT));
-  ctkDictionary configProperties = config->getAllProperties();
   //TODO security
-//  try
-//  {
-//    AccessController.doPrivileged(new PrivilegedExceptionAction() {
-//      public Object run() throws Exception {
-        writeConfigurationFile(configFile, configProperties);
-//        return null;
-//      }
-//    });
-//  }
-//  catch (PrivilegedActionException e)
-//  {
-//    throw (IOException) e.getException();
-//  }
+  journal->put(pid, config->getAllProperties());
 }
 
 void ctkConfigurationStore::removeConfiguration(const QString& pid)
 {
   QMutexLocker lock(&mutex);
   configurations.remove(pid);
-  if (!store.exists())
+  if (!journal)
     return; // no persistent store
 
-  QFile configFile(store.filePath(pid + PID_EXT));
-  //TODO security//  AccessController.doPrivileged(new PrivilegedAction() {
-//    public Object run() {
-  deleteConfigurationFile(configFile);
-//      return null;
-//    }
-//  });
+  //TODO security
+  journal->remove(pid);
 }
 
 ctkConfigurationImplPtr ctkConfigurationStore::getConfiguration(
@@ -194,19 +155,52 @@ void ctkConfigurationStore::unbindConfigurations(QSharedPointer<ctkPlugin> plugi
   }
 }
 
-void ctkConfigurationStore::writeConfigurationFile(QFile& configFile,
-                            const ctkDictionary& configProperties)
+void ctkConfigurationStore::importConfigurationFiles()
 {
-  QIODevice* iodevice = &configFile;
-  iodevice->open(QIODevice::WriteOnly);
-  QDataStream datastream(iodevice);
+  QStringList nameFilters;
+  nameFilters << QString('*') + PID_EXT;
+  QFileInfoList configurationFiles = store.entryInfoList(nameFilters, QDir::Files | QDir::CaseSensitive);
+  if (configurationFiles.isEmpty())
+  {
+    return;
+  }
 
-  datastream << configProperties;
-  // ignore errors
-  iodevice->close();
-}
+  foreach (QFileInfo configFileInfo, configurationFiles)
+  {
+    QString configurationFilePath = configFileInfo.absoluteFilePath();
+    QString configurationFileName = configFileInfo.fileName();
+    QString pid = configurationFileName.mid(0, configurationFileName.size() - PID_EXT.size());
 
-void ctkConfigurationStore::deleteConfigurationFile(QFile& configFile)
-{
-  configFile.remove();
+    QFile configFile(configurationFilePath);
+    configFile.open(QIODevice::ReadOnly);
+    QDataStream dataStream(&configFile);
+
+    ctkDictionary dictionary;
+    dataStream >> dictionary;
+    if (dataStream.status() == QDataStream::Ok)
+    {
+      ctkConfigurationImplPtr config(new ctkConfigurationImpl(configurationAdminFactory, this, dictionary));
+      configurations.insert(config->getPid(), config);
+      journal->put(config->getPid(), dictionary);
+    }
+    else
+    {
+      QString message = configFile.errorString();
+      QString errorMessage = QString("{Configuration Admin - pid = %1} could not be restored. %2").arg(pid).arg(message);
+      CTK_ERROR(configurationAdminFactory->getLogService()) << errorMessage;
+    }
+  }
+
+  // only remove the files once their contents are safely in the journal
+  if (!journal->flush())
+  {
+    CTK_ERROR(configurationAdminFactory->getLogService())
+        << "{Configuration Admin} could not move the configuration files in "
+        << store.absolutePath() << " into the journal, keeping them";
+    return;
+  }
+  foreach (QFileInfo configFileInfo, configurationFiles)
+  {
+    QFile::remove(configFileInfo.absoluteFilePath());
+  }
 }
@@ -34,14 +34,14 @@
 
 class ctkConfigurationImpl;
 class ctkConfigurationAdminFactory;
+class ctkCMJournal;
 class ctkPluginContext;
 class ctkPlugin;
 
 /**
- * ctkConfigurationStore manages all active configurations along with persistence. The current
- * implementation uses a filestore and serialization of the configuration dictionaries to files
- * identified by their pid. Persistence details are in the constructor, saveConfiguration, and
- * deleteConfiguration and can be factored out separately if required.
+ * ctkConfigurationStore manages all active configurations along with persistence. The
+ * configuration dictionaries are persisted in a journal, see ctkCMJournal. Configurations
+ * found in the one-file-per-pid format of earlier versions are moved into the journal.
  */
 class ctkConfigurationStore
 {
@@ -50,6 +50,7 @@ public:
 
   ctkConfigurationStore(ctkConfigurationAdminFactory* configurationAdminFactory,
                         ctkPluginContext* context);
+  ~ctkConfigurationStore();
 
   void saveConfiguration(const QString& pid, ctkConfigurationImpl* config);
   void removeConfiguration(const QString& pid);
@@ -75,11 +76,9 @@ private:
   QHash<QString, ctkConfigurationImplPtr> configurations;
   int createdPidCount;
   QDir store;
+  ctkCMJournal* journal;
 
-
-  void writeConfigurationFile(QFile& configFile,
-                              const ctkDictionary& configProperties);
-  void deleteConfigurationFile(QFile& configFile);
+  void importConfigurationFiles();
 
 };
 
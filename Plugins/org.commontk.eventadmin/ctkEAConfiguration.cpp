@@ -45,7 +45,7 @@ const QString ctkEAConfiguration::PROP_LOG_LEVEL = "org.commontk.eventadmin.LogL
 
 
 ctkEAConfiguration::ctkEAConfiguration(ctkPluginContext* pluginContext )
-  : pluginContext(pluginContext), sync_pool(0), async_pool(0), admin(0)
+  : pluginContext(pluginContext), async_pool(0), admin(0)
 {
   // default configuration
   configure(ctkDictionary());
@@ -193,20 +193,19 @@ void ctkEAConfiguration::destroy()
   if (admin)
   {
     admin->stop();
-    delete admin;
-    admin = 0;
   }
+  // Close the pool before deleting the admin, the workers may still be
+  // delivering posted events
   if (async_pool)
   {
     async_pool->close();
     delete async_pool;
     async_pool = 0;
   }
-  if (sync_pool)
+  if (admin)
   {
-    sync_pool->close();
-    delete sync_pool;
-    sync_pool = 0;
+    delete admin;
+    admin = 0;
   }
 }
 
@@ -223,31 +222,21 @@ void ctkEAConfiguration::startOrUpdate()
   CTK_DEBUG(ctkEventAdminActivator::getLogService())
       << PROP_REQUIRE_TOPIC << "=" << requireTopic;
 
-  ctkEventAdminService::TopicHandlerFiltersInterface* topicHandlerFilters =
-      new ctkEventAdminService::TopicHandlerFilters(
-        new ctkEventAdminService::TopicCacheMap(cacheSize), requireTopic);
-
   ctkEventAdminService::FiltersInterface* filters =
       new ctkEventAdminService::Filters(
         new ctkEventAdminService::LDAPCacheMap(cacheSize), pluginContext);
 
-  // Note that this uses a lazy thread pool that will create new threads on
-  // demand - in case none of its cached threads is free - until threadPoolSize
-  // is reached. Subsequently, a threadPoolSize of 2 effectively disables
-  // caching of threads.
-  if (sync_pool == 0)
-  {
-    sync_pool = new ctkEADefaultThreadPool(threadPoolSize, true);
-  }
-  else
-  {
-    sync_pool->configure(threadPoolSize);
-  }
+  // The index keeps track of the registered ctkEventHandler services by their
+  // topics and compiles their EVENT_FILTER once
+  ctkEventAdminService::TopicHandlerIndex* topicHandlerIndex =
+      new ctkEventAdminService::TopicHandlerIndex(pluginContext, filters, requireTopic);
 
+  // The workers of this pool deliver the posted events. Synchronous events
+  // are delivered by the sending thread and do not need a pool.
   int asyncThreadPoolSize = threadPoolSize > 5 ? threadPoolSize / 2 : 2;
   if (async_pool == 0)
   {
-    async_pool = new ctkEADefaultThreadPool(asyncThreadPoolSize, false);
+    async_pool = new ctkEAWorkStealingExecutor(asyncThreadPoolSize);
   }
   else
   {
@@ -260,11 +249,11 @@ void ctkEAConfiguration::startOrUpdate()
   // below (and not in this HandlerTasks object!)
   ctkEventAdminService::HandlerTasksInterface* handlerTasks =
       new ctkEventAdminService::BlacklistingHandlerTasks(
-        pluginContext, new ctkEventAdminService::BlackList(), topicHandlerFilters, filters);
+        pluginContext, new ctkEventAdminService::BlackList(), topicHandlerIndex);
 
   if (admin == 0)
   {
-    admin = new ctkEventAdminService(pluginContext, handlerTasks, sync_pool, async_pool,
+    admin = new ctkEventAdminService(pluginContext, handlerTasks, async_pool,
                                      timeout, ignoreTimeout);
 
     // Finally, adapt the outside events to our kind of events as per spec
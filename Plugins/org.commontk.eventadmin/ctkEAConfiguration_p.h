@@ -25,7 +25,7 @@
 
 #include <QString>
 
-#include "dispatch/ctkEADefaultThreadPool_p.h"
+#include "dispatch/ctkEAWorkStealingExecutor_p.h"
 #include "ctkEventAdminService_p.h"
 
 #include <service/cm/ctkManagedService.h>
@@ -131,8 +131,7 @@ private:
   int logLevel;
 
   // The thread pool used - this is a member because we need to close it on stop
-  ctkEADefaultThreadPool* sync_pool;
-  ctkEADefaultThreadPool* async_pool;
+  ctkEAWorkStealingExecutor* async_pool;
 
   // The actual implementation of the service - this is a member because we need to
   // close it on stop. Note, security is not part of this implementation but is
@@ -20,22 +20,20 @@
 =============================================================================*/
 
 
-#include "dispatch/ctkEADefaultThreadPool_p.h"
+#include "dispatch/ctkEAWorkStealingExecutor_p.h"
 
 
 template<class HandlerTasks, class SyncDeliverTasks, class AsyncDeliverTasks>
 ctkEventAdminImpl<HandlerTasks,SyncDeliverTasks,AsyncDeliverTasks>::ctkEventAdminImpl(
-  HandlerTasksInterface* managers, ctkEADefaultThreadPool* syncPool,
-  ctkEADefaultThreadPool* asyncPool, int timeout,
+  HandlerTasksInterface* managers,
+  ctkEAWorkStealingExecutor* asyncPool, int timeout,
   const QStringList& ignoreTimeout)
   : managers(managers)
 {
   checkNull(managers, "Managers");
-  checkNull(syncPool, "syncPool");
   checkNull(asyncPool, "asyncPool");
 
-  sendManager = new SyncDeliverTasks(syncPool, &syncMasterThread,
-                                     (timeout > 100 ? timeout : 0),
+  sendManager = new SyncDeliverTasks((timeout > 100 ? timeout : 0),
                                      ignoreTimeout);
 
   postManager = new AsyncDeliverTasks(asyncPool, sendManager);
@@ -54,6 +52,20 @@ void ctkEventAdminImpl<HandlerTasks,SyncDeliverTasks,AsyncDeliverTasks>::postEve
   handleEvent(managers.fetchAndAddOrdered(0)->createHandlerTasks(event), postManager);
 }
 
+template<class HandlerTasks, class SyncDeliverTasks, class AsyncDeliverTasks>
+void ctkEventAdminImpl<HandlerTasks,SyncDeliverTasks,AsyncDeliverTasks>::postEvents(const QList<ctkEvent>& events)
+{
+  HandlerTasksInterface* currManagers = managers.fetchAndAddOrdered(0);
+  QList<HandlerTask> tasks;
+  foreach(const ctkEvent& event, events)
+  {
+    tasks.append(currManagers->createHandlerTasks(event));
+  }
+  // All tasks are queued as one unit, so the delivery can coalesce and
+  // batch them
+  handleEvent(tasks, postManager);
+}
+
 template<class HandlerTasks, class SyncDeliverTasks, class AsyncDeliverTasks>
 void ctkEventAdminImpl<HandlerTasks,SyncDeliverTasks,AsyncDeliverTasks>::sendEvent(const ctkEvent& event)
 {
@@ -86,7 +98,7 @@ void ctkEventAdminImpl<HandlerTasks,SyncDeliverTasks,AsyncDeliverTasks>::stop()
   HandlerTasksInterface* oldManagers =
       this->managers.fetchAndStoreOrdered(&stoppedHandlerTasks);
   delete oldManagers;
-  syncMasterThread.stop();
+  sendManager->stop();
 }
 
 template<class HandlerTasks, class SyncDeliverTasks, class AsyncDeliverTasks>
@@ -25,9 +25,8 @@
 
 #include "handler/ctkEAHandlerTasks_p.h"
 #include "tasks/ctkEADeliverTask_p.h"
-#include "dispatch/ctkEASyncMasterThread_p.h"
 
-class ctkEADefaultThreadPool;
+class ctkEAWorkStealingExecutor;
 
 /**
  * This is the actual implementation of the OSGi R4 Event Admin Service (see the
@@ -60,9 +59,6 @@ private:
   // The asynchronous event dispatcher
   AsyncDeliverTaskInterface* postManager;
 
-  // The (interruptible) thread where sync events are handled
-  ctkEASyncMasterThread syncMasterThread;
-
   // The synchronous event dispatcher
   SyncDeliverTasks* sendManager;
 
@@ -96,12 +92,10 @@ public:
    * <tt>ctkEADeliverTasks</tt> are used to dispatch the event.
    *
    * @param managers The factory used to determine applicable <tt>ctkEventHandler</tt>
-   * @param syncPool The synchronous thread pool
    * @param asyncPool The asynchronous thread pool
    */
   ctkEventAdminImpl(HandlerTasksInterface* managers,
-                    ctkEADefaultThreadPool* syncPool,
-                    ctkEADefaultThreadPool* asyncPool,
+                    ctkEAWorkStealingExecutor* asyncPool,
                     int timeout,
                     const QStringList& ignoreTimeout);
 
@@ -118,6 +112,17 @@ public:
    */
   void postEvent(const ctkEvent& event);
 
+  /**
+   * Post several asynchronous events at once.
+   *
+   * @param events The events to be posted by this service
+   *
+   * @throws ctkIllegalStateException - In case we are stopped
+   *
+   * @see ctkEventAdmin#postEvents(const QList<ctkEvent>&)
+   */
+  void postEvents(const QList<ctkEvent>& events);
+
   /**
    * Send a synchronous event.
    *
@@ -28,11 +28,10 @@
 
 ctkEventAdminService::ctkEventAdminService(ctkPluginContext* context,
                                            HandlerTasksInterface* managers,
-                                           ctkEADefaultThreadPool* syncPool,
-                                           ctkEADefaultThreadPool* asyncPool,
+                                           ctkEAWorkStealingExecutor* asyncPool,
                                            int timeout,
                                            const QStringList& ignoreTimeout)
-  : impl(managers, syncPool, asyncPool, timeout, ignoreTimeout),
+  : impl(managers, asyncPool, timeout, ignoreTimeout),
     context(context)
 {
 
@@ -52,6 +51,11 @@ void ctkEventAdminService::postEvent(const ctkEvent& event)
   impl.postEvent(event);
 }
 
+void ctkEventAdminService::postEvents(const QList<ctkEvent>& events)
+{
+  impl.postEvents(events);
+}
+
 void ctkEventAdminService::sendEvent(const ctkEvent& event)
 {
   impl.sendEvent(event);
@@ -31,8 +31,8 @@
 
 #include "handler/ctkEACleanBlackList_p.h"
 #include "util/ctkEALeastRecentlyUsedCacheMap_p.h"
-#include "handler/ctkEACacheTopicHandlerFilters_p.h"
 #include "handler/ctkEACacheFilters_p.h"
+#include "handler/ctkEATopicHandlerIndex_p.h"
 #include "tasks/ctkEASyncDeliverTasks_p.h"
 #include "tasks/ctkEAAsyncDeliverTasks_p.h"
 #include "dispatch/ctkEASignalPublisher_p.h"
@@ -49,14 +49,12 @@ public:
   typedef ctkEACleanBlackList BlackList;
   typedef ctkEABlackList<BlackList> BlackListInterface;
 
-  typedef ctkEALeastRecentlyUsedCacheMap<QString, QString> TopicCacheMap;
-  typedef ctkEACacheTopicHandlerFilters<TopicCacheMap> TopicHandlerFilters;
-  typedef ctkEATopicHandlerFilters<TopicHandlerFilters> TopicHandlerFiltersInterface;
   typedef ctkEALeastRecentlyUsedCacheMap<QString, ctkLDAPSearchFilter> LDAPCacheMap;
   typedef ctkEACacheFilters<LDAPCacheMap> Filters;
   typedef ctkEAFilters<Filters> FiltersInterface;
+  typedef ctkEATopicHandlerIndex<Filters> TopicHandlerIndex;
 
-  typedef ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters> BlacklistingHandlerTasks;
+  typedef ctkEABlacklistingHandlerTasks<BlackList, Filters> BlacklistingHandlerTasks;
   typedef ctkEAHandlerTasks<BlacklistingHandlerTasks> HandlerTasksInterface;
 
   typedef ctkEAHandlerTask<BlacklistingHandlerTasks> HandlerTask;
@@ -77,8 +75,7 @@ private:
 public:
   ctkEventAdminService(ctkPluginContext* context,
                        HandlerTasksInterface* managers,
-                       ctkEADefaultThreadPool* syncPool,
-                       ctkEADefaultThreadPool* asyncPool,
+                       ctkEAWorkStealingExecutor* asyncPool,
                        int timeout,
                        const QStringList& ignoreTimeout);
 
@@ -86,6 +83,8 @@ public:
 
   void postEvent(const ctkEvent& event);
 
+  void postEvents(const QList<ctkEvent>& events);
+
   void sendEvent(const ctkEvent& event);
 
   void publishSignal(const QObject* publisher, const char* signal,
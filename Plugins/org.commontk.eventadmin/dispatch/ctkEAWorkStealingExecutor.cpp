@@ -0,0 +1,179 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkEAWorkStealingExecutor_p.h"
+
+#include <QThread>
+
+class ctkEAWorkStealingExecutor::Worker : public QThread
+{
+
+public:
+
+  Worker(ctkEAWorkStealingExecutor* executor, int index)
+    : executor(executor), index(index)
+  {
+    setObjectName(QString("ctkEAWorker-%1").arg(index));
+  }
+
+  void push(Job* job)
+  {
+    QMutexLocker l(&queueMutex);
+    queue.push_back(job);
+  }
+
+  /** Takes the oldest job, used by the owning worker. */
+  Job* takeFirst()
+  {
+    QMutexLocker l(&queueMutex);
+    return queue.isEmpty() ? 0 : queue.takeFirst();
+  }
+
+  /** Takes the newest job, used by other workers. */
+  Job* steal()
+  {
+    QMutexLocker l(&queueMutex);
+    return queue.isEmpty() ? 0 : queue.takeLast();
+  }
+
+protected:
+
+  void run()
+  {
+    while (Job* job = executor->take(index))
+    {
+      if (job->run())
+      {
+        executor->execute(job);
+      }
+    }
+  }
+
+private:
+
+  ctkEAWorkStealingExecutor* const executor;
+  const int index;
+
+  QMutex queueMutex;
+  QList<Job*> queue;
+};
+
+ctkEAWorkStealingExecutor::ctkEAWorkStealingExecutor(int poolSize)
+{
+  configure(poolSize);
+}
+
+ctkEAWorkStealingExecutor::~ctkEAWorkStealingExecutor()
+{
+  close();
+}
+
+void ctkEAWorkStealingExecutor::configure(int poolSize)
+{
+  QWriteLocker l(&workersLock);
+  if (closed.fetchAndAddOrdered(0)) return;
+
+  while (workers.size() < poolSize)
+  {
+    Worker* worker = new Worker(this, workers.size());
+    workers.push_back(worker);
+    worker->start();
+  }
+}
+
+void ctkEAWorkStealingExecutor::close()
+{
+  int n = 0;
+  {
+    QWriteLocker l(&workersLock);
+    if (!closed.testAndSetOrdered(0, 1)) return;
+    n = workers.size();
+  }
+
+  // wake up all workers, running jobs are finished first
+  available.release(n);
+  foreach(Worker* worker, workers)
+  {
+    worker->wait();
+  }
+
+  QWriteLocker l(&workersLock);
+  foreach(Worker* worker, workers)
+  {
+    while (Job* job = worker->takeFirst())
+    {
+      job->discard();
+    }
+  }
+  qDeleteAll(workers);
+  workers.clear();
+}
+
+void ctkEAWorkStealingExecutor::execute(Job* job)
+{
+  {
+    QReadLocker l(&workersLock);
+    if (!closed.fetchAndAddOrdered(0))
+    {
+      workers[job->home % workers.size()]->push(job);
+      job = 0;
+    }
+  }
+
+  if (job)
+  {
+    job->discard();
+  }
+  else
+  {
+    available.release();
+  }
+}
+
+ctkEAWorkStealingExecutor::Job* ctkEAWorkStealingExecutor::take(int index)
+{
+  available.acquire();
+
+  QReadLocker l(&workersLock);
+  if (closed.fetchAndAddOrdered(0))
+  {
+    return 0;
+  }
+
+  // Each permit stands for a queued job, but another worker may be about
+  // to take the job which was pushed for our permit and leave us its own.
+  forever
+  {
+    if (Job* job = workers[index]->takeFirst())
+    {
+      return job;
+    }
+    for (int i = 1; i < workers.size(); ++i)
+    {
+      if (Job* job = workers[(index + i) % workers.size()]->steal())
+      {
+        return job;
+      }
+    }
+    QThread::yieldCurrentThread();
+  }
+}
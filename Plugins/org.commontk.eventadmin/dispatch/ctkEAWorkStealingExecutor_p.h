@@ -0,0 +1,120 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKEAWORKSTEALINGEXECUTOR_P_H
+#define CTKEAWORKSTEALINGEXECUTOR_P_H
+
+#include <QList>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QSemaphore>
+
+/**
+ * A pool of worker threads executing jobs. Each worker owns a run queue.
+ * A job is scheduled onto the queue of its home worker, so that jobs of
+ * the same origin tend to stay on the same thread, and idle workers steal
+ * jobs from the queues of busy ones.
+ *
+ * A job is only ever in one run queue and executed by one worker at a
+ * time, hence a job that processes its own queue of work items keeps their
+ * order.
+ */
+class ctkEAWorkStealingExecutor
+{
+
+public:
+
+  struct Job
+  {
+    Job() : home(0) {}
+    virtual ~Job() {}
+
+    /**
+     * Executes the job.
+     *
+     * @return <code>true</code> if the job should be scheduled again. If
+     *         <code>false</code> is returned, the executor does not access
+     *         the job anymore.
+     */
+    virtual bool run() = 0;
+
+    /**
+     * Called instead of run() for jobs that are still queued when the
+     * executor is closed. The executor does not access the job anymore.
+     */
+    virtual void discard() = 0;
+
+    /** The index of the preferred worker. */
+    int home;
+  };
+
+  /**
+   * Create a new pool with <code>poolSize</code> workers.
+   */
+  ctkEAWorkStealingExecutor(int poolSize);
+
+  ~ctkEAWorkStealingExecutor();
+
+  /**
+   * Configure a new pool size. The pool only grows, surplus workers of a
+   * smaller size stay around and steal work.
+   */
+  void configure(int poolSize);
+
+  /**
+   * Close the pool. Running jobs are finished, queued jobs are discarded
+   * and jobs scheduled afterwards are discarded immediately.
+   */
+  void close();
+
+  /**
+   * Schedule the job for execution. May be called from any thread,
+   * including the workers.
+   *
+   * @param job The job to execute
+   */
+  void execute(Job* job);
+
+private:
+
+  class Worker;
+  friend class Worker;
+
+  // Guards the worker list, which is only modified by configure() and close()
+  QReadWriteLock workersLock;
+  QList<Worker*> workers;
+
+  // One permit per queued job
+  QSemaphore available;
+
+  QAtomicInt closed;
+
+  /**
+   * Takes the next job, preferably from the queue of the worker with the
+   * given index. Blocks until a job is available or the pool is closed.
+   */
+  Job* take(int index);
+
+  Q_DISABLE_COPY(ctkEAWorkStealingExecutor)
+};
+
+#endif // CTKEAWORKSTEALINGEXECUTOR_P_H
@@ -20,83 +20,69 @@
 =============================================================================*/
 
 
-template<class BlackList, class TopicHandlerFilters, class Filters>
-ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters>::
+template<class BlackList, class Filters>
+ctkEABlacklistingHandlerTasks<BlackList, Filters>::
 ctkEABlacklistingHandlerTasks(ctkPluginContext* context,
                               ctkEABlackList<BlackList>* blackList,
-                              ctkEATopicHandlerFilters<TopicHandlerFilters>* topicHandlerFilters,
-                              ctkEAFilters<Filters>* filters)
-  : blackList(blackList), context(context),
-    topicHandlerFilters(topicHandlerFilters), filters(filters)
+                              ctkEATopicHandlerIndex<Filters>* index)
+  : blackList(blackList), context(context), index(index)
 {
   checkNull(context, "Context");
   checkNull(blackList, "BlackList");
-  checkNull(topicHandlerFilters, "TopicHandlerFilters");
-  checkNull(filters, "Filters");
+  checkNull(index, "TopicHandlerIndex");
 }
 
-template<class BlackList, class TopicHandlerFilters, class Filters>
-ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters>::
+template<class BlackList, class Filters>
+ctkEABlacklistingHandlerTasks<BlackList, Filters>::
 ~ctkEABlacklistingHandlerTasks()
 {
-  delete filters;
-  delete topicHandlerFilters;
+  delete index;
   delete blackList;
 }
 
-template<class BlackList, class TopicHandlerFilters, class Filters>
-QList<ctkEAHandlerTask<ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters> > >
-ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters>::
+template<class BlackList, class Filters>
+QList<ctkEAHandlerTask<ctkEABlacklistingHandlerTasks<BlackList, Filters> > >
+ctkEABlacklistingHandlerTasks<BlackList, Filters>::
 createHandlerTasks(const ctkEvent& event)
 {
-  QList<ctkEAHandlerTask<Self> > result;
-  QList<ctkServiceReference> handlerRefs;
+  typedef typename ctkEATopicHandlerIndex<Filters>::Handler Handler;
 
-  try
-  {
-    handlerRefs = context->getServiceReferences<ctkEventHandler>(
-          topicHandlerFilters->createFilterForTopic(event.getTopic()));
-  }
-  catch (const ctkInvalidArgumentException& e)
-  {
-    CTK_WARN_EXC(ctkEventAdminActivator::getLogService(), &e)
-        << "Invalid EVENT_TOPIC [" << event.getTopic() << "]";
-  }
+  QList<ctkEAHandlerTask<Self> > result;
+  QList<Handler> handlers = index->getHandlers(event.getTopic());
 
-  for (int i = 0; i < handlerRefs.size(); ++i)
+  for (int i = 0; i < handlers.size(); ++i)
   {
-    const ctkServiceReference& ref = handlerRefs.at(i);
+    const Handler& handler = handlers.at(i);
+    const ctkServiceReference& ref = handler.reference;
     if (!blackList->contains(ref)
         //TODO security
         //&& ref.getPlugin()->hasPermission(
         //  PermissionsUtil.createSubscribePermission(event.getTopic()))
         )
     {
-      try
-      {
-        if (event.matches(filters->createFilter(
-                            ref.getProperty(ctkEventConstants::EVENT_FILTER).toString())))
-        {
-          result.push_back(ctkEAHandlerTask<Self>(ref, event, this));
-        }
-      }
-      catch (const ctkInvalidArgumentException& e)
+      if (!handler.filterError.isEmpty())
       {
+        ctkInvalidArgumentException e(handler.filterError);
         CTK_WARN_SR_EXC(ctkEventAdminActivator::getLogService(), ref, &e)
             << "Invalid EVENT_FILTER - Blacklisting ServiceReference ["
             << ref << " | Plugin(" << ref.getPlugin() << ")]";
 
         blackList->add(ref);
       }
+      else if (event.matches(handler.filter))
+      {
+        result.push_back(ctkEAHandlerTask<Self>(ref, event, this,
+                                                handler.coalesceProperty));
+      }
     }
   }
 
   return result;
 }
 
-template<class BlackList, class TopicHandlerFilters, class Filters>
+template<class BlackList, class Filters>
 void
-ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters>::
+ctkEABlacklistingHandlerTasks<BlackList, Filters>::
 blackListRef(const ctkServiceReference& handlerRef)
 {
   blackList->add(handlerRef);
@@ -106,9 +92,9 @@ blackListRef(const ctkServiceReference& handlerRef)
       << handlerRef.getPlugin() << ")] due to timeout!";
 }
 
-template<class BlackList, class TopicHandlerFilters, class Filters>
+template<class BlackList, class Filters>
 ctkEventHandler*
-ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters>::
+ctkEABlacklistingHandlerTasks<BlackList, Filters>::
 getEventHandler(const ctkServiceReference& handlerRef)
 {
   ctkEventHandler* result = (blackList->contains(handlerRef)) ? 0
@@ -117,9 +103,9 @@ getEventHandler(const ctkServiceReference& handlerRef)
   return (result ? result : &nullEventHandler);
 }
 
-template<class BlackList, class TopicHandlerFilters, class Filters>
+template<class BlackList, class Filters>
 void
-ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters>::
+ctkEABlacklistingHandlerTasks<BlackList, Filters>::
 ungetEventHandler(ctkEventHandler* handler,
                        const ctkServiceReference& handlerRef)
 {
@@ -134,9 +120,9 @@ ungetEventHandler(ctkEventHandler* handler,
   }
 }
 
-template<class BlackList, class TopicHandlerFilters, class Filters>
+template<class BlackList, class Filters>
 void
-ctkEABlacklistingHandlerTasks<BlackList, TopicHandlerFilters, Filters>::
+ctkEABlacklistingHandlerTasks<BlackList, Filters>::
 checkNull(void* object, const QString& name)
 {
   if(object == 0)
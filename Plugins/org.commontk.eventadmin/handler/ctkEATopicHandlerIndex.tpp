@@ -0,0 +1,264 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include <ctkPluginConstants.h>
+#include <service/event/ctkEventConstants.h>
+#include <service/event/ctkEventHandler.h>
+
+#include <QtAlgorithms>
+
+template<class Filters>
+ctkEATopicHandlerIndex<Filters>::
+ctkEATopicHandlerIndex(ctkPluginContext* context,
+                       ctkEAFilters<Filters>* filters,
+                       bool requireTopic)
+  : context(context), filters(filters), requireTopic(requireTopic)
+{
+  if (context == 0)
+  {
+    throw ctkInvalidArgumentException("Context may not be null");
+  }
+  if (filters == 0)
+  {
+    throw ctkInvalidArgumentException("Filters may not be null");
+  }
+
+  QString iid = qobject_interface_iid<ctkEventHandler*>();
+  QString listenerFilter = QString("(") + ctkPluginConstants::OBJECTCLASS + "=" + iid + ")";
+
+  QWriteLocker l(&lock);
+  context->connectServiceListener(this, "serviceChanged", listenerFilter);
+  foreach (ctkServiceReference ref, context->getServiceReferences(iid))
+  {
+    addHandler(ref);
+  }
+}
+
+template<class Filters>
+ctkEATopicHandlerIndex<Filters>::
+~ctkEATopicHandlerIndex()
+{
+  try
+  {
+    context->disconnectServiceListener(this, "serviceChanged");
+  }
+  catch (const ctkIllegalStateException&)
+  {
+    // In case the context was stopped.
+  }
+  delete filters;
+}
+
+template<class Filters>
+QList<typename ctkEATopicHandlerIndex<Filters>::Handler>
+ctkEATopicHandlerIndex<Filters>::
+getHandlers(const QString& topic) const
+{
+  QList<qlonglong> ids;
+
+  QReadLocker l(&lock);
+
+  if (!requireTopic)
+  {
+    collect(noTopic, ids);
+  }
+
+  // handlers subscribed to "*"
+  const Node* node = &root;
+  collect(node->wildcard, ids);
+
+  int start = 0;
+  while (node != 0)
+  {
+    int end = topic.indexOf('/', start);
+    node = node->children.value(topic.mid(start, end < 0 ? -1 : end - start));
+    if (node == 0)
+    {
+      break;
+    }
+    if (end < 0)
+    {
+      collect(node->exact, ids);
+      break;
+    }
+    collect(node->wildcard, ids);
+    start = end + 1;
+  }
+
+  // A handler may be subscribed to several matching topics
+  qSort(ids);
+  QList<Handler> result;
+  qlonglong last = -1;
+  foreach (qlonglong id, ids)
+  {
+    if (id == last) continue;
+    last = id;
+    result.push_back(entries[id].handler);
+  }
+  return result;
+}
+
+template<class Filters>
+void
+ctkEATopicHandlerIndex<Filters>::
+serviceChanged(const ctkServiceEvent& event)
+{
+  QWriteLocker l(&lock);
+
+  switch (event.getType())
+  {
+  case ctkServiceEvent::REGISTERED:
+  case ctkServiceEvent::MODIFIED:
+    addHandler(event.getServiceReference());
+    break;
+  case ctkServiceEvent::MODIFIED_ENDMATCH:
+  case ctkServiceEvent::UNREGISTERING:
+    removeHandler(event.getServiceReference());
+    break;
+  }
+}
+
+template<class Filters>
+void
+ctkEATopicHandlerIndex<Filters>::
+addHandler(const ctkServiceReference& reference)
+{
+  // a modified handler is indexed again
+  removeHandler(reference);
+
+  qlonglong id = reference.getProperty(ctkPluginConstants::SERVICE_ID).toLongLong();
+
+  Entry entry;
+  entry.handler.reference = reference;
+  try
+  {
+    entry.handler.filter = filters->createFilter(
+          reference.getProperty(ctkEventConstants::EVENT_FILTER).toString());
+  }
+  catch (const ctkInvalidArgumentException& e)
+  {
+    entry.handler.filterError = e.message();
+  }
+  entry.handler.coalesceProperty =
+      reference.getProperty(ctkEventConstants::EVENT_COALESCE).toString();
+
+  QVariant topics = reference.getProperty(ctkEventConstants::EVENT_TOPIC);
+  if (!topics.isValid())
+  {
+    noTopic.push_back(id);
+  }
+  else
+  {
+    entry.topics = topics.toStringList();
+    foreach (const QString& topic, entry.topics)
+    {
+      if (topic == "*")
+      {
+        root.wildcard.push_back(id);
+        continue;
+      }
+
+      bool wildcard = topic.endsWith("/*");
+      QStringList tokens = (wildcard ? topic.left(topic.size() - 2) : topic).split('/');
+      Node* node = &root;
+      foreach (const QString& token, tokens)
+      {
+        Node*& child = node->children[token];
+        if (child == 0)
+        {
+          child = new Node();
+        }
+        node = child;
+      }
+      (wildcard ? node->wildcard : node->exact).push_back(id);
+    }
+  }
+
+  entries.insert(id, entry);
+}
+
+template<class Filters>
+void
+ctkEATopicHandlerIndex<Filters>::
+removeHandler(const ctkServiceReference& reference)
+{
+  qlonglong id = reference.getProperty(ctkPluginConstants::SERVICE_ID).toLongLong();
+  typename QHash<qlonglong, Entry>::iterator it = entries.find(id);
+  if (it == entries.end())
+  {
+    return;
+  }
+
+  noTopic.removeAll(id);
+
+  foreach (const QString& topic, it.value().topics)
+  {
+    if (topic == "*")
+    {
+      root.wildcard.removeAll(id);
+      continue;
+    }
+
+    bool wildcard = topic.endsWith("/*");
+    QStringList tokens = (wildcard ? topic.left(topic.size() - 2) : topic).split('/');
+
+    QList<Node*> path;
+    path.push_back(&root);
+    foreach (const QString& token, tokens)
+    {
+      Node* child = path.back()->children.value(token);
+      if (child == 0) break;
+      path.push_back(child);
+    }
+    if (path.size() != tokens.size() + 1)
+    {
+      continue;
+    }
+
+    (wildcard ? path.back()->wildcard : path.back()->exact).removeAll(id);
+
+    // prune nodes which are no longer used
+    for (int i = path.size() - 1; i > 0; --i)
+    {
+      Node* node = path[i];
+      if (!node->children.isEmpty() || !node->exact.isEmpty() || !node->wildcard.isEmpty())
+      {
+        break;
+      }
+      path[i-1]->children.remove(tokens[i-1]);
+      delete node;
+    }
+  }
+
+  entries.erase(it);
+}
+
+template<class Filters>
+void
+ctkEATopicHandlerIndex<Filters>::
+collect(const QList<qlonglong>& ids, QList<qlonglong>& result)
+{
+  if (!ids.isEmpty())
+  {
+    result.append(ids);
+  }
+}
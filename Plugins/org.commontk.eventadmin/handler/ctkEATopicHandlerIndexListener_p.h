@@ -20,40 +20,36 @@
 =============================================================================*/
 
 
-#ifndef CTKEASYNCMASTERTHREAD_P_H
-#define CTKEASYNCMASTERTHREAD_P_H
+#ifndef CTKEATOPICHANDLERINDEXLISTENER_P_H
+#define CTKEATOPICHANDLERINDEXLISTENER_P_H
 
-#include "ctkEAInterruptibleThread_p.h"
+#include <QObject>
 
+#include <ctkServiceEvent.h>
 
 /**
- * Used to execute synchronuous tasks. This is not done
- * in the main thread because we need to be able to
- * interrupt the thread waiting on a synchronuous task
- * (for example on a timeout). ctkEAInterruptibleThread
- * provides this capability.
+ * Non-template base class of <tt>ctkEATopicHandlerIndex</tt> that provides
+ * the slot for <tt>ctkEventHandler</tt> service events.
  */
-class ctkEASyncMasterThread : public QObject
+class ctkEATopicHandlerIndexListener : public QObject
 {
   Q_OBJECT
 
 public:
-  ctkEASyncMasterThread();
 
-  void syncRun(QRunnable* command);
-
-  void stop();
+  ctkEATopicHandlerIndexListener(QObject* parent = 0)
+    : QObject(parent)
+  {}
 
 public Q_SLOTS:
 
-  void runCommand();
-
-private:
+  /**
+   * Slot connected to service events of <tt>ctkEventHandler</tt> services.
+   *
+   * @param event The service event from the framework.
+   */
+  virtual void serviceChanged(const ctkServiceEvent& event) = 0;
 
-  ctkEAInterruptibleThread thread;
-  QRunnable* command;
-  QMutex mutex;
-  QWaitCondition waitCond;
 };
 
-#endif // CTKEASYNCMASTERTHREAD_P_H
+#endif // CTKEATOPICHANDLERINDEXLISTENER_P_H
@@ -0,0 +1,154 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKEATOPICHANDLERINDEX_P_H
+#define CTKEATOPICHANDLERINDEX_P_H
+
+#include "ctkEATopicHandlerIndexListener_p.h"
+#include "ctkEAFilters_p.h"
+
+#include <ctkPluginContext.h>
+#include <ctkServiceReference.h>
+#include <ctkLDAPSearchFilter.h>
+
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QStringList>
+
+/**
+ * Index of the registered <tt>ctkEventHandler</tt> services by the topics
+ * they subscribed to. The index is kept up to date by a service listener,
+ * so that the applicable handlers for an event can be found by walking a
+ * trie of topic tokens instead of querying the service registry with an
+ * LDAP filter for each event. Looking up the handlers for a topic takes
+ * time proportional to the number of topic tokens.
+ *
+ * The <tt>EVENT_FILTER</tt> property of a handler is compiled once when the
+ * handler is added to the index.
+ */
+template<class Filters>
+class ctkEATopicHandlerIndex : public ctkEATopicHandlerIndexListener
+{
+
+public:
+
+  /**
+   * An indexed event handler.
+   */
+  struct Handler
+  {
+    ctkServiceReference reference;
+
+    /**
+     * The compiled <tt>EVENT_FILTER</tt> of the handler. Only valid if
+     * <tt>filterError</tt> is empty.
+     */
+    ctkLDAPSearchFilter filter;
+
+    /**
+     * Error message in case the <tt>EVENT_FILTER</tt> could not be parsed.
+     */
+    QString filterError;
+
+    /**
+     * The <tt>EVENT_COALESCE</tt> property of the handler, empty if posted
+     * events are not coalesced.
+     */
+    QString coalesceProperty;
+  };
+
+  /**
+   * The constructor of the index. It starts listening for
+   * <tt>ctkEventHandler</tt> services and adds the already registered
+   * ones.
+   *
+   * @param context The context of the plugin
+   * @param filters The factory for <tt>ctkLDAPSearchFilter</tt> objects
+   * @param requireTopic Whether handlers that do not provide a topic are
+   *        excluded
+   */
+  ctkEATopicHandlerIndex(ctkPluginContext* context,
+                         ctkEAFilters<Filters>* filters,
+                         bool requireTopic);
+
+  ~ctkEATopicHandlerIndex();
+
+  /**
+   * Returns all handlers that subscribed to the given topic, either
+   * directly or via a wildcard, ordered by service id.
+   *
+   * @param topic The topic of an event
+   * @return The handlers subscribed to <tt>topic</tt>
+   */
+  QList<Handler> getHandlers(const QString& topic) const;
+
+  void serviceChanged(const ctkServiceEvent& event);
+
+private:
+
+  struct Node
+  {
+    Node() {}
+    ~Node() { qDeleteAll(children); }
+
+    QHash<QString, Node*> children;
+
+    /** Handlers subscribed to the topic ending at this node. */
+    QList<qlonglong> exact;
+
+    /** Handlers subscribed to all topics below this node. */
+    QList<qlonglong> wildcard;
+
+  private:
+    Q_DISABLE_COPY(Node)
+  };
+
+  struct Entry
+  {
+    Handler handler;
+    QStringList topics;
+  };
+
+  ctkPluginContext* const context;
+  ctkEAFilters<Filters>* const filters;
+  const bool requireTopic;
+
+  mutable QReadWriteLock lock;
+
+  Node root;
+
+  /** Handlers that do not provide a topic. */
+  QList<qlonglong> noTopic;
+
+  /** All indexed handlers by service id. */
+  QHash<qlonglong, Entry> entries;
+
+  void addHandler(const ctkServiceReference& reference);
+  void removeHandler(const ctkServiceReference& reference);
+
+  static void collect(const QList<qlonglong>& ids, QList<qlonglong>& result);
+};
+
+#include "ctkEATopicHandlerIndex.tpp"
+
+#endif // CTKEATOPICHANDLERINDEX_P_H
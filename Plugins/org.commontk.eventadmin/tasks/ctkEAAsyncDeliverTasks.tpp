@@ -19,87 +19,221 @@
 
 =============================================================================*/
 
+
+#include <util/ctkEAMPSCQueue_p.h>
+
+#include <QHash>
+#include <QSet>
+#include <QThread>
+#include <QVector>
+
 template<class SyncDeliverTasks, class HandlerTask>
-class ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::TaskExecuter
-    : public ctkEARunnable
+class ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::Mailbox
+    : public ctkEAWorkStealingExecutor::Job
 {
 
 private:
 
   typedef ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask> TopClass;
 
+  // The number of posted events a worker delivers at once before it gives
+  // other mailboxes a turn
+  static const int BATCH_SIZE = 64;
+
   TopClass* tc;
 
-  QList<HandlerTask> tasks;
-  QMutex tasksMutex;
-  QThread* key;
+  ctkEAMPSCQueue<QList<HandlerTask> > queue;
+
+  // The number of posted but not yet delivered events. The mailbox is
+  // scheduled while this is greater than zero.
+  QAtomicInt pending;
+
+  // Held by the publishing thread and by the executor while scheduled
+  QAtomicInt ref;
 
 public:
 
-  TaskExecuter(TopClass* tc, const QList<HandlerTask>& tasks, QThread* key)
-    : tc(tc), tasks(tasks), key(key)
+  Mailbox(TopClass* tc, int home)
+    : tc(tc), ref(1)
+  {
+    this->home = home;
+  }
+
+  void post(const QList<HandlerTask>& tasks)
   {
+    queue.push(tasks);
+    if (pending.fetchAndAddOrdered(1) == 0)
+    {
+      ref.ref();
+      tc->pool->execute(this);
+    }
+  }
+
+  bool run()
+  {
+    int n = pending.fetchAndAddOrdered(0);
+    if (n > BATCH_SIZE) n = BATCH_SIZE;
+
+    QList<HandlerTask> window;
+    for (int i = 0; i < n; ++i)
+    {
+      QList<HandlerTask> tasks;
+      while (!queue.pop(tasks))
+      {
+        // the publisher is in the middle of a push
+        QThread::yieldCurrentThread();
+      }
+      window.append(tasks);
+    }
+
+    tc->deliver_task->execute(window.size() > 1 ? coalesce(window) : window);
+
+    if (pending.fetchAndAddOrdered(-n) == n)
+    {
+      release();
+      return false;
+    }
+    return true;
   }
 
-  void run()
+  /**
+   * Drops the tasks superseded by a later task with the same coalescing
+   * key for the same handler and merges the remaining tasks of each handler
+   * into one, keeping the order of the events.
+   */
+  static QList<HandlerTask> coalesce(const QList<HandlerTask>& window)
   {
-    bool running = true;
-    do
+    QVector<bool> superseded(window.size());
+    QHash<ctkServiceReference, QSet<QString> > latest;
+    for (int i = window.size() - 1; i >= 0; --i)
     {
-      QList<HandlerTask> currTasks;
+      const QString key = window[i].getCoalesceKey();
+      if (key.isNull()) continue;
 
+      QSet<QString>& keys = latest[window[i].getHandlerReference()];
+      if (keys.contains(key))
       {
-        QMutexLocker l(&tasksMutex);
-        currTasks.push_back(tasks.takeFirst());
+        superseded[i] = true;
       }
-      tc->deliver_task->execute(currTasks);
+      else
       {
-        QMutexLocker l(&tc->running_threads_mutex);
-        running = tasks.size() > 0;
-        if (!running)
-        {
-          ctkEARunnable* runnable = tc->running_threads.take(key);
-          if (runnable->autoDelete() && !--runnable->ref) delete runnable;
-        }
+        keys.insert(key);
       }
-    } while (running);
+    }
+
+    QList<HandlerTask> result;
+    QHash<ctkServiceReference, int> position;
+    for (int i = 0; i < window.size(); ++i)
+    {
+      if (superseded[i]) continue;
+
+      const ctkServiceReference ref = window[i].getHandlerReference();
+      typename QHash<ctkServiceReference, int>::const_iterator it = position.constFind(ref);
+      if (it == position.constEnd())
+      {
+        position.insert(ref, result.size());
+        result.push_back(window[i]);
+      }
+      else
+      {
+        result[it.value()].append(window[i]);
+      }
+    }
+    return result;
   }
 
-  void add(const QList<HandlerTask>& newTasks)
+  void discard()
   {
-    QMutexLocker l(&tasksMutex);
-    tasks.append(newTasks);
+    release();
+  }
+
+  void release()
+  {
+    if (!ref.deref()) delete this;
   }
 };
 
 template<class SyncDeliverTasks, class HandlerTask>
-ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::ctkEAAsyncDeliverTasks(ctkEADefaultThreadPool* pool, DeliverTask* deliverTask)
- : pool(pool), deliver_task(deliverTask)
+struct ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::MailboxRegistry
 {
-}
+  MailboxRegistry() : ref(1) {}
+
+  // Returns true if the mailbox was still registered. The caller then
+  // has to release the mailbox.
+  bool take(Mailbox* mailbox)
+  {
+    QMutexLocker l(&mutex);
+    return mailboxes.remove(mailbox);
+  }
 
+  void release()
+  {
+    if (!ref.deref()) delete this;
+  }
+
+  // Held by the owning ctkEAAsyncDeliverTasks and by each handle
+  QAtomicInt ref;
+  QMutex mutex;
+  QSet<Mailbox*> mailboxes;
+};
+
+// Deleted by QThreadStorage only, when its publishing thread ends. Releases
+// the mailbox unless the owner already did so when it was destroyed.
 template<class SyncDeliverTasks, class HandlerTask>
-void ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::execute(const QList<HandlerTask>& tasks)
+struct ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::MailboxHandle
 {
-  QThread* currentThread = QThread::currentThread();
-  TaskExecuter* executer = 0;
+  MailboxHandle(MailboxRegistry* registry, Mailbox* mailbox)
+    : registry(registry), mailbox(mailbox)
   {
-    QMutexLocker l(&running_threads_mutex);
-    TaskExecuter* runningExecutor = dynamic_cast<TaskExecuter*>(running_threads.value(currentThread));
-    if (runningExecutor)
-    {
-      runningExecutor->add(tasks);
-    }
-    else
+    registry->ref.ref();
+    QMutexLocker l(&registry->mutex);
+    registry->mailboxes.insert(mailbox);
+  }
+
+  ~MailboxHandle()
+  {
+    if (registry->take(mailbox))
     {
-      executer = new TaskExecuter(this, tasks, currentThread);
-      ++executer->ref;
-      running_threads.insert(currentThread, executer);
+      mailbox->release();
     }
+    registry->release();
   }
-  if (executer)
+
+  MailboxRegistry* const registry;
+  Mailbox* const mailbox;
+};
+
+template<class SyncDeliverTasks, class HandlerTask>
+ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::ctkEAAsyncDeliverTasks(ctkEAWorkStealingExecutor* pool, DeliverTask* deliverTask)
+ : pool(pool), deliver_task(deliverTask), registry(new MailboxRegistry())
+{
+}
+
+template<class SyncDeliverTasks, class HandlerTask>
+ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::~ctkEAAsyncDeliverTasks()
+{
+  // The storage does not delete the handles of threads which are still
+  // running, so release their mailboxes here. A thread ending meanwhile
+  // finds its mailbox gone from the registry and leaves it alone.
+  QSet<Mailbox*> remaining;
   {
-    pool->executeTask(executer);
+    QMutexLocker l(&registry->mutex);
+    remaining = registry->mailboxes;
+    registry->mailboxes.clear();
   }
+  foreach(Mailbox* mailbox, remaining)
+  {
+    mailbox->release();
+  }
+  registry->release();
 }
 
+template<class SyncDeliverTasks, class HandlerTask>
+void ctkEAAsyncDeliverTasks<SyncDeliverTasks, HandlerTask>::execute(const QList<HandlerTask>& tasks)
+{
+  if (!mailboxes.hasLocalData())
+  {
+    mailboxes.setLocalData(new MailboxHandle(registry, new Mailbox(this, nextHome.fetchAndAddRelaxed(1))));
+  }
+  mailboxes.localData()->mailbox->post(tasks);
+}
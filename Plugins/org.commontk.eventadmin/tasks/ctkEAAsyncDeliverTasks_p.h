@@ -24,12 +24,27 @@
 #define CTKEAASYNCDELIVERTASKS_P_H
 
 #include "ctkEADeliverTask_p.h"
-#include <dispatch/ctkEADefaultThreadPool_p.h>
+#include <dispatch/ctkEAWorkStealingExecutor_p.h>
 
-class ctkEARunnable;
+#include <QMutex>
+#include <QSet>
+#include <QThreadStorage>
 
 /**
  * This class does the actual work of the asynchronous event dispatch.
+ *
+ * Each publishing thread owns a mailbox, a queue of the events it posted.
+ * Posting an event only appends to this queue without taking a lock; the
+ * first event of a burst additionally schedules the mailbox on the
+ * executor, whose run queues are guarded by a mutex. A worker drains the
+ * mailbox in order, hence events of one publisher are delivered in the
+ * order they were posted, and publishers only contend with each other
+ * when a mailbox is scheduled.
+ *
+ * A worker takes all events pending in a mailbox at once. Events superseded
+ * according to the <tt>EVENT_COALESCE</tt> property of a handler are
+ * dropped, and the remaining events of each handler are delivered with one
+ * task, i.e. in one call if the handler is a <tt>ctkBatchEventHandler</tt>.
  */
 template<class SyncDeliverTasks, class HandlerTask>
 class ctkEAAsyncDeliverTasks : public ctkEADeliverTask<ctkEAAsyncDeliverTasks<SyncDeliverTasks,HandlerTask>, HandlerTask>
@@ -37,8 +52,8 @@ class ctkEAAsyncDeliverTasks : public ctkEADeliverTask<ctkEAAsyncDeliverTasks<Sy
 
 private:
 
-  /** The thread pool to use to spin-off new threads. */
-  ctkEADefaultThreadPool* pool;
+  /** The executor used to drain the mailboxes. */
+  ctkEAWorkStealingExecutor* pool;
 
   /**
    * The deliver task for actually delivering the events. This
@@ -48,21 +63,43 @@ private:
   typedef ctkEADeliverTask<SyncDeliverTasks, HandlerTask> DeliverTask;
   DeliverTask* deliver_task;
 
-  /** A map of running threads currently delivering async events. */
-  QHash<QThread*, ctkEARunnable*> running_threads;
-  QMutex running_threads_mutex;
+  class Mailbox;
+
+  struct MailboxRegistry;
+  struct MailboxHandle;
+
+  /**
+   * The mailbox of each publishing thread. QThreadStorage deletes the
+   * handle when its thread ends, but not the handles of threads still
+   * running when the storage is destroyed.
+   */
+  QThreadStorage<MailboxHandle*> mailboxes;
+
+  /**
+   * The mailboxes not yet released, shared with the handles. A mailbox
+   * is released by whoever takes it out of the registry first.
+   */
+  MailboxRegistry* registry;
+
+  /** Used to spread the mailboxes over the workers. */
+  QAtomicInt nextHome;
 
 public:
 
   /**
    * The constructor of the class that will use the asynchronous.
    *
-   * @param pool The thread pool used to spin-off new asynchronous event
-   *        dispatching threads in case of timeout or that the asynchronous event
-   *        dispatching thread is used to send a synchronous event
+   * @param pool The executor used to deliver the posted events
    * @param deliverTask The deliver tasks for dispatching the event.
    */
-  ctkEAAsyncDeliverTasks(ctkEADefaultThreadPool* pool, DeliverTask* deliverTask);
+  ctkEAAsyncDeliverTasks(ctkEAWorkStealingExecutor* pool, DeliverTask* deliverTask);
+
+  /**
+   * Releases the mailboxes of all publishing threads. Mailboxes still
+   * scheduled on the executor are deleted once the executor is done with
+   * them.
+   */
+  ~ctkEAAsyncDeliverTasks();
 
   /**
    * This does not block an unrelated thread used to send a synchronous event.
@@ -73,9 +110,6 @@ public:
    */
   void execute(const QList<HandlerTask>& tasks);
 
-private:
-
-  class TaskExecuter;
 };
 
 #include "ctkEAAsyncDeliverTasks.tpp"
@@ -19,6 +19,7 @@
 
 =============================================================================*/
 
+#include <service/event/ctkBatchEventHandler.h>
 #include <service/event/ctkEventHandler.h>
 
 #include <ctkEventAdminActivator_p.h>
@@ -60,16 +61,18 @@ private:
 
 template<class BlacklistingHandlerTasks>
 ctkEAHandlerTask<BlacklistingHandlerTasks>::ctkEAHandlerTask(const ctkServiceReference& eventHandlerRef,
-                                                             const ctkEvent& event, BlacklistingHandlerTasks* handlerTasks)
-  : eventHandlerRef(eventHandlerRef), event(event), handlerTasks(handlerTasks)
+                                                             const ctkEvent& event, BlacklistingHandlerTasks* handlerTasks,
+                                                             const QString& coalesceProperty)
+  : eventHandlerRef(eventHandlerRef), event(event), coalesceProperty(coalesceProperty),
+    handlerTasks(handlerTasks)
 {
 
 }
 
 template<class BlacklistingHandlerTasks>
 ctkEAHandlerTask<BlacklistingHandlerTasks>::ctkEAHandlerTask(const Self& task)
-  : eventHandlerRef(task.eventHandlerRef), event(task.event),
-    handlerTasks(task.handlerTasks)
+  : eventHandlerRef(task.eventHandlerRef), event(task.event), batch(task.batch),
+    coalesceProperty(task.coalesceProperty), handlerTasks(task.handlerTasks)
 {
 
 }
@@ -80,7 +83,9 @@ ctkEAHandlerTask<BlacklistingHandlerTasks>::operator=(const Self& task)
 {
   eventHandlerRef = task.eventHandlerRef;
   event = task.event;
+  batch = task.batch;
   handlerTasks = task.handlerTasks;
+  coalesceProperty = task.coalesceProperty;
   return *this;
 }
 
@@ -91,25 +96,111 @@ QString ctkEAHandlerTask<BlacklistingHandlerTasks>::getHandlerClassName() const
   return handler->metaObject()->className();
 }
 
+template<class BlacklistingHandlerTasks>
+ctkServiceReference ctkEAHandlerTask<BlacklistingHandlerTasks>::getHandlerReference() const
+{
+  return eventHandlerRef;
+}
+
+template<class BlacklistingHandlerTasks>
+QString ctkEAHandlerTask<BlacklistingHandlerTasks>::getCoalesceKey() const
+{
+  if (coalesceProperty.isEmpty())
+  {
+    return QString();
+  }
+  return event.getTopic() + QChar('\0') + event.getProperty(coalesceProperty).toString();
+}
+
+template<class BlacklistingHandlerTasks>
+void ctkEAHandlerTask<BlacklistingHandlerTasks>::append(const Self& task)
+{
+  if (batch.isEmpty())
+  {
+    batch.push_back(event);
+  }
+  if (task.batch.isEmpty())
+  {
+    batch.push_back(task.event);
+  }
+  else
+  {
+    batch.append(task.batch);
+  }
+}
+
+template<class BlacklistingHandlerTasks>
+QList<ctkEAHandlerTask<BlacklistingHandlerTasks> > ctkEAHandlerTask<BlacklistingHandlerTasks>::split() const
+{
+  QList<Self> tasks;
+  if (batch.isEmpty() ||
+      qobject_cast<ctkBatchEventHandler*>(_GetAndUngetEventHandler(handlerTasks, eventHandlerRef).getObject()))
+  {
+    tasks.push_back(*this);
+    return tasks;
+  }
+
+  foreach(const ctkEvent& e, batch)
+  {
+    tasks.push_back(Self(eventHandlerRef, e, handlerTasks, coalesceProperty));
+  }
+  return tasks;
+}
+
 template<class BlacklistingHandlerTasks>
 void ctkEAHandlerTask<BlacklistingHandlerTasks>::execute()
 {
   // Get the service object
-  ctkEventHandler* const handler = _GetAndUngetEventHandler(handlerTasks, eventHandlerRef).getHandler();
+  _GetAndUngetEventHandler getAndUnget(handlerTasks, eventHandlerRef);
+  ctkEventHandler* const handler = getAndUnget.getHandler();
 
+  if (batch.isEmpty())
+  {
+    deliver(handler, event);
+  }
+  else if (ctkBatchEventHandler* batchHandler = qobject_cast<ctkBatchEventHandler*>(getAndUnget.getObject()))
+  {
+    try
+    {
+      batchHandler->handleEvents(batch);
+    }
+    catch (const std::exception& e)
+    {
+      logException(e, event);
+    }
+  }
+  else
+  {
+    // an exception only drops the event which caused it
+    foreach(const ctkEvent& e, batch)
+    {
+      deliver(handler, e);
+    }
+  }
+}
+
+template<class BlacklistingHandlerTasks>
+void ctkEAHandlerTask<BlacklistingHandlerTasks>::deliver(ctkEventHandler* handler, const ctkEvent& e)
+{
   try
   {
-    handler->handleEvent(event);
+    handler->handleEvent(e);
   }
-  catch (const std::exception& e)
+  catch (const std::exception& exc)
   {
-    // The spec says that we must catch exceptions and log them:
-    CTK_WARN_SR_EXC(ctkEventAdminActivator::getLogService(), eventHandlerRef, &e)
-        << "Exception during event dispatch [" << event.getTopic() << "| Plugin("
-        << eventHandlerRef.getPlugin()->getSymbolicName() << ")]";
+    logException(exc, e);
   }
 }
 
+template<class BlacklistingHandlerTasks>
+void ctkEAHandlerTask<BlacklistingHandlerTasks>::logException(const std::exception& exc, const ctkEvent& e) const
+{
+  // The spec says that we must catch exceptions and log them:
+  CTK_WARN_SR_EXC(ctkEventAdminActivator::getLogService(), eventHandlerRef, &exc)
+      << "Exception during event dispatch [" << e.getTopic() << "| Plugin("
+      << eventHandlerRef.getPlugin()->getSymbolicName() << ")]";
+}
+
 template<class BlacklistingHandlerTasks>
 void ctkEAHandlerTask<BlacklistingHandlerTasks>::blackListHandler()
 {
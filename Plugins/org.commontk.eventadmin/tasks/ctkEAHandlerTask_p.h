@@ -28,6 +28,10 @@
 #include <ctkServiceReference.h>
 #include <service/event/ctkEvent.h>
 
+#include <exception>
+
+struct ctkEventHandler;
+
 /**
  * A task that will deliver its event to its <tt>ctkEventHandler</tt> when executed
  * or blacklist the handler, respectively.
@@ -46,11 +50,23 @@ private:
   // The event to deliver to the handler
   ctkEvent event;
 
+  // Further events for the same handler, delivered in one go. Either empty
+  // or starting with event.
+  QList<ctkEvent> batch;
+
+  // The event property posted events are coalesced by, empty if posted
+  // events must not be coalesced
+  QString coalesceProperty;
+
   // Used to blacklist the service or get the service object for the reference
   BlacklistingHandlerTasks* handlerTasks;
 
   class _GetAndUngetEventHandler;
 
+  void deliver(ctkEventHandler* handler, const ctkEvent& e);
+
+  void logException(const std::exception& exc, const ctkEvent& e) const;
+
 public:
 
   /**
@@ -60,9 +76,11 @@ public:
    * @param event The event to deliver
    * @param handlerTasks Used to blacklist the service or get the service object
    *      for the reference
+   * @param coalesceProperty The <tt>EVENT_COALESCE</tt> property of the handler
    */
   ctkEAHandlerTask(const ctkServiceReference& eventHandlerRef,
-                   const ctkEvent& event, BlacklistingHandlerTasks* handlerTasks);
+                   const ctkEvent& event, BlacklistingHandlerTasks* handlerTasks,
+                   const QString& coalesceProperty = QString());
 
   ctkEAHandlerTask(const Self& task);
 
@@ -73,6 +91,32 @@ public:
    */
   QString getHandlerClassName() const;
 
+  /**
+   * Return the service reference of the handler
+   */
+  ctkServiceReference getHandlerReference() const;
+
+  /**
+   * Return the key identifying events which supersede each other for the
+   * handler, or a null string if the events must not be coalesced.
+   */
+  QString getCoalesceKey() const;
+
+  /**
+   * Add the event of the given task for the same handler to this task.
+   * The events are delivered in one call if the handler is a
+   * <tt>ctkBatchEventHandler</tt> and one after another otherwise.
+   */
+  void append(const Self& task);
+
+  /**
+   * Return one task per event if this task holds a batch for a handler
+   * which is not a <tt>ctkBatchEventHandler</tt>, or a list containing
+   * only this task otherwise. This allows the events of a batch to be
+   * timed one by one.
+   */
+  QList<Self> split() const;
+
   /**
    * Deliver the event to the handler.
    */
@@ -20,89 +20,97 @@
 =============================================================================*/
 
 
-#include "ctkEASyncThread_p.h"
+#include <QMutexLocker>
 
-#include <dispatch/ctkEADefaultThreadPool_p.h>
-#include <dispatch/ctkEASyncMasterThread_p.h>
-#include <util/ctkEARendezvous_p.h>
-#include <util/ctkEATimeoutException_p.h>
-
-#include <QDateTime>
+#include <climits>
 
 template<class HandlerTask>
-class _TimeoutRunnable : public ctkEARunnable
+class _SyncWatchdog : public QThread
 {
 public:
 
-  ctkEARendezvous timerBarrier;
-  ctkEARendezvous startBarrier;
-
-  _TimeoutRunnable(HandlerTask* task)
-    : task(task)
+  _SyncWatchdog(ctkEASyncDeliverTasks<HandlerTask>* deliverTasks)
+    : deliverTasks(deliverTasks), stopped(false)
   {
-
+    setObjectName("ctkEASyncWatchdog");
   }
 
-  void run()
+  void stop()
   {
-    try
-    {
-      // notify the outer thread to start the timer
-      startBarrier.waitForRendezvous();
-      // execute the task
-      task->execute();
-      // stop the timer
-      timerBarrier.waitForRendezvous();
-    }
-    catch (const ctkIllegalStateException& )
     {
-      // this can happen on shutdown, so we ignore it
+      QMutexLocker l(&mutex);
+      stopped = true;
+      waitCond.wakeAll();
     }
+    wait();
   }
 
-private:
-
-  HandlerTask* task;
-};
-
-template<class HandlerTask>
-class _RunInSyncMaster : public QRunnable
-{
-public:
-
-  _RunInSyncMaster(ctkEASyncDeliverTasks<HandlerTask>* handlerTasks,
-                   const QList<HandlerTask>& tasks)
-    : handlerTasks(handlerTasks), tasks(tasks)
-  {
-
-  }
+protected:
 
   void run()
   {
-    handlerTasks->executeInSyncMaster(tasks);
+    unsigned long interval = deliverTasks->checkTimeouts();
+    QMutexLocker l(&mutex);
+    while (!stopped)
+    {
+      waitCond.wait(&mutex, interval);
+      if (stopped) break;
+
+      l.unlock();
+      interval = deliverTasks->checkTimeouts();
+      l.relock();
+    }
   }
 
 private:
 
-  ctkEASyncDeliverTasks<HandlerTask>* handlerTasks;
-  const QList<HandlerTask>& tasks;
+  ctkEASyncDeliverTasks<HandlerTask>* deliverTasks;
+  QMutex mutex;
+  QWaitCondition waitCond;
+  bool stopped;
 };
 
 template<class HandlerTask>
 ctkEASyncDeliverTasks<HandlerTask>::ctkEASyncDeliverTasks(
-  ctkEADefaultThreadPool* pool, ctkEASyncMasterThread* syncMasterThread,
   long timeout, const QList<QString>& ignoreTimeout)
-  : pool(pool), syncMasterThread(syncMasterThread)
+  : timeout(0), watchdog(0)
 {
+  clock.start();
   update(timeout, ignoreTimeout);
 }
 
+template<class HandlerTask>
+ctkEASyncDeliverTasks<HandlerTask>::~ctkEASyncDeliverTasks()
+{
+  stop();
+  qDeleteAll(ignoreTimeoutMatcher);
+  qDeleteAll(activeSlots);
+  qDeleteAll(freeSlots);
+}
+
 template<class HandlerTask>
 void ctkEASyncDeliverTasks<HandlerTask>::update(long timeout, const QList<QString>& ignoreTimeout)
 {
+  _SyncWatchdog<HandlerTask>* oldWatchdog = 0;
   {
     QMutexLocker l(&mutex);
     this->timeout = timeout;
+    if (timeout > 0 && watchdog == 0)
+    {
+      watchdog = new _SyncWatchdog<HandlerTask>(this);
+      watchdog->start();
+    }
+    else if (timeout <= 0)
+    {
+      oldWatchdog = watchdog;
+      watchdog = 0;
+    }
+  }
+
+  if (oldWatchdog)
+  {
+    oldWatchdog->stop();
+    delete oldWatchdog;
   }
 
   if (ignoreTimeout.isEmpty())
@@ -134,66 +142,48 @@ void ctkEASyncDeliverTasks<HandlerTask>::update(long timeout, const QList<QStrin
 template<class HandlerTask>
 void ctkEASyncDeliverTasks<HandlerTask>::execute(const QList<HandlerTask>& tasks)
 {
-  _RunInSyncMaster<HandlerTask> runnable(this, tasks);
-  runnable.setAutoDelete(false);
-  syncMasterThread->syncRun(&runnable);
-}
-
-template<class HandlerTask>
-void ctkEASyncDeliverTasks<HandlerTask>::executeInSyncMaster(const QList<HandlerTask>& tasks)
-{
-  QThread* const sleepingThread = QThread::currentThread();
-  ctkEASyncThread* const syncThread = qobject_cast<ctkEASyncThread*>(sleepingThread);
+  SlotScope scope(this);
 
-  foreach(HandlerTask task, tasks)
+  foreach(const HandlerTask& handlerTask, tasks)
   {
-    if (!useTimeout(task))
-    {
-      // no timeout, we can directly execute
-      task.execute();
-    }
-    else if (syncThread != 0)
-    {
-      // if this is a cascaded event, we directly use this thread
-      // otherwise we could end up in a starvation
-      //TODO use Qt4.7 API
-      //long startTime = System.currentTimeMillis();
-      QDateTime startTime = QDateTime::currentDateTime();
-      task.execute();
-      if (startTime.time().msecsTo(QDateTime::currentDateTime().time()) > timeout)
-      {
-        task.blackListHandler();
-      }
-    }
-    else
-    {
-      _TimeoutRunnable<HandlerTask>* timeoutRunnable
-          = new _TimeoutRunnable<HandlerTask>(&task);
-      ctkEAScopedRunnableReference runnableRef(timeoutRunnable);
-
-      ctkEARendezvous* startBarrier = &timeoutRunnable->startBarrier;
-      ctkEARendezvous* timerBarrier = &timeoutRunnable->timerBarrier;
-      pool->executeTask(timeoutRunnable);
+    const bool timed = useTimeout(handlerTask);
 
-      // we wait for the inner thread to start
-      startBarrier->waitForRendezvous();
-
-      // timeout handling
-      // we sleep for the sleep time
-      // if someone wakes us up it's the finished inner task
-      try
+    // The events of a batch for a handler without batch support are
+    // timed one by one.
+    foreach(HandlerTask task, handlerTask.split())
+    {
+      if (!timed)
       {
-        timerBarrier->waitAttemptForRendezvous(timeout);
+        // no timeout, we can directly execute
+        task.execute();
       }
-      catch (const ctkEATimeoutException& )
+      else
       {
-        // if we timed out, we have to blacklist the handler
-        task.blackListHandler();
+        // the watchdog blacklists the handler if it takes too long
+        TimedTask timedTask(scope.slot, &task, clock.elapsedMilli());
+        task.execute();
       }
     }
   }
 }
 
+template<class HandlerTask>
+void ctkEASyncDeliverTasks<HandlerTask>::stop()
+{
+  _SyncWatchdog<HandlerTask>* oldWatchdog = 0;
+  {
+    QMutexLocker l(&mutex);
+    oldWatchdog = watchdog;
+    watchdog = 0;
+  }
+
+  if (oldWatchdog)
+  {
+    oldWatchdog->stop();
+    delete oldWatchdog;
+  }
+}
+
 template<class HandlerTask>
 bool ctkEASyncDeliverTasks<HandlerTask>::useTimeout(const HandlerTask& task)
 {
@@ -229,3 +219,76 @@ bool ctkEASyncDeliverTasks<HandlerTask>::useTimeout(const HandlerTask& task)
   }
   return false;
 }
+
+template<class HandlerTask>
+typename ctkEASyncDeliverTasks<HandlerTask>::Slot*
+ctkEASyncDeliverTasks<HandlerTask>::acquireSlot()
+{
+  QThread* const currentThread = QThread::currentThread();
+
+  QMutexLocker l(&slotsMutex);
+  Slot*& slot = activeSlots[currentThread];
+  if (slot == 0)
+  {
+    slot = freeSlots.isEmpty() ? new Slot() : freeSlots.takeLast();
+  }
+  ++slot->depth;
+  return slot;
+}
+
+template<class HandlerTask>
+void ctkEASyncDeliverTasks<HandlerTask>::releaseSlot(Slot* slot)
+{
+  QMutexLocker l(&slotsMutex);
+  if (--slot->depth == 0)
+  {
+    activeSlots.remove(QThread::currentThread());
+    freeSlots.push_back(slot);
+  }
+}
+
+template<class HandlerTask>
+unsigned long ctkEASyncDeliverTasks<HandlerTask>::checkTimeouts()
+{
+  long t = 0;
+  {
+    QMutexLocker l(&mutex);
+    t = timeout;
+  }
+  if (t <= 0)
+  {
+    return ULONG_MAX;
+  }
+
+  QList<HandlerTask> timedOut;
+  qint64 next = t;
+  {
+    const qint64 now = clock.elapsedMilli();
+    QMutexLocker l(&slotsMutex);
+    foreach(Slot* slot, activeSlots)
+    {
+      QMutexLocker sl(&slot->lock);
+      if (slot->task == 0 || slot->timedOut) continue;
+
+      const qint64 remaining = t - (now - slot->start);
+      if (remaining <= 0)
+      {
+        // the task stays running but its handler will not receive
+        // events anymore
+        slot->timedOut = true;
+        timedOut.push_back(*slot->task);
+      }
+      else if (remaining < next)
+      {
+        next = remaining;
+      }
+    }
+  }
+
+  foreach(HandlerTask task, timedOut)
+  {
+    task.blackListHandler();
+  }
+
+  return static_cast<unsigned long>(next);
+}
@@ -25,30 +25,32 @@
 
 #include "ctkEADeliverTask_p.h"
 
+#include <ctkHighPrecisionTimer.h>
+
+#include <QHash>
 #include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
 
-class ctkEADefaultThreadPool;
-class ctkEASyncMasterThread;
+template<class HandlerTask> class _SyncWatchdog;
 
 /**
  * This class does the actual work of the synchronous event delivery.
  *
- * This is the heart of the event delivery. If an event is delivered
- * without timeout handling, the event is directly delivered using
- * the calling thread.
- * If timeout handling is enabled, a new thread is taken from the
- * thread pool and this thread is used to deliver the event.
- * The calling thread is blocked until either the deliver is finished
- * or the timeout occurs.
+ * This is the heart of the event delivery. The event is always delivered
+ * directly using the calling thread, there is no hand-off to another
+ * thread per event or per handler.
+ * If timeout handling is enabled, the calling thread records the start
+ * time of each handler invocation in a per-thread slot. A single watchdog
+ * thread periodically checks these slots and blacklists the handler of any
+ * invocation which exceeded the timeout, so that it will not receive events
+ * anymore.
  * <p><tt>
- * Note that in case of a timeout while a task is disabled the thread
- * is released and we spin-off a new thread that resumes the disabled
- * task hence, this is the only place were we break the semantics of
- * the synchronous delivery. While the only one to notice this is the
- * timed-out handler - it is the fault of this handler too (i.e., it
- * blocked the dispatch for to long) but since it will not receive
- * events anymore it will not notice this semantic difference except
- * that it might not see events it already sent before.
+ * Note that contrary to a hand-off based timeout handling the calling
+ * thread is not released when a handler times out, it stays blocked until
+ * the handler returns. Only the timed-out handler is affected by this
+ * since it is the fault of this handler (i.e., it blocked the dispatch for
+ * to long).
  * </tt></pre>
  *
  * If during an event delivery a new event should be delivered from
@@ -61,11 +63,7 @@ class ctkEASyncDeliverTasks : public ctkEADeliverTask<ctkEASyncDeliverTasks<Hand
 
 private:
 
-  /** The thread pool used to spin-off new threads. */
-  ctkEADefaultThreadPool* pool;
-
-  /** This is a ctkEAInterruptibleThread used to execute the handlers */
-  ctkEASyncMasterThread* syncMasterThread;
+  friend class _SyncWatchdog<HandlerTask>;
 
   /** The timeout for event handlers, 0 = disabled. */
   long timeout;
@@ -103,21 +101,120 @@ private:
 
   QMutex mutex;
 
+  /**
+   * The handler invocation a thread is currently timing. The slot is
+   * written by the owning thread and read by the watchdog, both under
+   * the slot lock.
+   */
+  struct Slot
+  {
+    Slot() : task(0), start(0), timedOut(false), depth(0) {}
+
+    QMutex lock;
+
+    /** The running task or null if no timed task is running. */
+    HandlerTask* task;
+
+    /** The start time of the running task in ms since <tt>clock</tt> started. */
+    qint64 start;
+
+    /** Whether the watchdog already blacklisted the running task. */
+    bool timedOut;
+
+    /** The nesting level of deliveries on the owning thread. */
+    int depth;
+  };
+
+  /**
+   * Acquires the slot of the calling thread for the duration of a delivery.
+   * In case of a nested delivery, the timer of the outer task is stopped
+   * and resumed afterwards.
+   */
+  struct SlotScope
+  {
+    SlotScope(ctkEASyncDeliverTasks* owner)
+      : owner(owner), slot(owner->acquireSlot()), begin(owner->clock.elapsedMilli())
+    {
+      QMutexLocker l(&slot->lock);
+      outerTask = slot->task;
+      outerStart = slot->start;
+      outerTimedOut = slot->timedOut;
+      slot->task = 0;
+    }
+
+    ~SlotScope()
+    {
+      if (outerTask)
+      {
+        QMutexLocker l(&slot->lock);
+        slot->task = outerTask;
+        slot->start = outerStart + (owner->clock.elapsedMilli() - begin);
+        slot->timedOut = outerTimedOut;
+      }
+      owner->releaseSlot(slot);
+    }
+
+    ctkEASyncDeliverTasks* const owner;
+    Slot* const slot;
+    const qint64 begin;
+    HandlerTask* outerTask;
+    qint64 outerStart;
+    bool outerTimedOut;
+  };
+
+  /**
+   * Publishes a task in the slot of the calling thread while it runs.
+   */
+  struct TimedTask
+  {
+    TimedTask(Slot* slot, HandlerTask* task, qint64 start)
+      : slot(slot)
+    {
+      QMutexLocker l(&slot->lock);
+      slot->task = task;
+      slot->start = start;
+      slot->timedOut = false;
+    }
+
+    ~TimedTask()
+    {
+      QMutexLocker l(&slot->lock);
+      slot->task = 0;
+    }
+
+    Slot* const slot;
+  };
+
+  /** The clock all slot time stamps are relative to. */
+  ctkHighPrecisionTimer clock;
+
+  /** The slots of the threads currently delivering events, guarded by slotsMutex. */
+  QHash<QThread*, Slot*> activeSlots;
+
+  /** Released slots for reuse, guarded by slotsMutex. */
+  QList<Slot*> freeSlots;
+
+  QMutex slotsMutex;
+
+  /** The watchdog thread, only running while a timeout is configured. */
+  _SyncWatchdog<HandlerTask>* watchdog;
+
 public:
 
   /**
    * Construct a new sync deliver tasks.
-   * @param pool The thread pool used to spin-off new threads.
    * @param timeout The timeout for an event handler, 0 = disabled
+   * @param ignoreTimeout The class names of handlers without timeout handling
    */
-  ctkEASyncDeliverTasks(ctkEADefaultThreadPool* pool, ctkEASyncMasterThread* syncMasterThread,
-                        long timeout, const QList<QString>& ignoreTimeout);
+  ctkEASyncDeliverTasks(long timeout, const QList<QString>& ignoreTimeout);
+
+  ~ctkEASyncDeliverTasks();
 
   void update(long timeout, const QList<QString>& ignoreTimeout);
 
   /**
-   * This blocks an unrelated thread used to send a synchronous event until the
-   * event is send (or a timeout occurs).
+   * This delivers a synchronous event to the handlers using the calling
+   * thread and returns after all handlers were invoked.
    *
    * @param tasks The event handler dispatch tasks to execute
    *
@@ -125,7 +222,10 @@ public:
    */
   void execute(const QList<HandlerTask>& tasks);
 
-  void executeInSyncMaster(const QList<HandlerTask>& tasks);
+  /**
+   * Stops the watchdog thread.
+   */
+  void stop();
 
 private:
 
@@ -136,6 +236,17 @@ private:
    */
   bool useTimeout(const HandlerTask& task);
 
+  Slot* acquireSlot();
+  void releaseSlot(Slot* slot);
+
+  /**
+   * Called by the watchdog thread. Blacklists the handlers of all running
+   * tasks which exceeded the timeout.
+   *
+   * @return The time in ms until the next running task times out
+   */
+  unsigned long checkTimeouts();
+
 };
 
 #include "ctkEASyncDeliverTasks.tpp"
@@ -1,48 +0,0 @@
-/*=============================================================================
-
-  Library: CTK
-
-  Copyright (c) German Cancer Research Center,
-    Division of Medical and Biological Informatics
-
-  Licensed under the Apache License, Version 2.0 (the "License");
-  you may not use this file except in compliance with the License.
-  You may obtain a copy of the License at
-
-    http://www.apache.org/licenses/LICENSE-2.0
-
-  Unless required by applicable law or agreed to in writing, software
-  distributed under the License is distributed on an "AS IS" BASIS,
-  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-  See the License for the specific language governing permissions and
-  limitations under the License.
-
-=============================================================================*/
-
-
-#include "ctkEABrokenBarrierException_p.h"
-
-ctkEABrokenBarrierException::ctkEABrokenBarrierException(int idx, const QString& message)
-  : ctkRuntimeException(message), index(idx)
-{
-
-}
-
-ctkEABrokenBarrierException::~ctkEABrokenBarrierException() throw()
-{
-}
-
-const char *ctkEABrokenBarrierException::name() const throw()
-{
-  return "ctkEABrokenBarrierException";
-}
-
-ctkEABrokenBarrierException *ctkEABrokenBarrierException::clone() const
-{
-  return new ctkEABrokenBarrierException(*this);
-}
-
-void ctkEABrokenBarrierException::rethrow() const
-{
-  throw *this;
-}
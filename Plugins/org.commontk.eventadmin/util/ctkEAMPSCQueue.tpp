@@ -20,45 +20,43 @@
 =============================================================================*/
 
 
-#include "ctkEARendezvous_p.h"
-
-#include "ctkEABrokenBarrierException_p.h"
-#include "ctkEATimeoutException_p.h"
+template<typename T>
+ctkEAMPSCQueue<T>::ctkEAMPSCQueue()
+  : tail(new Node())
+{
+  head.fetchAndStoreRelaxed(tail);
+}
 
-ctkEARendezvous::ctkEARendezvous()
-  : ctkEACyclicBarrier(2), timedout()
+template<typename T>
+ctkEAMPSCQueue<T>::~ctkEAMPSCQueue()
 {
+  T value;
+  while (pop(value)) {}
+  delete tail;
 }
 
-void ctkEARendezvous::waitForRendezvous()
+template<typename T>
+void ctkEAMPSCQueue<T>::push(const T& value)
 {
-  if (timedout.fetchAndAddOrdered(0))
-  {
-    // if we have timed out, we return immediately
-    return;
-  }
-  try
-  {
-    this->barrier();
-  }
-  catch (const ctkEABrokenBarrierException&)
-  {
-  }
+  Node* node = new Node(value);
+  Node* prev = head.fetchAndStoreOrdered(node);
+  // Until this store, the consumer cannot reach the new node
+  prev->next.fetchAndStoreRelease(node);
 }
 
-void ctkEARendezvous::waitAttemptForRendezvous(long timeout)
+template<typename T>
+bool ctkEAMPSCQueue<T>::pop(T& value)
 {
-  try
-  {
-    this->attemptBarrier(timeout);
-    this->restart();
-  }
-  catch (const ctkEABrokenBarrierException&)
+  Node* next = tail->next.fetchAndAddAcquire(0);
+  if (next == 0)
   {
+    return false;
   }
-  catch (const ctkEATimeoutException& te)
-  {
-    timedout.testAndSetOrdered(0, 1);
-    throw te;
-  }
+
+  value = next->value;
+  // next becomes the new dummy node
+  next->value = T();
+  delete tail;
+  tail = next;
+  return true;
 }
@@ -0,0 +1,87 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKEAMPSCQUEUE_P_H
+#define CTKEAMPSCQUEUE_P_H
+
+#include <QAtomicPointer>
+
+/**
+ * An unbounded lock-free queue for multiple producers and a single
+ * consumer. Producers only exchange the head pointer, hence
+ * <tt>push()</tt> never blocks and never contends on a lock.
+ *
+ * The consumer may see the queue empty for a short moment while a
+ * producer is in the middle of a <tt>push()</tt>. Callers which need to
+ * know whether an element is on its way must track this themselves, e.g.
+ * with a counter that is incremented after each push.
+ */
+template<typename T>
+class ctkEAMPSCQueue
+{
+
+private:
+
+  struct Node
+  {
+    Node() {}
+    explicit Node(const T& value) : value(value) {}
+
+    QAtomicPointer<Node> next;
+    T value;
+  };
+
+  // The most recently pushed node, exchanged by the producers
+  QAtomicPointer<Node> head;
+
+  // The dummy node in front of the oldest element, only used by the consumer
+  Node* tail;
+
+  Q_DISABLE_COPY(ctkEAMPSCQueue)
+
+public:
+
+  ctkEAMPSCQueue();
+
+  ~ctkEAMPSCQueue();
+
+  /**
+   * Appends the value to the queue. May be called from any thread.
+   *
+   * @param value The value to append
+   */
+  void push(const T& value);
+
+  /**
+   * Removes the oldest value from the queue. Must only be called from
+   * one thread at a time.
+   *
+   * @param value Receives the removed value
+   * @return <code>false</code> if no element could be removed
+   */
+  bool pop(T& value);
+
+};
+
+#include "ctkEAMPSCQueue.tpp"
+
+#endif // CTKEAMPSCQUEUE_P_H
@@ -44,6 +44,7 @@ public Q_SLOTS:
     void setObjectValue8(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8){QVERIFY(v1 != 0);QVERIFY(v2 != 0);QVERIFY(v3 != 0);QVERIFY(v4 != 0);QVERIFY(v5 != 0);QVERIFY(v6 != 0);QVERIFY(v7 != 0);QVERIFY(v8 != 0);};
     void setObjectValue9(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9){QVERIFY(v1 != 0);QVERIFY(v2 != 0);QVERIFY(v3 != 0);QVERIFY(v4 != 0);QVERIFY(v5 != 0);QVERIFY(v6 != 0);QVERIFY(v7 != 0);QVERIFY(v8 != 0);QVERIFY(v9 != 0);};
     void setObjectValue10(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9, int v10){QVERIFY(v1 != 0);QVERIFY(v2 != 0);QVERIFY(v3 != 0);QVERIFY(v4 != 0);QVERIFY(v5 != 0);QVERIFY(v6 != 0);QVERIFY(v7 != 0);QVERIFY(v8 != 0);QVERIFY(v9 != 0);QVERIFY(v10 != 0);};
+    void setObjectValue12(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9, int v10, int v11, int v12){m_Var = v1 + v2 + v3 + v4 + v5 + v6 + v7 + v8 + v9 + v10 + v11 + v12;};
 
     // with return value
     int setObjectValue0WithReturnValue(){ return 0;};
@@ -70,6 +71,7 @@ Q_SIGNALS:
     void signalSetObjectValue8(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8);
     void signalSetObjectValue9(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9);
     void signalSetObjectValue10(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9, int v10);
+    void signalSetObjectValue12(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9, int v10, int v11, int v12);
 
     int signalSetObjectValue0WithReturnValue();
     int signalSetObjectValue1WithReturnValue(int v1);
@@ -132,6 +134,9 @@ private Q_SLOTS:
     /// notify event test which cover all the possibilities in terms of arguments with returned value
     void notifyEventWitReturnValueTest();
 
+    /// notify event test with more than 10 arguments and with wrong arguments
+    void notifyEventWithManyArgumentsTest();
+
 private:
     testObjectCustomForDispatcherLocal *m_ObjTest; ///< Test Object var
     ctkEventDispatcherLocal *m_EventDispatcherLocal; ///< Test var.
@@ -419,5 +424,43 @@ void ctkEventDispatcherLocalTest::notifyEventWitReturnValueTest() {
     delete propCallback10;
 }
 
+void ctkEventDispatcherLocalTest::notifyEventWithManyArgumentsTest() {
+    QString topic = "ctk/local/setObjectValue12";
+
+    ctkBusEvent *propSignal = new ctkBusEvent(topic, ctkEventTypeLocal, ctkSignatureTypeSignal, m_ObjTest, "signalSetObjectValue12(int,int,int,int,int,int,int,int,int,int,int,int)");
+    m_EventDispatcherLocal->registerSignal(*propSignal);
+
+    ctkBusEvent *propCallback = new ctkBusEvent(topic, ctkEventTypeLocal, ctkSignatureTypeCallback, m_ObjTest, "setObjectValue12(int,int,int,int,int,int,int,int,int,int,int,int)");
+    m_EventDispatcherLocal->addObserver(*propCallback);
+
+    int values[12];
+    ctkEventArgumentsList argList;
+    int argCounter = 0, sum = 0;
+    for( ; argCounter < 12; argCounter++) {
+        values[argCounter] = argCounter + 1;
+        sum += values[argCounter];
+        argList.append(ctkEventArgument(int, values[argCounter]));
+    }
+
+    ctkBusEvent notEvent(topic, ctkDictionary());
+    m_EventDispatcherLocal->notifyEvent(notEvent, &argList);
+    QCOMPARE(m_ObjTest->var(), sum);
+
+    // wrong number of arguments: the signal must not be emitted.
+    argList.removeLast();
+    values[0] = 100;
+    m_EventDispatcherLocal->notifyEvent(notEvent, &argList);
+    QCOMPARE(m_ObjTest->var(), sum);
+
+    // wrong type of argument: the signal must not be emitted.
+    double wrongType = 12.0;
+    argList.append(ctkEventArgument(double, wrongType));
+    m_EventDispatcherLocal->notifyEvent(notEvent, &argList);
+    QCOMPARE(m_ObjTest->var(), sum);
+
+    delete propSignal;
+    delete propCallback;
+}
+
 CTK_REGISTER_TEST(ctkEventDispatcherLocalTest);
 #include "ctkEventDispatcherLocalTest.moc"
@@ -0,0 +1,240 @@
+/*
+ *  ctkNetworkConnectorSocketTest.cpp
+ *  ctkNetworkConnectorSocketTest
+ *
+ *  See Licence at: http://tiny.cc/QXJ4D
+ *
+ */
+
+#include "ctkTestSuite.h"
+#include <ctkNetworkConnectorSocket.h>
+#include <ctkNetworkConnectorQXMLRPC.h>
+#include <ctkEventBusManager.h>
+
+#include <QApplication>
+#include <QElapsedTimer>
+
+using namespace ctkEventBus;
+
+//-------------------------------------------------------------------------
+/**
+ Class name: ctkObjectCustom
+ Custom object needed for testing.
+ */
+class testObjectCustomForNetworkConnectorSocket : public QObject {
+    Q_OBJECT
+
+public:
+    /// constructor.
+    testObjectCustomForNetworkConnectorSocket();
+
+    /// Return tha var's value.
+    int var() {return m_Var;}
+
+    /// Return the number of remote communications done.
+    int done() {return m_Done;}
+
+public Q_SLOTS:
+    /// Test slot that will increment the value of m_Var when an UPDATE_OBJECT event is raised.
+    void updateObject();
+    void setObjectValue(int v);
+
+    /// Test slot that will increment the value of m_Done when a remote communication is done.
+    void communicationDone();
+
+Q_SIGNALS:
+    void valueModified(int v);
+    void objectModified();
+
+private:
+    int m_Var; ///< Test var.
+    int m_Done; ///< Number of remote communications done.
+};
+
+testObjectCustomForNetworkConnectorSocket::testObjectCustomForNetworkConnectorSocket() : m_Var(0), m_Done(0) {
+}
+
+void testObjectCustomForNetworkConnectorSocket::updateObject() {
+    m_Var++;
+}
+
+void testObjectCustomForNetworkConnectorSocket::setObjectValue(int v) {
+    m_Var = v;
+}
+
+void testObjectCustomForNetworkConnectorSocket::communicationDone() {
+    m_Done++;
+}
+
+
+/**
+ Class name: ctkNetworkConnectorSocketTest
+ This class implements the test suite for ctkNetworkConnectorSocket.
+ */
+
+//! <title>
+//ctkNetworkConnectorSocket
+//! </title>
+//! <description>
+//ctkNetworkConnectorSocket provides the connection with a binary protocol
+//over a persistent TCP connection.
+//! </description>
+
+class ctkNetworkConnectorSocketTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    /// Initialize test variables
+    void initTestCase() {
+        m_EventBus = ctkEventBusManager::instance();
+        m_NetWorkConnectorSocket = new ctkEventBus::ctkNetworkConnectorSocket();
+        m_ObjectTest = new testObjectCustomForNetworkConnectorSocket();
+    }
+
+    /// Cleanup tes variables memory allocation.
+    void cleanupTestCase() {
+        if(m_ObjectTest) {
+            m_EventBus->removeObserver(m_ObjectTest);
+            delete m_ObjectTest;
+            m_ObjectTest = NULL;
+        }
+        delete m_NetWorkConnectorSocket;
+        m_EventBus->shutdown();
+    }
+
+    /// Check the existence of the ctkNetworkConnectorSocket instance.
+    void ctkNetworkConnectorSocketConstructorTest();
+
+    /// Check that a request sent by the client is processed by the server.
+    void ctkNetworkConnectorSocketCommunictionTest();
+
+    /// Compare events/sec and latency of the socket and the xml-rpc connectors on the loopback interface.
+    void ctkNetworkConnectorSocketBenchmarkTest();
+
+private:
+    /// send the given number of events, returning false if not all of them were done before the timeout.
+    bool sendEvents(ctkNetworkConnector *connector, const QString &method, int count, bool waitEach);
+
+    ctkEventBusManager *m_EventBus; ///< event bus instance
+    ctkNetworkConnectorSocket *m_NetWorkConnectorSocket; ///< EventBus test variable instance.
+    testObjectCustomForNetworkConnectorSocket *m_ObjectTest;
+};
+
+void ctkNetworkConnectorSocketTest::ctkNetworkConnectorSocketConstructorTest() {
+    QVERIFY(m_NetWorkConnectorSocket != NULL);
+    QCOMPARE(m_NetWorkConnectorSocket->protocol(), QString("SOCKET"));
+}
+
+void ctkNetworkConnectorSocketTest::ctkNetworkConnectorSocketCommunictionTest() {
+    m_NetWorkConnectorSocket->createServer(8010);
+    m_NetWorkConnectorSocket->startListen();
+
+    // Register callback (done by the remote object).
+    ctkRegisterLocalCallback("ctk/local/eventBus/globalUpdate", m_ObjectTest, "updateObject()");
+
+    m_NetWorkConnectorSocket->createClient("localhost", 8010);
+
+    //create list to send from the client
+    //first parameter is a list which contains event prperties
+    QVariantList eventParameters;
+    eventParameters.append("ctk/local/eventBus/globalUpdate");
+    eventParameters.append(ctkEventTypeLocal);
+    eventParameters.append(ctkSignatureTypeCallback);
+    eventParameters.append("updateObject()");
+
+    QVariantList dataParameters;
+
+    ctkEventArgumentsList listToSend;
+    listToSend.append(ctkEventArgument(QVariantList, eventParameters));
+    listToSend.append(ctkEventArgument(QVariantList, dataParameters));
+
+    m_NetWorkConnectorSocket->send("ctk/remote/eventBus/comunication/send/socket", &listToSend);
+    m_NetWorkConnectorSocket->send("ctk/remote/eventBus/comunication/send/socket", &listToSend);
+
+    QTime dieTime = QTime::currentTime().addSecs(3);
+    while(QTime::currentTime() < dieTime && m_ObjectTest->var() < 2) {
+       QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+    }
+    QCOMPARE(m_ObjectTest->var(), 2);
+
+    m_EventBus->removeObserver(m_ObjectTest, "ctk/local/eventBus/globalUpdate");
+}
+
+bool ctkNetworkConnectorSocketTest::sendEvents(ctkNetworkConnector *connector, const QString &method, int count, bool waitEach) {
+    QVariantList eventParameters;
+    eventParameters.append("ctk/local/eventBus/globalUpdate");
+    eventParameters.append(ctkEventTypeLocal);
+    eventParameters.append(ctkSignatureTypeCallback);
+    eventParameters.append("updateObject()");
+
+    QVariantList dataParameters;
+
+    ctkEventArgumentsList listToSend;
+    listToSend.append(ctkEventArgument(QVariantList, eventParameters));
+    listToSend.append(ctkEventArgument(QVariantList, dataParameters));
+
+    int expected = m_ObjectTest->done();
+    QTime dieTime = QTime::currentTime().addSecs(60);
+    for(int i = 0; i < count; ++i) {
+        connector->send(method, &listToSend);
+        ++expected;
+        while(waitEach && m_ObjectTest->done() < expected) {
+            if(QTime::currentTime() > dieTime) return false;
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+        }
+    }
+    while(m_ObjectTest->done() < expected) {
+        if(QTime::currentTime() > dieTime) return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 3);
+    }
+    return true;
+}
+
+void ctkNetworkConnectorSocketTest::ctkNetworkConnectorSocketBenchmarkTest() {
+    const int nEvents = 2000;
+    const int nLatencyEvents = 200;
+
+    ctkRegisterLocalCallback("ctk/local/eventBus/remoteCommunicationDone", m_ObjectTest, "communicationDone()");
+
+    ctkNetworkConnectorSocket socketConnector;
+    socketConnector.createServer(8011);
+    socketConnector.startListen();
+    socketConnector.createClient("localhost", 8011);
+
+    ctkNetworkConnectorQXMLRPC xmlrpcConnector;
+    xmlrpcConnector.createServer(8012);
+    xmlrpcConnector.startListen();
+    xmlrpcConnector.createClient("localhost", 8012);
+
+    struct {
+        ctkNetworkConnector *connector;
+        QString method;
+    } connectors[] = {
+        { &socketConnector, "ctk/remote/eventBus/comunication/send/socket" },
+        { &xmlrpcConnector, "ctk/remote/eventBus/comunication/send/xmlrpc" }
+    };
+
+    for(int i = 0; i < 2; ++i) {
+        // warm up the connection
+        QVERIFY(sendEvents(connectors[i].connector, connectors[i].method, 10, true));
+
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(sendEvents(connectors[i].connector, connectors[i].method, nEvents, false));
+        qint64 throughputTime = timer.elapsed();
+
+        timer.restart();
+        QVERIFY(sendEvents(connectors[i].connector, connectors[i].method, nLatencyEvents, true));
+        qint64 latencyTime = timer.nsecsElapsed();
+
+        qDebug() << connectors[i].connector->protocol() << ":"
+                 << (nEvents * 1000.0 / qMax<qint64>(throughputTime, 1)) << "events/sec,"
+                 << (latencyTime / nLatencyEvents / 1000.0) << "usecs round trip latency";
+    }
+
+    m_EventBus->removeObserver(m_ObjectTest, "ctk/local/eventBus/remoteCommunicationDone");
+}
+
+CTK_REGISTER_TEST(ctkNetworkConnectorSocketTest);
+#include "ctkNetworkConnectorSocketTest.moc"
+
@@ -13,6 +13,8 @@
 #include "ctkEventDispatcher.h"
 #include "ctkBusEvent.h"
 
+#include <QMetaMethod>
+
 #define CALLBACK_SIGNATURE "1"
 #define SIGNAL_SIGNATURE   "2"
 
@@ -42,6 +44,7 @@ void ctkEventDispatcher::resetHashes() {
         delete i.value();
     }
     m_SignalsHash.clear();
+    m_SignalMethodsHash.clear();
 }
 
 void ctkEventDispatcher::initializeGlobalEvents() {
@@ -144,6 +147,7 @@ bool ctkEventDispatcher::removeEventItem(ctkBusEvent &props) {
                 i++;
             }
             m_SignalsHash.remove(props[TOPIC].toString()); //in signal hash the id is unique
+            m_SignalMethodsHash.remove(props[TOPIC].toString());
             m_CallbacksHash.remove(props[TOPIC].toString()); //remove also all the id associated in callback
         }
 
@@ -236,6 +240,9 @@ bool ctkEventDispatcher::removeFromHash(ctkEventsHashType *hash, const QObject *
                 }
                 disconnectItem = disconnectItem && currentDisconnetFlag;
                 if(currentDisconnetFlag) {
+                    if(hash == &m_SignalsHash) {
+                        m_SignalMethodsHash.remove(i.key());
+                    }
                     delete i.value();
                     i = hash->erase(i);
                 } else {
@@ -267,6 +274,9 @@ bool ctkEventDispatcher::removeFromHash(ctkEventsHashType *hash, const QObject *
                 }
                 disconnectItem = disconnectItem && currentDisconnetFlag;
                 if(currentDisconnetFlag) {
+                    if(hash == &m_SignalsHash) {
+                        m_SignalMethodsHash.remove(i.key());
+                    }
                     delete i.value();
                     i = hash->erase(i);
                 } else {
@@ -319,6 +329,7 @@ bool ctkEventDispatcher::registerSignal(ctkBusEvent &props) {
         // Add the new signal to the Hash.
         ctkBusEvent *dict = const_cast<ctkBusEvent *>(&props);
         this->m_SignalsHash.insert(topic, dict);
+        cacheSignalMethod(props);
         return true;
     }
 
@@ -342,11 +353,31 @@ bool ctkEventDispatcher::registerSignal(ctkBusEvent &props) {
          }
          ctkBusEvent *dict = const_cast<ctkBusEvent *>(&props);
          this->m_SignalsHash.insert(topic, dict);
+         cacheSignalMethod(props);
     }
 
     return cumulativeConnect;
 }
 
+void ctkEventDispatcher::cacheSignalMethod(ctkBusEvent &props) {
+    ctkSignalMethod method;
+    method.object = props[OBJECT].value<QObject *>();
+    method.index = -1;
+    if(method.object != NULL) {
+        QByteArray sig = QMetaObject::normalizedSignature(props[SIGNATURE].toString().toLatin1().constData());
+        const QMetaObject *metaObject = method.object->metaObject();
+        method.index = metaObject->indexOfMethod(sig.constData());
+        if(method.index < 0) {
+            qWarning("%s", tr("Signal '%1' not found in %2 for Topic '%3'").arg(QString(sig), metaObject->className(), props[TOPIC].toString()).toLatin1().data());
+        } else {
+            QMetaMethod metaMethod = metaObject->method(method.index);
+            method.parameterTypes = metaMethod.parameterTypes();
+            method.returnType = QMetaObject::normalizedType(metaMethod.typeName());
+        }
+    }
+    m_SignalMethodsHash.insert(props[TOPIC].toString(), method);
+}
+
 bool ctkEventDispatcher::removeSignal(ctkBusEvent &props) {
     return removeEventItem(props);
 }
@@ -16,6 +16,21 @@
 
 namespace ctkEventBus {
 
+/**
+ Class name: ctkSignalMethod
+ Signal registered for a topic, resolved once at registration time so that events
+ can be notified without any lookup by name.
+ */
+struct ctkSignalMethod {
+    QObject *object; ///< object owning the signal.
+    int index; ///< index of the signal in the object's meta object, -1 if not found.
+    QList<QByteArray> parameterTypes; ///< normalized types of the signal's parameters.
+    QByteArray returnType; ///< normalized return type of the signal.
+};
+
+/// typedef that represent the hash of the resolved signals by topic.
+typedef QHash<QString, ctkSignalMethod> ctkSignalMethodsHashType;
+
 /**
  Class name: ctkEventDispatcher
  This allows dispatching events coming from local application to attached observers.
@@ -82,6 +97,9 @@ protected:
     /// Return the signal item property associated to the given ID.
     ctkEventItemListType signalItemProperty(const QString topic) const;
 
+    /// Return the resolved signal registered for the given ID, NULL if no signal has been registered.
+    const ctkSignalMethod *signalMethod(const QString topic) const;
+
 private:
     /// method used to check if the given object has been already registered for the given id and signature.
     bool isSignaturePresent(ctkBusEvent &props) const;
@@ -96,8 +114,12 @@ private:
     /// Remove the given object from the has passed as argument
     bool removeFromHash(ctkEventsHashType *hash, const QObject *obj, const QString topic, bool qt_disconnect = true);
 
+    /// Resolve the signal of the given signal item property and cache it for its topic.
+    void cacheSignalMethod(ctkBusEvent &props);
+
     ctkEventsHashType m_CallbacksHash; ///< Callbacks' hash for receiving events like updates or refreshes.
     ctkEventsHashType m_SignalsHash; ///< Signals' hash for sending events.
+    ctkSignalMethodsHashType m_SignalMethodsHash; ///< Resolved signals of m_SignalsHash by topic.
 };
 
 /////////////////////////////////////////////////////////////
@@ -108,6 +130,11 @@ inline ctkEventItemListType ctkEventDispatcher::signalItemProperty(const QString
     return m_SignalsHash.values(topic);
 }
 
+inline const ctkSignalMethod *ctkEventDispatcher::signalMethod(const QString topic) const {
+    ctkSignalMethodsHashType::const_iterator i = m_SignalMethodsHash.constFind(topic);
+    return i == m_SignalMethodsHash.constEnd() ? NULL : &i.value();
+}
+
 } // namespace ctkEventBus
 
 #endif // CTKEVENTDISPATCHER_H
@@ -12,6 +12,8 @@
 #include "ctkEventDispatcherLocal.h"
 #include "ctkBusEvent.h"
 
+#include <QVarLengthArray>
+
 using namespace ctkEventBus;
 
 ctkEventDispatcherLocal::ctkEventDispatcherLocal() : ctkEventDispatcher() {
@@ -35,127 +37,43 @@ void ctkEventDispatcherLocal::initializeGlobalEvents() {
 
 void ctkEventDispatcherLocal::notifyEvent(ctkBusEvent &event_dictionary, ctkEventArgumentsList *argList, ctkGenericReturnArgument *returnArg) const {
     QString topic = event_dictionary[TOPIC].toString();
-    ctkEventItemListType items = signalItemProperty(topic);
-    ctkBusEvent *itemEventProp;
-    foreach(itemEventProp, items) {
-        if((*itemEventProp)[SIGNATURE].toString().length() != 0) {
-            QString signal_to_emit = (*itemEventProp)[SIGNATURE].toString().split("(")[0];
-            QObject *obj = (*itemEventProp)[OBJECT].value<QObject *>();
-            if(argList != NULL) {
-                if (returnArg == NULL || returnArg->data() == NULL) { //don't use return value
-                    switch (argList->count()) {
-                        case 0:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1());
-                            break;
-                        case 1:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                            argList->at(0));
-                            break;
-                        case 2:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1));
-                            break;
-                        case 3:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2));
-                            break;
-                        case 4:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3));
-                            break;
-                        case 5:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4));
-                            break;
-                        case 6:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), argList->at(5));
-                            break;
-                        case 7:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6));
-                            break;
-                        case 8:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6), argList->at(7));
-                            break;
-                        case 9:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6), argList->at(7), argList->at(8));
-                            break;
-                        case 10:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6), argList->at(7), argList->at(8), argList->at(9));
-                            break;
-                        default:
-                            qWarning("%s", tr("Number of arguments not supported. Max 10 arguments").toLatin1().data());
-                    } //switch
-                 } else { //use return value
-                    switch (argList->count()) {
-                        case 0:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg);
-                            break;
-                        case 1:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg,\
-                            argList->at(0));
-                            break;
-                        case 2:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1));
-                            break;
-                        case 3:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2));
-                            break;
-                        case 4:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3));
-                            break;
-                        case 5:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4));
-                            break;
-                        case 6:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), argList->at(5));
-                            break;
-                        case 7:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6));
-                            break;
-                        case 8:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6), argList->at(7));
-                            break;
-                        case 9:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6), argList->at(7), argList->at(8));
-                            break;
-                        case 10:
-                            this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg, \
-                             argList->at(0), argList->at(1), argList->at(2), argList->at(3), argList->at(4), \
-                             argList->at(5), argList->at(6), argList->at(7), argList->at(8), argList->at(9));
-                            break;
-                        default:
-                            qWarning("%s", tr("Number of arguments not supported. Max 10 arguments").toLatin1().data());
-                    } //switch
-                 }
-            } else {
-                if (returnArg == NULL || returnArg->data() == NULL) { //don't use return value
-                    this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1());
-                } else {
-                    this->metaObject()->invokeMethod(obj, signal_to_emit.toLatin1(), *returnArg);
-                }
+    const ctkSignalMethod *method = signalMethod(topic);
+    if(method == NULL || method->index < 0) {
+        return;
+    }
 
-            }
+    // the signal has been resolved at registration, check the arguments against its parameters and emit it directly.
+    int argCount = argList != NULL ? argList->count() : 0;
+    if(argCount != method->parameterTypes.count()) {
+        qWarning("%s", tr("Number of arguments (%1) does not match the signal of Topic '%2'").arg(QString::number(argCount), topic).toLatin1().data());
+        return;
+    }
+
+    QVarLengthArray<void *, 11> args(argCount + 1);
+    args[0] = NULL;
+    if(returnArg != NULL && returnArg->data() != NULL) {
+        if(!sameType(returnArg->name(), method->returnType)) {
+            qWarning("%s", tr("Return type %1 does not match the signal of Topic '%2'").arg(returnArg->name(), topic).toLatin1().data());
+            return;
         }
+        args[0] = returnArg->data();
     }
+    for(int i = 0; i < argCount; ++i) {
+        const QGenericArgument &arg = argList->at(i);
+        if(!sameType(arg.name(), method->parameterTypes.at(i))) {
+            qWarning("%s", tr("Argument type %1 does not match the signal of Topic '%2'").arg(arg.name(), topic).toLatin1().data());
+            return;
+        }
+        args[i + 1] = arg.data();
+    }
+
+    QMetaObject::metacall(method->object, QMetaObject::InvokeMetaMethod, method->index, args.data());
 }
 
+bool ctkEventDispatcherLocal::sameType(const char *argumentType, const QByteArray &parameterType) {
+    // argument types are usually given already normalized, avoid normalizing them for each event.
+    if(qstrcmp(argumentType, parameterType.constData()) == 0) {
+        return true;
+    }
+    return QMetaObject::normalizedType(argumentType) == parameterType;
+}
@@ -29,6 +29,7 @@ public:
     ctkEventDispatcherLocal();
 
     /// Emit event corresponding to the given id locally to the application.
+    /** The signal registered for the id is invoked through its cached meta method index, with any number of arguments. */
     virtual void notifyEvent(ctkBusEvent &event_dictionary, ctkEventArgumentsList *argList = NULL, ctkGenericReturnArgument *returnArg = NULL) const;
 
 protected:
@@ -36,6 +37,8 @@ protected:
     /*virtual*/ void initializeGlobalEvents();
 
 private:
+    /// Check that the type name of an argument matches the normalized type of a parameter.
+    static bool sameType(const char *argumentType, const QByteArray &parameterType);
 };
 
 }
@@ -0,0 +1,326 @@
+/*
+ *  ctkNetworkConnectorSocket.cpp
+ *  ctkEventBus
+ *
+ *  See Licence at: http://tiny.cc/QXJ4D
+ *
+ */
+
+#include "ctkNetworkConnectorSocket.h"
+#include "ctkEventBusManager.h"
+
+#include <QDataStream>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+using namespace ctkEventBus;
+
+namespace {
+
+/// size of the queued requests above which they are written without waiting for the event loop.
+const int MAX_OUTGOING_SIZE = 64 * 1024;
+
+/// largest frame accepted from the peer; bigger frames close the connection.
+const quint32 MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+/// encode a frame and append it to the given buffer.
+void appendFrame(QByteArray &buffer, quint8 type, qint32 requestId, const QVariantList &values) {
+    QByteArray frame;
+    QDataStream out(&frame, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << quint32(0) << type << requestId;
+    foreach(const QVariant &value, values) {
+        out << value;
+    }
+    out.device()->seek(0);
+    out << quint32(frame.size() - sizeof(quint32));
+    buffer.append(frame);
+}
+
+}
+
+ctkNetworkConnectorSocket::ctkNetworkConnectorSocket() : ctkNetworkConnector(), m_Client(NULL), m_Server(NULL), m_ListenAddress(QHostAddress::LocalHost), m_Port(0), m_RequestId(0), m_FlushScheduled(false) {
+    m_Protocol = "SOCKET";
+}
+
+void ctkNetworkConnectorSocket::initializeForEventBus() {
+    ctkRegisterRemoteSignal("ctk/remote/eventBus/comunication/send/socket", this, "remoteCommunication(const QString, ctkEventArgumentsList *)");
+    ctkRegisterRemoteCallback("ctk/remote/eventBus/comunication/send/socket", this, "send(const QString, ctkEventArgumentsList *)");
+}
+
+ctkNetworkConnectorSocket::~ctkNetworkConnectorSocket() {
+    if(m_Client) {
+        delete m_Client;
+        m_Client = NULL;
+    }
+    if(m_Server) {
+        stopServer();
+    }
+}
+
+//retrieve an instance of the object
+ctkNetworkConnector *ctkNetworkConnectorSocket::clone() {
+    ctkNetworkConnectorSocket *copy = new ctkNetworkConnectorSocket();
+    return copy;
+}
+
+void ctkNetworkConnectorSocket::createClient(const QString hostName, const unsigned int port) {
+    if(m_Client == NULL) {
+        m_Client = new QTcpSocket(NULL);
+        connect(m_Client, SIGNAL(connected()), this, SLOT(clientConnected()));
+        connect(m_Client, SIGNAL(readyRead()), this, SLOT(readReplies()));
+        connect(m_Client, SIGNAL(error(QAbstractSocket::SocketError)),
+                this, SLOT(processFault(QAbstractSocket::SocketError)));
+    } else {
+        m_Client->abort();
+        failPendingRequests();
+    }
+    // requests sent before the connection is established are buffered by the socket.
+    m_Client->connectToHost(hostName, port);
+}
+
+void ctkNetworkConnectorSocket::createServer(const unsigned int port) {
+    if(m_Server != NULL) {
+        if(m_Port == port) {
+            return;
+        }
+        stopServer();
+    }
+    m_Server = new QTcpServer(NULL);
+    m_Port = port;
+    connect(m_Server, SIGNAL(newConnection()), this, SLOT(acceptConnections()));
+}
+
+void ctkNetworkConnectorSocket::setListenAddress(const QHostAddress &address) {
+    m_ListenAddress = address;
+}
+
+QHostAddress ctkNetworkConnectorSocket::listenAddress() const {
+    return m_ListenAddress;
+}
+
+void ctkNetworkConnectorSocket::stopServer() {
+    // Delete (and stop) the previous instance of the server, closing its connections.
+    foreach(QTcpSocket *connection, m_Server->findChildren<QTcpSocket *>()) {
+        connection->abort();
+    }
+    delete m_Server;
+    m_Server = NULL;
+    m_Port = 0;
+}
+
+void ctkNetworkConnectorSocket::startListen() {
+    if(m_Server == NULL) {
+        qWarning("%s", tr("Server can not start. Create it first, then call startListen again!!").toLatin1().data());
+        return;
+    }
+    if(m_Server->isListening()) {
+        qDebug("%s", tr("Server is already listening on port %1").arg(m_Port).toLatin1().data());
+        return;
+    }
+
+    if( m_Server->listen( m_ListenAddress, m_Port ) ) {
+        qDebug() << "Listening for socket requests on" << m_ListenAddress.toString() << "port" << m_Port;
+    } else {
+        qDebug() << "Error listening port" << m_Port << m_Server->errorString();
+    }
+}
+
+void ctkNetworkConnectorSocket::send(const QString event_id, ctkEventArgumentsList *argList) {
+    if(argList == NULL || argList->count() == 0) {
+        qWarning("%s", tr("Remote Dispatcher need to have at least one argument that is a QVariantList").toLatin1().data());
+        return;
+    }
+    if(m_Client == NULL) {
+        qWarning("%s", tr("Client has not been created, call createClient first!!").toLatin1().data());
+        return;
+    }
+
+    QVariantList values;
+    int i=0, size = argList->count();
+    for(;i<size;i++) {
+        QString typeArgument;
+        typeArgument = argList->at(i).name();
+        if(typeArgument != "QVariantList") {
+            qWarning("%s", tr("Remote Dispatcher need to have arguments that are QVariantList").toLatin1().data());
+            return;
+        }
+        values.append(QVariant(*static_cast<QVariantList *>(argList->at(i).data())));
+    }
+    // the request always carries the event parameters and the data parameters.
+    if(size == 1) {
+        values.append(QVariant(QVariantList()));
+    }
+
+    ++m_RequestId;
+    m_PendingRequests.insert(m_RequestId, event_id);
+    appendFrame(m_Outgoing, FRAME_REQUEST, m_RequestId, values);
+
+    if(m_Outgoing.size() >= MAX_OUTGOING_SIZE) {
+        flush();
+    } else if(!m_FlushScheduled) {
+        // batch all the requests sent in this event loop iteration into one write.
+        m_FlushScheduled = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+void ctkNetworkConnectorSocket::flush() {
+    m_FlushScheduled = false;
+    if(m_Client == NULL || m_Outgoing.isEmpty()) {
+        return;
+    }
+    m_Client->write(m_Outgoing);
+    m_Outgoing.clear();
+}
+
+void ctkNetworkConnectorSocket::clientConnected() {
+    // requests are batched by the connector, do not delay them any further.
+    m_Client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+}
+
+bool ctkNetworkConnectorSocket::readFrame(QTcpSocket *socket, QByteArray &frame) {
+    if(socket->bytesAvailable() < (qint64)sizeof(quint32)) {
+        return false;
+    }
+    quint32 frameSize = 0;
+    QDataStream header(socket->peek(sizeof(quint32)));
+    header.setVersion(QDataStream::Qt_4_6);
+    header >> frameSize;
+    if(frameSize > MAX_FRAME_SIZE) {
+        qWarning("%s", tr("Frame of %1 bytes exceeds the maximum frame size, closing the connection").arg(frameSize).toLatin1().data());
+        socket->abort();
+        return false;
+    }
+    if(socket->bytesAvailable() < (qint64)(sizeof(quint32) + frameSize)) {
+        return false;
+    }
+    socket->read(sizeof(quint32));
+    frame = socket->read(frameSize);
+    return true;
+}
+
+void ctkNetworkConnectorSocket::readReplies() {
+    QByteArray frame;
+    while(readFrame(m_Client, frame)) {
+        QDataStream in(frame);
+        in.setVersion(QDataStream::Qt_4_6);
+        quint8 type = 0;
+        qint32 requestId = 0;
+        QVariant value;
+        in >> type >> requestId >> value;
+        if(type != FRAME_REPLY || in.status() != QDataStream::Ok) {
+            qWarning("%s", tr("Invalid reply received, closing the connection").toLatin1().data());
+            m_Client->abort();
+            failPendingRequests();
+            return;
+        }
+        processReturnValue(requestId, value);
+    }
+    if(m_Client->state() == QAbstractSocket::UnconnectedState) {
+        // the connection has been closed because of an invalid frame.
+        failPendingRequests();
+    }
+}
+
+void ctkNetworkConnectorSocket::processReturnValue( int requestId, QVariant value ) {
+    if(!m_PendingRequests.contains(requestId)) {
+        qWarning("%s", tr("Reply received for unknown request %1").arg(requestId).toLatin1().data());
+        return;
+    }
+    QString event_id = m_PendingRequests.take(requestId);
+    if(value.toString() == "OK") {
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationDone", ctkEventTypeLocal);
+    } else {
+        qDebug("%s", tr("Request %1 (%2) failed: %3").arg(QString::number(requestId), event_id, value.toString()).toLatin1().data());
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationFailed", ctkEventTypeLocal);
+    }
+}
+
+void ctkNetworkConnectorSocket::processFault(QAbstractSocket::SocketError error) {
+    // Log the error.
+    qDebug("%s", tr("Process Fault with error %1 - %2").arg(QString::number(error), m_Client->errorString()).toLatin1().data());
+    failPendingRequests();
+}
+
+void ctkNetworkConnectorSocket::failPendingRequests() {
+    m_Outgoing.clear();
+    int i = 0, size = m_PendingRequests.count();
+    m_PendingRequests.clear();
+    for(;i<size;i++) {
+        ctkEventBusManager::instance()->notifyEvent("ctk/local/eventBus/remoteCommunicationFailed", ctkEventTypeLocal);
+    }
+}
+
+void ctkNetworkConnectorSocket::acceptConnections() {
+    while(m_Server->hasPendingConnections()) {
+        // connections are children of the server and are deleted with it.
+        QTcpSocket *connection = m_Server->nextPendingConnection();
+        connection->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(connection, SIGNAL(readyRead()), this, SLOT(readRequests()));
+        connect(connection, SIGNAL(disconnected()), connection, SLOT(deleteLater()));
+    }
+}
+
+void ctkNetworkConnectorSocket::readRequests() {
+    QTcpSocket *connection = qobject_cast<QTcpSocket *>(sender());
+    if(connection == NULL) {
+        return;
+    }
+
+    QByteArray replies;
+    QByteArray frame;
+    while(readFrame(connection, frame)) {
+        QDataStream in(frame);
+        in.setVersion(QDataStream::Qt_4_6);
+        quint8 type = 0;
+        qint32 requestId = 0;
+        QVariant eventParameters, dataParameters;
+        in >> type >> requestId >> eventParameters >> dataParameters;
+        if(type != FRAME_REQUEST || in.status() != QDataStream::Ok) {
+            qWarning("%s", tr("Invalid request received, closing the connection").toLatin1().data());
+            connection->abort();
+            return;
+        }
+
+        QVariantList reply;
+        reply.append(processRequest(eventParameters.toList(), dataParameters.toList()));
+        appendFrame(replies, FRAME_REPLY, requestId, reply);
+    }
+
+    // answer all the requests read at once with one write.
+    if(!replies.isEmpty()) {
+        connection->write(replies);
+    }
+}
+
+QVariant ctkNetworkConnectorSocket::processRequest(const QVariantList &eventParameters, const QVariantList &dataParameters) {
+    enum {
+      EVENT_ID,
+      EVENT_ITEM_TYPE,
+      EVENT_SIGNATURE_TYPE,
+      EVENT_METHOD_SIGNATURE,
+    };
+
+    if(eventParameters.count() == 0) {
+        return QString("No Command to Execute, command list is empty");
+    }
+
+    //here eventually can be used a filter for events
+
+    //first argument regards local signal to be called.
+    QString id_name = eventParameters.at(EVENT_ID).toString();
+    if(!ctkEventBusManager::instance()->isLocalSignalPresent(id_name)) {
+        return QString("FAIL");
+    }
+
+    ctkEventArgumentsList argList;
+    if(dataParameters.count() != 0) {
+        argList.push_back(Q_ARG(QVariantList, dataParameters));
+    }
+
+    ctkBusEvent dictionary(id_name,ctkEventTypeLocal,0,NULL,"");
+    ctkEventBusManager::instance()->notifyEvent(dictionary, argList.isEmpty() ? NULL : &argList);
+    return QString("OK");
+}
@@ -0,0 +1,124 @@
+/*
+ *  ctkNetworkConnectorSocket.h
+ *  ctkEventBus
+ *
+ *  See Licence at: http://tiny.cc/QXJ4D
+ *
+ */
+
+#ifndef ctkNetworkConnectorSocket_H
+#define ctkNetworkConnectorSocket_H
+
+// include list
+#include "ctkNetworkConnector.h"
+
+#include <QAbstractSocket>
+#include <QHostAddress>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace ctkEventBus {
+
+/**
+ Class name: ctkNetworkConnectorSocket
+ This class is the implementation class for client/server objects that works over network
+ with a binary protocol. Requests and replies are length-prefixed QDataStream frames exchanged
+ over one persistent TCP connection. Requests are pipelined: every request carries an ID which
+ the server echoes in its reply, so the client does not wait for a reply before sending the next
+ request. Requests sent in the same event loop iteration are written with a single socket write,
+ and the server answers all the requests it read at once with a single write.
+ */
+class org_commontk_eventbus_EXPORT ctkNetworkConnectorSocket : public ctkNetworkConnector {
+    Q_OBJECT
+
+public:
+    /// object constructor.
+    ctkNetworkConnectorSocket();
+
+    /// object destructor.
+    /*virtual*/ ~ctkNetworkConnectorSocket();
+
+    /// create the unique instance of the client.
+    /*virtual*/ void createClient(const QString hostName, const unsigned int port);
+
+    /// create the unique instance of the server.
+    /*virtual*/ void createServer(const unsigned int port);
+
+    /// Start the server.
+    /*virtual*/ void startListen();
+
+    /// set the address the server listens on; QHostAddress::Any accepts remote clients.
+    /** Only the local host is accepted by default. The address is used by the next call to startListen(). */
+    void setListenAddress(const QHostAddress &address);
+
+    /// return the address the server listens on.
+    QHostAddress listenAddress() const;
+
+    //retrieve an instance of the object
+    /*virtual*/ ctkNetworkConnector *clone();
+
+    /// register all the signals and slots
+    /*virtual*/ void initializeForEventBus();
+
+public Q_SLOTS:
+    /// Allow to send a network request.
+    /** The first argument contains the event parameters, the optional second one the data parameters; both have to be QVariantList. */
+    /*virtual*/ void send(const QString event_id, ctkEventArgumentsList *argList);
+
+    /// write all the queued requests to the server.
+    void flush();
+
+private Q_SLOTS:
+    /// callback for the client which retrieve the variable from the server
+    virtual void processReturnValue( int requestId, QVariant value );
+
+    /// callback for the client which receives the replies of the server.
+    void readReplies();
+
+    /// callback for the client which manage a fault in the connection.
+    void processFault(QAbstractSocket::SocketError error);
+
+    /// callback for the client called when the connection has been established.
+    void clientConnected();
+
+    /// callback for the server which accepts the new connections.
+    void acceptConnections();
+
+    /// callback for the server which receives the requests of a connection.
+    void readRequests();
+
+protected:
+    QTcpSocket *m_Client; ///< persistent connection to the server
+    QTcpServer *m_Server; ///< server accepting the client connections
+
+private:
+    /// frame types
+    enum {
+      FRAME_REQUEST = 1,
+      FRAME_REPLY = 2
+    };
+
+    /// read a complete frame from the socket, if one has been received.
+    bool readFrame(QTcpSocket *socket, QByteArray &frame);
+
+    /// process a request received by the server, returning the reply value.
+    QVariant processRequest(const QVariantList &eventParameters, const QVariantList &dataParameters);
+
+    /// notify the failure of all the requests waiting for a reply.
+    void failPendingRequests();
+
+    /// stop and destroy the server instance.
+    void stopServer();
+
+    QHostAddress m_ListenAddress; ///< address on which the server listens
+    unsigned int m_Port; ///< port on which the server listens
+    int m_RequestId; ///< ID of the last request sent
+    QHash<int, QString> m_PendingRequests; ///< requests waiting for a reply, by ID
+    QByteArray m_Outgoing; ///< requests not yet written to the client socket
+    bool m_FlushScheduled; ///< flag indicating that a flush has been scheduled
+};
+
+} //namespace ctkEventBus
+
+#endif // ctkNetworkConnectorSocket_H
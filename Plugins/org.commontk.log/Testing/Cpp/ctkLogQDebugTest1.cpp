@@ -0,0 +1,328 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegExp>
+#include <QSemaphore>
+#include <QThread>
+#include <QVector>
+
+// CTK includes
+#include <ctkLogQDebug_p.h>
+#include <ctkLogRingBuffer_p.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+const int PRODUCER_COUNT = 4;
+const int RECORDS_PER_PRODUCER = 2000;
+
+//----------------------------------------------------------------------------
+class RingBufferProducer : public QThread
+{
+public:
+
+  RingBufferProducer(ctkLogRingBuffer* buffer, int producer)
+    : buffer(buffer), producer(producer)
+  {}
+
+protected:
+
+  void run()
+  {
+    for (int i = 0; i < RECORDS_PER_PRODUCER; ++i)
+    {
+      // the producer and its sequence number are passed in the level and line fields
+      ctkLogRecord record;
+      record.level = producer;
+      record.line = i;
+      while (!buffer->tryPush(record))
+      {
+        QThread::yieldCurrentThread();
+      }
+    }
+  }
+
+private:
+
+  ctkLogRingBuffer* const buffer;
+  const int producer;
+};
+
+//----------------------------------------------------------------------------
+class LogProducer : public QThread
+{
+public:
+
+  LogProducer(ctkLogService* logService, int producer)
+    : logService(logService), producer(producer)
+  {}
+
+protected:
+
+  void run()
+  {
+    for (int i = 0; i < RECORDS_PER_PRODUCER; ++i)
+    {
+      logService->log(ctkLogService::LOG_INFO, QString("producer %1 record %2").arg(producer).arg(i));
+    }
+  }
+
+private:
+
+  ctkLogService* const logService;
+  const int producer;
+};
+
+//----------------------------------------------------------------------------
+// The messages written by the writer thread of the log service
+struct CapturedMessages
+{
+  CapturedMessages()
+    : nextRecord(PRODUCER_COUNT, 0), records(0), dropped(0), outOfOrder(0), blockWriter(false)
+  {}
+
+  QMutex mutex;
+  // the next expected record number of each producer
+  QVector<int> nextRecord;
+  int records;
+  int dropped;
+  int outOfOrder;
+
+  // if set, the writer thread blocks on the first message until the gate is opened
+  bool blockWriter;
+  QSemaphore gate;
+};
+
+CapturedMessages* captured = 0;
+
+//----------------------------------------------------------------------------
+void captureMessage(const QString& msg)
+{
+  static QRegExp recordRegExp(" - producer (\\d+) record (\\d+)$");
+  static QRegExp droppedRegExp(" - (\\d+) log messages dropped");
+
+  bool block = false;
+  {
+    QMutexLocker lock(&captured->mutex);
+    if (recordRegExp.indexIn(msg) >= 0)
+    {
+      int producer = recordRegExp.cap(1).toInt();
+      int record = recordRegExp.cap(2).toInt();
+      // records may be dropped, but the remaining ones keep their order
+      if (record < captured->nextRecord[producer])
+      {
+        ++captured->outOfOrder;
+      }
+      captured->nextRecord[producer] = record + 1;
+      ++captured->records;
+      block = captured->blockWriter;
+      captured->blockWriter = false;
+    }
+    else if (droppedRegExp.indexIn(msg) >= 0)
+    {
+      captured->dropped += droppedRegExp.cap(1).toInt();
+    }
+  }
+
+  if (block)
+  {
+    captured->gate.acquire();
+  }
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+{
+  Q_UNUSED(type)
+  Q_UNUSED(context)
+  captureMessage(msg);
+}
+#else
+void messageHandler(QtMsgType type, const char* msg)
+{
+  Q_UNUSED(type)
+  captureMessage(QString::fromLocal8Bit(msg));
+}
+#endif
+
+//----------------------------------------------------------------------------
+void installMessageHandler(bool install)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+  qInstallMessageHandler(install ? messageHandler : 0);
+#else
+  qInstallMsgHandler(install ? messageHandler : 0);
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Logs from several threads and waits until the log service has written
+// all queued records.
+void logConcurrently(ctkLogQDebug* logService)
+{
+  QList<LogProducer*> producers;
+  for (int p = 0; p < PRODUCER_COUNT; ++p)
+  {
+    producers.push_back(new LogProducer(logService, p));
+    producers.back()->start();
+  }
+  foreach(LogProducer* producer, producers)
+  {
+    producer->wait();
+  }
+  qDeleteAll(producers);
+}
+
+//----------------------------------------------------------------------------
+bool testRingBuffer()
+{
+  ctkLogRingBuffer buffer(16);
+
+  QList<RingBufferProducer*> producers;
+  for (int p = 0; p < PRODUCER_COUNT; ++p)
+  {
+    producers.push_back(new RingBufferProducer(&buffer, p));
+    producers.back()->start();
+  }
+
+  // a single consumer takes out all records, each producer's in order
+  QVector<int> nextRecord(PRODUCER_COUNT, 0);
+  int count = 0;
+  bool ok = true;
+  while (count < PRODUCER_COUNT * RECORDS_PER_PRODUCER)
+  {
+    ctkLogRecord record;
+    if (!buffer.tryPop(record))
+    {
+      QThread::yieldCurrentThread();
+      continue;
+    }
+    if (record.level < 0 || record.level >= PRODUCER_COUNT || record.line != nextRecord[record.level])
+    {
+      ok = false;
+    }
+    else
+    {
+      ++nextRecord[record.level];
+    }
+    ++count;
+  }
+
+  foreach(RingBufferProducer* producer, producers)
+  {
+    producer->wait();
+  }
+  qDeleteAll(producers);
+
+  ctkLogRecord record;
+  if (!ok || buffer.tryPop(record) || !buffer.isEmpty())
+  {
+    std::cerr << "Line " << __LINE__ << " - Records of the ring buffer lost or out of order" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool testBlockOnOverflow()
+{
+  CapturedMessages messages;
+  captured = &messages;
+  installMessageHandler(true);
+
+  // the destructor writes all remaining records
+  ctkLogQDebug* logService = new ctkLogQDebug(16, ctkLogQDebug::BlockOnOverflow);
+  logConcurrently(logService);
+  delete logService;
+
+  installMessageHandler(false);
+  captured = 0;
+
+  if (messages.records != PRODUCER_COUNT * RECORDS_PER_PRODUCER || messages.dropped != 0)
+  {
+    std::cerr << "Line " << __LINE__ << " - Records lost when blocking on overflow: "
+              << messages.records << " written, " << messages.dropped << " dropped" << std::endl;
+    return false;
+  }
+  if (messages.outOfOrder != 0)
+  {
+    std::cerr << "Line " << __LINE__ << " - Records out of order when blocking on overflow" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool testDropOnOverflow()
+{
+  CapturedMessages messages;
+  // keep the writer busy with the first record, so the buffer fills up
+  messages.blockWriter = true;
+  captured = &messages;
+  installMessageHandler(true);
+
+  ctkLogQDebug* logService = new ctkLogQDebug(16, ctkLogQDebug::DropOnOverflow);
+  logConcurrently(logService);
+  messages.gate.release();
+  delete logService;
+
+  installMessageHandler(false);
+  captured = 0;
+
+  if (messages.dropped == 0)
+  {
+    std::cerr << "Line " << __LINE__ << " - No records dropped on overflow" << std::endl;
+    return false;
+  }
+  if (messages.records + messages.dropped != PRODUCER_COUNT * RECORDS_PER_PRODUCER)
+  {
+    std::cerr << "Line " << __LINE__ << " - Dropped records not counted: "
+              << messages.records << " written, " << messages.dropped << " dropped" << std::endl;
+    return false;
+  }
+  if (messages.outOfOrder != 0)
+  {
+    std::cerr << "Line " << __LINE__ << " - Records out of order when dropping on overflow" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+//----------------------------------------------------------------------------
+int ctkLogQDebugTest1(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  if (!testRingBuffer() || !testBlockOnOverflow() || !testDropOnOverflow())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
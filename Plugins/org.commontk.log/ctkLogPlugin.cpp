@@ -24,8 +24,14 @@
 
 #include "ctkLogQDebug_p.h"
 
+#include <ctkPluginContext.h>
+
 #include <QtPlugin>
 #include <QStringList>
+#include <QDebug>
+
+const QString ctkLogPlugin::PROP_BUFFER_SIZE = "org.commontk.log.BufferSize";
+const QString ctkLogPlugin::PROP_OVERFLOW_POLICY = "org.commontk.log.OverflowPolicy";
 
 ctkLogPlugin::ctkLogPlugin()
   : logService(0)
@@ -35,7 +41,40 @@ ctkLogPlugin::ctkLogPlugin()
 
 void ctkLogPlugin::start(ctkPluginContext* context)
 {
-  logService = new ctkLogQDebug();
+  int bufferSize = 4096;
+  QVariant value = context->getProperty(PROP_BUFFER_SIZE);
+  if (value.isValid())
+  {
+    bool ok = false;
+    int size = value.toInt(&ok);
+    if (ok && size > 0 && size <= ctkLogRingBuffer::MAX_CAPACITY)
+    {
+      bufferSize = size;
+    }
+    else
+    {
+      qWarning() << "Invalid value for" << PROP_BUFFER_SIZE << ":" << value.toString()
+                 << "- Using default:" << bufferSize;
+    }
+  }
+
+  ctkLogQDebug::OverflowPolicy policy = ctkLogQDebug::BlockOnOverflow;
+  value = context->getProperty(PROP_OVERFLOW_POLICY);
+  if (value.isValid())
+  {
+    QString policyName = value.toString().toLower();
+    if (policyName == "drop")
+    {
+      policy = ctkLogQDebug::DropOnOverflow;
+    }
+    else if (policyName != "block")
+    {
+      qWarning() << "Invalid value for" << PROP_OVERFLOW_POLICY << ":" << value.toString()
+                 << "- Using default: block";
+    }
+  }
+
+  logService = new ctkLogQDebug(bufferSize, policy);
   context->registerService(QStringList("ctkLogService"), logService);
 }
 
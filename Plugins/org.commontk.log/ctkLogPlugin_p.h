@@ -38,6 +38,18 @@ class ctkLogPlugin :
 
 public:
 
+  /**
+   * The number of log records which can be queued for the writer thread
+   * (default 4096).
+   */
+  static const QString PROP_BUFFER_SIZE;
+
+  /**
+   * What to do with a log record if the queue is full: "block" waits for
+   * the writer thread (default), "drop" discards the record.
+   */
+  static const QString PROP_OVERFLOW_POLICY;
+
   ctkLogPlugin();
 
   void start(ctkPluginContext* context);
@@ -25,92 +25,244 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QStringList>
+#include <QThread>
 
 #include <ctkPluginConstants.h>
 
-ctkLogQDebug::ctkLogQDebug()
-  : logLevel(ctkLogService::LOG_DEBUG)
+// for ctk::msecsTo() - remove after switching to Qt 4.7
+#include <ctkUtils.h>
+
+namespace {
+
+// The maximum number of records taken out of the ring buffer at once
+const int BATCH_SIZE = 256;
+
+qint64 now()
 {
+  return ctk::msecsTo(QDateTime::fromTime_t(0), QDateTime::currentDateTime());
 }
 
-void ctkLogQDebug::log(int level, const QString& message, const std::exception* exception,
-                       const char* file, const char* function, int line)
+}
+
+class ctkLogWriterThread : public QThread
 {
-  Q_UNUSED(function)
+public:
 
-  QString s = QDateTime::currentDateTime().toString(Qt::ISODate)
-      .append(" - ").append(message);
+  ctkLogWriterThread(ctkLogQDebug* logService)
+    : logService(logService)
+  {}
 
-  if (exception != 0)
-  {
-    s.append(" (").append(exception->what()).append(")");
-  }
+protected:
 
-  if (file)
+  void run()
   {
-    s.append(" [at ").append(file).append(":").append(QString::number(line)).append("]");
+    logService->writeRecords();
   }
 
-  if (level == ctkLogService::LOG_WARNING)
-  {
-    qWarning() << s;
-  }
-  else if (level == ctkLogService::LOG_ERROR)
+private:
+
+  ctkLogQDebug* const logService;
+};
+
+//----------------------------------------------------------------------------
+ctkLogQDebug::ctkLogQDebug(int bufferSize, OverflowPolicy policy)
+  : logLevel(ctkLogService::LOG_DEBUG), policy(policy), buffer(bufferSize),
+    writer(new ctkLogWriterThread(this)), lastSecond(-1)
+{
+  writer->start(QThread::LowPriority);
+}
+
+//----------------------------------------------------------------------------
+ctkLogQDebug::~ctkLogQDebug()
+{
+  stopping.fetchAndStoreOrdered(1);
   {
-    qCritical() << s;
+    QMutexLocker lock(&mutex);
+    recordsAvailable.wakeAll();
   }
-  else
+  // The writer thread writes all remaining records before it terminates
+  writer->wait();
+  delete writer;
+}
+
+//----------------------------------------------------------------------------
+void ctkLogQDebug::log(int level, const QString& message, const std::exception* exception,
+                       const char* file, const char* function, int line)
+{
+  ctkLogRecord record;
+  record.level = level;
+  record.time = now();
+  record.file = file;
+  record.function = function;
+  record.line = line;
+  record.message = message;
+  if (exception != 0)
   {
-    qDebug() << s;
+    record.exception = exception->what();
   }
+  append(record);
 }
 
+//----------------------------------------------------------------------------
 void ctkLogQDebug::log(const ctkServiceReference& sr, int level, const QString& message,
                        const std::exception* exception,
                        const char* file, const char* function, int line)
 {
-  Q_UNUSED(function)
+  ctkLogRecord record;
+  record.level = level;
+  record.time = now();
+  record.file = file;
+  record.function = function;
+  record.line = line;
+  record.message = message;
+  if (exception != 0)
+  {
+    record.exception = exception->what();
+  }
+  // The service properties are looked up by the writer thread
+  record.serviceRef = new ctkServiceReference(sr);
+  append(record);
+}
 
-  QString s = QDateTime::currentDateTime().toString(Qt::ISODate)
-      .append(" - [");
+//----------------------------------------------------------------------------
+int ctkLogQDebug::getLogLevel() const
+{
+  return logLevel;
+}
 
-  s.append(sr.getProperty(ctkPluginConstants::SERVICE_ID).toString());
-  s.append(";");
-  QStringList clazzes = sr.getProperty(ctkPluginConstants::OBJECTCLASS).toStringList();
-  int i = 0;
-  foreach (QString clazz, clazzes)
+//----------------------------------------------------------------------------
+void ctkLogQDebug::append(const ctkLogRecord& record)
+{
+  if (!buffer.tryPush(record))
   {
-    if (i > 0) s.append(",");
-    s.append(clazz);
+    if (policy == DropOnOverflow)
+    {
+      delete record.serviceRef;
+      dropped.ref();
+      return;
+    }
+
+    blockedProducers.ref();
+    {
+      QMutexLocker lock(&mutex);
+      while (!buffer.tryPush(record))
+      {
+        recordsAvailable.wakeOne();
+        spaceAvailable.wait(&mutex);
+      }
+    }
+    blockedProducers.deref();
   }
+  wakeWriter();
+}
 
-  s.append(message);
+//----------------------------------------------------------------------------
+void ctkLogQDebug::wakeWriter()
+{
+  // Only the producer which finds the writer sleeping pays for the mutex
+  if (writerSleeping.testAndSetOrdered(1, 0))
+  {
+    QMutexLocker lock(&mutex);
+    recordsAvailable.wakeOne();
+  }
+}
 
-  if(exception != 0)
+//----------------------------------------------------------------------------
+void ctkLogQDebug::writeRecords()
+{
+  ctkLogRecord batch[BATCH_SIZE];
+  forever
   {
-    s.append(" (").append(exception->what()).append(")");
+    int count = 0;
+    while (count < BATCH_SIZE && buffer.tryPop(batch[count]))
+    {
+      ++count;
+    }
+
+    if (count > 0 && blockedProducers.fetchAndAddOrdered(0) > 0)
+    {
+      QMutexLocker lock(&mutex);
+      spaceAvailable.wakeAll();
+    }
+
+    int droppedCount = dropped.fetchAndStoreRelaxed(0);
+    if (droppedCount > 0)
+    {
+      qWarning("%s - %d log messages dropped, the log buffer was full",
+               qPrintable(QDateTime::currentDateTime().toString(Qt::ISODate)), droppedCount);
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+      const ctkLogRecord& record = batch[i];
+      QByteArray s = format(record);
+      if (record.level == ctkLogService::LOG_WARNING)
+      {
+        qWarning("%s", s.constData());
+      }
+      else if (record.level == ctkLogService::LOG_ERROR)
+      {
+        qCritical("%s", s.constData());
+      }
+      else
+      {
+        qDebug("%s", s.constData());
+      }
+      delete record.serviceRef;
+      batch[i] = ctkLogRecord();
+    }
+
+    if (count == 0)
+    {
+      QMutexLocker lock(&mutex);
+      writerSleeping.fetchAndStoreOrdered(1);
+      if (buffer.isEmpty())
+      {
+        if (stopping.fetchAndAddOrdered(0))
+        {
+          return;
+        }
+        recordsAvailable.wait(&mutex);
+      }
+      writerSleeping.fetchAndStoreOrdered(0);
+    }
   }
+}
 
-  if (file)
+//----------------------------------------------------------------------------
+QByteArray ctkLogQDebug::format(const ctkLogRecord& record)
+{
+  // Consecutive records are mostly logged within the same second
+  qint64 second = record.time / 1000;
+  if (second != lastSecond)
   {
-    s.append(" [at ").append(file).append(":").append(QString::number(line)).append("]");
+    lastSecond = second;
+    lastTimestamp = QDateTime::fromTime_t(static_cast<uint>(second)).toString(Qt::ISODate);
   }
 
-  if (level == ctkLogService::LOG_WARNING)
+  QString s = lastTimestamp;
+  s.append(" - ");
+
+  if (record.serviceRef)
   {
-    qWarning() << s;
+    s.append("[");
+    s.append(record.serviceRef->getProperty(ctkPluginConstants::SERVICE_ID).toString());
+    s.append(";");
+    s.append(record.serviceRef->getProperty(ctkPluginConstants::OBJECTCLASS).toStringList().join(","));
+    s.append("] ");
   }
-  else if (level == ctkLogService::LOG_ERROR)
+
+  s.append(record.message);
+
+  if (!record.exception.isEmpty())
   {
-    qCritical() << s;
+    s.append(" (").append(record.exception).append(")");
   }
-  else
+
+  if (record.file)
   {
-    qDebug() << s;
+    s.append(" [at ").append(record.file).append(":").append(QString::number(record.line)).append("]");
   }
-}
 
-int ctkLogQDebug::getLogLevel() const
-{
-  return logLevel;
+  return s.toLocal8Bit();
 }
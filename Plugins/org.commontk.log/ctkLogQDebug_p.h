@@ -25,9 +25,29 @@
 
 #include <service/log/ctkLogService.h>
 
-#include <QObject>
+#include "ctkLogRingBuffer_p.h"
+
+#include <org_commontk_log_Export.h>
 
-class ctkLogQDebug : public QObject, public ctkLogService
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+
+class ctkLogWriterThread;
+
+/**
+ * A log service writing to the Qt message handlers.
+ *
+ * Logging only queues a compact record in a ring buffer. A writer thread
+ * takes the records out in batches, formats them and hands them to
+ * qDebug(), qWarning() or qCritical(), depending on the log level.
+ *
+ * If the writer thread does not keep up, the ring buffer fills up. The
+ * overflow policy decides whether callers then wait for free space or
+ * drop their record. Dropped records are counted and reported by the
+ * writer thread.
+ */
+class org_commontk_log_EXPORT ctkLogQDebug : public QObject, public ctkLogService
 {
 
   Q_OBJECT
@@ -35,7 +55,14 @@ class ctkLogQDebug : public QObject, public ctkLogService
 
 public:
 
-  ctkLogQDebug();
+  enum OverflowPolicy
+  {
+    BlockOnOverflow,
+    DropOnOverflow
+  };
+
+  ctkLogQDebug(int bufferSize = 4096, OverflowPolicy policy = BlockOnOverflow);
+  ~ctkLogQDebug();
 
   void log(int level, const QString& message, const std::exception* exception = 0,
            const char* file = 0, const char* function = 0, int line = -1);
@@ -46,7 +73,34 @@ public:
 
 private:
 
+  friend class ctkLogWriterThread;
+
+  void append(const ctkLogRecord& record);
+  void wakeWriter();
+
+  // The loop of the writer thread
+  void writeRecords();
+  QByteArray format(const ctkLogRecord& record);
+
   int logLevel;
+  const OverflowPolicy policy;
+
+  ctkLogRingBuffer buffer;
+
+  QAtomicInt dropped;
+  QAtomicInt blockedProducers;
+  QAtomicInt writerSleeping;
+  QAtomicInt stopping;
+
+  QMutex mutex;
+  QWaitCondition recordsAvailable;
+  QWaitCondition spaceAvailable;
+
+  ctkLogWriterThread* writer;
+
+  // Only used by the writer thread
+  qint64 lastSecond;
+  QString lastTimestamp;
 };
 
 #endif // CTKLOGQDEBUG_P_H
@@ -0,0 +1,141 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkLogRingBuffer_p.h"
+
+#include <ctkServiceReference.h>
+
+namespace {
+
+int roundUpToPowerOfTwo(int value)
+{
+  int result = 1;
+  while (result < value)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+
+// Positions wrap around; compare them with unsigned arithmetic
+inline int positionAdd(int pos, int n)
+{
+  return static_cast<int>(static_cast<uint>(pos) + static_cast<uint>(n));
+}
+
+inline int positionDiff(int a, int b)
+{
+  return static_cast<int>(static_cast<uint>(a) - static_cast<uint>(b));
+}
+
+}
+
+const int ctkLogRingBuffer::MAX_CAPACITY = 1 << 20;
+
+//----------------------------------------------------------------------------
+ctkLogRecord::ctkLogRecord()
+  : level(0), time(0), file(0), function(0), line(-1), serviceRef(0)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkLogRingBuffer::ctkLogRingBuffer(int capacity)
+  : mask(roundUpToPowerOfTwo(qBound(2, capacity, MAX_CAPACITY)) - 1),
+    slots(new Slot[mask + 1]), readPos(0)
+{
+  for (int i = 0; i <= mask; ++i)
+  {
+    slots[i].sequence.fetchAndStoreRelaxed(i);
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkLogRingBuffer::~ctkLogRingBuffer()
+{
+  ctkLogRecord record;
+  while (tryPop(record))
+  {
+    delete record.serviceRef;
+  }
+  delete[] slots;
+}
+
+//----------------------------------------------------------------------------
+int ctkLogRingBuffer::capacity() const
+{
+  return mask + 1;
+}
+
+//----------------------------------------------------------------------------
+bool ctkLogRingBuffer::tryPush(const ctkLogRecord& record)
+{
+  int pos = writePos.fetchAndAddRelaxed(0);
+  forever
+  {
+    Slot& slot = slots[pos & mask];
+    int diff = positionDiff(slot.sequence.fetchAndAddAcquire(0), pos);
+    if (diff == 0)
+    {
+      // The slot is free for this position, try to claim it
+      if (writePos.testAndSetRelaxed(pos, positionAdd(pos, 1)))
+      {
+        slot.record = record;
+        slot.sequence.fetchAndStoreOrdered(positionAdd(pos, 1));
+        return true;
+      }
+      pos = writePos.fetchAndAddRelaxed(0);
+    }
+    else if (diff < 0)
+    {
+      // The slot still holds the record from one lap ago
+      return false;
+    }
+    else
+    {
+      // Another producer claimed the position first
+      pos = writePos.fetchAndAddRelaxed(0);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ctkLogRingBuffer::tryPop(ctkLogRecord& record)
+{
+  Slot& slot = slots[readPos & mask];
+  if (slot.sequence.fetchAndAddAcquire(0) != positionAdd(readPos, 1))
+  {
+    return false;
+  }
+
+  record = slot.record;
+  slot.record = ctkLogRecord();
+  // Hand the slot over to the producers of the next lap
+  slot.sequence.fetchAndStoreRelease(positionAdd(readPos, capacity()));
+  readPos = positionAdd(readPos, 1);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkLogRingBuffer::isEmpty() const
+{
+  return slots[readPos & mask].sequence.fetchAndAddOrdered(0) != positionAdd(readPos, 1);
+}
@@ -0,0 +1,135 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKLOGRINGBUFFER_P_H
+#define CTKLOGRINGBUFFER_P_H
+
+#include <QAtomicInt>
+#include <QString>
+
+#include <org_commontk_log_Export.h>
+
+class ctkServiceReference;
+
+/**
+ * A log record as queued by the callers of the log service. It only
+ * holds what the caller has at hand; all the formatting is left to the
+ * writer thread.
+ */
+struct org_commontk_log_EXPORT ctkLogRecord
+{
+  ctkLogRecord();
+
+  int level;
+  // milliseconds since the epoch
+  qint64 time;
+
+  // Both point to string literals (__FILE__ and __FUNCTION__), which live as
+  // long as the plug-in library they come from. Plug-in libraries are
+  // never unloaded by the framework.
+  const char* file;
+  const char* function;
+  int line;
+
+  QString message;
+  // the what() of the logged exception, if any
+  QString exception;
+
+  // Null if the record was not logged for a service. Allocated by the
+  // producer; deleted by the writer thread or, if the record is dropped,
+  // by the producer.
+  ctkServiceReference* serviceRef;
+};
+
+/**
+ * A bounded lock-free ring buffer for multiple producers and a single
+ * consumer.
+ *
+ * Each slot carries a sequence number telling whether it may be written
+ * or read for a given position. Producers claim a position by advancing
+ * the write position with a compare-and-swap, copy their record into the
+ * slot and publish it by updating the slot's sequence number. Hence
+ * <tt>tryPush()</tt> never blocks; it fails if the buffer is full.
+ */
+class org_commontk_log_EXPORT ctkLogRingBuffer
+{
+
+public:
+
+  /** The largest number of records a buffer can hold. */
+  static const int MAX_CAPACITY; // = 1 << 20
+
+  /**
+   * @param capacity The number of records the buffer can hold. Rounded up
+   *        to the next power of two and limited to MAX_CAPACITY.
+   */
+  explicit ctkLogRingBuffer(int capacity);
+
+  ~ctkLogRingBuffer();
+
+  int capacity() const;
+
+  /**
+   * Appends the record to the buffer. May be called from any thread.
+   *
+   * @return <code>false</code> if the buffer is full
+   */
+  bool tryPush(const ctkLogRecord& record);
+
+  /**
+   * Removes the oldest record from the buffer. Must only be called from
+   * one thread at a time.
+   *
+   * @param record Receives the removed record
+   * @return <code>false</code> if the buffer is empty
+   */
+  bool tryPop(ctkLogRecord& record);
+
+  /**
+   * Checks whether a record is available for <tt>tryPop()</tt>. Must only
+   * be called from the consuming thread. Implies a full memory barrier.
+   */
+  bool isEmpty() const;
+
+private:
+
+  struct Slot
+  {
+    // The position for which the slot may be written next, or the
+    // position plus one once the record for it has been published
+    QAtomicInt sequence;
+    ctkLogRecord record;
+  };
+
+  const int mask;
+  Slot* const slots;
+
+  // The next position to be claimed by a producer
+  QAtomicInt writePos;
+
+  // The next position to be read, only used by the consumer
+  int readPos;
+
+  Q_DISABLE_COPY(ctkLogRingBuffer)
+};
+
+#endif // CTKLOGRINGBUFFER_P_H
@@ -40,6 +40,8 @@ class ctkAttributeDefinitionImpl : public ctkAttributeDefinition
 
 private:
 
+  friend class ctkMTCache;
+
   static const QChar SEPARATE;
   static const QChar CONTROL;
 
@@ -0,0 +1,280 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkMTCache_p.h"
+
+#include "ctkAttributeDefinitionImpl_p.h"
+
+#include <ctkPlugin.h>
+#include <service/log/ctkLogService.h>
+
+// for ctk::msecsTo() - remove after switching to Qt 4.7
+#include <ctkUtils.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QUrl>
+
+namespace {
+
+// "CTKM" in ASCII
+const quint32 CACHE_MAGIC = 0x43544b4d;
+// Increase the version whenever the cache layout changes
+const quint32 CACHE_VERSION = 1;
+
+typedef QHash<QString, ctkObjectClassDefinitionImplPtr> OCDHash;
+
+void writePidHash(QDataStream& out, const OCDHash& ocds,
+                  const QHash<ctkObjectClassDefinitionImpl*, int>& indexes)
+{
+  out << static_cast<quint32>(ocds.size());
+  for (OCDHash::ConstIterator it = ocds.begin(); it != ocds.end(); ++it)
+  {
+    out << it.key() << static_cast<qint32>(indexes.value(it.value().data()));
+  }
+}
+
+bool readPidHash(QDataStream& in, OCDHash& ocds, const QList<ctkObjectClassDefinitionImplPtr>& ocdList)
+{
+  quint32 count = 0;
+  in >> count;
+  for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i)
+  {
+    QString pid;
+    qint32 index = -1;
+    in >> pid >> index;
+    if (index < 0 || index >= ocdList.size())
+    {
+      return false;
+    }
+    ocds.insert(pid, ocdList[index]);
+  }
+  return in.status() == QDataStream::Ok;
+}
+
+}
+
+ctkMTCache::ctkMTCache(const QDir& cacheDir, ctkLogService* logger)
+  : cacheDir(cacheDir), logger(logger)
+{
+}
+
+bool ctkMTCache::read(const QSharedPointer<ctkPlugin>& plugin,
+                      QHash<QString, ctkObjectClassDefinitionImplPtr>& pidOCDs,
+                      QHash<QString, ctkObjectClassDefinitionImplPtr>& factoryPidOCDs) const
+{
+  QFile file(getCacheFilePath(plugin->getPluginId()));
+  if (!file.open(QIODevice::ReadOnly) || file.size() == 0) return false;
+
+  uchar* data = file.map(0, file.size());
+  QByteArray buffer = data ? QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size())
+                           : file.readAll();
+
+  bool valid = false;
+  {
+    QDataStream in(buffer);
+    in.setVersion(QDataStream::Qt_4_6);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString stamp;
+    quint32 ocdCount = 0;
+    in >> magic >> version;
+    if (magic == CACHE_MAGIC && version == CACHE_VERSION)
+    {
+      in >> stamp >> ocdCount;
+      valid = in.status() == QDataStream::Ok && stamp == getPluginStamp(plugin);
+    }
+
+    QList<ctkObjectClassDefinitionImplPtr> ocdList;
+    for (quint32 i = 0; valid && i < ocdCount; ++i)
+    {
+      QString name, id, description, localization, context, iconName;
+      qint32 type = 0;
+      qint32 iconSize = -1;
+      bool hasIcon = false;
+      in >> name >> id >> description >> localization >> context >> type
+         >> hasIcon >> iconName >> iconSize;
+
+      ctkObjectClassDefinitionImplPtr ocd(new ctkObjectClassDefinitionImpl(
+                                            name, description, id, localization, context, type));
+      if (hasIcon)
+      {
+        ocd->setIcon(ctkMTIcon(iconName, iconSize, plugin));
+      }
+
+      readAttributeDefinitions(in, ocd, true);
+      readAttributeDefinitions(in, ocd, false);
+
+      valid = in.status() == QDataStream::Ok;
+      ocdList.push_back(ocd);
+    }
+
+    valid = valid && readPidHash(in, pidOCDs, ocdList) && readPidHash(in, factoryPidOCDs, ocdList);
+  }
+
+  // QByteArray::fromRawData does not copy, so release the buffer
+  // before unmapping the file.
+  buffer.clear();
+  if (data) file.unmap(data);
+
+  if (!valid)
+  {
+    pidOCDs.clear();
+    factoryPidOCDs.clear();
+  }
+  return valid;
+}
+
+void ctkMTCache::write(const QSharedPointer<ctkPlugin>& plugin,
+                       const QHash<QString, ctkObjectClassDefinitionImplPtr>& pidOCDs,
+                       const QHash<QString, ctkObjectClassDefinitionImplPtr>& factoryPidOCDs) const
+{
+  if (!cacheDir.exists() && !cacheDir.mkpath(cacheDir.absolutePath()))
+  {
+    return;
+  }
+
+  // Object class definitions may be designated by more than one pid,
+  // so write each of them only once.
+  QList<ctkObjectClassDefinitionImplPtr> ocdList = pidOCDs.values() + factoryPidOCDs.values();
+  QHash<ctkObjectClassDefinitionImpl*, int> indexes;
+  for (int i = 0; i < ocdList.size(); )
+  {
+    if (indexes.contains(ocdList[i].data()))
+    {
+      ocdList.removeAt(i);
+    }
+    else
+    {
+      indexes.insert(ocdList[i].data(), i++);
+    }
+  }
+
+  const QString cacheFilePath = getCacheFilePath(plugin->getPluginId());
+  const QString tmpPath = cacheFilePath + ".tmp";
+  QFile file(tmpPath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    CTK_WARN(logger) << "Could not write metatype cache " << tmpPath << ": " << file.errorString();
+    return;
+  }
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << CACHE_MAGIC << CACHE_VERSION << getPluginStamp(plugin)
+      << static_cast<quint32>(ocdList.size());
+
+  foreach (ctkObjectClassDefinitionImplPtr ocd, ocdList)
+  {
+    out << ocd->_name << ocd->_id << ocd->_description
+        << ocd->_locElem.getLocalizationBase() << ocd->_locElem.getContext()
+        << static_cast<qint32>(ocd->_type) << static_cast<bool>(ocd->_icon)
+        << ocd->_icon.getIconName() << static_cast<qint32>(ocd->_icon.getIconSize());
+
+    writeAttributeDefinitions(out, ocd->_required);
+    writeAttributeDefinitions(out, ocd->_optional);
+  }
+
+  writePidHash(out, pidOCDs, indexes);
+  writePidHash(out, factoryPidOCDs, indexes);
+
+  file.close();
+  if (out.status() != QDataStream::Ok || file.error() != QFile::NoError)
+  {
+    QFile::remove(tmpPath);
+    return;
+  }
+
+  QFile::remove(cacheFilePath);
+  if (!QFile::rename(tmpPath, cacheFilePath))
+  {
+    QFile::remove(tmpPath);
+  }
+}
+
+void ctkMTCache::readAttributeDefinitions(QDataStream& in, const ctkObjectClassDefinitionImplPtr& ocd,
+                                          bool required) const
+{
+  quint32 count = 0;
+  in >> count;
+  for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i)
+  {
+    QString id, name, description, localization, context;
+    qint32 cardinality = 0;
+    qint32 dataType = 0;
+    QVariant minValue, maxValue;
+    bool isRequired = false;
+    in >> id >> name >> description >> cardinality >> dataType
+       >> minValue >> maxValue >> isRequired >> localization >> context;
+
+    ctkAttributeDefinitionImplPtr ad(new ctkAttributeDefinitionImpl(
+                                       id, name, description, dataType, cardinality,
+                                       minValue, maxValue, isRequired,
+                                       localization, context, logger));
+    // the values were validated when the metatype document was parsed
+    in >> ad->_defaults >> ad->_values >> ad->_labels;
+    ocd->addAttributeDefinition(ad, required);
+  }
+}
+
+void ctkMTCache::writeAttributeDefinitions(QDataStream& out, const QList<ctkAttributeDefinitionImplPtr>& ads)
+{
+  out << static_cast<quint32>(ads.size());
+  foreach (ctkAttributeDefinitionImplPtr ad, ads)
+  {
+    out << ad->_id << ad->_name << ad->_description
+        << static_cast<qint32>(ad->_cardinality) << static_cast<qint32>(ad->_dataType)
+        << ad->_minValue << ad->_maxValue << ad->_isRequired
+        << ad->_locElem.getLocalizationBase() << ad->_locElem.getContext()
+        << ad->_defaults << ad->_values << ad->_labels;
+  }
+}
+
+void ctkMTCache::remove(long pluginId) const
+{
+  QFile::remove(getCacheFilePath(pluginId));
+}
+
+QString ctkMTCache::getCacheFilePath(long pluginId) const
+{
+  return cacheDir.filePath(QString::number(pluginId) + ".mtc");
+}
+
+QString ctkMTCache::getPluginStamp(const QSharedPointer<ctkPlugin>& plugin)
+{
+  QString stamp = QString::number(plugin->getPluginId()) + '|' + plugin->getLocation()
+      + '|' + plugin->getVersion().toString()
+      + '|' + QString::number(ctk::msecsTo(QDateTime::fromTime_t(0), plugin->getLastModified()));
+
+  // Plugins may be rebuilt in place during development
+  QString localPath = QUrl(plugin->getLocation()).toLocalFile();
+  if (localPath.isEmpty()) localPath = plugin->getLocation();
+  QFileInfo libInfo(localPath);
+  if (libInfo.exists())
+  {
+    stamp += '|' + QString::number(ctk::msecsTo(QDateTime::fromTime_t(0), libInfo.lastModified()));
+  }
+  return stamp;
+}
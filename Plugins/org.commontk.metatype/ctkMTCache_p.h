@@ -0,0 +1,91 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKMTCACHE_P_H
+#define CTKMTCACHE_P_H
+
+#include "ctkObjectClassDefinitionImpl_p.h"
+
+#include <QDir>
+#include <QHash>
+
+class QDataStream;
+struct ctkLogService;
+
+/**
+ * Persists the object class definitions parsed from a plugin's metatype
+ * documents in a compact binary form, one file per plugin.
+ *
+ * A cache file is only used if it was written for the same plugin
+ * generation, that is the same plugin id, location, version and last
+ * modified time, and if the plugin library has not been modified since.
+ * Otherwise the metatype documents are parsed again and the cache file
+ * is rewritten.
+ */
+class ctkMTCache
+{
+
+public:
+
+  ctkMTCache(const QDir& cacheDir, ctkLogService* logger);
+
+  /**
+   * Reads the cached object class definitions of the plugin.
+   *
+   * @return <code>false</code> if there is no valid cache file for the
+   *         current generation of the plugin.
+   */
+  bool read(const QSharedPointer<ctkPlugin>& plugin,
+            QHash<QString, ctkObjectClassDefinitionImplPtr>& pidOCDs,
+            QHash<QString, ctkObjectClassDefinitionImplPtr>& factoryPidOCDs) const;
+
+  /**
+   * Writes the object class definitions of the plugin. Empty hashes are
+   * cached as well, so plugins without metatype documents are not
+   * searched again.
+   */
+  void write(const QSharedPointer<ctkPlugin>& plugin,
+             const QHash<QString, ctkObjectClassDefinitionImplPtr>& pidOCDs,
+             const QHash<QString, ctkObjectClassDefinitionImplPtr>& factoryPidOCDs) const;
+
+  /**
+   * Removes the cache file of an uninstalled plugin.
+   */
+  void remove(long pluginId) const;
+
+private:
+
+  QDir cacheDir;
+  ctkLogService* const logger;
+
+  QString getCacheFilePath(long pluginId) const;
+
+  void readAttributeDefinitions(QDataStream& in, const ctkObjectClassDefinitionImplPtr& ocd,
+                                bool required) const;
+  static void writeAttributeDefinitions(QDataStream& out,
+                                        const QList<QSharedPointer<ctkAttributeDefinitionImpl> >& ads);
+
+  static QString getPluginStamp(const QSharedPointer<ctkPlugin>& plugin);
+
+};
+
+#endif // CTKMTCACHE_P_H
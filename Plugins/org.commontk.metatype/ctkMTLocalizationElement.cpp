@@ -56,3 +56,8 @@ QString ctkMTLocalizationElement::getLocalizationBase() const
 {
   return _localization;
 }
+
+QString ctkMTLocalizationElement::getContext() const
+{
+  return _context;
+}
@@ -27,8 +27,9 @@
 
 #include <ctkPlugin.h>
 
-ctkMetaTypeInformationImpl::ctkMetaTypeInformationImpl(const QSharedPointer<ctkPlugin>& plugin, ctkLogService* logger)
-  : ctkMetaTypeProviderImpl(plugin, logger)
+ctkMetaTypeInformationImpl::ctkMetaTypeInformationImpl(const QSharedPointer<ctkPlugin>& plugin, ctkLogService* logger,
+                                                       const ctkMTCache* cache)
+  : ctkMetaTypeProviderImpl(plugin, logger, cache)
 {
 
 }
@@ -26,6 +26,7 @@
 #include "ctkAttributeDefinitionImpl_p.h"
 #include "ctkMTMsg_p.h"
 #include "ctkMTDataParser_p.h"
+#include "ctkMTCache_p.h"
 
 #include <ctkPluginConstants.h>
 #include <ctkException.h>
@@ -47,11 +48,22 @@ const QChar ctkMetaTypeProviderImpl::DIRECTORY_SEP = '/';
 
 
 ctkMetaTypeProviderImpl::ctkMetaTypeProviderImpl(
-  const QSharedPointer<ctkPlugin>& plugin, ctkLogService* logger)
+  const QSharedPointer<ctkPlugin>& plugin, ctkLogService* logger, const ctkMTCache* cache)
   : _plugin(plugin), logger(logger), _isThereMeta(false)
 {
-  // read all plugin's metadata files and build internal data structures
-  _isThereMeta = readMetaFiles(plugin);
+  if (cache && cache->read(plugin, _allPidOCDs, _allFPidOCDs))
+  {
+    _isThereMeta = !_allPidOCDs.isEmpty() || !_allFPidOCDs.isEmpty();
+  }
+  else
+  {
+    // read all plugin's metadata files and build internal data structures
+    _isThereMeta = readMetaFiles(plugin);
+    if (cache)
+    {
+      cache->write(plugin, _allPidOCDs, _allFPidOCDs);
+    }
+  }
 
   if (!_isThereMeta)
   {
@@ -27,6 +27,7 @@
 
 class ctkPlugin;
 struct ctkLogService;
+class ctkMTCache;
 class ctkObjectClassDefinitionImpl;
 
 /**
@@ -66,8 +67,13 @@ public:
 
   /**
    * Constructor of class MetaTypeProviderImpl.
+   *
+   * If a cache is given, the object class definitions are read from it
+   * and the plugin's metatype documents are only parsed if the cache is
+   * out of date.
    */
-  ctkMetaTypeProviderImpl(const QSharedPointer<ctkPlugin>& plugin, ctkLogService* logger);
+  ctkMetaTypeProviderImpl(const QSharedPointer<ctkPlugin>& plugin, ctkLogService* logger,
+                          const ctkMTCache* cache = 0);
 
   /*
    * @see ctkMetaTypeProvider#getObjectClassDefinition(const QString&, const QLocale&)
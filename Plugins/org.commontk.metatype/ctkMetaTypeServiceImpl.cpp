@@ -29,8 +29,9 @@
 
 #include <service/log/ctkLogService.h>
 
-ctkMetaTypeServiceImpl::ctkMetaTypeServiceImpl(ctkLogService* logger, ctkServiceTracker<>* metaTypeProviderTracker)
-  : logger(logger), metaTypeProviderTracker(metaTypeProviderTracker)
+ctkMetaTypeServiceImpl::ctkMetaTypeServiceImpl(ctkLogService* logger, ctkServiceTracker<>* metaTypeProviderTracker,
+                                               const QDir& cacheDir)
+  : logger(logger), metaTypeProviderTracker(metaTypeProviderTracker), cache(cacheDir, logger)
 {
 }
 
@@ -59,7 +60,7 @@ ctkMetaTypeInformationPtr ctkMetaTypeServiceImpl::getMetaTypeProvider(const QSha
       return _mtps.value(pID);
     }
 
-    ctkMetaTypeInformationImpl* impl = new ctkMetaTypeInformationImpl(p, logger);
+    ctkMetaTypeInformationImpl* impl = new ctkMetaTypeInformationImpl(p, logger, &cache);
     ctkMetaTypeInformation* mti = impl;
     if (!impl->_isThereMeta)
     {
@@ -80,9 +81,18 @@ void ctkMetaTypeServiceImpl::pluginChanged(const ctkPluginEvent& event)
   switch (type)
   {
     case ctkPluginEvent::UPDATED:
+    {
+      QMutexLocker lock(&_mtpsMutex);
+      _mtps.remove(pID);
+      break;
+    }
     case ctkPluginEvent::UNINSTALLED:
+    {
+      QMutexLocker lock(&_mtpsMutex);
       _mtps.remove(pID);
+      cache.remove(pID);
       break;
+    }
     default :
       break;
   }
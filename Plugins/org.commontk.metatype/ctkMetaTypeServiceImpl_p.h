@@ -26,6 +26,8 @@
 #include <service/metatype/ctkMetaTypeService.h>
 #include <ctkServiceTracker.h>
 
+#include "ctkMTCache_p.h"
+
 #include <QObject>
 
 /**
@@ -43,13 +45,18 @@ private:
 
   ctkLogService* const logger;
   ctkServiceTracker<>* metaTypeProviderTracker;
+  const ctkMTCache cache;
 
 public:
 
   /**
    * Constructor of class ctkMetaTypeServiceImpl.
+   *
+   * @param cacheDir The directory in which the parsed metatype documents
+   *        of the plugins are cached.
    */
-  ctkMetaTypeServiceImpl(ctkLogService* logger, ctkServiceTracker<>* metaTypeProviderTracker);
+  ctkMetaTypeServiceImpl(ctkLogService* logger, ctkServiceTracker<>* metaTypeProviderTracker,
+                         const QDir& cacheDir);
 
   /*
    * @see ctkMetaTypeService#getMetaTypeInformation()
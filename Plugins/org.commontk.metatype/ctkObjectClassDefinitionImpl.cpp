@@ -42,14 +42,14 @@ ctkObjectClassDefinitionImpl::ctkObjectClassDefinitionImpl(const ctkObjectClassD
   : _name(other._name), _id(other._id), _description(other._description),
     _locElem(other._locElem), _type(other._type), _icon(other._icon)
 {
-  for (int i = 0; i < _required.size(); i++)
+  for (int i = 0; i < other._required.size(); i++)
   {
-    ctkAttributeDefinitionImplPtr ad(new ctkAttributeDefinitionImpl(*_required.value(i).data()));
+    ctkAttributeDefinitionImplPtr ad(new ctkAttributeDefinitionImpl(*other._required.value(i).data()));
     this->addAttributeDefinition(ad, true);
   }
-  for (int i = 0; i < _optional.size(); i++)
+  for (int i = 0; i < other._optional.size(); i++)
   {
-    ctkAttributeDefinitionImplPtr ad(new ctkAttributeDefinitionImpl(*_optional.value(i).data()));
+    ctkAttributeDefinitionImplPtr ad(new ctkAttributeDefinitionImpl(*other._optional.value(i).data()));
     this->addAttributeDefinition(ad, false);
   }
 }
@@ -39,6 +39,8 @@ class ctkObjectClassDefinitionImpl : public ctkObjectClassDefinition
 
 private:
 
+  friend class ctkMTCache;
+
   static const QChar LOCALE_SEP; // = '_'
 
   QString _name;